@@ -0,0 +1,10 @@
+#include <string> //std::string
+#include "benchmark.h" //BenchmarkRegistry
+
+int main(int argc, char* argv[]){
+    //Optional name filter and minimum time per benchmark
+    const std::string filter = argc > 1 ? argv[1] : "";
+    const double min_seconds = argc > 2 ? std::stod(argv[2]) : 0.5;
+    mygbc::BenchmarkRegistry::instance().run(filter, min_seconds);
+    return 0;
+}
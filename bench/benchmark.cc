@@ -0,0 +1,123 @@
+#include <iomanip> //std::setw
+#include <iostream> //std::cout
+#include "benchmark.h" //BenchmarkState, BenchmarkRegistry
+#include "../src/util/memory/allocation_counter.h" //AllocationCounter
+
+namespace mygbc{
+
+    /// @brief Initializes state running for at least the given time.
+    /// @param min_seconds Minimum measured time.
+    BenchmarkState::BenchmarkState(const double min_seconds)
+    :min_seconds_(min_seconds), iterations_(0), bytes_per_iteration_(0), started_(false), start_allocations_(0), end_allocations_(0){
+    }
+
+    /// @brief Should the benchmark run another iteration?
+    /// @details Starts the clock on the first call.
+    /// @return Should the benchmark run another iteration?
+    bool BenchmarkState::keep_running(){
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const uint64_t allocations = AllocationCounter::get_allocation_count();
+        if(!started_){
+            started_ = true;
+            start_ = now;
+            end_ = now;
+            start_allocations_ = allocations;
+            end_allocations_ = allocations;
+            return true;
+        }
+        ++iterations_;
+        end_ = now;
+        end_allocations_ = allocations;
+        return get_elapsed_seconds() < min_seconds_;
+    }
+
+    /// @brief Sets the bytes processed by a single iteration for throughput reporting.
+    /// @param bytes Bytes processed per iteration.
+    void BenchmarkState::set_bytes_per_iteration(const uint64_t bytes) noexcept{
+        bytes_per_iteration_ = bytes;
+    }
+
+    /// @brief Sets a custom value reported with the results.
+    /// @param name Name of the value.
+    /// @param value Reported value.
+    void BenchmarkState::set_counter(const std::string& name, const double value){
+        counters_[name] = value;
+    }
+
+    /// @brief Returns the number of completed iterations.
+    /// @return Completed iterations.
+    uint64_t BenchmarkState::get_iterations() const noexcept{
+        return iterations_;
+    }
+
+    /// @brief Returns the measured time.
+    /// @return Measured time in seconds.
+    double BenchmarkState::get_elapsed_seconds() const noexcept{
+        return std::chrono::duration<double>(end_ - start_).count();
+    }
+
+    /// @brief Returns the bytes processed by a single iteration.
+    /// @return Bytes processed per iteration.
+    uint64_t BenchmarkState::get_bytes_per_iteration() const noexcept{
+        return bytes_per_iteration_;
+    }
+
+    /// @brief Returns the heap allocations made by the measured iterations.
+    /// @details Zero unless the allocation hooks are linked.
+    /// @return Allocations of the benchmark thread between the first and the last keep_running.
+    uint64_t BenchmarkState::get_allocations() const noexcept{
+        return end_allocations_ - start_allocations_;
+    }
+
+    /// @brief Returns the custom values.
+    /// @return Name => Value.
+    const std::map<std::string, double>& BenchmarkState::get_counters() const noexcept{
+        return counters_;
+    }
+
+    /// @brief Gets a static instance of the registry
+    /// @return Static instance of the registry
+    BenchmarkRegistry& BenchmarkRegistry::instance(){
+        static BenchmarkRegistry registry;
+        return registry;
+    }
+
+    /// @brief Registers the benchmark.
+    /// @param name Name of the benchmark.
+    /// @param function Benchmark body.
+    /// @return Always true, used for static registration.
+    bool BenchmarkRegistry::add(const std::string& name, BenchmarkFunction function){
+        benchmarks_.emplace_back(name, function);
+        return true;
+    }
+
+    /// @brief Runs the benchmarks whose name contains the filter and prints the results.
+    /// @param filter Substring of the names to run, empty runs all.
+    /// @param min_seconds Minimum measured time per benchmark.
+    void BenchmarkRegistry::run(const std::string& filter, const double min_seconds){
+        for(const auto& [name, function] : benchmarks_){
+            if(!filter.empty() && name.find(filter) == std::string::npos){
+                continue;
+            }
+            BenchmarkState state(min_seconds);
+            function(state);
+            const double iterations = static_cast<double>(state.get_iterations() > 0 ? state.get_iterations() : 1);
+            const double ns_per_iteration = (state.get_elapsed_seconds() * 1e9) / iterations;
+            std::cout << std::left << std::setw(48) << name << std::right
+                << std::setw(12) << state.get_iterations() << " it "
+                << std::fixed << std::setprecision(1) << std::setw(14) << ns_per_iteration << " ns/it";
+            if(state.get_bytes_per_iteration() > 0 && state.get_elapsed_seconds() > 0){
+                const double megabytes_per_second = (static_cast<double>(state.get_bytes_per_iteration()) * iterations) / (state.get_elapsed_seconds() * 1e6);
+                std::cout << std::setw(12) << megabytes_per_second << " MB/s";
+            }
+            if(AllocationCounter::is_hooked()){
+                std::cout << "  allocs_per_it=" << std::setprecision(3) << static_cast<double>(state.get_allocations()) / iterations;
+            }
+            for(const auto& [counter_name, value] : state.get_counters()){
+                std::cout << "  " << counter_name << "=" << std::setprecision(3) << value;
+            }
+            std::cout << "\n";
+        }
+    }
+
+}//namespace_mygbc
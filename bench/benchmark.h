@@ -0,0 +1,100 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono> //std::chrono
+#include <cstdint> //Fixed lenght variables
+#include <map> //std::map
+#include <string> //std::string
+#include <utility> //std::pair
+#include <vector> //std::vector
+
+//Registers the function body following the macro as a benchmark
+#define MYGBC_BENCHMARK(NAME) \
+    static void NAME(mygbc::BenchmarkState& state); \
+    static const bool NAME##_registered = mygbc::BenchmarkRegistry::instance().add(#NAME, NAME); \
+    static void NAME(mygbc::BenchmarkState& state)
+
+namespace mygbc{
+
+    /// @brief Drives the iterations of a single benchmark and collects its results.
+    class BenchmarkState{
+        public:
+            /// @brief Initializes state running for at least the given time.
+            /// @param min_seconds Minimum measured time.
+            explicit BenchmarkState(const double min_seconds);
+
+            /// @brief Should the benchmark run another iteration?
+            /// @details Starts the clock on the first call.
+            /// @return Should the benchmark run another iteration?
+            bool keep_running();
+
+            /// @brief Sets the bytes processed by a single iteration for throughput reporting.
+            /// @param bytes Bytes processed per iteration.
+            void set_bytes_per_iteration(const uint64_t bytes) noexcept;
+
+            /// @brief Sets a custom value reported with the results.
+            /// @param name Name of the value.
+            /// @param value Reported value.
+            void set_counter(const std::string& name, const double value);
+
+            /// @brief Returns the number of completed iterations.
+            /// @return Completed iterations.
+            uint64_t get_iterations() const noexcept;
+
+            /// @brief Returns the measured time.
+            /// @return Measured time in seconds.
+            double get_elapsed_seconds() const noexcept;
+
+            /// @brief Returns the bytes processed by a single iteration.
+            /// @return Bytes processed per iteration.
+            uint64_t get_bytes_per_iteration() const noexcept;
+
+            /// @brief Returns the heap allocations made by the measured iterations.
+            /// @details Zero unless the allocation hooks are linked.
+            /// @return Allocations of the benchmark thread between the first and the last keep_running.
+            uint64_t get_allocations() const noexcept;
+
+            /// @brief Returns the custom values.
+            /// @return Name => Value.
+            const std::map<std::string, double>& get_counters() const noexcept;
+
+        private:
+            const double min_seconds_;
+            uint64_t iterations_;
+            uint64_t bytes_per_iteration_;
+            bool started_;
+            std::chrono::steady_clock::time_point start_;
+            std::chrono::steady_clock::time_point end_;
+            uint64_t start_allocations_;
+            uint64_t end_allocations_;
+            std::map<std::string, double> counters_;
+    };
+
+    //Signature of a benchmark body
+    using BenchmarkFunction = void(*)(BenchmarkState&);
+
+    /// @brief Holds and runs the registered benchmarks.
+    class BenchmarkRegistry{
+        public:
+            /// @brief Gets a static instance of the registry
+            /// @return Static instance of the registry
+            static BenchmarkRegistry& instance();
+
+            /// @brief Registers the benchmark.
+            /// @param name Name of the benchmark.
+            /// @param function Benchmark body.
+            /// @return Always true, used for static registration.
+            bool add(const std::string& name, BenchmarkFunction function);
+
+            /// @brief Runs the benchmarks whose name contains the filter and prints the results.
+            /// @param filter Substring of the names to run, empty runs all.
+            /// @param min_seconds Minimum measured time per benchmark.
+            void run(const std::string& filter, const double min_seconds);
+
+        private:
+            std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,47 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/control/run_ahead.h" //RunAhead
+#include "../../src/snapshot/state_slot.h" //StateSlot
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <vector> //std::vector
+
+/// @brief Writes a byte to each of four RAM pages, as a frame of a game.
+/// @param gbc GBC to write to.
+static void write_frame_pages(mygbc::GBC& gbc){
+    for(uint16_t page = 0; page < 4; ++page){
+        gbc.get_memory().set_byte(static_cast<uint16_t>(0xC000 + (page * 0x100)), 0x01);
+    }
+}
+
+/// @brief Saves and restores a full snapshot around a frame writing four pages.
+MYGBC_BENCHMARK(state_roundtrip_full_snapshot){
+    mygbc::GBC gbc;
+    while(state.keep_running()){
+        const mygbc::GBCSnapshot snapshot = gbc.save_snapshot();
+        write_frame_pages(gbc);
+        gbc.restore_snapshot(snapshot);
+    }
+}
+
+/// @brief Saves and restores a state slot around a frame writing four pages.
+MYGBC_BENCHMARK(state_roundtrip_state_slot){
+    mygbc::GBC gbc;
+    mygbc::StateSlot slot(gbc);
+    while(state.keep_running()){
+        write_frame_pages(gbc);
+        slot.save();
+        write_frame_pages(gbc);
+        slot.restore();
+    }
+    state.set_counter("pages_per_restore", static_cast<double>(slot.get_last_restored_page_count()));
+}
+
+/// @brief Host frame running two frames ahead, the presented frame writes four pages.
+MYGBC_BENCHMARK(run_ahead_two_frames){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    mygbc::RunAhead run_ahead(gbc, 2);
+    run_ahead.set_present_callback(write_frame_pages);
+    while(state.keep_running()){
+        run_ahead.run_frame(0x00);
+    }
+}
@@ -0,0 +1,42 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/episode_resetter.h" //EpisodeResetter
+#include <vector> //std::vector
+
+/// @brief Writes a byte to each of four RAM pages, as a short episode.
+/// @param gbc GBC to write to.
+static void write_episode_pages(mygbc::GBC& gbc){
+    for(uint16_t page = 0; page < 4; ++page){
+        gbc.get_memory().set_byte(static_cast<uint16_t>(0xC000 + (page * 0x100)), 0x01);
+    }
+}
+
+/// @brief Restores a full start snapshot after an episode writing four pages.
+MYGBC_BENCHMARK(episode_reset_full_snapshot){
+    mygbc::GBC gbc;
+    const mygbc::GBCSnapshot start_state = gbc.save_snapshot();
+    while(state.keep_running()){
+        write_episode_pages(gbc);
+        gbc.restore_snapshot(start_state);
+    }
+}
+
+/// @brief Resets from a pool of four start states after an episode writing four pages.
+MYGBC_BENCHMARK(episode_reset_start_state_pool){
+    mygbc::GBC gbc;
+    mygbc::StartStatePool pool;
+    for(uint8_t start = 0; start < 4; ++start){
+        gbc.get_memory().set_byte(0xD000, start);
+        pool.add(gbc.save_snapshot());
+    }
+    mygbc::EpisodeResetter resetter(gbc, pool);
+    resetter.set_random_sampling(1);
+    uint64_t restored_pages = 0;
+    uint64_t resets = 0;
+    while(state.keep_running()){
+        write_episode_pages(gbc);
+        resetter.reset();
+        restored_pages += resetter.get_last_restored_page_count();
+        ++resets;
+    }
+    state.set_counter("pages_per_reset", resets > 0 ? static_cast<double>(restored_pages) / static_cast<double>(resets) : 0.0);
+}
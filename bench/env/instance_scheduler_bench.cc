@@ -0,0 +1,31 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/instance_scheduler.h" //InstanceScheduler
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <chrono> //std::chrono::steady_clock
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+
+/// @brief Runs 1024 instances for a slice worth of cycles on every hardware thread.
+MYGBC_BENCHMARK(instance_scheduler_1024_instances){
+    mygbc::InstanceSchedulerConfig config;
+    config.quantum_cycles = 1024;
+    mygbc::InstanceScheduler scheduler(config);
+    std::vector<std::unique_ptr<mygbc::GBC>> instances;
+    for(std::size_t index = 0; index < 1024; ++index){
+        instances.push_back(std::make_unique<mygbc::GBC>());
+        mygbc::load_jump_loop_rom(*instances.back());
+        scheduler.add_instance(*instances.back());
+    }
+    uint64_t runs = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while(state.keep_running()){
+        scheduler.run_for(config.quantum_cycles * 2);
+        ++runs;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    //Emulated cycles of every instance per host second
+    state.set_counter("emulated_mcycles_per_s", seconds > 0.0 ? static_cast<double>(runs * instances.size() * config.quantum_cycles * 2) / (seconds * 1e6) : 0.0);
+    state.set_counter("steals", static_cast<double>(scheduler.get_steal_count()));
+    state.set_counter("queued_slices", static_cast<double>(scheduler.get_queued_slice_count()));
+    state.set_counter("idle_threads", static_cast<double>(scheduler.get_idle_count()));
+}
@@ -0,0 +1,75 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/lockstep_engine.h" //LockstepEngine
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <array> //std::array
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+
+//Instances of the benchmarks
+static constexpr std::size_t instance_count = 64;
+
+/// @brief Returns instances running a JP 0x0000 loop.
+/// @return Instances.
+static std::vector<std::unique_ptr<mygbc::GBC>> get_jump_loop_instances(){
+    std::vector<std::unique_ptr<mygbc::GBC>> instances;
+    for(std::size_t index = 0; index < instance_count; ++index){
+        instances.push_back(std::make_unique<mygbc::GBC>());
+        mygbc::load_jump_loop_rom(*instances.back());
+    }
+    return instances;
+}
+
+/// @brief Runs a frame of 64 instances one after another on their own CPUs.
+MYGBC_BENCHMARK(lockstep_scalar_frame_64_instances){
+    std::vector<std::unique_ptr<mygbc::GBC>> instances = get_jump_loop_instances();
+    while(state.keep_running()){
+        for(std::unique_ptr<mygbc::GBC>& gbc : instances){
+            gbc->run_until_cycle(gbc->get_cycle_count() + mygbc::GBC::cycles_per_frame);
+        }
+    }
+}
+
+/// @brief Runs a frame of 64 instances in lockstep.
+MYGBC_BENCHMARK(lockstep_engine_frame_64_instances){
+    std::vector<std::unique_ptr<mygbc::GBC>> instances = get_jump_loop_instances();
+    std::vector<mygbc::GBC*> lanes;
+    for(std::unique_ptr<mygbc::GBC>& gbc : instances){
+        lanes.push_back(gbc.get());
+    }
+    mygbc::LockstepEngine engine(lanes);
+    while(state.keep_running()){
+        engine.run_for(mygbc::GBC::cycles_per_frame);
+    }
+    const uint64_t passes = engine.get_lockstep_pass_count();
+    state.set_counter("lanes_per_pass", passes > 0 ? static_cast<double>(engine.get_lockstep_instruction_count()) / static_cast<double>(passes) : 0.0);
+}
+
+/// @brief Runs a frame of 512 instances spread over a ring of 64 JPs, the lanes form many small groups.
+MYGBC_BENCHMARK(lockstep_engine_frame_512_diverged_instances){
+    constexpr std::size_t diverged_instance_count = 512;
+    constexpr std::size_t ring_size = 64;
+    std::vector<uint8_t> rom = mygbc::get_jump_loop_rom_image();
+    for(std::size_t jump = 0; jump < ring_size; ++jump){
+        //The decoder reads the high byte of a16 first
+        const uint16_t target = static_cast<uint16_t>(0x0200 + (3 * ((jump + 1) % ring_size)));
+        rom[0x0200 + (3 * jump)] = 0xC3; //JP a16
+        rom[0x0201 + (3 * jump)] = static_cast<uint8_t>(target >> 8);
+        rom[0x0202 + (3 * jump)] = static_cast<uint8_t>(target & 0xFF);
+    }
+    std::vector<std::unique_ptr<mygbc::GBC>> instances;
+    std::vector<mygbc::GBC*> lanes;
+    for(std::size_t index = 0; index < diverged_instance_count; ++index){
+        instances.push_back(std::make_unique<mygbc::GBC>());
+        mygbc::load_test_rom(*instances.back(), rom);
+        //ir_ie, a_f, b_c, d_e, h_l, pc, sp
+        const std::array<uint16_t, mygbc::GBCSnapshot::register_count> register_words{0, 0, 0, 0, 0, static_cast<uint16_t>(0x0200 + (3 * ((index * 7) % ring_size))), 0xFFFE};
+        instances.back()->get_processing_unit().get_register_file().set_register_words(register_words);
+        lanes.push_back(instances.back().get());
+    }
+    mygbc::LockstepEngine engine(lanes);
+    while(state.keep_running()){
+        engine.run_for(mygbc::GBC::cycles_per_frame);
+    }
+    const uint64_t passes = engine.get_lockstep_pass_count();
+    state.set_counter("lanes_per_pass", passes > 0 ? static_cast<double>(engine.get_lockstep_instruction_count()) / static_cast<double>(passes) : 0.0);
+}
@@ -0,0 +1,35 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/observation_preprocessor.h" //ObservationPreprocessor
+#include <vector> //std::vector
+
+/// @brief Preprocesses a frame into the stack and writes the observation.
+/// @param state Benchmark state.
+/// @param downscale_factor Width and height of the averaged pixel blocks.
+static void run_preprocessor(mygbc::BenchmarkState& state, const uint32_t downscale_factor){
+    std::vector<uint8_t> frame(mygbc::ObservationPreprocessor::frame_width * mygbc::ObservationPreprocessor::frame_height);
+    for(std::size_t pixel = 0; pixel < frame.size(); ++pixel){
+        frame[pixel] = static_cast<uint8_t>((pixel * 7) >> 3);
+    }
+    mygbc::ObservationPreprocessor preprocessor(downscale_factor, 4);
+    std::vector<uint8_t> observation(preprocessor.get_observation_size());
+    state.set_bytes_per_iteration(frame.size());
+    while(state.keep_running()){
+        preprocessor.push_frame(frame.data());
+        preprocessor.write_observation(observation.data());
+    }
+}
+
+/// @brief Full size grayscale frames stacked by four.
+MYGBC_BENCHMARK(observation_preprocessor_full_size){
+    run_preprocessor(state, 1);
+}
+
+/// @brief 80x72 grayscale frames stacked by four.
+MYGBC_BENCHMARK(observation_preprocessor_half_size){
+    run_preprocessor(state, 2);
+}
+
+/// @brief 40x36 grayscale frames stacked by four, without SIMD.
+MYGBC_BENCHMARK(observation_preprocessor_quarter_size){
+    run_preprocessor(state, 4);
+}
@@ -0,0 +1,44 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/ram_watch.h" //RamWatch
+#include <vector> //std::vector
+
+/// @brief Returns a watch list of 64 addresses in runs of four, as multi-byte score and position fields.
+/// @return Watched addresses.
+static std::vector<uint16_t> get_watched_addresses(){
+    std::vector<uint16_t> addresses;
+    for(uint16_t field = 0; field < 16; ++field){
+        for(uint16_t offset = 0; offset < 4; ++offset){
+            addresses.push_back(static_cast<uint16_t>(0xC000 + (field * 0x40) + offset));
+        }
+    }
+    return addresses;
+}
+
+/// @brief Reads the watched addresses of 16 instances with a StatusOr get_byte per address.
+MYGBC_BENCHMARK(ram_watch_get_byte_16_instances){
+    const std::vector<uint16_t> addresses = get_watched_addresses();
+    std::vector<mygbc::MemoryController> memories(16);
+    std::vector<uint8_t> output(memories.size() * addresses.size());
+    while(state.keep_running()){
+        for(std::size_t index = 0; index < memories.size(); ++index){
+            for(std::size_t address_index = 0; address_index < addresses.size(); ++address_index){
+                mygbc::StatusOr<uint8_t> byte_fetch = memories[index].AddressableMemory::get_byte(addresses[address_index]);
+                output[(index * addresses.size()) + address_index] = byte_fetch.ok() ? byte_fetch.value() : 0;
+            }
+        }
+    }
+    state.set_bytes_per_iteration(output.size());
+}
+
+/// @brief Reads the watched addresses of 16 instances through a RamWatch.
+MYGBC_BENCHMARK(ram_watch_read_16_instances){
+    const mygbc::RamWatch watch(get_watched_addresses());
+    std::vector<mygbc::MemoryController> memories(16);
+    std::vector<uint8_t> output(memories.size() * watch.get_size());
+    while(state.keep_running()){
+        for(std::size_t index = 0; index < memories.size(); ++index){
+            watch.read_strided(memories[index], output.data(), watch.get_size(), index);
+        }
+    }
+    state.set_bytes_per_iteration(output.size());
+}
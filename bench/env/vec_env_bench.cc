@@ -0,0 +1,40 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/env/vec_env.h" //VecEnv
+#include "../../test/test_rom.h" //get_jump_loop_rom_image
+#include <chrono> //std::chrono::steady_clock
+#include <vector> //std::vector
+
+/// @brief Runs a step of the environment per iteration.
+/// @param state Benchmark state.
+/// @param thread_count Threads stepping the instances.
+static void run_vec_env_steps(mygbc::BenchmarkState& state, const std::size_t thread_count){
+    mygbc::GBCBinary binary = mygbc::get_test_binary(mygbc::get_jump_loop_rom_image());
+    mygbc::VecEnvConfig config;
+    config.instance_count = 16;
+    config.frames_per_step = 1;
+    config.thread_count = thread_count;
+    config.observation_addresses = {0xC000, 0xC001, 0xFF00};
+    mygbc::VecEnv env(binary, config);
+    std::vector<uint8_t> actions(config.instance_count, 0x00);
+    std::vector<uint8_t> observations(config.instance_count * env.get_observation_size());
+    std::vector<uint8_t> dones(config.instance_count);
+    uint64_t steps = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while(state.keep_running()){
+        env.step(actions.data(), observations.data(), dones.data());
+        ++steps;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    //Instance steps per second, the throughput of the environment
+    state.set_counter("env_steps_per_s", seconds > 0.0 ? static_cast<double>(steps * config.instance_count) / seconds : 0.0);
+}
+
+/// @brief Steps of 16 instances on the calling thread.
+MYGBC_BENCHMARK(vec_env_step_1_thread){
+    run_vec_env_steps(state, 1);
+}
+
+/// @brief Steps of 16 instances on every hardware thread.
+MYGBC_BENCHMARK(vec_env_step_all_threads){
+    run_vec_env_steps(state, 0);
+}
@@ -0,0 +1,32 @@
+#include "benchmark.h" //MYGBC_BENCHMARK
+#include "../src/gbc.h" //GBC
+#include "../src/util/memory/allocation_counter.h" //AllocationScope
+#include "../test/test_rom.h" //load_jump_loop_rom
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+
+/// @brief Frame of steady state emulation, reports the heap allocations per instruction.
+MYGBC_BENCHMARK(gbc_run_frame){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    gbc.run_frame();
+    const uint64_t start_instructions = gbc.get_metrics().instructions;
+    mygbc::AllocationScope scope;
+    while(state.keep_running()){
+        gbc.run_frame();
+    }
+    const double instructions = static_cast<double>(gbc.get_metrics().instructions - start_instructions);
+    state.set_counter("allocs_per_instruction", instructions > 0 ? static_cast<double>(scope.get_allocation_count()) / instructions : 0.0);
+}
+
+/// @brief Construction of a GBC once the shared tables are built, reports the footprint of an instance.
+MYGBC_BENCHMARK(gbc_construct){
+    //Build the shared tables
+    mygbc::GBC warm_up;
+    std::size_t footprint_bytes = 0;
+    while(state.keep_running()){
+        std::unique_ptr<mygbc::GBC> gbc = std::make_unique<mygbc::GBC>();
+        footprint_bytes = gbc->get_memory_footprint().get_total_bytes();
+    }
+    state.set_counter("footprint_kib", static_cast<double>(footprint_bytes) / 1024.0);
+}
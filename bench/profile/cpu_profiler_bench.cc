@@ -0,0 +1,27 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/profile/cpu_profiler.h" //CpuProfiler
+#include "../../src/gbc.h" //GBC
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <vector> //std::vector
+
+/// @brief Frame without profiling, baseline for the profiled frame.
+MYGBC_BENCHMARK(cpu_profiler_run_frame_unprofiled){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    while(state.keep_running()){
+        gbc.run_frame();
+    }
+}
+
+/// @brief Frame with the cycles of every instruction counted.
+MYGBC_BENCHMARK(cpu_profiler_run_frame_profiled){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    mygbc::CpuProfiler profiler(512);
+    gbc.get_processing_unit().set_profiler(&profiler);
+    while(state.keep_running()){
+        gbc.run_frame();
+    }
+    gbc.get_processing_unit().set_profiler(nullptr);
+    state.set_counter("counter_bytes", static_cast<double>(profiler.get_memory_usage()));
+}
@@ -0,0 +1,35 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/snapshot/rewind_buffer.h" //RewindBuffer
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <chrono> //std::chrono::steady_clock
+
+/// @brief Frame with a rewind capture every frame, reports the share of the capture in the frame time.
+/// @details Each frame writes a WRAM page, the OAM and the HRAM, about what a game touches per frame. The target is a
+///          capture share below 5 percent.
+MYGBC_BENCHMARK(rewind_capture_frame){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    mygbc::RewindBuffer rewind(gbc, 16 * 1024 * 1024, 1, 60);
+    uint64_t frame_ns = 0;
+    uint64_t capture_ns = 0;
+    uint8_t value = 0;
+    while(state.keep_running()){
+        ++value;
+        for(uint16_t addr = 0; addr < 0x100; addr += 4){
+            gbc.get_memory().set_byte(static_cast<uint16_t>(0xC000 + addr), value);
+            gbc.get_memory().set_byte(static_cast<uint16_t>(0xFE00 + (addr % 0xA0)), value);
+        }
+        gbc.get_memory().set_byte(0xFF90, value);
+        const std::chrono::steady_clock::time_point frame_start = std::chrono::steady_clock::now();
+        gbc.run_frame();
+        const std::chrono::steady_clock::time_point capture_start = std::chrono::steady_clock::now();
+        rewind.on_frame_end();
+        const std::chrono::steady_clock::time_point capture_end = std::chrono::steady_clock::now();
+        frame_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(capture_start - frame_start).count());
+        capture_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(capture_end - capture_start).count());
+    }
+    state.set_counter("capture_share_pct", frame_ns > 0 ? (100.0 * static_cast<double>(capture_ns)) / static_cast<double>(frame_ns) : 0.0);
+    state.set_counter("capture_us", static_cast<double>(capture_ns) / 1000.0 / static_cast<double>(gbc.get_frame_count() > 0 ? gbc.get_frame_count() : 1));
+    state.set_counter("memory_kib", static_cast<double>(rewind.get_memory_usage()) / 1024.0);
+    state.set_counter("scratch_kib", static_cast<double>(rewind.get_scratch_memory_usage()) / 1024.0);
+}
@@ -0,0 +1,19 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/snapshot/snapshot_page_store.h" //SnapshotPageStore
+#include "../../src/gbc.h" //GBC
+
+/// @brief Stores incremental snapshots with a few dirty pages each, reports the bytes per snapshot.
+MYGBC_BENCHMARK(snapshot_page_store_store_incremental){
+    mygbc::GBC gbc;
+    mygbc::SnapshotPageStore store;
+    mygbc::SnapshotPageStore::SnapshotId previous = store.store(gbc.save_snapshot()).value();
+    uint8_t counter = 0;
+    while(state.keep_running()){
+        ++counter;
+        gbc.get_memory().set_byte(0xC000, counter);
+        gbc.get_memory().set_byte(0xD100 + (counter & 0x0F), counter);
+        previous = store.store(gbc.save_incremental_snapshot(), previous).value();
+    }
+    state.set_counter("snapshots", static_cast<double>(store.get_snapshot_count()));
+    state.set_counter("bytes_per_snapshot", static_cast<double>(store.get_memory_usage()) / static_cast<double>(store.get_snapshot_count()));
+}
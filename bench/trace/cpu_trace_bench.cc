@@ -0,0 +1,33 @@
+#include "../benchmark.h" //MYGBC_BENCHMARK
+#include "../../src/trace/cpu_trace_recorder.h" //CpuTraceRecorder
+#include "../../src/gbc.h" //GBC
+#include "../../test/test_rom.h" //load_jump_loop_rom
+#include <filesystem> //std::filesystem
+#include <vector> //std::vector
+
+/// @brief Frame without tracing, baseline for the traced frame.
+MYGBC_BENCHMARK(cpu_trace_run_frame_untraced){
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    while(state.keep_running()){
+        gbc.run_frame();
+    }
+}
+
+/// @brief Frame with every instruction recorded to a trace file.
+MYGBC_BENCHMARK(cpu_trace_run_frame_traced){
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "mygbc_cpu_trace_bench.mgtr";
+    mygbc::GBC gbc;
+    mygbc::load_jump_loop_rom(gbc);
+    mygbc::CpuTraceRecorder recorder;
+    recorder.open(path.string(), gbc.get_cycle_count());
+    gbc.get_processing_unit().set_trace_recorder(&recorder);
+    while(state.keep_running()){
+        gbc.run_frame();
+    }
+    gbc.get_processing_unit().set_trace_recorder(nullptr);
+    const double records = static_cast<double>(recorder.get_record_count());
+    recorder.close();
+    state.set_counter("bytes_per_record", static_cast<double>(std::filesystem::file_size(path)) / records);
+    std::filesystem::remove(path);
+}
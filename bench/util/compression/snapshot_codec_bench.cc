@@ -0,0 +1,60 @@
+#include "../../benchmark.h" //MYGBC_BENCHMARK
+#include "../../../src/util/compression/snapshot_codec.h" //SnapshotCodec
+#include <random> //std::mt19937
+#include <vector> //std::vector
+
+/// @brief Builds a 64 KiB image resembling GB memory.
+/// @details Zeroed areas, repeated tiles and a few pages of noise.
+/// @return Memory image.
+static std::vector<uint8_t> build_memory_image(){
+    std::vector<uint8_t> image(0x10000, 0x00);
+    std::mt19937 generator(0x6BC);
+    //ROM code and data
+    for(std::size_t addr = 0x0000; addr < 0x3000; ++addr){
+        image[addr] = static_cast<uint8_t>(generator());
+    }
+    //Tile data repeating a handful of tiles
+    for(std::size_t addr = 0x8000; addr < 0x9000; addr += 16){
+        for(std::size_t byte = 0; byte < 16; ++byte){
+            image[addr + byte] = static_cast<uint8_t>(((addr >> 4) % 6) * 0x11 + byte);
+        }
+    }
+    //Work RAM variables
+    for(std::size_t addr = 0xC000; addr < 0xC400; ++addr){
+        image[addr] = static_cast<uint8_t>(generator() & 0x0F);
+    }
+    return image;
+}
+
+/// @brief Compression throughput of a memory image.
+MYGBC_BENCHMARK(snapshot_codec_compress_memory_image){
+    const std::vector<uint8_t> image = build_memory_image();
+    std::vector<uint8_t> compressed;
+    while(state.keep_running()){
+        mygbc::SnapshotCodec::compress(image.data(), image.size(), compressed);
+    }
+    state.set_bytes_per_iteration(image.size());
+    state.set_counter("ratio", static_cast<double>(image.size()) / static_cast<double>(compressed.size()));
+}
+
+/// @brief Decompression throughput of a memory image.
+MYGBC_BENCHMARK(snapshot_codec_decompress_memory_image){
+    const std::vector<uint8_t> image = build_memory_image();
+    const std::vector<uint8_t> compressed = mygbc::SnapshotCodec::compress(image);
+    std::vector<uint8_t> decompressed;
+    while(state.keep_running()){
+        mygbc::SnapshotCodec::decompress(compressed, decompressed);
+    }
+    state.set_bytes_per_iteration(image.size());
+}
+
+/// @brief Zero run scanning throughput.
+MYGBC_BENCHMARK(snapshot_codec_zero_run_scan){
+    const std::vector<uint8_t> zeroes(0x10000, 0x00);
+    std::size_t run = 0;
+    while(state.keep_running()){
+        run += mygbc::SnapshotCodec::count_zero_run(zeroes.data(), zeroes.size());
+    }
+    state.set_bytes_per_iteration(zeroes.size());
+    state.set_counter("checksum", static_cast<double>(run & 0xFF));
+}
@@ -0,0 +1,34 @@
+#include "../../benchmark.h" //MYGBC_BENCHMARK
+#include "../../../src/util/hash/content_hash.h" //ContentHash
+#include "../../../src/snapshot/state_hasher.h" //StateHasher
+#include <vector> //std::vector
+
+/// @brief Hash throughput over a single page.
+MYGBC_BENCHMARK(content_hash_page){
+    std::vector<uint8_t> page(0x100);
+    for(std::size_t index = 0; index < page.size(); ++index){
+        page[index] = static_cast<uint8_t>(index * 31);
+    }
+    uint64_t hash = 0;
+    while(state.keep_running()){
+        hash += mygbc::ContentHash::hash(page.data(), page.size(), hash);
+    }
+    state.set_bytes_per_iteration(page.size());
+    state.set_counter("checksum", static_cast<double>(hash & 0xFF));
+}
+
+/// @brief State hash update with a few dirty pages, as after a typical frame.
+MYGBC_BENCHMARK(state_hasher_update_few_dirty_pages){
+    mygbc::GBC gbc;
+    mygbc::StateHasher hasher(gbc);
+    hasher.update();
+    uint8_t counter = 0;
+    uint64_t hash = 0;
+    while(state.keep_running()){
+        ++counter;
+        gbc.get_memory().set_byte(0xC000, counter);
+        gbc.get_memory().set_byte(0xFF80, counter);
+        hash ^= hasher.update();
+    }
+    state.set_counter("checksum", static_cast<double>(hash & 0xFF));
+}
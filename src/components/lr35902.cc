@@ -4,7 +4,7 @@
 namespace mygbc{
     /// @brief Initializes the CPU for execution
     /// @details Sets pc pointing at 0x00 (BOOT start)
-    LR35902::LR35902(){
+    LR35902::LR35902():trace_recorder_(nullptr), profiler_(nullptr){
         //Point the pc at the start of the boot rom
         register_file_.pc.set_word(0x00);
     }
@@ -12,14 +12,85 @@ namespace mygbc{
     /// @brief Emulates one fetch-decode-execute cycle returning the costs of that cycle.
     /// @return Status or Cost of the fetch-decode-execute cycle.
     StatusOr<uint8_t> LR35902::fetch_decode_execute(MemoryController& memory_controller){
-        //Fetch and decode
-        StatusOr<InstructionLR35902> instruction_fetch = InstructionDecoderLR35902::decode(
+        const uint16_t pc = register_file_.pc.get_word();
+        StatusOr<uint8_t> cost = trace_recorder_ != nullptr ?
+            fetch_decode_execute_traced(memory_controller) : fetch_decode_execute_untraced(memory_controller);
+        if(profiler_ != nullptr && cost.ok()){
+            profiler_->record(pc, cost.value());
+        }
+        return cost;
+    }
+
+    /// @brief Grants access to the registers of the CPU.
+    /// @return Register file of the CPU.
+    LR35902RegisterFile& LR35902::get_register_file(){
+        return register_file_;
+    }
+
+    /// @brief Sets the recorder of the executed instructions.
+    /// @param trace_recorder Open recorder or nullptr to stop tracing. Must outlive the tracing.
+    void LR35902::set_trace_recorder(CpuTraceRecorder* trace_recorder) noexcept{
+        trace_recorder_ = trace_recorder;
+    }
+
+    /// @brief Sets the profiler of the executed instructions.
+    /// @param profiler Profiler or nullptr to stop profiling. Must outlive the profiling.
+    void LR35902::set_profiler(CpuProfiler* profiler) noexcept{
+        profiler_ = profiler;
+    }
+
+    /// @brief Is a trace recorder or a profiler attached?
+    /// @return Does every instruction have to pass through the CPU to be seen?
+    bool LR35902::is_instrumented() const noexcept{
+        return trace_recorder_ != nullptr || profiler_ != nullptr;
+    }
+
+    /// @brief Adds the memory used by the CPU components to the footprint.
+    /// @details Components are reported with their own size and the heap memory they own. The instruction and
+    ///         register lookup tables are shared by every CPU and not reported.
+    ///         Attached trace recorders and profilers are reported with the memory of their buffers.
+    /// @param footprint Footprint to add to.
+    void LR35902::add_memory_footprint(MemoryFootprint& footprint) const{
+        footprint.add("register_file", sizeof(register_file_) + register_file_.get_memory_usage());
+        footprint.add("instruction_set", sizeof(instruction_set_));
+        footprint.add("instruction_executor", sizeof(instruction_executor_));
+        if(profiler_ != nullptr){
+            footprint.add("cpu_profiler", sizeof(CpuProfiler) + profiler_->get_memory_usage());
+        }
+        if(trace_recorder_ != nullptr){
+            footprint.add("cpu_trace_buffers", sizeof(CpuTraceRecorder) + trace_recorder_->get_memory_usage());
+        }
+    }
+
+    /// @brief Executes the instruction at PC and records it to the trace.
+    /// @return Status or Cost of the fetch-decode-execute cycle.
+    StatusOr<uint8_t> LR35902::fetch_decode_execute_traced(MemoryController& memory_controller){
+        const std::array<uint16_t, CpuTraceEntry::register_count> register_words = register_file_.get_register_words();
+        const uint16_t pc = register_file_.pc.get_word();
+        std::array<uint8_t, 4> pc_memory{};
+        for(uint16_t offset = 0; offset < pc_memory.size(); ++offset){
+            //Uncounted read, the trace must not skew the access metrics
+            StatusOr<uint8_t> byte = memory_controller.AddressableMemory::get_byte(static_cast<uint16_t>(pc + offset));
+            pc_memory[offset] = byte.ok() ? byte.value() : 0x00;
+        }
+        StatusOr<uint8_t> cost = fetch_decode_execute_untraced(memory_controller);
+        if(cost.ok()){
+            trace_recorder_->record(register_words, pc_memory, cost.value());
+        }
+        return cost;
+    }
+
+    /// @brief Executes the instruction at PC.
+    /// @return Status or Cost of the fetch-decode-execute cycle.
+    StatusOr<uint8_t> LR35902::fetch_decode_execute_untraced(MemoryController& memory_controller){
+        //Fetch and decode, the instruction is not copied out of the set
+        StatusOr<DecodedInstructionLR35902> instruction_fetch = InstructionDecoderLR35902::decode_reference(
             memory_controller, register_file_.pc.get_word(), instruction_set_
         );
         if(instruction_fetch.ok()){
             //Execute
-            InstructionLR35902 instruction = std::move(instruction_fetch).value();
-            return instruction_executor_.execute_instruction(instruction, register_file_, memory_controller);
+            const DecodedInstructionLR35902& decoded = instruction_fetch.value();
+            return instruction_executor_.execute_instruction(*decoded.instruction, decoded.read_value, register_file_, memory_controller);
         }
         return instruction_fetch.status();
     }
@@ -5,6 +5,9 @@
 #include "memory_controller.h" //MemoryController
 #include "../instruction_set_lr35902/instruction_set_lr35902.h" //InstructionSetLR35902
 #include "../instruction_set_lr35902/instruction_executor_lr35902.h" //InstructionExecutorLR35902
+#include "../trace/cpu_trace_recorder.h" //CpuTraceRecorder
+#include "../profile/cpu_profiler.h" //CpuProfiler
+#include "../profile/memory_footprint.h" //MemoryFootprint
 
 namespace mygbc{
 
@@ -20,8 +23,40 @@ namespace mygbc{
         /// @brief Emulates one fetch-decode-execute cycle returning the costs of that cycle.
         /// @return Status or Cost of the fetch-decode-execute cycle.
         StatusOr<uint8_t> fetch_decode_execute(MemoryController& memory_controller);
+
+        /// @brief Grants access to the registers of the CPU.
+        /// @return Register file of the CPU.
+        LR35902RegisterFile& get_register_file();
+
+        /// @brief Sets the recorder of the executed instructions.
+        /// @param trace_recorder Open recorder or nullptr to stop tracing. Must outlive the tracing.
+        void set_trace_recorder(CpuTraceRecorder* trace_recorder) noexcept;
+
+        /// @brief Sets the profiler of the executed instructions.
+        /// @param profiler Profiler or nullptr to stop profiling. Must outlive the profiling.
+        void set_profiler(CpuProfiler* profiler) noexcept;
+
+        /// @brief Is a trace recorder or a profiler attached?
+        /// @return Does every instruction have to pass through the CPU to be seen?
+        bool is_instrumented() const noexcept;
+
+        /// @brief Adds the memory used by the CPU components to the footprint.
+        /// @details Components are reported with their own size and the heap memory they own. The instruction and
+        ///         register lookup tables are shared by every CPU and not reported.
+        ///         Attached trace recorders and profilers are reported with the memory of their buffers.
+        /// @param footprint Footprint to add to.
+        void add_memory_footprint(MemoryFootprint& footprint) const;
         
         private:
+
+        /// @brief Executes the instruction at PC and records it to the trace.
+        /// @return Status or Cost of the fetch-decode-execute cycle.
+        StatusOr<uint8_t> fetch_decode_execute_traced(MemoryController& memory_controller);
+
+        /// @brief Executes the instruction at PC.
+        /// @return Status or Cost of the fetch-decode-execute cycle.
+        StatusOr<uint8_t> fetch_decode_execute_untraced(MemoryController& memory_controller);
+
         //Registers of the cpu
         LR35902RegisterFile register_file_;
 
@@ -30,6 +65,12 @@ namespace mygbc{
 
         //Executor of the LR35902 instructions
         InstructionExecutorLR35902 instruction_executor_;
+
+        //Recorder of the executed instructions, nullptr when not tracing
+        CpuTraceRecorder* trace_recorder_;
+
+        //Profiler of the executed instructions, nullptr when not profiling
+        CpuProfiler* profiler_;
     };
 
 }//namespace_mygbc
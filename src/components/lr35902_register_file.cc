@@ -1,25 +1,58 @@
 #include "lr35902_register_file.h" //LR35902RegisterFile
+#include "../profile/memory_footprint.h" //MemoryFootprint
 
 namespace mygbc{
 
-    /// @brief Initializes the register_file and lookup tables.
+    /// @brief Initializes the register_file.
+    /// @details The id lookup table is built once per process and shared by every register file.
     LR35902RegisterFile::LR35902RegisterFile()
-    :lower_eight_index(1), register_lookup_table(std::move(get_lookup_table())){
+    :lower_eight_index(1){
     }
 
     /// @brief Returns the lookup table for id to register lookup.
+    /// @details Built on each call from the shared lookup table.
     /// @return Id to register lookup table.
     const std::unordered_map<std::string, Register16Bit*> LR35902RegisterFile::get_lookup_table(){
-        return std::unordered_map<std::string, Register16Bit*>{
-            {"A", &a_f}, {"F", &a_f}, {"AF", &a_f},
-            {"B", &b_c}, {"C", &b_c}, {"BC", &b_c},
-            {"D", &d_e}, {"E", &d_e}, {"DE", &d_e},
-            {"H", &h_l}, {"L", &h_l}, {"HL", &h_l},
-            {"IR", &ir_ie},
-            {"IE", &ir_ie},
-            {"PC", &pc},
-            {"SP", &sp}
+        std::unordered_map<std::string, Register16Bit*> lookup_table;
+        for(const std::pair<const std::string, Register16Bit LR35902RegisterFile::*>& entry : get_shared_lookup_table()){
+            lookup_table.emplace(entry.first, &(this->*entry.second));
+        }
+        return lookup_table;
+    }
+
+    /// @brief Returns the memory used by the shared lookup table.
+    /// @details Shared by every register file, so it is not part of the footprint of an instance.
+    /// @return Memory usage in bytes.
+    std::size_t LR35902RegisterFile::get_shared_memory_usage() noexcept{
+        const std::unordered_map<std::string, Register16Bit LR35902RegisterFile::*>& lookup_table = get_shared_lookup_table();
+        std::size_t bytes = MemoryFootprint::get_unordered_map_usage(lookup_table);
+        for(const std::pair<const std::string, Register16Bit LR35902RegisterFile::*>& entry : lookup_table){
+            bytes += MemoryFootprint::get_string_usage(entry.first);
+        }
+        return bytes;
+    }
+
+    /// @brief Returns the heap memory owned by the registers.
+    /// @return Owned bytes.
+    std::size_t LR35902RegisterFile::get_memory_usage() const noexcept{
+        return ir_ie.get_memory_usage() + a_f.get_memory_usage() + b_c.get_memory_usage() + d_e.get_memory_usage() +
+            h_l.get_memory_usage() + pc.get_memory_usage() + sp.get_memory_usage();
+    }
+
+    /// @brief Returns the shared id lookup table, builds it on first use.
+    /// @return Id to register member lookup table.
+    const std::unordered_map<std::string, Register16Bit LR35902RegisterFile::*>& LR35902RegisterFile::get_shared_lookup_table(){
+        static const std::unordered_map<std::string, Register16Bit LR35902RegisterFile::*> lookup_table{
+            {"A", &LR35902RegisterFile::a_f}, {"F", &LR35902RegisterFile::a_f}, {"AF", &LR35902RegisterFile::a_f},
+            {"B", &LR35902RegisterFile::b_c}, {"C", &LR35902RegisterFile::b_c}, {"BC", &LR35902RegisterFile::b_c},
+            {"D", &LR35902RegisterFile::d_e}, {"E", &LR35902RegisterFile::d_e}, {"DE", &LR35902RegisterFile::d_e},
+            {"H", &LR35902RegisterFile::h_l}, {"L", &LR35902RegisterFile::h_l}, {"HL", &LR35902RegisterFile::h_l},
+            {"IR", &LR35902RegisterFile::ir_ie},
+            {"IE", &LR35902RegisterFile::ir_ie},
+            {"PC", &LR35902RegisterFile::pc},
+            {"SP", &LR35902RegisterFile::sp}
         };
+        return lookup_table;
     }
 
     /// @brief Helper to get the zero flag from F register
@@ -94,12 +127,37 @@ namespace mygbc{
     /// @details Returns reference to the register.
     /// @return Reference to the register or Status.
     StatusOr<Register16Bit*> LR35902RegisterFile::get_register_by_id(const std::string& id) noexcept{
-        if(register_lookup_table.find(id) != register_lookup_table.end()){
-            return register_lookup_table.at(id);
+        const std::unordered_map<std::string, Register16Bit LR35902RegisterFile::*>& lookup_table = get_shared_lookup_table();
+        const auto register_member = lookup_table.find(id);
+        if(register_member != lookup_table.end()){
+            return &(this->*register_member->second);
         }
         //Valid opcode was not found for the input
         return Status::invalid_register_id_error(
             "Given register ID is not a LR35902 register! " + id
         );
     }
+
+    /// @brief Returns the values of all registers.
+    /// @details Order is ir_ie, a_f, b_c, d_e, h_l, pc, sp.
+    /// @return Values of all registers.
+    std::array<uint16_t, 7> LR35902RegisterFile::get_register_words() noexcept{
+        return std::array<uint16_t, 7>{
+            ir_ie.get_word(), a_f.get_word(), b_c.get_word(), d_e.get_word(),
+            h_l.get_word(), pc.get_word(), sp.get_word()
+        };
+    }
+
+    /// @brief Sets the values of all registers.
+    /// @details Order is ir_ie, a_f, b_c, d_e, h_l, pc, sp.
+    /// @param words New values of the registers.
+    void LR35902RegisterFile::set_register_words(const std::array<uint16_t, 7>& words) noexcept{
+        ir_ie.set_word(words[0]);
+        a_f.set_word(words[1]);
+        b_c.set_word(words[2]);
+        d_e.set_word(words[3]);
+        h_l.set_word(words[4]);
+        pc.set_word(words[5]);
+        sp.set_word(words[6]);
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef LR35902_REGISTER_FILE_H
 #define LR35902_REGISTER_FILE_H
 
+#include <array> //std::array
 #include <unordered_map> //std::unordered_map
 #include <string> //std::string
 #include "../memory/register_16bit.h" //Register16Bit
@@ -18,16 +19,24 @@ namespace mygbc{
         //Flag registry index
         const uint8_t lower_eight_index;
 
-        /// id lookup table
-        const std::unordered_map<std::string, Register16Bit*> register_lookup_table;
-
-        /// @brief Initializes the register_file and lookup tables.
+        /// @brief Initializes the register_file.
+        /// @details The id lookup table is built once per process and shared by every register file.
         LR35902RegisterFile();
 
         /// @brief Returns the lookup table for id to register lookup.
+        /// @details Built on each call from the shared lookup table.
         /// @return Id to register lookup table.
         const std::unordered_map<std::string, Register16Bit*> get_lookup_table();
 
+        /// @brief Returns the memory used by the shared lookup table.
+        /// @details Shared by every register file, so it is not part of the footprint of an instance.
+        /// @return Memory usage in bytes.
+        static std::size_t get_shared_memory_usage() noexcept;
+
+        /// @brief Returns the heap memory owned by the registers.
+        /// @return Owned bytes.
+        std::size_t get_memory_usage() const noexcept;
+
         /// @brief Helper to get the zero flag from F register
         /// @details Queries the 7th bit of the F registry.
         /// @return State of the zero flag or status.
@@ -73,6 +82,22 @@ namespace mygbc{
         /// @return Reference to the register or Status.
         StatusOr<Register16Bit*> get_register_by_id(const std::string& id) noexcept;
 
+        /// @brief Returns the values of all registers.
+        /// @details Order is ir_ie, a_f, b_c, d_e, h_l, pc, sp.
+        /// @return Values of all registers.
+        std::array<uint16_t, 7> get_register_words() noexcept;
+
+        /// @brief Sets the values of all registers.
+        /// @details Order is ir_ie, a_f, b_c, d_e, h_l, pc, sp.
+        /// @param words New values of the registers.
+        void set_register_words(const std::array<uint16_t, 7>& words) noexcept;
+
+        private:
+
+        /// @brief Returns the shared id lookup table, builds it on first use.
+        /// @return Id to register member lookup table.
+        static const std::unordered_map<std::string, Register16Bit LR35902RegisterFile::*>& get_shared_lookup_table();
+
     };
 }
 
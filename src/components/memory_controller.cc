@@ -0,0 +1,212 @@
+#include <algorithm> //std::min
+#include <cstring> //std::memcpy
+#include <vector> //std::vector
+#include "memory_controller.h" //MemoryController
+
+namespace mygbc{
+
+    /// @brief Initializes zeroed address space.
+    MemoryController::MemoryController()
+    :AddressableMemory(std::vector<uint8_t>(address_space_size, 0x00), false), joypad_buttons_(0), write_watch_(nullptr), watched_writes_{}{
+        update_joypad_register();
+    }
+
+    /// @brief Returns the byte located at the given address.
+    /// @details Counts the read in the access counters.
+    /// @param addr Address of the byte.
+    /// @return byte value located at the given address or error Status.
+    StatusOr<uint8_t> MemoryController::get_byte(const uint16_t addr) noexcept{
+        access_counters_.record_read(addr);
+        return AddressableMemory::get_byte(addr);
+    }
+
+    /// @brief Returns the word located at the given address.
+    /// @details Byte order matches AddressableMemory::get_word. Counts both byte reads in the access counters.
+    /// @param addr Address of the word.
+    /// @return Word value located at the given address or error Status.
+    StatusOr<uint16_t> MemoryController::get_word(const uint16_t addr) noexcept{
+        access_counters_.record_read(addr);
+        access_counters_.record_read(static_cast<uint16_t>(addr + 1));
+        return AddressableMemory::get_word(addr);
+    }
+
+    /// @brief Sets the byte located at the given address to the given value.
+    /// @details Writes to ROM are MBC control writes, no MBC is emulated so they are ignored. RAM writes mark the page dirty.
+    /// @param addr Address of the byte.
+    /// @param value Byte, New value.
+    /// @return Returns status of the set
+    Status MemoryController::set_byte(const uint16_t addr, const uint8_t value) noexcept{
+        access_counters_.record_write(addr);
+        if(is_rom_address(addr)){
+            return Status::ok_status();
+        }
+        std::unique_lock<std::shared_mutex> write_lock(*memory_mutex_);
+        memory_[addr] = value;
+        dirty_pages_.mark_address(addr);
+        if(addr == joypad_register_addr){
+            update_joypad_register();
+        }
+        if(write_watch_ != nullptr && (((*write_watch_)[addr >> 6] >> (addr & 0x3F)) & 1)){
+            if(watched_writes_.count < max_watched_writes){
+                watched_writes_.addrs[watched_writes_.count] = addr;
+            }
+            ++watched_writes_.count;
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Sets the word located at the given address to the given value.
+    /// @details Byte order matches AddressableMemory::set_word. Each byte is handled as in set_byte.
+    /// @param addr Address of the word.
+    /// @param value Word, New value.
+    /// @return Returns status of the set
+    Status MemoryController::set_word(const uint16_t addr, const uint16_t value) noexcept{
+        const uint8_t first_byte = static_cast<uint8_t>(value >> 8);
+        const uint8_t second_byte = static_cast<uint8_t>(value & 0xFF);
+        Status first_byte_set = set_byte(addr, first_byte);
+        if(!first_byte_set.ok()){
+            return first_byte_set;
+        }
+        return set_byte(addr + 1, second_byte);
+    }
+
+    /// @brief Copies the cartridge ROM area from the binary.
+    /// @details Copies banks 0 and 1 (0x0000 => 0x7FFF), does not mark pages dirty.
+    /// @param binary Binary to load.
+    /// @return Status of the load.
+    Status MemoryController::load_rom(GBCBinary& binary){
+        const std::vector<uint8_t> rom = binary.get_memory();
+        if(rom.empty()){
+            return Status::invalid_binary_error("Can't load empty binary as ROM!");
+        }
+        std::unique_lock<std::shared_mutex> write_lock(*memory_mutex_);
+        const std::size_t copy_size = std::min<std::size_t>(rom.size(), rom_end_addr);
+        std::memcpy(memory_.data(), rom.data(), copy_size);
+        return Status::ok_status();
+    }
+
+    /// @brief Copies the contents of the page to the destination.
+    /// @param page Index of the page.
+    /// @param destination Buffer of at least PageBitmap::page_size bytes.
+    void MemoryController::read_page(const uint8_t page, uint8_t* destination){
+        std::shared_lock<std::shared_mutex> read_lock(*memory_mutex_);
+        std::memcpy(destination, &memory_[page * PageBitmap::page_size], PageBitmap::page_size);
+    }
+
+    /// @brief Overwrites the contents of the page from the source.
+    /// @details Marks the page dirty unless it is a ROM page.
+    /// @param page Index of the page.
+    /// @param source Buffer of at least PageBitmap::page_size bytes.
+    void MemoryController::write_page(const uint8_t page, const uint8_t* source){
+        std::unique_lock<std::shared_mutex> write_lock(*memory_mutex_);
+        const uint16_t page_addr = static_cast<uint16_t>(page * PageBitmap::page_size);
+        std::memcpy(&memory_[page_addr], source, PageBitmap::page_size);
+        if(!is_rom_address(page_addr)){
+            dirty_pages_.set(page);
+        }
+    }
+
+    /// @brief Copies the bytes of the ranges back to back to the destination.
+    /// @details Takes the read lock once for the whole batch of ranges. Not CPU accesses, so the access counters are not updated.
+    /// @param ranges Ranges to copy.
+    /// @param range_count Number of ranges.
+    /// @param destination Buffer of at least the summed range sizes.
+    void MemoryController::read_ranges(const AddressRange* ranges, const std::size_t range_count, uint8_t* destination){
+        std::shared_lock<std::shared_mutex> read_lock(*memory_mutex_);
+        for(std::size_t range = 0; range < range_count; ++range){
+            //Single bytes are the common case, skip the memcpy call for them
+            if(ranges[range].size == 1){
+                *destination = memory_[ranges[range].start_addr];
+            }
+            else{
+                std::memcpy(destination, &memory_[ranges[range].start_addr], ranges[range].size);
+            }
+            destination += ranges[range].size;
+        }
+    }
+
+    /// @brief Sets the pressed joypad buttons.
+    /// @details Bits 0-3 are Right, Left, Up, Down and bits 4-7 are A, B, Select, Start. Set bit is pressed.
+    /// @param buttons Pressed buttons.
+    void MemoryController::set_joypad_state(const uint8_t buttons) noexcept{
+        std::unique_lock<std::shared_mutex> write_lock(*memory_mutex_);
+        joypad_buttons_ = buttons;
+        update_joypad_register();
+        dirty_pages_.mark_address(joypad_register_addr);
+    }
+
+    /// @brief Returns the pressed joypad buttons.
+    /// @return Pressed buttons, see set_joypad_state.
+    uint8_t MemoryController::get_joypad_state() const noexcept{
+        return joypad_buttons_;
+    }
+
+    /// @brief Returns the pages written to since the last clear.
+    /// @return Dirty page bitmap.
+    const PageBitmap& MemoryController::get_dirty_pages() const noexcept{
+        return dirty_pages_;
+    }
+
+    /// @brief Returns the pages written to since the last clear and clears them.
+    /// @return Dirty page bitmap before the clear.
+    PageBitmap MemoryController::take_dirty_pages() noexcept{
+        PageBitmap dirty_pages = dirty_pages_;
+        dirty_pages_.clear();
+        return dirty_pages;
+    }
+
+    /// @brief Marks every page clean.
+    void MemoryController::clear_dirty_pages() noexcept{
+        dirty_pages_.clear();
+    }
+
+    /// @brief Sets the addresses whose writes are kept for take_watched_writes.
+    /// @details The check is a single pointer test on writes while nothing is watched. Clears the kept writes.
+    /// @param watched_addresses Watched addresses, nullptr watches nothing. Must outlive its use.
+    void MemoryController::set_write_watch(const AddressBitmap* watched_addresses) noexcept{
+        write_watch_ = watched_addresses;
+        watched_writes_.count = 0;
+    }
+
+    /// @brief Returns the writes to watched addresses since the last take and clears them.
+    /// @return Watched writes before the clear.
+    MemoryController::WatchedWrites MemoryController::take_watched_writes() noexcept{
+        const WatchedWrites watched_writes = watched_writes_;
+        watched_writes_.count = 0;
+        return watched_writes;
+    }
+
+    /// @brief Returns the CPU reads and writes per memory region.
+    /// @details Page copies of snapshots and traces are not counted.
+    /// @return Access counters.
+    const MemoryAccessCounters& MemoryController::get_access_counters() const noexcept{
+        return access_counters_;
+    }
+
+    /// @brief Zeroes the access counters.
+    void MemoryController::reset_access_counters() noexcept{
+        access_counters_.reset();
+    }
+
+    /// @brief Is the address inside the cartridge ROM area?
+    /// @param addr Address to check.
+    /// @return Is the address inside the cartridge ROM area?
+    bool MemoryController::is_rom_address(const uint16_t addr) noexcept{
+        return addr < rom_end_addr;
+    }
+
+    /// @brief Rebuilds the joypad register from the selected lines and pressed buttons.
+    /// @details Expects the write lock to be held.
+    void MemoryController::update_joypad_register() noexcept{
+        //Bits 4-5 select the lines (0 = selected), bits 0-3 read 0 for pressed buttons, bits 6-7 read 1
+        const uint8_t selected_lines = memory_[joypad_register_addr] & 0x30;
+        uint8_t button_lines = 0x0F;
+        if((selected_lines & 0x10) == 0){
+            button_lines &= ~(joypad_buttons_ & 0x0F);
+        }
+        if((selected_lines & 0x20) == 0){
+            button_lines &= ~(joypad_buttons_ >> 4);
+        }
+        memory_[joypad_register_addr] = 0xC0 | selected_lines | button_lines;
+    }
+}
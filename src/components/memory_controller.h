@@ -1,11 +1,176 @@
 #ifndef MEMORY_CONTROLLER_H
 #define MEMORY_CONTROLLER_H
 
+#include <array> //std::array
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
 #include "../memory/addressable_memory.h" //AddressableMemory
+#include "../memory/gbc_binary.h" //GBCBinary
+#include "../memory/page_bitmap.h" //PageBitmap
+#include "../profile/emulation_metrics.h" //MemoryAccessCounters
 
 namespace mygbc{
+
+    /// @brief Represents the 16-bit address space of the GBC.
+    /// @details Tracks the RAM pages written to in a dirty page bitmap. ROM (0x0000 => 0x7FFF) is never marked dirty.
     class MemoryController : public AddressableMemory{
+        public:
+        //Size of the address space in bytes
+        static constexpr uint32_t address_space_size = 0x10000;
+
+        //End of the cartridge ROM area (Exclusive)
+        static constexpr uint16_t rom_end_addr = 0x8000;
+
+        //Address of the joypad register (P1)
+        static constexpr uint16_t joypad_register_addr = 0xFF00;
+
+        //One bit per address of the address space
+        using AddressBitmap = std::array<uint64_t, address_space_size / 64>;
+
+        //Watched writes kept between two takes, a single instruction writes at most two bytes
+        static constexpr std::size_t max_watched_writes = 2;
+
+        /// @brief Writes to watched addresses since the last take.
+        struct WatchedWrites{
+            //Written addresses in write order
+            std::array<uint16_t, max_watched_writes> addrs;
+
+            //Number of writes, above max_watched_writes when the later addresses were not kept
+            std::size_t count;
+        };
+
+        /// @brief Consecutive bytes of the address space.
+        struct AddressRange{
+            //First address of the range
+            uint16_t start_addr;
+
+            //Number of bytes, the range may not wrap past the end of the address space
+            uint32_t size;
+        };
+
+        /// @brief Initializes zeroed address space.
+        MemoryController();
+
+        /// @brief Returns the byte located at the given address.
+        /// @details Counts the read in the access counters.
+        /// @param addr Address of the byte.
+        /// @return byte value located at the given address or error Status.
+        StatusOr<uint8_t> get_byte(const uint16_t addr) noexcept;
+
+        /// @brief Returns the word located at the given address.
+        /// @details Byte order matches AddressableMemory::get_word. Counts both byte reads in the access counters.
+        /// @param addr Address of the word.
+        /// @return Word value located at the given address or error Status.
+        StatusOr<uint16_t> get_word(const uint16_t addr) noexcept;
+
+        /// @brief Sets the byte located at the given address to the given value.
+        /// @details Writes to ROM are MBC control writes, no MBC is emulated so they are ignored. RAM writes mark the page dirty.
+        /// @param addr Address of the byte.
+        /// @param value Byte, New value.
+        /// @return Returns status of the set
+        Status set_byte(const uint16_t addr, const uint8_t value) noexcept;
+
+        /// @brief Sets the word located at the given address to the given value.
+        /// @details Byte order matches AddressableMemory::set_word. Each byte is handled as in set_byte.
+        /// @param addr Address of the word.
+        /// @param value Word, New value.
+        /// @return Returns status of the set
+        Status set_word(const uint16_t addr, const uint16_t value) noexcept;
+
+        /// @brief Copies the cartridge ROM area from the binary.
+        /// @details Copies banks 0 and 1 (0x0000 => 0x7FFF), does not mark pages dirty.
+        /// @param binary Binary to load.
+        /// @return Status of the load.
+        Status load_rom(GBCBinary& binary);
+
+        /// @brief Copies the contents of the page to the destination.
+        /// @param page Index of the page.
+        /// @param destination Buffer of at least PageBitmap::page_size bytes.
+        void read_page(const uint8_t page, uint8_t* destination);
+
+        /// @brief Overwrites the contents of the page from the source.
+        /// @details Marks the page dirty unless it is a ROM page.
+        /// @param page Index of the page.
+        /// @param source Buffer of at least PageBitmap::page_size bytes.
+        void write_page(const uint8_t page, const uint8_t* source);
+
+        /// @brief Copies the bytes of the ranges back to back to the destination.
+        /// @details Takes the read lock once for the whole batch of ranges. Not CPU accesses, so the access counters are not updated.
+        /// @param ranges Ranges to copy.
+        /// @param range_count Number of ranges.
+        /// @param destination Buffer of at least the summed range sizes.
+        void read_ranges(const AddressRange* ranges, const std::size_t range_count, uint8_t* destination);
+
+        /// @brief Sets the pressed joypad buttons.
+        /// @details Bits 0-3 are Right, Left, Up, Down and bits 4-7 are A, B, Select, Start. Set bit is pressed.
+        /// @param buttons Pressed buttons.
+        void set_joypad_state(const uint8_t buttons) noexcept;
+
+        /// @brief Returns the pressed joypad buttons.
+        /// @return Pressed buttons, see set_joypad_state.
+        uint8_t get_joypad_state() const noexcept;
+
+        /// @brief Returns the pages written to since the last clear.
+        /// @return Dirty page bitmap.
+        const PageBitmap& get_dirty_pages() const noexcept;
+
+        /// @brief Returns the pages written to since the last clear and clears them.
+        /// @return Dirty page bitmap before the clear.
+        PageBitmap take_dirty_pages() noexcept;
+
+        /// @brief Marks every page clean.
+        void clear_dirty_pages() noexcept;
+
+        /// @brief Sets the addresses whose writes are kept for take_watched_writes.
+        /// @details The check is a single pointer test on writes while nothing is watched. Clears the kept writes.
+        /// @param watched_addresses Watched addresses, nullptr watches nothing. Must outlive its use.
+        void set_write_watch(const AddressBitmap* watched_addresses) noexcept;
+
+        /// @brief Was a watched address written since the last take?
+        /// @details Defined in the header, it is called per instruction by conditional runs.
+        /// @return Was a watched address written?
+        bool has_watched_writes() const noexcept{
+            return watched_writes_.count != 0;
+        }
+
+        /// @brief Returns the writes to watched addresses since the last take and clears them.
+        /// @return Watched writes before the clear.
+        WatchedWrites take_watched_writes() noexcept;
+
+        /// @brief Returns the CPU reads and writes per memory region.
+        /// @details Page copies of snapshots and traces are not counted.
+        /// @return Access counters.
+        const MemoryAccessCounters& get_access_counters() const noexcept;
+
+        /// @brief Zeroes the access counters.
+        void reset_access_counters() noexcept;
+
+        private:
+
+        /// @brief Is the address inside the cartridge ROM area?
+        /// @param addr Address to check.
+        /// @return Is the address inside the cartridge ROM area?
+        static bool is_rom_address(const uint16_t addr) noexcept;
+
+        /// @brief Rebuilds the joypad register from the selected lines and pressed buttons.
+        /// @details Expects the write lock to be held.
+        void update_joypad_register() noexcept;
+
+        //RAM pages written to since the last clear
+        PageBitmap dirty_pages_;
+
+        //Pressed joypad buttons
+        uint8_t joypad_buttons_;
+
+        //Addresses whose writes are kept, nullptr when nothing is watched
+        const AddressBitmap* write_watch_;
+
+        //Writes to watched addresses since the last take
+        WatchedWrites watched_writes_;
+
+        //CPU reads and writes per memory region
+        MemoryAccessCounters access_counters_;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
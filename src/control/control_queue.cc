@@ -0,0 +1,84 @@
+#include <algorithm> //std::max
+#include <bit> //std::bit_ceil
+#include "control_queue.h" //ControlQueue
+
+namespace mygbc{
+
+    /// @brief Initializes empty queue.
+    /// @param capacity Maximum number of queued commands, rounded up to a power of two.
+    ControlQueue::ControlQueue(const std::size_t capacity)
+    :slots_(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))), mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+    enqueue_position_(0), push_count_(0), dequeue_position_(0){
+        for(uint64_t position = 0; position <= mask_; ++position){
+            slots_[position].sequence.store(position, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Appends the command. Safe to call from any thread.
+    /// @param command Command to append.
+    /// @return Was the command queued? False when the queue is full.
+    bool ControlQueue::push(const ControlCommand& command) noexcept{
+        uint64_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while(true){
+            slot = &slots_[position & mask_];
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const int64_t difference = static_cast<int64_t>(sequence - position);
+            if(difference == 0){
+                if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                    break;
+                }
+            }
+            else if(difference < 0){
+                //The consumer has not freed the slot of the previous lap
+                return false;
+            }
+            else{
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->command = command;
+        slot->sequence.store(position + 1, std::memory_order_release);
+        push_count_.fetch_add(1, std::memory_order_release);
+        push_count_.notify_one();
+        return true;
+    }
+
+    /// @brief Removes the oldest published command. Call only from the consumer thread.
+    /// @param command Removed command.
+    /// @return Was a command removed?
+    bool ControlQueue::pop(ControlCommand& command) noexcept{
+        Slot& slot = slots_[dequeue_position_ & mask_];
+        if(slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1){
+            return false;
+        }
+        command = slot.command;
+        //Frees the slot for the next lap of the producers
+        slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_position_;
+        return true;
+    }
+
+    /// @brief Blocks until a command was pushed that has not been popped. Call only from the consumer thread.
+    /// @details May return before the command is published, pop may then fail once more.
+    void ControlQueue::wait() const noexcept{
+        uint64_t push_count = push_count_.load(std::memory_order_acquire);
+        while(push_count == dequeue_position_){
+            push_count_.wait(push_count, std::memory_order_acquire);
+            push_count = push_count_.load(std::memory_order_acquire);
+        }
+    }
+
+    /// @brief Returns the maximum number of queued commands.
+    /// @return Capacity of the queue.
+    std::size_t ControlQueue::get_capacity() const noexcept{
+        return static_cast<std::size_t>(mask_ + 1);
+    }
+
+    /// @brief Returns the heap memory used by the queue.
+    /// @return Used heap memory in bytes.
+    std::size_t ControlQueue::get_memory_usage() const noexcept{
+        return get_capacity() * sizeof(Slot);
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,98 @@
+#ifndef CONTROL_QUEUE_H
+#define CONTROL_QUEUE_H
+
+#include <atomic> //std::atomic
+#include <memory> //std::unique_ptr
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Kinds of commands sent to a running GBC.
+    enum class ControlCommandType : uint8_t{
+        //Sets the pressed joypad buttons
+        SET_JOYPAD,
+
+        //Stops executing frames until resumed
+        PAUSE,
+
+        //Continues executing frames
+        RESUME,
+
+        //Passes a full snapshot to the snapshot callback
+        SNAPSHOT,
+
+        //Ends the main loop
+        STOP
+    };
+
+    /// @brief Command sent to a running GBC, applied at the next frame boundary.
+    struct ControlCommand{
+        //Kind of the command
+        ControlCommandType type;
+
+        //Pressed buttons of SET_JOYPAD, see MemoryController::set_joypad_state
+        uint8_t buttons = 0;
+    };
+
+    /// @brief Bounded lock-free multi producer single consumer queue of control commands.
+    /// @details Producers claim slots with a compare and swap on the enqueue position and publish them through the
+    ///         sequence number of the slot, the consumer never writes shared positions. Neither side allocates or locks.
+    class ControlQueue{
+        public:
+
+        /// @brief Initializes empty queue.
+        /// @param capacity Maximum number of queued commands, rounded up to a power of two.
+        explicit ControlQueue(const std::size_t capacity);
+
+        /// @brief Appends the command. Safe to call from any thread.
+        /// @param command Command to append.
+        /// @return Was the command queued? False when the queue is full.
+        bool push(const ControlCommand& command) noexcept;
+
+        /// @brief Removes the oldest published command. Call only from the consumer thread.
+        /// @param command Removed command.
+        /// @return Was a command removed?
+        bool pop(ControlCommand& command) noexcept;
+
+        /// @brief Blocks until a command was pushed that has not been popped. Call only from the consumer thread.
+        /// @details May return before the command is published, pop may then fail once more.
+        void wait() const noexcept;
+
+        /// @brief Returns the maximum number of queued commands.
+        /// @return Capacity of the queue.
+        std::size_t get_capacity() const noexcept;
+
+        /// @brief Returns the heap memory used by the queue.
+        /// @return Used heap memory in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        /// @brief Slot of the ring.
+        struct Slot{
+            //Position the slot is free for or position + 1 once the command is published
+            std::atomic<uint64_t> sequence;
+
+            //Command of the slot
+            ControlCommand command;
+        };
+
+        //Ring of the queue
+        std::unique_ptr<Slot[]> slots_;
+
+        //Capacity - 1
+        const uint64_t mask_;
+
+        //Next position claimed by a producer
+        alignas(64) std::atomic<uint64_t> enqueue_position_;
+
+        //Completed pushes, waited on by the consumer
+        std::atomic<uint64_t> push_count_;
+
+        //Next position read by the consumer
+        alignas(64) uint64_t dequeue_position_;
+    };
+
+}//namespace_mygbc
+
+#endif
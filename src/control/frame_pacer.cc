@@ -0,0 +1,132 @@
+#include <algorithm> //std::max
+#include <cmath> //std::isinf, std::llround
+#include <thread> //std::this_thread::sleep_until
+#if defined(__linux__)
+#include <cerrno> //EINTR
+#include <time.h> //clock_nanosleep
+#endif
+#if defined(__SSE2__)
+#include <immintrin.h> //_mm_pause
+#endif
+#include "frame_pacer.h" //FramePacer
+
+namespace mygbc{
+
+    /// @brief Initializes pacer at 1x speed.
+    /// @param config Configuration of the pacer.
+    FramePacer::FramePacer(const FramePacerConfig& config)
+    :config_(config), period_ns_(config.frame_period_ns), reset_requested_(false), schedule_period_ns_(config.frame_period_ns),
+    schedule_frames_(0), started_(false), frame_count_(0), late_frame_count_(0), resync_count_(0){
+    }
+
+    /// @brief Sets the speed multiplier. Safe to call from any thread.
+    /// @details Applies from the next frame, the schedule restarts from the current deadline.
+    /// @param speed Multiplier of the frame rate, values below min_speed are clamped to it. unlimited_speed,
+    ///         negative and infinite values disable pacing.
+    void FramePacer::set_speed(const double speed) noexcept{
+        if(!(speed > 0.0) || std::isinf(speed)){
+            period_ns_.store(0, std::memory_order_relaxed);
+            return;
+        }
+        const double period = static_cast<double>(config_.frame_period_ns) / std::max(speed, min_speed);
+        period_ns_.store(std::max<uint64_t>(static_cast<uint64_t>(std::llround(period)), 1), std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the speed multiplier.
+    /// @return Multiplier of the frame rate or unlimited_speed.
+    double FramePacer::get_speed() const noexcept{
+        const uint64_t period = period_ns_.load(std::memory_order_relaxed);
+        if(period == 0){
+            return unlimited_speed;
+        }
+        return static_cast<double>(config_.frame_period_ns) / static_cast<double>(period);
+    }
+
+    /// @brief Waits until the deadline of the next frame.
+    /// @details Call once after each emulated frame. The first call starts the schedule and does not wait.
+    void FramePacer::wait_for_next_frame(){
+        frame_count_.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t period = period_ns_.load(std::memory_order_relaxed);
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(!started_ || reset_requested_.exchange(false, std::memory_order_relaxed)){
+            schedule_start_ = now;
+            schedule_frames_ = 0;
+            schedule_period_ns_ = period;
+            started_ = true;
+            return;
+        }
+        if(period != schedule_period_ns_){
+            //Speed changed, continue from the last deadline of the old schedule
+            schedule_start_ = schedule_period_ns_ == 0 ? now : schedule_start_ + std::chrono::nanoseconds(schedule_frames_ * schedule_period_ns_);
+            schedule_frames_ = 0;
+            schedule_period_ns_ = period;
+        }
+        if(period == 0){
+            return;
+        }
+        ++schedule_frames_;
+        const std::chrono::steady_clock::time_point deadline = schedule_start_ + std::chrono::nanoseconds(schedule_frames_ * period);
+        if(deadline <= now){
+            late_frame_count_.fetch_add(1, std::memory_order_relaxed);
+            if(now - deadline > std::chrono::nanoseconds(static_cast<uint64_t>(config_.max_lag_frames) * period)){
+                //Catching up would run a burst of unpaced frames
+                resync_count_.fetch_add(1, std::memory_order_relaxed);
+                schedule_start_ = now;
+                schedule_frames_ = 0;
+            }
+            return;
+        }
+        wait_until(deadline);
+    }
+
+    /// @brief Restarts the schedule at the next wait, such as after a pause.
+    void FramePacer::reset() noexcept{
+        reset_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the frames paced since construction. Safe to call from any thread.
+    /// @return Paced frames.
+    uint64_t FramePacer::get_frame_count() const noexcept{
+        return frame_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the frames whose deadline had passed when the wait started. Safe to call from any thread.
+    /// @return Late frames.
+    uint64_t FramePacer::get_late_frame_count() const noexcept{
+        return late_frame_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the times the pacer fell more than max_lag_frames behind and restarted the schedule.
+    /// @details Safe to call from any thread.
+    /// @return Schedule restarts caused by lag.
+    uint64_t FramePacer::get_resync_count() const noexcept{
+        return resync_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Sleeps until shortly before the deadline and spins the rest.
+    /// @param deadline Time to wait to.
+    void FramePacer::wait_until(const std::chrono::steady_clock::time_point deadline) const{
+        const std::chrono::steady_clock::time_point sleep_deadline = deadline - std::chrono::nanoseconds(config_.spin_ns);
+        if(sleep_deadline > std::chrono::steady_clock::now()){
+#if defined(__linux__)
+            //steady_clock is CLOCK_MONOTONIC on Linux, an absolute deadline does not accumulate wake up errors
+            const uint64_t sleep_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_deadline.time_since_epoch()).count()
+            );
+            timespec sleep_time;
+            sleep_time.tv_sec = static_cast<time_t>(sleep_ns / 1000000000);
+            sleep_time.tv_nsec = static_cast<long>(sleep_ns % 1000000000);
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sleep_time, nullptr) == EINTR){
+            }
+#else
+            std::this_thread::sleep_until(sleep_deadline);
+#endif
+        }
+        while(std::chrono::steady_clock::now() < deadline){
+#if defined(__SSE2__)
+            _mm_pause();
+#endif
+        }
+    }
+
+}//namespace_mygbc
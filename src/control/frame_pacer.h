@@ -0,0 +1,107 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <atomic> //std::atomic
+#include <chrono> //std::chrono::steady_clock
+#include <cstdint> //Fixed lenght variables
+
+namespace mygbc{
+
+    /// @brief Configuration of a FramePacer.
+    struct FramePacerConfig{
+        //Host frame period at 1x speed, 70224 T-cycles of the 4194304 Hz clock (59.73 Hz)
+        uint64_t frame_period_ns = 16742706;
+
+        //Last part of each wait that is spun instead of slept, covers the wake up latency of the scheduler
+        uint64_t spin_ns = 250000;
+
+        //Frames the pacer may fall behind before it gives up catching up and restarts the schedule from the current time
+        uint32_t max_lag_frames = 3;
+    };
+
+    /// @brief Paces frames to the host clock for realtime use.
+    /// @details Frame deadlines are taken from a fixed schedule (start + n * period), so late wake ups and slow frames
+    ///         do not drift the frame rate: following frames wait less until the schedule is met again. Waits sleep
+    ///         with clock_nanosleep to an absolute deadline and spin the last spin_ns. The pacer only delays the caller
+    ///         between frames, host time never feeds the emulation, so pacing does not affect determinism.
+    class FramePacer{
+        public:
+        //Slowest supported speed multiplier
+        static constexpr double min_speed = 0.25;
+
+        //Speed multiplier that disables pacing
+        static constexpr double unlimited_speed = 0.0;
+
+        /// @brief Initializes pacer at 1x speed.
+        /// @param config Configuration of the pacer.
+        explicit FramePacer(const FramePacerConfig& config);
+
+        /// @brief Sets the speed multiplier. Safe to call from any thread.
+        /// @details Applies from the next frame, the schedule restarts from the current deadline.
+        /// @param speed Multiplier of the frame rate, values below min_speed are clamped to it. unlimited_speed,
+        ///         negative and infinite values disable pacing.
+        void set_speed(const double speed) noexcept;
+
+        /// @brief Returns the speed multiplier.
+        /// @return Multiplier of the frame rate or unlimited_speed.
+        double get_speed() const noexcept;
+
+        /// @brief Waits until the deadline of the next frame.
+        /// @details Call once after each emulated frame. The first call starts the schedule and does not wait.
+        void wait_for_next_frame();
+
+        /// @brief Restarts the schedule at the next wait, such as after a pause.
+        void reset() noexcept;
+
+        /// @brief Returns the frames paced since construction. Safe to call from any thread.
+        /// @return Paced frames.
+        uint64_t get_frame_count() const noexcept;
+
+        /// @brief Returns the frames whose deadline had passed when the wait started. Safe to call from any thread.
+        /// @return Late frames.
+        uint64_t get_late_frame_count() const noexcept;
+
+        /// @brief Returns the times the pacer fell more than max_lag_frames behind and restarted the schedule.
+        /// @details Safe to call from any thread.
+        /// @return Schedule restarts caused by lag.
+        uint64_t get_resync_count() const noexcept;
+
+        private:
+        /// @brief Sleeps until shortly before the deadline and spins the rest.
+        /// @param deadline Time to wait to.
+        void wait_until(const std::chrono::steady_clock::time_point deadline) const;
+
+        //Configuration of the pacer
+        const FramePacerConfig config_;
+
+        //Frame period in nanoseconds at the current speed, 0 when unlimited
+        std::atomic<uint64_t> period_ns_;
+
+        //Set by reset, the next wait restarts the schedule
+        std::atomic<bool> reset_requested_;
+
+        //Period the schedule was started with
+        uint64_t schedule_period_ns_;
+
+        //Start of the schedule
+        std::chrono::steady_clock::time_point schedule_start_;
+
+        //Frames since the start of the schedule
+        uint64_t schedule_frames_;
+
+        //Has the schedule been started?
+        bool started_;
+
+        //Frames paced since construction, the statistics are written by the pacing thread and read by any thread
+        std::atomic<uint64_t> frame_count_;
+
+        //Frames whose deadline had passed when the wait started
+        std::atomic<uint64_t> late_frame_count_;
+
+        //Schedule restarts after stalls longer than the lag limit
+        std::atomic<uint64_t> resync_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,73 @@
+#include <utility> //std::move
+#include "run_ahead.h" //RunAhead
+
+namespace mygbc{
+
+    /// @brief Initializes run-ahead of the GBC.
+    /// @param gbc GBC to run. Must outlive the run-ahead.
+    /// @param frames Frames to run ahead, 0 presents the real frames.
+    RunAhead::RunAhead(GBC& gbc, const uint32_t frames)
+    :gbc_(gbc), state_slot_(gbc), frames_(frames){
+    }
+
+    /// @brief Sets the frames to run ahead.
+    /// @param frames Frames to run ahead, 0 presents the real frames.
+    void RunAhead::set_frames(const uint32_t frames) noexcept{
+        frames_ = frames;
+    }
+
+    /// @brief Returns the frames run ahead.
+    /// @return Frames run ahead.
+    uint32_t RunAhead::get_frames() const noexcept{
+        return frames_;
+    }
+
+    /// @brief Sets the receiver of the presented frames.
+    /// @details Called with the GBC at the end of the presented frame, before the state is restored.
+    /// @param callback Receiver of the presented frames, nullptr presents nothing.
+    void RunAhead::set_present_callback(std::function<void(GBC&)> callback){
+        present_callback_ = std::move(callback);
+    }
+
+    /// @brief Runs a host frame.
+    /// @details The GBC ends the call at the end of the real frame, its state does not depend on the run-ahead.
+    /// @param buttons Pressed buttons of the frame, see MemoryController::set_joypad_state.
+    /// @return Status of the execution.
+    Status RunAhead::run_frame(const uint8_t buttons){
+        if(gbc_.get_memory().get_joypad_state() != buttons){
+            gbc_.set_joypad_state(buttons);
+        }
+        Status frame_status = gbc_.run_frame();
+        if(!frame_status.ok() || frames_ == 0){
+            if(frame_status.ok()){
+                present();
+            }
+            return frame_status;
+        }
+        state_slot_.save();
+        Status ahead_status = Status::ok_status();
+        for(uint32_t frame = 0; frame < frames_ && ahead_status.ok(); ++frame){
+            //Not run_frame, frames run ahead are not real frames of the metrics
+            ahead_status = gbc_.run_until_cycle((gbc_.get_frame_count() + 1) * GBC::cycles_per_frame);
+        }
+        if(ahead_status.ok()){
+            present();
+        }
+        Status restore_status = state_slot_.restore();
+        return ahead_status.ok() ? restore_status : ahead_status;
+    }
+
+    /// @brief Returns the slot holding the real state while running ahead.
+    /// @return State slot, reports the pages copied by the last save and restore.
+    const StateSlot& RunAhead::get_state_slot() const noexcept{
+        return state_slot_;
+    }
+
+    /// @brief Calls the present callback if there is one.
+    void RunAhead::present(){
+        if(present_callback_){
+            present_callback_(gbc_);
+        }
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,68 @@
+#ifndef RUN_AHEAD_H
+#define RUN_AHEAD_H
+
+#include <functional> //std::function
+#include <cstdint> //Fixed lenght variables
+#include "../gbc.h" //GBC
+#include "../snapshot/state_slot.h" //StateSlot
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Hides the input lag of the game by presenting frames emulated ahead of the real state.
+    /// @details Each host frame runs the real frame with the current input, saves the state, runs the given number of
+    ///         frames ahead with the same input, presents the last of them and restores the saved state. The presented
+    ///         frame reacts to the input as many frames earlier as the game delays it internally. The state is saved
+    ///         to a StateSlot, so save and restore only copy the pages written since the previous save.
+    ///         Frames run ahead are counted in the instruction metrics of the GBC but not as frames.
+    class RunAhead{
+        public:
+
+        /// @brief Initializes run-ahead of the GBC.
+        /// @param gbc GBC to run. Must outlive the run-ahead.
+        /// @param frames Frames to run ahead, 0 presents the real frames.
+        RunAhead(GBC& gbc, const uint32_t frames);
+
+        /// @brief Sets the frames to run ahead.
+        /// @param frames Frames to run ahead, 0 presents the real frames.
+        void set_frames(const uint32_t frames) noexcept;
+
+        /// @brief Returns the frames run ahead.
+        /// @return Frames run ahead.
+        uint32_t get_frames() const noexcept;
+
+        /// @brief Sets the receiver of the presented frames.
+        /// @details Called with the GBC at the end of the presented frame, before the state is restored.
+        /// @param callback Receiver of the presented frames, nullptr presents nothing.
+        void set_present_callback(std::function<void(GBC&)> callback);
+
+        /// @brief Runs a host frame.
+        /// @details The GBC ends the call at the end of the real frame, its state does not depend on the run-ahead.
+        /// @param buttons Pressed buttons of the frame, see MemoryController::set_joypad_state.
+        /// @return Status of the execution.
+        Status run_frame(const uint8_t buttons);
+
+        /// @brief Returns the slot holding the real state while running ahead.
+        /// @return State slot, reports the pages copied by the last save and restore.
+        const StateSlot& get_state_slot() const noexcept;
+
+        private:
+        /// @brief Calls the present callback if there is one.
+        void present();
+
+        //GBC to run
+        GBC& gbc_;
+
+        //Holds the real state while running ahead
+        StateSlot state_slot_;
+
+        //Frames to run ahead
+        uint32_t frames_;
+
+        //Receiver of the presented frames, nullptr presents nothing
+        std::function<void(GBC&)> present_callback_;
+    };
+
+}//namespace_mygbc
+
+#endif
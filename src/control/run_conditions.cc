@@ -0,0 +1,104 @@
+#include <algorithm> //std::find, std::min
+#include <utility> //std::move
+#include "run_conditions.h" //RunConditions
+
+namespace mygbc{
+
+    /// @brief Initializes conditions that only stop on the cycle budget.
+    RunConditions::RunConditions()
+    :pc_breakpoints_{}, pc_breakpoint_count_(0), watched_addresses_{}, stop_at_frame_end_(false){
+    }
+
+    /// @brief Stops the run when the PC reaches the address after an instruction.
+    /// @details The PC at the start of the run does not stop it, so a run can resume from a breakpoint.
+    /// @param pc Address of the breakpoint.
+    void RunConditions::add_pc_breakpoint(const uint16_t pc) noexcept{
+        if(!is_pc_breakpoint(pc)){
+            pc_breakpoints_[pc >> 6] |= uint64_t{1} << (pc & 0x3F);
+            ++pc_breakpoint_count_;
+        }
+    }
+
+    /// @brief Stops the run when a write during the run leaves the byte at the value.
+    /// @details Conditions are combined with OR. Only writes to the byte itself are checked, a byte that already
+    ///         holds the value does not stop the run until it is written again and writes to other bytes never do.
+    /// @param addr Address of the byte.
+    /// @param value Value to match.
+    void RunConditions::add_memory_condition(const uint16_t addr, const uint8_t value){
+        memory_conditions_.push_back({addr, value});
+        watched_addresses_[addr >> 6] |= uint64_t{1} << (addr & 0x3F);
+    }
+
+    /// @brief Stops the run at the first frame boundary.
+    /// @param enabled Stop at frame ends?
+    void RunConditions::set_stop_at_frame_end(const bool enabled) noexcept{
+        stop_at_frame_end_ = enabled;
+    }
+
+    /// @brief Sets the predicate called at each frame boundary, the run stops when it returns true.
+    /// @param predicate Predicate receiving the running GBC, nullptr removes it.
+    void RunConditions::set_frame_predicate(std::function<bool(GBC&)> predicate){
+        frame_predicate_ = std::move(predicate);
+    }
+
+    /// @brief Are any PC breakpoints registered?
+    /// @return Are any PC breakpoints registered?
+    bool RunConditions::has_pc_breakpoints() const noexcept{
+        return pc_breakpoint_count_ != 0;
+    }
+
+    /// @brief Are any memory conditions registered?
+    /// @return Are any memory conditions registered?
+    bool RunConditions::has_memory_conditions() const noexcept{
+        return !memory_conditions_.empty();
+    }
+
+    /// @brief Returns the addresses of the memory conditions.
+    /// @return Watched addresses, see MemoryController::set_write_watch.
+    const MemoryController::AddressBitmap& RunConditions::get_watched_addresses() const noexcept{
+        return watched_addresses_;
+    }
+
+    /// @brief Is the address watched by a memory condition?
+    /// @param addr Address to check.
+    /// @return Is the address watched?
+    bool RunConditions::is_watched_address(const uint16_t addr) const noexcept{
+        return (watched_addresses_[addr >> 6] >> (addr & 0x3F)) & 1;
+    }
+
+    /// @brief Did one of the writes leave its byte at the value of a memory condition?
+    /// @details Only the conditions of the written bytes are read. When more writes happened than were kept,
+    ///         every condition is read. Reads are not CPU accesses, the access counters are not updated.
+    /// @param memory Memory to check.
+    /// @param writes Writes to the watched addresses, see MemoryController::take_watched_writes.
+    /// @return Is a memory condition of a written byte true?
+    bool RunConditions::memory_condition_met(MemoryController& memory, const MemoryController::WatchedWrites& writes) const{
+        const std::size_t kept_writes = std::min(writes.count, MemoryController::max_watched_writes);
+        for(const MemoryCondition& condition : memory_conditions_){
+            if(writes.count <= MemoryController::max_watched_writes &&
+                std::find(writes.addrs.begin(), writes.addrs.begin() + kept_writes, condition.addr) == writes.addrs.begin() + kept_writes){
+                continue;
+            }
+            const MemoryController::AddressRange range{condition.addr, 1};
+            uint8_t value = 0;
+            memory.read_ranges(&range, 1, &value);
+            if(value == condition.value){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Does the run stop at frame ends?
+    /// @return Does the run stop at frame ends?
+    bool RunConditions::stops_at_frame_end() const noexcept{
+        return stop_at_frame_end_;
+    }
+
+    /// @brief Returns the frame predicate.
+    /// @return Frame predicate, empty when there is none.
+    const std::function<bool(GBC&)>& RunConditions::get_frame_predicate() const noexcept{
+        return frame_predicate_;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,134 @@
+#ifndef RUN_CONDITIONS_H
+#define RUN_CONDITIONS_H
+
+#include <vector> //std::vector
+#include <functional> //std::function
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../components/memory_controller.h" //MemoryController
+
+namespace mygbc{
+
+    class GBC;
+
+    /// @brief Why a conditional run stopped.
+    enum class RunStopReason{
+        //The cycle budget was used up
+        CYCLE_BUDGET,
+
+        //A frame boundary was reached and the conditions stop at frame ends
+        FRAME_END,
+
+        //The PC reached a breakpoint
+        PC_HIT,
+
+        //A write made a memory condition true
+        MEMORY_MATCH,
+
+        //The frame predicate returned true at a frame boundary
+        FRAME_PREDICATE
+    };
+
+    /// @brief Stop conditions of GBC::run_until.
+    /// @details The checks are compiled into the run loop selected once per run, a run only pays for the kinds of
+    ///         conditions that are registered: PC breakpoints are a bit test per instruction, memory conditions are
+    ///         flagged by the write path of the memory controller and the frame predicate only runs at frame boundaries.
+    class RunConditions{
+        public:
+
+        /// @brief Initializes conditions that only stop on the cycle budget.
+        RunConditions();
+
+        /// @brief Stops the run when the PC reaches the address after an instruction.
+        /// @details The PC at the start of the run does not stop it, so a run can resume from a breakpoint.
+        /// @param pc Address of the breakpoint.
+        void add_pc_breakpoint(const uint16_t pc) noexcept;
+
+        /// @brief Stops the run when a write during the run leaves the byte at the value.
+        /// @details Conditions are combined with OR. Only writes to the byte itself are checked, a byte that already
+        ///         holds the value does not stop the run until it is written again and writes to other bytes never do.
+        /// @param addr Address of the byte.
+        /// @param value Value to match.
+        void add_memory_condition(const uint16_t addr, const uint8_t value);
+
+        /// @brief Stops the run at the first frame boundary.
+        /// @param enabled Stop at frame ends?
+        void set_stop_at_frame_end(const bool enabled) noexcept;
+
+        /// @brief Sets the predicate called at each frame boundary, the run stops when it returns true.
+        /// @param predicate Predicate receiving the running GBC, nullptr removes it.
+        void set_frame_predicate(std::function<bool(GBC&)> predicate);
+
+        /// @brief Are any PC breakpoints registered?
+        /// @return Are any PC breakpoints registered?
+        bool has_pc_breakpoints() const noexcept;
+
+        /// @brief Is the address a PC breakpoint?
+        /// @details Defined in the header, it is called per instruction by conditional runs.
+        /// @param pc Address to check.
+        /// @return Is the address a PC breakpoint?
+        bool is_pc_breakpoint(const uint16_t pc) const noexcept{
+            return (pc_breakpoints_[pc >> 6] >> (pc & 0x3F)) & 1;
+        }
+
+        /// @brief Are any memory conditions registered?
+        /// @return Are any memory conditions registered?
+        bool has_memory_conditions() const noexcept;
+
+        /// @brief Returns the addresses of the memory conditions.
+        /// @return Watched addresses, see MemoryController::set_write_watch.
+        const MemoryController::AddressBitmap& get_watched_addresses() const noexcept;
+
+        /// @brief Is the address watched by a memory condition?
+        /// @param addr Address to check.
+        /// @return Is the address watched?
+        bool is_watched_address(const uint16_t addr) const noexcept;
+
+        /// @brief Did one of the writes leave its byte at the value of a memory condition?
+        /// @details Only the conditions of the written bytes are read. When more writes happened than were kept,
+        ///         every condition is read. Reads are not CPU accesses, the access counters are not updated.
+        /// @param memory Memory to check.
+        /// @param writes Writes to the watched addresses, see MemoryController::take_watched_writes.
+        /// @return Is a memory condition of a written byte true?
+        bool memory_condition_met(MemoryController& memory, const MemoryController::WatchedWrites& writes) const;
+
+        /// @brief Does the run stop at frame ends?
+        /// @return Does the run stop at frame ends?
+        bool stops_at_frame_end() const noexcept;
+
+        /// @brief Returns the frame predicate.
+        /// @return Frame predicate, empty when there is none.
+        const std::function<bool(GBC&)>& get_frame_predicate() const noexcept;
+
+        private:
+        /// @brief Byte value to stop at.
+        struct MemoryCondition{
+            //Address of the byte
+            uint16_t addr;
+
+            //Value to match
+            uint8_t value;
+        };
+
+        //One bit per address of the 16-bit address space
+        MemoryController::AddressBitmap pc_breakpoints_;
+
+        //Number of registered breakpoints
+        std::size_t pc_breakpoint_count_;
+
+        //Registered memory conditions
+        std::vector<MemoryCondition> memory_conditions_;
+
+        //Addresses of the memory conditions
+        MemoryController::AddressBitmap watched_addresses_;
+
+        //Stop at the first frame boundary?
+        bool stop_at_frame_end_;
+
+        //Called at each frame boundary, empty when there is none
+        std::function<bool(GBC&)> frame_predicate_;
+    };
+
+}//namespace_mygbc
+
+#endif
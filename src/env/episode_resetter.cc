@@ -0,0 +1,79 @@
+#include "episode_resetter.h" //EpisodeResetter
+
+namespace mygbc{
+
+    /// @brief Initializes resetter sampling the start states in order.
+    /// @param gbc GBC to reset. Must outlive the resetter.
+    /// @param pool Start states. Must outlive the resetter.
+    EpisodeResetter::EpisodeResetter(GBC& gbc, const StartStatePool& pool)
+    :gbc_(gbc), pool_(pool), dirty_page_consumer_id_(gbc.register_dirty_page_consumer()), current_index_(no_state),
+    next_index_(0), random_sampling_(false), last_restored_page_count_(0){
+    }
+
+    /// @brief Unregisters the dirty page consumer.
+    EpisodeResetter::~EpisodeResetter(){
+        gbc_.unregister_dirty_page_consumer(dirty_page_consumer_id_);
+    }
+
+    /// @brief Samples the start states randomly from now on.
+    /// @details Equal seeds sample equal sequences on every platform.
+    /// @param seed Seed of the sampling.
+    void EpisodeResetter::set_random_sampling(const uint64_t seed){
+        random_sampling_ = true;
+        random_engine_.seed(seed);
+    }
+
+    /// @brief Restores the next sampled start state.
+    /// @return Status of the reset.
+    Status EpisodeResetter::reset(){
+        if(pool_.get_size() == 0){
+            return Status::invalid_index_error("Start state pool is empty!");
+        }
+        //Engine output is fixed by the standard, the distributions are not
+        const std::size_t index = random_sampling_ ? static_cast<std::size_t>(random_engine_() % pool_.get_size()) : (next_index_ % pool_.get_size());
+        next_index_ = index + 1;
+        return reset_to(index);
+    }
+
+    /// @brief Restores the given start state.
+    /// @param index Index of the start state.
+    /// @return Status of the reset.
+    Status EpisodeResetter::reset_to(const std::size_t index){
+        if(index >= pool_.get_size()){
+            return Status::invalid_index_error(
+                "Invalid start state index! (Index: " + std::to_string(index) + "/ Limit: " + std::to_string(pool_.get_size()) + ")."
+            );
+        }
+        const StartStatePool::StartState& state = pool_.get_state(index);
+        PageBitmap pages = gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        if(current_index_ == no_state){
+            pages.set_all();
+        }
+        else if(current_index_ != index){
+            //Pages equal in both states are equal to the first state
+            pages |= pool_.get_state(current_index_).differing_pages;
+            pages |= state.differing_pages;
+        }
+        gbc_.restore_state_from_image(state.register_words, state.cycle_count, pages, state.address_space.data());
+        //Inputs of the previous episode must not replay, also drops the later recorded inputs
+        gbc_.set_joypad_state(state.joypad_buttons);
+        //Restored pages match the start state
+        gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        current_index_ = index;
+        last_restored_page_count_ = pages.count();
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the start state restored last.
+    /// @return Index of the start state or no_state before the first reset.
+    std::size_t EpisodeResetter::get_current_index() const noexcept{
+        return current_index_;
+    }
+
+    /// @brief Returns the number of pages restored by the last reset.
+    /// @return Restored pages.
+    std::size_t EpisodeResetter::get_last_restored_page_count() const noexcept{
+        return last_restored_page_count_;
+    }
+
+}//namespace_mygbc
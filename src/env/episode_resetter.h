@@ -0,0 +1,82 @@
+#ifndef EPISODE_RESETTER_H
+#define EPISODE_RESETTER_H
+
+#include <random> //std::mt19937_64
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../snapshot/start_state_pool.h" //StartStatePool
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Resets the episodes of a GBC to the start states of a pool without reloading the ROM.
+    /// @details Tracks the pages the GBC writes through its own dirty page consumer. A reset only restores those pages
+    ///         and the pages where the previous and the next start state differ, so it costs O(dirty pages).
+    ///         The first reset restores every page. Start states are sampled in order, or randomly once seeded.
+    ///         Each reset starts a new input timeline, inputs recorded from the start cycle on are dropped.
+    class EpisodeResetter{
+        public:
+        //Index returned before the first reset
+        static constexpr std::size_t no_state = SIZE_MAX;
+
+        /// @brief Initializes resetter sampling the start states in order.
+        /// @param gbc GBC to reset. Must outlive the resetter.
+        /// @param pool Start states. Must outlive the resetter.
+        EpisodeResetter(GBC& gbc, const StartStatePool& pool);
+
+        /// @brief Unregisters the dirty page consumer.
+        ~EpisodeResetter();
+
+        EpisodeResetter(const EpisodeResetter&) = delete;
+        EpisodeResetter& operator=(const EpisodeResetter&) = delete;
+
+        /// @brief Samples the start states randomly from now on.
+        /// @details Equal seeds sample equal sequences on every platform.
+        /// @param seed Seed of the sampling.
+        void set_random_sampling(const uint64_t seed);
+
+        /// @brief Restores the next sampled start state.
+        /// @return Status of the reset.
+        Status reset();
+
+        /// @brief Restores the given start state.
+        /// @param index Index of the start state.
+        /// @return Status of the reset.
+        Status reset_to(const std::size_t index);
+
+        /// @brief Returns the start state restored last.
+        /// @return Index of the start state or no_state before the first reset.
+        std::size_t get_current_index() const noexcept;
+
+        /// @brief Returns the number of pages restored by the last reset.
+        /// @return Restored pages.
+        std::size_t get_last_restored_page_count() const noexcept;
+
+        private:
+        //Reset GBC
+        GBC& gbc_;
+
+        //Start states
+        const StartStatePool& pool_;
+
+        //Dirty page consumer id of the resetter
+        const std::size_t dirty_page_consumer_id_;
+
+        //Start state restored last, no_state before the first reset
+        std::size_t current_index_;
+
+        //Next start state of the in order sampling
+        std::size_t next_index_;
+
+        //Random sampling
+        bool random_sampling_;
+        std::mt19937_64 random_engine_;
+
+        //Pages restored by the last reset
+        std::size_t last_restored_page_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,194 @@
+#include <algorithm> //std::max, std::min, std::sort
+#include "instance_scheduler.h" //InstanceScheduler
+
+namespace mygbc{
+
+    /// @brief Initializes instance with no run.
+    /// @param scheduled_gbc Scheduled GBC.
+    /// @param slice_priority Scheduling order and slice length in quanta.
+    InstanceScheduler::ScheduledInstance::ScheduledInstance(GBC* scheduled_gbc, const uint32_t slice_priority)
+    :gbc(scheduled_gbc), priority(slice_priority), run_priority(slice_priority), target_cycle(0), status(Status::ok_status()), slice_count(0){
+    }
+
+    /// @brief Appends the id as the newest entry.
+    /// @param id Id of the instance.
+    void InstanceScheduler::ReadyQueue::push(const std::size_t id){
+        std::lock_guard<std::mutex> queue_lock(mutex);
+        ring[(head + size) % ring.size()] = id;
+        ++size;
+    }
+
+    /// @brief Removes the oldest entry.
+    /// @param id Removed id.
+    /// @return Was the queue non-empty?
+    bool InstanceScheduler::ReadyQueue::pop(std::size_t& id){
+        std::lock_guard<std::mutex> queue_lock(mutex);
+        if(size == 0){
+            return false;
+        }
+        id = ring[head];
+        head = (head + 1) % ring.size();
+        --size;
+        return true;
+    }
+
+    /// @brief Starts the worker threads.
+    /// @param config Configuration of the scheduler.
+    InstanceScheduler::InstanceScheduler(const InstanceSchedulerConfig& config)
+    :config_(config), worker_pool_(config.thread_count, config.pin_workers), remaining_instances_(0), steal_count_(0),
+    queued_slice_count_(0), idle_count_(0){
+        for(std::size_t thread = 0; thread < worker_pool_.get_thread_count(); ++thread){
+            ready_queues_.emplace_back();
+        }
+    }
+
+    /// @brief Adds an instance to the scheduler.
+    /// @details Do not call during a run.
+    /// @param gbc Instance to run. Must outlive the scheduler.
+    /// @param priority Scheduling order and slice length in quanta of the instance, at least 1.
+    /// @return Id of the instance.
+    std::size_t InstanceScheduler::add_instance(GBC& gbc, const uint32_t priority){
+        instances_.emplace_back(&gbc, std::max<uint32_t>(priority, 1));
+        //Any queue may end up holding every instance through steals
+        for(ReadyQueue& queue : ready_queues_){
+            queue.ring.resize(instances_.size());
+        }
+        run_order_.push_back(instances_.size() - 1);
+        return instances_.size() - 1;
+    }
+
+    /// @brief Changes the priority of an instance.
+    /// @details Safe to call during a run, the slice length applies from the next slice and the order from the next run.
+    /// @param id Id of the instance.
+    /// @param priority Scheduling order and slice length in quanta of the instance, at least 1.
+    void InstanceScheduler::set_priority(const std::size_t id, const uint32_t priority) noexcept{
+        instances_[id].priority.store(std::max<uint32_t>(priority, 1), std::memory_order_relaxed);
+    }
+
+    /// @brief Runs every instance for the given cycles and waits for them.
+    /// @details Each instance stops at the first instruction boundary at or after its cycle count plus the cycles,
+    ///         the same state as a single GBC::run_for. Failed instances are not rescheduled.
+    /// @param cycles T-cycles to run each instance.
+    /// @return Status of the failed instance with the lowest id or ok.
+    Status InstanceScheduler::run_for(const uint64_t cycles){
+        if(cycles == 0 || instances_.empty()){
+            return Status::ok_status();
+        }
+        for(ReadyQueue& queue : ready_queues_){
+            queue.head = 0;
+            queue.size = 0;
+        }
+        //Higher priorities first, equal priorities in id order. The priorities are read once, set_priority may run concurrently.
+        for(std::size_t id = 0; id < instances_.size(); ++id){
+            instances_[id].run_priority = instances_[id].priority.load(std::memory_order_relaxed);
+            run_order_[id] = id;
+        }
+        std::sort(run_order_.begin(), run_order_.end(), [this](const std::size_t first, const std::size_t second){
+            const uint32_t first_priority = instances_[first].run_priority;
+            const uint32_t second_priority = instances_[second].run_priority;
+            return first_priority != second_priority ? first_priority > second_priority : first < second;
+        });
+        //Spread the instances round robin over the queues
+        for(std::size_t position = 0; position < run_order_.size(); ++position){
+            const std::size_t id = run_order_[position];
+            ScheduledInstance& instance = instances_[id];
+            instance.target_cycle = instance.gbc->get_cycle_count() + cycles;
+            instance.status = Status::ok_status();
+            ReadyQueue& queue = ready_queues_[position % ready_queues_.size()];
+            queue.ring[queue.size++] = id;
+        }
+        queued_slice_count_.fetch_add(instances_.size(), std::memory_order_relaxed);
+        remaining_instances_.store(instances_.size());
+        worker_pool_.run(ready_queues_.size(), &InstanceScheduler::run_worker, this);
+        for(const ScheduledInstance& instance : instances_){
+            if(!instance.status.ok()){
+                return instance.status;
+            }
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of instances.
+    /// @return Number of instances.
+    std::size_t InstanceScheduler::get_instance_count() const noexcept{
+        return instances_.size();
+    }
+
+    /// @brief Returns the number of threads running the instances.
+    /// @return Workers plus the calling thread.
+    std::size_t InstanceScheduler::get_thread_count() const noexcept{
+        return worker_pool_.get_thread_count();
+    }
+
+    /// @brief Returns the slices run by the instance since it was added.
+    /// @param id Id of the instance.
+    /// @return Slices of the instance.
+    uint64_t InstanceScheduler::get_slice_count(const std::size_t id) const noexcept{
+        return instances_[id].slice_count;
+    }
+
+    /// @brief Returns the instances stolen from the queues of other threads since construction.
+    /// @return Steals.
+    uint64_t InstanceScheduler::get_steal_count() const noexcept{
+        return steal_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the slices queued since construction, including the first slice of each instance in a run.
+    /// @return Queued slices.
+    uint64_t InstanceScheduler::get_queued_slice_count() const noexcept{
+        return queued_slice_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns how often a thread left a run with nothing to steal while other threads still ran slices.
+    /// @details A high count against the runs means the instances do not keep the threads busy.
+    /// @return Idle threads.
+    uint64_t InstanceScheduler::get_idle_count() const noexcept{
+        return idle_count_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Runs slices of the queue of the thread until there is nothing left to take, run by the worker pool.
+    /// @param context The scheduler.
+    /// @param index Index of the thread and its queue.
+    void InstanceScheduler::run_worker(void* context, const std::size_t index){
+        InstanceScheduler& scheduler = *static_cast<InstanceScheduler*>(context);
+        std::size_t id = 0;
+        //Instances are only requeued by the thread that ran their slice. With every queue empty each remaining
+        //instance is inside a slice of a thread that will run it to the end, so waiting for it would only spin.
+        while(scheduler.take_instance(index, id)){
+            ScheduledInstance& instance = scheduler.instances_[id];
+            GBC& gbc = *instance.gbc;
+            const uint64_t slice_cycles = static_cast<uint64_t>(scheduler.config_.quantum_cycles) * instance.priority.load(std::memory_order_relaxed);
+            instance.status = gbc.run_for(std::min(slice_cycles, instance.target_cycle - gbc.get_cycle_count()));
+            ++instance.slice_count;
+            if(!instance.status.ok() || gbc.get_cycle_count() >= instance.target_cycle){
+                scheduler.remaining_instances_.fetch_sub(1, std::memory_order_release);
+            }
+            else{
+                scheduler.ready_queues_[index].push(id);
+                scheduler.queued_slice_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if(scheduler.remaining_instances_.load(std::memory_order_acquire) > 0){
+            scheduler.idle_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Takes the next ready instance of the thread, stealing when its own queue is empty.
+    /// @param queue_index Index of the queue of the thread.
+    /// @param id Taken id.
+    /// @return Was an instance taken?
+    bool InstanceScheduler::take_instance(const std::size_t queue_index, std::size_t& id){
+        if(ready_queues_[queue_index].pop(id)){
+            return true;
+        }
+        //Oldest instance of the next non-empty queue keeps the round robin order
+        for(std::size_t offset = 1; offset < ready_queues_.size(); ++offset){
+            if(ready_queues_[(queue_index + offset) % ready_queues_.size()].pop(id)){
+                steal_count_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}//namespace_mygbc
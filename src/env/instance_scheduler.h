@@ -0,0 +1,179 @@
+#ifndef INSTANCE_SCHEDULER_H
+#define INSTANCE_SCHEDULER_H
+
+#include <atomic> //std::atomic
+#include <deque> //std::deque
+#include <mutex> //std::mutex
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../util/status/status.h" //Status
+#include "../util/thread/worker_pool.h" //WorkerPool
+
+namespace mygbc{
+
+    /// @brief Configuration of an InstanceScheduler.
+    struct InstanceSchedulerConfig{
+        //Threads running the instances including the calling thread, 0 uses the hardware concurrency
+        std::size_t thread_count = 0;
+
+        //T-cycles of a slice at priority 1
+        uint32_t quantum_cycles = GBC::cycles_per_frame / 4;
+
+        //Pin each worker thread to its own core?
+        bool pin_workers = false;
+    };
+
+    /// @brief Cooperative M:N scheduler time-slicing many GBC instances on a fixed set of threads.
+    /// @details Instances run in slices of emulated cycles (GBC::run_for) instead of owning a thread. Each thread owns a
+    ///         FIFO ready queue and steals the oldest instance of another queue when its own runs empty. A thread that finds
+    ///         nothing to steal leaves the run, every remaining instance is then inside a slice of its own thread. A run gives
+    ///         every instance the same cycles. Priorities order the queues at the start of a run and make a slice last
+    ///         quantum_cycles times the priority, so higher priorities finish their cycles sooner. Runs do not allocate.
+    class InstanceScheduler{
+        public:
+
+        /// @brief Starts the worker threads.
+        /// @param config Configuration of the scheduler.
+        explicit InstanceScheduler(const InstanceSchedulerConfig& config);
+
+        /// @brief Adds an instance to the scheduler.
+        /// @details Do not call during a run.
+        /// @param gbc Instance to run. Must outlive the scheduler.
+        /// @param priority Scheduling order and slice length in quanta of the instance, at least 1.
+        /// @return Id of the instance.
+        std::size_t add_instance(GBC& gbc, const uint32_t priority = 1);
+
+        /// @brief Changes the priority of an instance.
+        /// @details Safe to call during a run, the slice length applies from the next slice and the order from the next run.
+        /// @param id Id of the instance.
+        /// @param priority Scheduling order and slice length in quanta of the instance, at least 1.
+        void set_priority(const std::size_t id, const uint32_t priority) noexcept;
+
+        /// @brief Runs every instance for the given cycles and waits for them.
+        /// @details Each instance stops at the first instruction boundary at or after its cycle count plus the cycles,
+        ///         the same state as a single GBC::run_for. Failed instances are not rescheduled.
+        /// @param cycles T-cycles to run each instance.
+        /// @return Status of the failed instance with the lowest id or ok.
+        Status run_for(const uint64_t cycles);
+
+        /// @brief Returns the number of instances.
+        /// @return Number of instances.
+        std::size_t get_instance_count() const noexcept;
+
+        /// @brief Returns the number of threads running the instances.
+        /// @return Workers plus the calling thread.
+        std::size_t get_thread_count() const noexcept;
+
+        /// @brief Returns the slices run by the instance since it was added.
+        /// @param id Id of the instance.
+        /// @return Slices of the instance.
+        uint64_t get_slice_count(const std::size_t id) const noexcept;
+
+        /// @brief Returns the instances stolen from the queues of other threads since construction.
+        /// @return Steals.
+        uint64_t get_steal_count() const noexcept;
+
+        /// @brief Returns the slices queued since construction, including the first slice of each instance in a run.
+        /// @return Queued slices.
+        uint64_t get_queued_slice_count() const noexcept;
+
+        /// @brief Returns how often a thread left a run with nothing to steal while other threads still ran slices.
+        /// @details A high count against the runs means the instances do not keep the threads busy.
+        /// @return Idle threads.
+        uint64_t get_idle_count() const noexcept;
+
+        private:
+        /// @brief Scheduling state of an instance.
+        struct ScheduledInstance{
+            //Scheduled GBC
+            GBC* gbc;
+
+            //Scheduling order and slice length in quanta
+            std::atomic<uint32_t> priority;
+
+            //Priority read at the start of the current run
+            uint32_t run_priority;
+
+            //Cycle the current run ends at
+            uint64_t target_cycle;
+
+            //Status of the current run
+            Status status;
+
+            //Slices run since the instance was added
+            uint64_t slice_count;
+
+            /// @brief Initializes instance with no run.
+            /// @param scheduled_gbc Scheduled GBC.
+            /// @param slice_priority Scheduling order and slice length in quanta.
+            ScheduledInstance(GBC* scheduled_gbc, const uint32_t slice_priority);
+        };
+
+        /// @brief FIFO ready queue of a thread.
+        struct ReadyQueue{
+            //Guards the ring
+            std::mutex mutex;
+
+            //Ids of the ready instances, sized for every instance
+            std::vector<std::size_t> ring;
+
+            //Index of the oldest id in the ring
+            std::size_t head = 0;
+
+            //Number of ids in the ring
+            std::size_t size = 0;
+
+            /// @brief Appends the id as the newest entry.
+            /// @param id Id of the instance.
+            void push(const std::size_t id);
+
+            /// @brief Removes the oldest entry.
+            /// @param id Removed id.
+            /// @return Was the queue non-empty?
+            bool pop(std::size_t& id);
+        };
+
+        /// @brief Runs slices of the queue of the thread until there is nothing left to take, run by the worker pool.
+        /// @param context The scheduler.
+        /// @param index Index of the thread and its queue.
+        static void run_worker(void* context, const std::size_t index);
+
+        /// @brief Takes the next ready instance of the thread, stealing when its own queue is empty.
+        /// @param queue_index Index of the queue of the thread.
+        /// @param id Taken id.
+        /// @return Was an instance taken?
+        bool take_instance(const std::size_t queue_index, std::size_t& id);
+
+        //Configuration of the scheduler
+        const InstanceSchedulerConfig config_;
+
+        //Threads running the slices
+        WorkerPool worker_pool_;
+
+        //Instances in id order, deque keeps them in place as they are added
+        std::deque<ScheduledInstance> instances_;
+
+        //Ready queue per thread
+        std::deque<ReadyQueue> ready_queues_;
+
+        //Instance ids by descending priority, sized for every instance
+        std::vector<std::size_t> run_order_;
+
+        //Instances that have not reached their target in the current run
+        std::atomic<std::size_t> remaining_instances_;
+
+        //Instances stolen from other queues
+        std::atomic<uint64_t> steal_count_;
+
+        //Slices pushed to the ready queues
+        std::atomic<uint64_t> queued_slice_count_;
+
+        //Threads that left a run before its end
+        std::atomic<uint64_t> idle_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
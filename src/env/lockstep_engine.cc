@@ -0,0 +1,471 @@
+#include <algorithm> //std::min, std::max
+#include <cstring> //std::memcmp
+#include <limits> //std::numeric_limits
+#include <string> //std::string
+#include <unordered_map> //std::unordered_map
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> //SSE2, AVX2
+#endif
+#include "lockstep_engine.h" //LockstepEngine
+#include "../instruction_set_lr35902/instruction_decoder_lr35902.h" //InstructionDecoderLR35902
+#include "../profile/trace_events.h" //MYGBC_TRACE_SPAN
+
+namespace mygbc{
+
+    namespace{
+        //PC of the padding lanes, never matches a 16-bit PC
+        constexpr uint32_t padding_pc = 0xFFFFFFFF;
+
+        //End of a lane list and PCs without a group
+        constexpr uint32_t no_lane = 0xFFFFFFFF;
+
+        //Number of 16-bit PCs
+        constexpr std::size_t pc_count = 0x10000;
+
+        //Start of the minimum cycles of a kernel summary, above any cycles below the budget
+        constexpr uint32_t summary_max = 0x7FFFFFFF;
+
+        //Bits of the flags in the AF word
+        constexpr uint32_t zero_flag_shift = 7;
+        constexpr uint32_t carry_flag_shift = 4;
+    }
+
+    /// @brief Initializes engine for the instances.
+    /// @details Instances whose ROM differs from the first instance always execute scalar.
+    ///         The ROMs must not be reloaded while the engine is used.
+    /// @param instances Instances to run. Must outlive the engine.
+    LockstepEngine::LockstepEngine(const std::vector<GBC*>& instances)
+    :instances_(instances), lockstep_capable_(instances.size(), true), start_cycles_(instances.size(), 0), run_budget_(0),
+    lockstep_instruction_count_(0), scalar_instruction_count_(0), lockstep_pass_count_(0){
+        //A regroup may add a group per lane before it drops the emptied one
+        lane_groups_.reserve(instances_.size() + 1);
+        group_indices_.assign(pc_count, no_lane);
+        next_lanes_.assign(instances_.size(), no_lane);
+        const std::size_t padded_size = ((instances_.size() + lane_width - 1) / lane_width) * lane_width;
+        for(std::vector<uint32_t>& register_lanes : lanes_.registers){
+            register_lanes.assign(padded_size, 0);
+        }
+        lanes_.registers[pc_index].assign(padded_size, padding_pc);
+        lanes_.cycles.assign(padded_size, 0);
+        lanes_.lockstep_ends.assign(padded_size, 0);
+        lanes_.instructions.assign(padded_size, 0);
+        //Lockstep decodes from the first instance, the others must have the same ROM
+        constexpr std::size_t rom_page_count = MemoryController::rom_end_addr / PageBitmap::page_size;
+        uint8_t first_page[PageBitmap::page_size];
+        uint8_t page[PageBitmap::page_size];
+        for(std::size_t rom_page = 0; rom_page < rom_page_count && !instances_.empty(); ++rom_page){
+            instances_[0]->get_memory().read_page(static_cast<uint8_t>(rom_page), first_page);
+            for(std::size_t lane = 1; lane < instances_.size(); ++lane){
+                instances_[lane]->get_memory().read_page(static_cast<uint8_t>(rom_page), page);
+                if(std::memcmp(first_page, page, PageBitmap::page_size) != 0){
+                    lockstep_capable_[lane] = false;
+                }
+            }
+        }
+    }
+
+    /// @brief Runs every instance for the given cycles.
+    /// @details Each instance stops at the first instruction boundary at or after its own cycle count plus the budget,
+    ///         matching GBC::run_until_cycle.
+    /// @param cycles Budget of T-cycles, at most INT32_MAX.
+    /// @return Status of the first failed instance or ok.
+    Status LockstepEngine::run_for(const uint32_t cycles){
+        MYGBC_TRACE_SPAN("lockstep_run");
+        //Lane compares are signed without AVX-512
+        run_budget_ = std::min<uint32_t>(cycles, std::numeric_limits<int32_t>::max());
+        for(std::size_t lane = 0; lane < instances_.size(); ++lane){
+            GBC& gbc = *instances_[lane];
+            start_cycles_[lane] = gbc.get_cycle_count();
+            if(!lockstep_capable_[lane] || gbc.get_processing_unit().is_instrumented()){
+                //Lane never joins the lockstep, run it as a whole
+                Status run_status = gbc.run_until_cycle(start_cycles_[lane] + run_budget_);
+                if(!run_status.ok()){
+                    return run_status;
+                }
+                lanes_.registers[pc_index][lane] = padding_pc;
+                lanes_.cycles[lane] = run_budget_;
+                lanes_.lockstep_ends[lane] = 0;
+                continue;
+            }
+            load_lane(lane);
+        }
+        //Groups left by a failed run
+        for(const LaneGroup& group : lane_groups_){
+            group_indices_[group.pc] = no_lane;
+        }
+        lane_groups_.clear();
+        for(std::size_t lane = 0; lane < instances_.size(); ++lane){
+            if(lanes_.cycles[lane] < run_budget_){
+                add_to_group(static_cast<uint32_t>(lane));
+            }
+        }
+        const KernelTable& kernel_table = get_kernel_table();
+        Status run_status = Status::ok_status();
+        while(run_status.ok() && !lane_groups_.empty()){
+            //Group furthest behind leads, so lanes on the same path stay at the same PC
+            std::size_t group_index = 0;
+            for(std::size_t index = 1; index < lane_groups_.size(); ++index){
+                if(lane_groups_[index].cycles < lane_groups_[group_index].cycles){
+                    group_index = index;
+                }
+            }
+            const uint32_t pc = lane_groups_[group_index].pc;
+            const uint32_t leader_cycles = lane_groups_[group_index].cycles;
+            uint32_t leader = lane_groups_[group_index].first_lane;
+            while(lanes_.cycles[leader] != leader_cycles){
+                leader = next_lanes_[leader];
+            }
+            if(leader_cycles < lanes_.lockstep_ends[leader] && pc < MemoryController::rom_end_addr){
+                //ROM is equal for every lane, decode it once without counting the reads
+                AddressableMemory& leader_memory = instances_[leader]->get_memory();
+                StatusOr<DecodedInstructionLR35902> instruction_fetch = InstructionDecoderLR35902::decode_reference(
+                    leader_memory, static_cast<uint16_t>(pc), instruction_set_
+                );
+                if(instruction_fetch.ok() && pc + instruction_fetch.value().instruction->size_in_bytes <= MemoryController::rom_end_addr){
+                    const DecodedInstructionLR35902& decoded = instruction_fetch.value();
+                    const LaneKernel kernel = kernel_table[InstructionSetLR35902::get_lookup_index(decoded.instruction->opcode)];
+                    if(kernel != nullptr){
+                        //Lanes outside of the bounds of the group are at other PCs
+                        const std::size_t lane_begin = (lane_groups_[group_index].lane_begin / lane_width) * lane_width;
+                        const std::size_t lane_end = ((lane_groups_[group_index].lane_end + lane_width - 1) / lane_width) * lane_width;
+                        const KernelSummary summary = kernel(*decoded.instruction, decoded.read_value, pc, lane_begin, lane_end, lanes_);
+                        ++lockstep_pass_count_;
+                        LaneGroup& group = lane_groups_[group_index];
+                        //Whole group moved to a PC without a group and can run in lockstep again, no lane has to move
+                        const uint32_t next_pc = summary.any_pc_bits;
+                        const bool moved_together = summary.lane_count == group.lane_count && summary.ended_lane_count == 0 && summary.any_pc_bits == summary.all_pc_bits &&
+                            (next_pc == group.pc || group_indices_[next_pc] == no_lane);
+                        if(moved_together){
+                            group_indices_[group.pc] = no_lane;
+                            group_indices_[next_pc] = static_cast<uint32_t>(group_index);
+                            group.pc = next_pc;
+                            group.cycles = summary.min_cycles;
+                        }
+                        else{
+                            regroup(group_index);
+                        }
+                        continue;
+                    }
+                }
+            }
+            run_status = step_scalar(leader);
+            regroup(group_index);
+        }
+        for(std::size_t lane = 0; lane < instances_.size(); ++lane){
+            if(lanes_.registers[pc_index][lane] != padding_pc){
+                store_lane(lane);
+            }
+        }
+        return run_status;
+    }
+
+    /// @brief Returns the number of instances.
+    /// @return Number of instances.
+    std::size_t LockstepEngine::get_instance_count() const noexcept{
+        return instances_.size();
+    }
+
+    /// @brief Returns the instructions executed on lanes since construction.
+    /// @return Lane instructions, an instruction executed on N lanes counts N times.
+    uint64_t LockstepEngine::get_lockstep_instruction_count() const noexcept{
+        return lockstep_instruction_count_;
+    }
+
+    /// @brief Returns the instructions executed by the scalar fallback since construction.
+    /// @return Scalar instructions.
+    uint64_t LockstepEngine::get_scalar_instruction_count() const noexcept{
+        return scalar_instruction_count_;
+    }
+
+    /// @brief Returns the lane kernel passes since construction.
+    /// @return Decoded instructions executed across the lanes.
+    uint64_t LockstepEngine::get_lockstep_pass_count() const noexcept{
+        return lockstep_pass_count_;
+    }
+
+    /// @brief Returns the shared kernel table, builds it on first use.
+    /// @details Resolves the mnemonic of every instruction in the set to its kernel.
+    /// @return Shared kernel table.
+    const LockstepEngine::KernelTable& LockstepEngine::get_kernel_table(){
+        static const KernelTable kernel_table = [](){
+            const std::unordered_map<std::string, LaneKernel> mnemonic_table{
+                {"JP", LockstepEngine::kernel_jp}
+            };
+            const InstructionSetLR35902 instruction_set;
+            KernelTable built{};
+            for(std::size_t opcode = 0; opcode < 0x100; ++opcode){
+                for(const uint16_t prefix : {uint16_t{0x0000}, uint16_t{0xCB00}}){
+                    const InstructionLR35902* instruction = instruction_set.find_by_opcode(static_cast<uint16_t>(prefix | opcode));
+                    if(instruction == nullptr){
+                        continue;
+                    }
+                    //Register operands are only supported for JP HL
+                    const bool supported_operands = instruction->operand_registers.empty() ?
+                        instruction->has_read_value : (instruction->operand_registers[0].id == "HL");
+                    const auto kernel = mnemonic_table.find(instruction->short_mnemonic);
+                    if(kernel != mnemonic_table.end() && supported_operands){
+                        built[InstructionSetLR35902::get_lookup_index(instruction->opcode)] = kernel->second;
+                    }
+                }
+            }
+            return built;
+        }();
+        return kernel_table;
+    }
+
+    /// @brief Kernel for all of the JP instructions.
+    /// @details Matches InstructionExecutorLR35902::exec_jp, including the PC of untaken jumps.
+    /// @param instruction JP variation.
+    /// @param read_value Jump address when the variation has a read value.
+    /// @param pc PC of the executing lanes.
+    /// @param lane_begin First lane to execute, a multiple of lane_width.
+    /// @param lane_end Lane after the last lane to execute, a multiple of lane_width.
+    /// @param lanes Lanes of the engine.
+    /// @return Summary of the executed lanes.
+    LockstepEngine::KernelSummary LockstepEngine::kernel_jp(const InstructionLR35902& instruction, const uint16_t read_value, const uint32_t pc,
+        const std::size_t lane_begin, const std::size_t lane_end, Lanes& lanes){
+        using ExecutionCondition = InstructionLR35902::ExecutionCondition;
+        const ExecutionCondition condition = instruction.execution_condition;
+        const uint32_t flag_shift = (condition == ExecutionCondition::ZERO_SET || condition == ExecutionCondition::ZERO_NOT_SET) ? zero_flag_shift : carry_flag_shift;
+        const uint32_t taken_flag = (condition == ExecutionCondition::ZERO_SET || condition == ExecutionCondition::CARRY_SET) ? 1 : 0;
+        const uint32_t taken_cost = instruction.t_cycles_costs[0];
+        const uint32_t untaken_cost = instruction.t_cycles_costs.size() > 1 ? instruction.t_cycles_costs[1] : taken_cost;
+        const uint32_t untaken_pc = (pc + 1) & 0xFFFF;
+        uint32_t* pcs = lanes.registers[pc_index].data();
+        const uint32_t* afs = lanes.registers[af_index].data();
+        const uint32_t* hls = lanes.registers[hl_index].data();
+        uint32_t* cycles = lanes.cycles.data();
+        const uint32_t* lockstep_ends = lanes.lockstep_ends.data();
+        uint32_t* instructions = lanes.instructions.data();
+        KernelSummary summary{0, 0, 0, 0xFFFFFFFF, summary_max};
+        std::size_t lane = lane_begin;
+#if defined(__AVX2__)
+        const __m256i pc_vector = _mm256_set1_epi32(static_cast<int>(pc));
+        const __m256i taken_flag_vector = _mm256_set1_epi32(static_cast<int>(taken_flag));
+        const __m256i taken_cost_vector = _mm256_set1_epi32(static_cast<int>(taken_cost));
+        const __m256i untaken_cost_vector = _mm256_set1_epi32(static_cast<int>(untaken_cost));
+        const __m256i untaken_pc_vector = _mm256_set1_epi32(static_cast<int>(untaken_pc));
+        const __m256i read_value_vector = _mm256_set1_epi32(read_value);
+        const __m256i all_set_vector = _mm256_set1_epi32(-1);
+        const __m256i summary_max_vector = _mm256_set1_epi32(static_cast<int>(summary_max));
+        __m256i executed_lanes = _mm256_setzero_si256();
+        __m256i ended_lanes = _mm256_setzero_si256();
+        __m256i any_pc_bits = _mm256_setzero_si256();
+        __m256i all_pc_bits = all_set_vector;
+        __m256i min_cycles = summary_max_vector;
+        for(; lane + 8 <= lane_end; lane += 8){
+            __m256i lane_pcs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pcs + lane));
+            __m256i lane_cycles = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cycles + lane));
+            const __m256i lane_ends = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lockstep_ends + lane));
+            const __m256i active = _mm256_and_si256(_mm256_cmpeq_epi32(lane_pcs, pc_vector), _mm256_cmpgt_epi32(lane_ends, lane_cycles));
+            if(_mm256_movemask_epi8(active) == 0){
+                continue;
+            }
+            __m256i taken = _mm256_set1_epi32(-1);
+            if(condition != ExecutionCondition::NONE){
+                const __m256i lane_afs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(afs + lane));
+                const __m256i flags = _mm256_and_si256(_mm256_srli_epi32(lane_afs, static_cast<int>(flag_shift)), _mm256_set1_epi32(1));
+                taken = _mm256_cmpeq_epi32(flags, taken_flag_vector);
+            }
+            const __m256i targets = instruction.has_read_value ? read_value_vector : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hls + lane));
+            const __m256i next_pcs = _mm256_blendv_epi8(untaken_pc_vector, targets, taken);
+            const __m256i costs = _mm256_blendv_epi8(untaken_cost_vector, taken_cost_vector, taken);
+            lane_pcs = _mm256_blendv_epi8(lane_pcs, next_pcs, active);
+            lane_cycles = _mm256_add_epi32(lane_cycles, _mm256_and_si256(costs, active));
+            //Active lanes are -1, subtracting counts the instruction
+            const __m256i lane_instructions = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(instructions + lane)), active);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pcs + lane), lane_pcs);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cycles + lane), lane_cycles);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(instructions + lane), lane_instructions);
+            //Cycles exceed their end by less than an instruction, the difference does not overflow
+            const __m256i ended = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_sub_epi32(lane_cycles, lane_ends), all_set_vector), active);
+            executed_lanes = _mm256_sub_epi32(executed_lanes, active);
+            ended_lanes = _mm256_sub_epi32(ended_lanes, ended);
+            any_pc_bits = _mm256_or_si256(any_pc_bits, _mm256_and_si256(active, lane_pcs));
+            all_pc_bits = _mm256_and_si256(all_pc_bits, _mm256_or_si256(lane_pcs, _mm256_xor_si256(active, all_set_vector)));
+            min_cycles = _mm256_min_epi32(min_cycles, _mm256_blendv_epi8(summary_max_vector, lane_cycles, active));
+        }
+        alignas(32) uint32_t lane_values[5][8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values[0]), executed_lanes);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values[1]), ended_lanes);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values[2]), any_pc_bits);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values[3]), all_pc_bits);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane_values[4]), min_cycles);
+        for(std::size_t value = 0; value < 8; ++value){
+            summary.lane_count += lane_values[0][value];
+            summary.ended_lane_count += lane_values[1][value];
+            summary.any_pc_bits |= lane_values[2][value];
+            summary.all_pc_bits &= lane_values[3][value];
+            summary.min_cycles = std::min(summary.min_cycles, lane_values[4][value]);
+        }
+#elif defined(__SSE2__)
+        const __m128i pc_vector = _mm_set1_epi32(static_cast<int>(pc));
+        const __m128i taken_flag_vector = _mm_set1_epi32(static_cast<int>(taken_flag));
+        const __m128i taken_cost_vector = _mm_set1_epi32(static_cast<int>(taken_cost));
+        const __m128i untaken_cost_vector = _mm_set1_epi32(static_cast<int>(untaken_cost));
+        const __m128i untaken_pc_vector = _mm_set1_epi32(static_cast<int>(untaken_pc));
+        const __m128i read_value_vector = _mm_set1_epi32(read_value);
+        const __m128i all_set_vector = _mm_set1_epi32(-1);
+        const __m128i summary_max_vector = _mm_set1_epi32(static_cast<int>(summary_max));
+        __m128i executed_lanes = _mm_setzero_si128();
+        __m128i ended_lanes = _mm_setzero_si128();
+        __m128i any_pc_bits = _mm_setzero_si128();
+        __m128i all_pc_bits = all_set_vector;
+        __m128i min_cycles = summary_max_vector;
+        for(; lane + 4 <= lane_end; lane += 4){
+            __m128i lane_pcs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcs + lane));
+            __m128i lane_cycles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cycles + lane));
+            const __m128i lane_ends = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lockstep_ends + lane));
+            const __m128i active = _mm_and_si128(_mm_cmpeq_epi32(lane_pcs, pc_vector), _mm_cmpgt_epi32(lane_ends, lane_cycles));
+            if(_mm_movemask_epi8(active) == 0){
+                continue;
+            }
+            __m128i taken = _mm_set1_epi32(-1);
+            if(condition != ExecutionCondition::NONE){
+                const __m128i lane_afs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(afs + lane));
+                const __m128i flags = _mm_and_si128(_mm_srli_epi32(lane_afs, static_cast<int>(flag_shift)), _mm_set1_epi32(1));
+                taken = _mm_cmpeq_epi32(flags, taken_flag_vector);
+            }
+            const __m128i targets = instruction.has_read_value ? read_value_vector : _mm_loadu_si128(reinterpret_cast<const __m128i*>(hls + lane));
+            const __m128i next_pcs = _mm_or_si128(_mm_and_si128(taken, targets), _mm_andnot_si128(taken, untaken_pc_vector));
+            const __m128i costs = _mm_or_si128(_mm_and_si128(taken, taken_cost_vector), _mm_andnot_si128(taken, untaken_cost_vector));
+            lane_pcs = _mm_or_si128(_mm_and_si128(active, next_pcs), _mm_andnot_si128(active, lane_pcs));
+            lane_cycles = _mm_add_epi32(lane_cycles, _mm_and_si128(costs, active));
+            //Active lanes are -1, subtracting counts the instruction
+            const __m128i lane_instructions = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(instructions + lane)), active);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcs + lane), lane_pcs);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(cycles + lane), lane_cycles);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(instructions + lane), lane_instructions);
+            //Cycles exceed their end by less than an instruction, the difference does not overflow
+            const __m128i ended = _mm_and_si128(_mm_cmpgt_epi32(_mm_sub_epi32(lane_cycles, lane_ends), all_set_vector), active);
+            executed_lanes = _mm_sub_epi32(executed_lanes, active);
+            ended_lanes = _mm_sub_epi32(ended_lanes, ended);
+            any_pc_bits = _mm_or_si128(any_pc_bits, _mm_and_si128(active, lane_pcs));
+            all_pc_bits = _mm_and_si128(all_pc_bits, _mm_or_si128(lane_pcs, _mm_xor_si128(active, all_set_vector)));
+            //SSE2 has no 32-bit min, select with a compare instead
+            const __m128i active_cycles = _mm_or_si128(_mm_and_si128(active, lane_cycles), _mm_andnot_si128(active, summary_max_vector));
+            const __m128i lower_cycles = _mm_cmplt_epi32(active_cycles, min_cycles);
+            min_cycles = _mm_or_si128(_mm_and_si128(lower_cycles, active_cycles), _mm_andnot_si128(lower_cycles, min_cycles));
+        }
+        alignas(16) uint32_t lane_values[5][4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_values[0]), executed_lanes);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_values[1]), ended_lanes);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_values[2]), any_pc_bits);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_values[3]), all_pc_bits);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lane_values[4]), min_cycles);
+        for(std::size_t value = 0; value < 4; ++value){
+            summary.lane_count += lane_values[0][value];
+            summary.ended_lane_count += lane_values[1][value];
+            summary.any_pc_bits |= lane_values[2][value];
+            summary.all_pc_bits &= lane_values[3][value];
+            summary.min_cycles = std::min(summary.min_cycles, lane_values[4][value]);
+        }
+#endif
+        for(; lane < lane_end; ++lane){
+            if(pcs[lane] != pc || cycles[lane] >= lockstep_ends[lane]){
+                continue;
+            }
+            const bool taken = condition == ExecutionCondition::NONE || ((afs[lane] >> flag_shift) & 1) == taken_flag;
+            pcs[lane] = taken ? (instruction.has_read_value ? read_value : hls[lane]) : untaken_pc;
+            cycles[lane] += taken ? taken_cost : untaken_cost;
+            ++instructions[lane];
+            ++summary.lane_count;
+            summary.ended_lane_count += cycles[lane] >= lockstep_ends[lane] ? 1 : 0;
+            summary.any_pc_bits |= pcs[lane];
+            summary.all_pc_bits &= pcs[lane];
+            summary.min_cycles = std::min(summary.min_cycles, cycles[lane]);
+        }
+        return summary;
+    }
+
+    /// @brief Adds the lane to the group of its PC, creates the group when the PC has none.
+    /// @param lane Index of the lane, below the budget.
+    void LockstepEngine::add_to_group(const uint32_t lane){
+        const uint32_t pc = lanes_.registers[pc_index][lane];
+        const uint32_t cycles = lanes_.cycles[lane];
+        const uint32_t group_index = group_indices_[pc];
+        if(group_index == no_lane){
+            group_indices_[pc] = static_cast<uint32_t>(lane_groups_.size());
+            lane_groups_.push_back(LaneGroup{pc, lane, 1, cycles, lane, lane + 1});
+            next_lanes_[lane] = no_lane;
+            return;
+        }
+        LaneGroup& group = lane_groups_[group_index];
+        next_lanes_[lane] = group.first_lane;
+        group.first_lane = lane;
+        ++group.lane_count;
+        group.cycles = std::min(group.cycles, cycles);
+        group.lane_begin = std::min(group.lane_begin, lane);
+        group.lane_end = std::max(group.lane_end, lane + 1);
+    }
+
+    /// @brief Moves the lanes of the group that left its PC to the groups of their new PCs.
+    /// @details Drops lanes that used their budget and the group once it is empty. Costs one step per lane of the group.
+    /// @param group_index Index of the group that executed.
+    void LockstepEngine::regroup(const std::size_t group_index){
+        uint32_t lane = lane_groups_[group_index].first_lane;
+        lane_groups_[group_index].first_lane = no_lane;
+        lane_groups_[group_index].lane_count = 0;
+        lane_groups_[group_index].cycles = run_budget_;
+        lane_groups_[group_index].lane_begin = no_lane;
+        lane_groups_[group_index].lane_end = 0;
+        while(lane != no_lane){
+            const uint32_t next_lane = next_lanes_[lane];
+            if(lanes_.cycles[lane] < run_budget_){
+                //Lanes still at the PC go back to the same group
+                add_to_group(lane);
+            }
+            lane = next_lane;
+        }
+        if(lane_groups_[group_index].first_lane == no_lane){
+            group_indices_[lane_groups_[group_index].pc] = no_lane;
+            if(group_index + 1 != lane_groups_.size()){
+                lane_groups_[group_index] = lane_groups_.back();
+                group_indices_[lane_groups_[group_index].pc] = static_cast<uint32_t>(group_index);
+            }
+            lane_groups_.pop_back();
+        }
+    }
+
+    /// @brief Copies the state of the instance to its lane.
+    /// @param lane Index of the lane.
+    void LockstepEngine::load_lane(const std::size_t lane){
+        GBC& gbc = *instances_[lane];
+        const std::array<uint16_t, GBCSnapshot::register_count> register_words = gbc.get_processing_unit().get_register_file().get_register_words();
+        for(std::size_t register_index = 0; register_index < register_words.size(); ++register_index){
+            lanes_.registers[register_index][lane] = register_words[register_index];
+        }
+        const uint64_t cycle_count = gbc.get_cycle_count();
+        lanes_.cycles[lane] = static_cast<uint32_t>(cycle_count - start_cycles_[lane]);
+        //Recorded inputs are applied by the scalar CPU
+        const uint64_t next_input_cycle = gbc.get_next_input_cycle();
+        const uint64_t input_end = next_input_cycle > start_cycles_[lane] ? next_input_cycle - start_cycles_[lane] : 0;
+        lanes_.lockstep_ends[lane] = static_cast<uint32_t>(std::min<uint64_t>(input_end, run_budget_));
+        lanes_.instructions[lane] = 0;
+    }
+
+    /// @brief Commits the state of the lane to its instance.
+    /// @param lane Index of the lane.
+    void LockstepEngine::store_lane(const std::size_t lane){
+        std::array<uint16_t, GBCSnapshot::register_count> register_words;
+        for(std::size_t register_index = 0; register_index < register_words.size(); ++register_index){
+            register_words[register_index] = static_cast<uint16_t>(lanes_.registers[register_index][lane]);
+        }
+        instances_[lane]->commit_external_execution(register_words, start_cycles_[lane] + lanes_.cycles[lane], lanes_.instructions[lane]);
+        lockstep_instruction_count_ += lanes_.instructions[lane];
+        lanes_.instructions[lane] = 0;
+    }
+
+    /// @brief Executes a single instruction of the lane on the scalar CPU of its instance.
+    /// @param lane Index of the lane.
+    /// @return Status of the execution.
+    Status LockstepEngine::step_scalar(const std::size_t lane){
+        store_lane(lane);
+        GBC& gbc = *instances_[lane];
+        Status step_status = gbc.run_until_cycle(gbc.get_cycle_count() + 1);
+        ++scalar_instruction_count_;
+        load_lane(lane);
+        return step_status;
+    }
+
+}//namespace_mygbc
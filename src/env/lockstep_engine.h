@@ -0,0 +1,196 @@
+#ifndef LOCKSTEP_ENGINE_H
+#define LOCKSTEP_ENGINE_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../instruction_set_lr35902/instruction_set_lr35902.h" //InstructionSetLR35902
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Experimental engine running many GBCs with the same ROM in lockstep.
+    /// @details The register files of the instances are kept in structure of arrays layout, one lane per instance.
+    ///         Each iteration decodes the instruction at the PC of the instance furthest behind and executes it with
+    ///         SIMD (AVX2 or SSE2 when available) on every lane at the same ROM address. Lanes are grouped by PC, so an
+    ///         iteration costs the groups and the lanes of the executing group instead of every lane. Other instructions and
+    ///         lanes fall back to the scalar CPU of their GBC: instructions without a lane kernel, code outside of the
+    ///         ROM, lanes with a recorded input due and lanes with a trace recorder or profiler attached.
+    ///         Lockstep instructions update the registers, cycle count and metrics but not the memory access counters.
+    class LockstepEngine{
+        public:
+        //Lanes processed per SIMD operation, lane arrays are padded to a multiple of it
+        static constexpr std::size_t lane_width = 8;
+
+        /// @brief Initializes engine for the instances.
+        /// @details Instances whose ROM differs from the first instance always execute scalar.
+        ///         The ROMs must not be reloaded while the engine is used.
+        /// @param instances Instances to run. Must outlive the engine.
+        explicit LockstepEngine(const std::vector<GBC*>& instances);
+
+        /// @brief Runs every instance for the given cycles.
+        /// @details Each instance stops at the first instruction boundary at or after its own cycle count plus the budget,
+        ///         matching GBC::run_until_cycle.
+        /// @param cycles Budget of T-cycles, at most INT32_MAX.
+        /// @return Status of the first failed instance or ok.
+        Status run_for(const uint32_t cycles);
+
+        /// @brief Returns the number of instances.
+        /// @return Number of instances.
+        std::size_t get_instance_count() const noexcept;
+
+        /// @brief Returns the instructions executed on lanes since construction.
+        /// @return Lane instructions, an instruction executed on N lanes counts N times.
+        uint64_t get_lockstep_instruction_count() const noexcept;
+
+        /// @brief Returns the instructions executed by the scalar fallback since construction.
+        /// @return Scalar instructions.
+        uint64_t get_scalar_instruction_count() const noexcept;
+
+        /// @brief Returns the lane kernel passes since construction.
+        /// @return Decoded instructions executed across the lanes.
+        uint64_t get_lockstep_pass_count() const noexcept;
+
+        private:
+        //Lane registers in the order of GBCSnapshot::register_words
+        static constexpr std::size_t pc_index = 5;
+        static constexpr std::size_t af_index = 1;
+        static constexpr std::size_t hl_index = 4;
+
+        /// @brief Lanes of the engine, 16-bit registers are widened to 32 bits.
+        struct Lanes{
+            //Register words per lane
+            std::array<std::vector<uint32_t>, GBCSnapshot::register_count> registers;
+
+            //T-cycles executed in the current run
+            std::vector<uint32_t> cycles;
+
+            //Cycle where the lane leaves lockstep in the current run, 0 for scalar lanes
+            std::vector<uint32_t> lockstep_ends;
+
+            //Lockstep instructions not yet committed to the GBC
+            std::vector<uint32_t> instructions;
+        };
+
+        /// @brief Lanes below the budget at the same PC.
+        struct LaneGroup{
+            //PC of the lanes
+            uint32_t pc;
+
+            //First lane of the group, next_lanes_ links the others
+            uint32_t first_lane;
+
+            //Lanes in the group
+            uint32_t lane_count;
+
+            //Lowest cycles of the lanes
+            uint32_t cycles;
+
+            //Lowest lane and the lane after the highest lane of the group
+            uint32_t lane_begin;
+            uint32_t lane_end;
+        };
+
+        /// @brief Lanes executed by a kernel, lets a group that stayed together move without visiting its lanes.
+        struct KernelSummary{
+            //Executed lanes
+            uint32_t lane_count;
+
+            //Executed lanes that reached their lockstep end
+            uint32_t ended_lane_count;
+
+            //Bits set in any and in all PCs of the executed lanes, equal when the lanes share a PC
+            uint32_t any_pc_bits;
+            uint32_t all_pc_bits;
+
+            //Lowest cycles of the executed lanes, valid when none reached its lockstep end
+            uint32_t min_cycles;
+        };
+
+        //Executes a decoded instruction on the lanes of the range at the PC that have not reached their lockstep end
+        using LaneKernel = KernelSummary(*)(const InstructionLR35902&, const uint16_t, const uint32_t, const std::size_t, const std::size_t, Lanes&);
+
+        //Opcode lookup index => Lane kernel, nullptr for instructions without a kernel
+        using KernelTable = std::array<LaneKernel, InstructionSetLR35902::opcode_lookup_size>;
+
+        /// @brief Returns the shared kernel table, builds it on first use.
+        /// @details Resolves the mnemonic of every instruction in the set to its kernel.
+        /// @return Shared kernel table.
+        static const KernelTable& get_kernel_table();
+
+        /// @brief Kernel for all of the JP instructions.
+        /// @details Matches InstructionExecutorLR35902::exec_jp, including the PC of untaken jumps.
+        /// @param instruction JP variation.
+        /// @param read_value Jump address when the variation has a read value.
+        /// @param pc PC of the executing lanes.
+        /// @param lane_begin First lane to execute, a multiple of lane_width.
+        /// @param lane_end Lane after the last lane to execute, a multiple of lane_width.
+        /// @param lanes Lanes of the engine.
+        /// @return Summary of the executed lanes.
+        static KernelSummary kernel_jp(const InstructionLR35902& instruction, const uint16_t read_value, const uint32_t pc,
+            const std::size_t lane_begin, const std::size_t lane_end, Lanes& lanes);
+
+        /// @brief Adds the lane to the group of its PC, creates the group when the PC has none.
+        /// @param lane Index of the lane, below the budget.
+        void add_to_group(const uint32_t lane);
+
+        /// @brief Moves the lanes of the group that left its PC to the groups of their new PCs.
+        /// @details Drops lanes that used their budget and the group once it is empty. Costs one step per lane of the group.
+        /// @param group_index Index of the group that executed.
+        void regroup(const std::size_t group_index);
+
+        /// @brief Copies the state of the instance to its lane.
+        /// @param lane Index of the lane.
+        void load_lane(const std::size_t lane);
+
+        /// @brief Commits the state of the lane to its instance.
+        /// @param lane Index of the lane.
+        void store_lane(const std::size_t lane);
+
+        /// @brief Executes a single instruction of the lane on the scalar CPU of its instance.
+        /// @param lane Index of the lane.
+        /// @return Status of the execution.
+        Status step_scalar(const std::size_t lane);
+
+        //Instances of the lanes
+        const std::vector<GBC*> instances_;
+
+        //Can the lane run in lockstep at all?
+        std::vector<bool> lockstep_capable_;
+
+        //Lanes padded to a multiple of lane_width
+        Lanes lanes_;
+
+        //Cycle count of each instance at the start of the current run
+        std::vector<uint64_t> start_cycles_;
+
+        //Budget of the current run
+        uint32_t run_budget_;
+
+        //Groups of the lanes by PC, the leader is found among the groups instead of every lane
+        std::vector<LaneGroup> lane_groups_;
+
+        //PC => Index of its group in lane_groups_, no_lane without a group
+        std::vector<uint32_t> group_indices_;
+
+        //Lane => Next lane of its group
+        std::vector<uint32_t> next_lanes_;
+
+        //Instruction set used to decode the lockstep instructions
+        InstructionSetLR35902 instruction_set_;
+
+        //Lane instructions executed since construction
+        uint64_t lockstep_instruction_count_;
+
+        //Instructions executed by the scalar fallback since construction
+        uint64_t scalar_instruction_count_;
+
+        //Lane kernel passes since construction
+        uint64_t lockstep_pass_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,242 @@
+#include <algorithm> //std::max, std::fill
+#include <cstring> //std::memcpy
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> //SSE2, AVX2
+#endif
+#include "observation_preprocessor.h" //ObservationPreprocessor
+
+namespace mygbc{
+
+    namespace{
+        //Pixels of a row
+        constexpr uint32_t row_size = ObservationPreprocessor::frame_width;
+
+#if defined(__AVX2__)
+        /// @brief Maps the shade indices to gray levels.
+        /// @param shades 32 shade indices.
+        /// @param grays Gray level of each shade broadcast to every byte.
+        /// @return 32 gray levels.
+        __m256i map_shades(const __m256i shades, const __m256i (&grays)[4]) noexcept{
+            const __m256i indices = _mm256_and_si256(shades, _mm256_set1_epi8(0x03));
+            __m256i mapped = grays[0];
+            for(int shade = 1; shade < 4; ++shade){
+                mapped = _mm256_blendv_epi8(mapped, grays[shade], _mm256_cmpeq_epi8(indices, _mm256_set1_epi8(static_cast<char>(shade))));
+            }
+            return mapped;
+        }
+
+        /// @brief Sums the horizontal pixel pairs.
+        /// @param grays 32 gray levels.
+        /// @return 16 pair sums.
+        __m256i sum_pairs(const __m256i grays) noexcept{
+            return _mm256_add_epi16(_mm256_and_si256(grays, _mm256_set1_epi16(0x00FF)), _mm256_srli_epi16(grays, 8));
+        }
+#elif defined(__SSE2__)
+        /// @brief Maps the shade indices to gray levels.
+        /// @param shades 16 shade indices.
+        /// @param grays Gray level of each shade broadcast to every byte.
+        /// @return 16 gray levels.
+        __m128i map_shades(const __m128i shades, const __m128i (&grays)[4]) noexcept{
+            const __m128i indices = _mm_and_si128(shades, _mm_set1_epi8(0x03));
+            __m128i mapped = grays[0];
+            for(int shade = 1; shade < 4; ++shade){
+                const __m128i mask = _mm_cmpeq_epi8(indices, _mm_set1_epi8(static_cast<char>(shade)));
+                mapped = _mm_or_si128(_mm_and_si128(mask, grays[shade]), _mm_andnot_si128(mask, mapped));
+            }
+            return mapped;
+        }
+
+        /// @brief Sums the horizontal pixel pairs.
+        /// @param grays 16 gray levels.
+        /// @return 8 pair sums.
+        __m128i sum_pairs(const __m128i grays) noexcept{
+            return _mm_add_epi16(_mm_and_si128(grays, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(grays, 8));
+        }
+#endif
+
+        /// @brief Maps the shades of the frame to gray levels.
+        /// @param shades Frame of shade indices.
+        /// @param shade_grays Gray level of each shade.
+        /// @param destination Frame of gray levels.
+        void map_frame(const uint8_t* shades, const std::array<uint8_t, 4>& shade_grays, uint8_t* destination) noexcept{
+            constexpr std::size_t pixel_count = ObservationPreprocessor::frame_width * ObservationPreprocessor::frame_height;
+            std::size_t pixel = 0;
+#if defined(__AVX2__)
+            const __m256i grays[4] = {
+                _mm256_set1_epi8(static_cast<char>(shade_grays[0])), _mm256_set1_epi8(static_cast<char>(shade_grays[1])),
+                _mm256_set1_epi8(static_cast<char>(shade_grays[2])), _mm256_set1_epi8(static_cast<char>(shade_grays[3]))
+            };
+            for(; pixel + 32 <= pixel_count; pixel += 32){
+                const __m256i mapped = map_shades(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(shades + pixel)), grays);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + pixel), mapped);
+            }
+#elif defined(__SSE2__)
+            const __m128i grays[4] = {
+                _mm_set1_epi8(static_cast<char>(shade_grays[0])), _mm_set1_epi8(static_cast<char>(shade_grays[1])),
+                _mm_set1_epi8(static_cast<char>(shade_grays[2])), _mm_set1_epi8(static_cast<char>(shade_grays[3]))
+            };
+            for(; pixel + 16 <= pixel_count; pixel += 16){
+                const __m128i mapped = map_shades(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shades + pixel)), grays);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + pixel), mapped);
+            }
+#endif
+            for(; pixel < pixel_count; ++pixel){
+                destination[pixel] = shade_grays[shades[pixel] & 0x03];
+            }
+        }
+
+        /// @brief Averages the 2x2 blocks of the frame.
+        /// @param shades Frame of shade indices.
+        /// @param shade_grays Gray level of each shade.
+        /// @param destination Half sized frame of gray levels.
+        void downscale_by_two(const uint8_t* shades, const std::array<uint8_t, 4>& shade_grays, uint8_t* destination) noexcept{
+            constexpr uint32_t output_width = row_size / 2;
+            for(uint32_t output_row = 0; output_row < ObservationPreprocessor::frame_height / 2; ++output_row){
+                const uint8_t* top = shades + (static_cast<std::size_t>(output_row) * 2 * row_size);
+                const uint8_t* bottom = top + row_size;
+                uint8_t* output = destination + (static_cast<std::size_t>(output_row) * output_width);
+                uint32_t column = 0;
+#if defined(__AVX2__)
+                const __m256i grays[4] = {
+                    _mm256_set1_epi8(static_cast<char>(shade_grays[0])), _mm256_set1_epi8(static_cast<char>(shade_grays[1])),
+                    _mm256_set1_epi8(static_cast<char>(shade_grays[2])), _mm256_set1_epi8(static_cast<char>(shade_grays[3]))
+                };
+                for(; column + 32 <= row_size; column += 32){
+                    const __m256i top_sums = sum_pairs(map_shades(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + column)), grays));
+                    const __m256i bottom_sums = sum_pairs(map_shades(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + column)), grays));
+                    //Rounded mean of the four pixels
+                    const __m256i means = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(top_sums, bottom_sums), _mm256_set1_epi16(2)), 2);
+                    //Packing works per 128-bit lane, gather the low halves of both lanes
+                    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(means, means), 0x08);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + (column / 2)), _mm256_castsi256_si128(packed));
+                }
+#elif defined(__SSE2__)
+                const __m128i grays[4] = {
+                    _mm_set1_epi8(static_cast<char>(shade_grays[0])), _mm_set1_epi8(static_cast<char>(shade_grays[1])),
+                    _mm_set1_epi8(static_cast<char>(shade_grays[2])), _mm_set1_epi8(static_cast<char>(shade_grays[3]))
+                };
+                for(; column + 16 <= row_size; column += 16){
+                    const __m128i top_sums = sum_pairs(map_shades(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + column)), grays));
+                    const __m128i bottom_sums = sum_pairs(map_shades(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + column)), grays));
+                    //Rounded mean of the four pixels
+                    const __m128i means = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(top_sums, bottom_sums), _mm_set1_epi16(2)), 2);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + (column / 2)), _mm_packus_epi16(means, means));
+                }
+#endif
+                for(; column < row_size; column += 2){
+                    const uint32_t sum = shade_grays[top[column] & 0x03] + shade_grays[top[column + 1] & 0x03] +
+                        shade_grays[bottom[column] & 0x03] + shade_grays[bottom[column + 1] & 0x03];
+                    output[column / 2] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        /// @brief Averages the blocks of the frame.
+        /// @param shades Frame of shade indices.
+        /// @param downscale_factor Width and height of the blocks.
+        /// @param shade_grays Gray level of each shade.
+        /// @param destination Downscaled frame of gray levels.
+        void downscale_blocks(const uint8_t* shades, const uint32_t downscale_factor, const std::array<uint8_t, 4>& shade_grays, uint8_t* destination) noexcept{
+            const uint32_t output_width = row_size / downscale_factor;
+            const uint32_t output_height = ObservationPreprocessor::frame_height / downscale_factor;
+            const uint32_t block_pixels = downscale_factor * downscale_factor;
+            for(uint32_t output_row = 0; output_row < output_height; ++output_row){
+                for(uint32_t output_column = 0; output_column < output_width; ++output_column){
+                    uint32_t sum = 0;
+                    for(uint32_t block_row = 0; block_row < downscale_factor; ++block_row){
+                        const uint8_t* row = shades + ((static_cast<std::size_t>(output_row) * downscale_factor + block_row) * row_size) + (output_column * downscale_factor);
+                        for(uint32_t block_column = 0; block_column < downscale_factor; ++block_column){
+                            sum += shade_grays[row[block_column] & 0x03];
+                        }
+                    }
+                    destination[(static_cast<std::size_t>(output_row) * output_width) + output_column] = static_cast<uint8_t>((sum + (block_pixels / 2)) / block_pixels);
+                }
+            }
+        }
+    }
+
+    /// @brief Is the downscale factor supported?
+    /// @param downscale_factor Width and height of the averaged pixel blocks.
+    /// @return Does the factor divide the frame width and height?
+    bool ObservationPreprocessor::is_valid_downscale_factor(const uint32_t downscale_factor) noexcept{
+        return downscale_factor != 0 && frame_width % downscale_factor == 0 && frame_height % downscale_factor == 0;
+    }
+
+    /// @brief Initializes preprocessor with an empty frame stack.
+    /// @param downscale_factor Width and height of the averaged pixel blocks, unsupported factors fall back to 1.
+    /// @param stack_size Number of stacked frames, at least 1.
+    /// @param shade_grays Gray level of each shade.
+    ObservationPreprocessor::ObservationPreprocessor(const uint32_t downscale_factor, const std::size_t stack_size, const std::array<uint8_t, 4>& shade_grays)
+    :downscale_factor_(is_valid_downscale_factor(downscale_factor) ? downscale_factor : 1), stack_size_(std::max<std::size_t>(stack_size, 1)),
+    shade_grays_(shade_grays), frames_(stack_size_ * (frame_width / downscale_factor_) * (frame_height / downscale_factor_), 0), next_slot_(0){
+    }
+
+    /// @brief Returns the width of the preprocessed frames.
+    /// @return Width in pixels.
+    uint32_t ObservationPreprocessor::get_width() const noexcept{
+        return frame_width / downscale_factor_;
+    }
+
+    /// @brief Returns the height of the preprocessed frames.
+    /// @return Height in pixels.
+    uint32_t ObservationPreprocessor::get_height() const noexcept{
+        return frame_height / downscale_factor_;
+    }
+
+    /// @brief Returns the size of a preprocessed frame.
+    /// @return Bytes per frame.
+    std::size_t ObservationPreprocessor::get_frame_size() const noexcept{
+        return static_cast<std::size_t>(get_width()) * get_height();
+    }
+
+    /// @brief Returns the size of the stacked observation.
+    /// @return Bytes per observation.
+    std::size_t ObservationPreprocessor::get_observation_size() const noexcept{
+        return frames_.size();
+    }
+
+    /// @brief Preprocesses the frame and replaces the oldest frame of the stack with it.
+    /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+    void ObservationPreprocessor::push_frame(const uint8_t* shades) noexcept{
+        downscale(shades, downscale_factor_, shade_grays_, frames_.data() + (next_slot_ * get_frame_size()));
+        next_slot_ = (next_slot_ + 1) % stack_size_;
+    }
+
+    /// @brief Preprocesses the frame and fills the whole stack with it, as at the start of an episode.
+    /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+    void ObservationPreprocessor::reset(const uint8_t* shades) noexcept{
+        const std::size_t frame_size = get_frame_size();
+        downscale(shades, downscale_factor_, shade_grays_, frames_.data());
+        for(std::size_t slot = 1; slot < stack_size_; ++slot){
+            std::memcpy(frames_.data() + (slot * frame_size), frames_.data(), frame_size);
+        }
+        next_slot_ = 0;
+    }
+
+    /// @brief Writes the stacked frames, oldest first.
+    /// @param destination Buffer of get_observation_size() bytes.
+    void ObservationPreprocessor::write_observation(uint8_t* destination) const noexcept{
+        const std::size_t frame_size = get_frame_size();
+        const std::size_t oldest_bytes = (stack_size_ - next_slot_) * frame_size;
+        std::memcpy(destination, frames_.data() + (next_slot_ * frame_size), oldest_bytes);
+        std::memcpy(destination + oldest_bytes, frames_.data(), next_slot_ * frame_size);
+    }
+
+    /// @brief Converts the shades to gray levels and averages the blocks of pixels.
+    /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+    /// @param downscale_factor Valid downscale factor, see is_valid_downscale_factor.
+    /// @param shade_grays Gray level of each shade.
+    /// @param destination Buffer of (frame_width / factor) * (frame_height / factor) bytes.
+    void ObservationPreprocessor::downscale(const uint8_t* shades, const uint32_t downscale_factor, const std::array<uint8_t, 4>& shade_grays, uint8_t* destination) noexcept{
+        if(downscale_factor == 1){
+            map_frame(shades, shade_grays, destination);
+        }
+        else if(downscale_factor == 2){
+            downscale_by_two(shades, shade_grays, destination);
+        }
+        else{
+            downscale_blocks(shades, downscale_factor, shade_grays, destination);
+        }
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,82 @@
+#ifndef OBSERVATION_PREPROCESSOR_H
+#define OBSERVATION_PREPROCESSOR_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Turns frames of 2-bit shade indices into downscaled grayscale frame stacks for learning agents.
+    /// @details Shades map straight to gray levels, so no RGBA frame is built. Downscaling averages square blocks
+    ///         of pixels, factors 1 and 2 use SSE2 or AVX2 when available. The last frames are kept in a ring.
+    class ObservationPreprocessor{
+        public:
+        //Size of the LCD in pixels
+        static constexpr uint32_t frame_width = 160;
+        static constexpr uint32_t frame_height = 144;
+
+        //Gray level of each shade, shade 0 is the lightest
+        static constexpr std::array<uint8_t, 4> default_shade_grays{255, 170, 85, 0};
+
+        /// @brief Is the downscale factor supported?
+        /// @param downscale_factor Width and height of the averaged pixel blocks.
+        /// @return Does the factor divide the frame width and height?
+        static bool is_valid_downscale_factor(const uint32_t downscale_factor) noexcept;
+
+        /// @brief Initializes preprocessor with an empty frame stack.
+        /// @param downscale_factor Width and height of the averaged pixel blocks, unsupported factors fall back to 1.
+        /// @param stack_size Number of stacked frames, at least 1.
+        /// @param shade_grays Gray level of each shade.
+        ObservationPreprocessor(const uint32_t downscale_factor, const std::size_t stack_size, const std::array<uint8_t, 4>& shade_grays = default_shade_grays);
+
+        /// @brief Returns the width of the preprocessed frames.
+        /// @return Width in pixels.
+        uint32_t get_width() const noexcept;
+
+        /// @brief Returns the height of the preprocessed frames.
+        /// @return Height in pixels.
+        uint32_t get_height() const noexcept;
+
+        /// @brief Returns the size of a preprocessed frame.
+        /// @return Bytes per frame.
+        std::size_t get_frame_size() const noexcept;
+
+        /// @brief Returns the size of the stacked observation.
+        /// @return Bytes per observation.
+        std::size_t get_observation_size() const noexcept;
+
+        /// @brief Preprocesses the frame and replaces the oldest frame of the stack with it.
+        /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+        void push_frame(const uint8_t* shades) noexcept;
+
+        /// @brief Preprocesses the frame and fills the whole stack with it, as at the start of an episode.
+        /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+        void reset(const uint8_t* shades) noexcept;
+
+        /// @brief Writes the stacked frames, oldest first.
+        /// @param destination Buffer of get_observation_size() bytes.
+        void write_observation(uint8_t* destination) const noexcept;
+
+        /// @brief Converts the shades to gray levels and averages the blocks of pixels.
+        /// @param shades Frame of shade indices, frame_width * frame_height bytes. Only the 2 low bits are used.
+        /// @param downscale_factor Valid downscale factor, see is_valid_downscale_factor.
+        /// @param shade_grays Gray level of each shade.
+        /// @param destination Buffer of (frame_width / factor) * (frame_height / factor) bytes.
+        static void downscale(const uint8_t* shades, const uint32_t downscale_factor, const std::array<uint8_t, 4>& shade_grays, uint8_t* destination) noexcept;
+
+        private:
+        //Configuration of the preprocessor
+        const uint32_t downscale_factor_;
+        const std::size_t stack_size_;
+        const std::array<uint8_t, 4> shade_grays_;
+
+        //Stacked frames, slot next_slot_ holds the oldest frame
+        std::vector<uint8_t> frames_;
+        std::size_t next_slot_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,50 @@
+#include "ram_watch.h" //RamWatch
+
+namespace mygbc{
+
+    /// @brief Initializes watch list.
+    /// @param addresses Addresses to read, written to the destination in this order.
+    RamWatch::RamWatch(const std::vector<uint16_t>& addresses)
+    :size_(addresses.size()){
+        for(const uint16_t addr : addresses){
+            //Extend the previous range when the address follows it
+            if(!ranges_.empty() && ranges_.back().start_addr + ranges_.back().size == addr){
+                ++ranges_.back().size;
+            }
+            else{
+                ranges_.push_back(MemoryController::AddressRange{addr, 1});
+            }
+        }
+        ranges_.shrink_to_fit();
+    }
+
+    /// @brief Returns the number of watched addresses.
+    /// @return Bytes written per read.
+    std::size_t RamWatch::get_size() const noexcept{
+        return size_;
+    }
+
+    /// @brief Returns the ranges the addresses were merged into.
+    /// @return Ranges in read order.
+    const std::vector<MemoryController::AddressRange>& RamWatch::get_ranges() const noexcept{
+        return ranges_;
+    }
+
+    /// @brief Writes the watched bytes to the destination.
+    /// @details Not CPU accesses, the access counters of the memory are not updated.
+    /// @param memory Memory to read.
+    /// @param destination Buffer of get_size() bytes.
+    void RamWatch::read(MemoryController& memory, uint8_t* destination) const{
+        memory.read_ranges(ranges_.data(), ranges_.size(), destination);
+    }
+
+    /// @brief Writes the watched bytes of the memory to its slot of a strided output array.
+    /// @param memory Memory to read.
+    /// @param output Output array shared by the instances.
+    /// @param stride Bytes between the slots of consecutive instances, at least get_size().
+    /// @param index Index of the slot.
+    void RamWatch::read_strided(MemoryController& memory, uint8_t* output, const std::size_t stride, const std::size_t index) const{
+        read(memory, output + (index * stride));
+    }
+
+}//namespace_mygbc
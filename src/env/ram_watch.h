@@ -0,0 +1,52 @@
+#ifndef RAM_WATCH_H
+#define RAM_WATCH_H
+
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../components/memory_controller.h" //MemoryController
+
+namespace mygbc{
+
+    /// @brief List of watched addresses, such as the score or lives read by reward functions.
+    /// @details Registered once and read straight from the memory pages. Consecutive addresses are merged into
+    ///         ranges, so a read takes the memory lock once and copies runs of bytes instead of reading byte by byte.
+    class RamWatch{
+        public:
+
+        /// @brief Initializes watch list.
+        /// @param addresses Addresses to read, written to the destination in this order.
+        explicit RamWatch(const std::vector<uint16_t>& addresses);
+
+        /// @brief Returns the number of watched addresses.
+        /// @return Bytes written per read.
+        std::size_t get_size() const noexcept;
+
+        /// @brief Returns the ranges the addresses were merged into.
+        /// @return Ranges in read order.
+        const std::vector<MemoryController::AddressRange>& get_ranges() const noexcept;
+
+        /// @brief Writes the watched bytes to the destination.
+        /// @details Not CPU accesses, the access counters of the memory are not updated.
+        /// @param memory Memory to read.
+        /// @param destination Buffer of get_size() bytes.
+        void read(MemoryController& memory, uint8_t* destination) const;
+
+        /// @brief Writes the watched bytes of the memory to its slot of a strided output array.
+        /// @param memory Memory to read.
+        /// @param output Output array shared by the instances.
+        /// @param stride Bytes between the slots of consecutive instances, at least get_size().
+        /// @param index Index of the slot.
+        void read_strided(MemoryController& memory, uint8_t* output, const std::size_t stride, const std::size_t index) const;
+
+        private:
+        //Number of watched addresses
+        const std::size_t size_;
+
+        //Runs of consecutive addresses in read order
+        std::vector<MemoryController::AddressRange> ranges_;
+    };
+
+}//namespace_mygbc
+
+#endif
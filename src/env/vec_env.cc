@@ -0,0 +1,85 @@
+#include "vec_env.h" //VecEnv
+
+namespace mygbc{
+
+    /// @brief Creates the instances and loads the ROM to each of them.
+    /// @param binary ROM to run.
+    /// @param config Configuration of the environment.
+    VecEnv::VecEnv(GBCBinary& binary, const VecEnvConfig& config)
+    :config_(config), observation_watch_(config.observation_addresses), step_statuses_(config.instance_count, Status::ok_status()), init_status_(Status::ok_status()),
+    worker_pool_(config.thread_count), step_actions_(nullptr), step_observations_(nullptr), step_dones_(nullptr){
+        instances_.reserve(config_.instance_count);
+        for(std::size_t index = 0; index < config_.instance_count; ++index){
+            instances_.push_back(std::make_unique<GBC>());
+            instances_.back()->set_input_recording(false);
+            Status load_status = instances_.back()->get_memory().load_rom(binary);
+            if(!load_status.ok() && init_status_.ok()){
+                init_status_ = load_status;
+            }
+        }
+    }
+
+    /// @brief Returns the status of the ROM loading.
+    /// @return Status of the construction.
+    const Status& VecEnv::get_init_status() const noexcept{
+        return init_status_;
+    }
+
+    /// @brief Runs every instance for the configured frames.
+    /// @details Instances that fail keep their state and report done.
+    /// @param actions Pressed joypad buttons per instance, see MemoryController::set_joypad_state.
+    /// @param observations Observations of the instances, instance_count * get_observation_size() bytes.
+    /// @param dones Done flags per instance, 1 when done.
+    /// @return Status of the first failed instance or ok.
+    Status VecEnv::step(const uint8_t* actions, uint8_t* observations, uint8_t* dones){
+        step_actions_ = actions;
+        step_observations_ = observations;
+        step_dones_ = dones;
+        worker_pool_.run(instances_.size(), &VecEnv::step_instance, this);
+        for(const Status& step_status : step_statuses_){
+            if(!step_status.ok()){
+                return step_status;
+            }
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of instances.
+    /// @return Number of instances.
+    std::size_t VecEnv::get_instance_count() const noexcept{
+        return instances_.size();
+    }
+
+    /// @brief Returns the size of the observation of an instance.
+    /// @return Observation bytes per instance.
+    std::size_t VecEnv::get_observation_size() const noexcept{
+        return observation_watch_.get_size();
+    }
+
+    /// @brief Grants access to an instance.
+    /// @param index Index of the instance.
+    /// @return Instance.
+    GBC& VecEnv::get_instance(const std::size_t index){
+        return *instances_[index];
+    }
+
+    /// @brief Steps a single instance, run by the worker pool.
+    /// @param context The environment.
+    /// @param index Index of the instance.
+    void VecEnv::step_instance(void* context, const std::size_t index){
+        VecEnv& env = *static_cast<VecEnv*>(context);
+        GBC& gbc = *env.instances_[index];
+        Status& step_status = env.step_statuses_[index];
+        step_status = Status::ok_status();
+        if(gbc.get_memory().get_joypad_state() != env.step_actions_[index]){
+            gbc.set_joypad_state(env.step_actions_[index]);
+        }
+        for(uint32_t frame = 0; frame < env.config_.frames_per_step && step_status.ok(); ++frame){
+            step_status = gbc.run_frame();
+        }
+        env.observation_watch_.read_strided(gbc.get_memory(), env.step_observations_, env.observation_watch_.get_size(), index);
+        const bool done = !step_status.ok() || (env.config_.done_condition && env.config_.done_condition(gbc));
+        env.step_dones_[index] = done ? 1 : 0;
+    }
+
+}//namespace_mygbc
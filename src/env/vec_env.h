@@ -0,0 +1,106 @@
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include <functional> //std::function
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../memory/gbc_binary.h" //GBCBinary
+#include "../util/status/status.h" //Status
+#include "../util/thread/worker_pool.h" //WorkerPool
+#include "ram_watch.h" //RamWatch
+
+namespace mygbc{
+
+    /// @brief Configuration of a VecEnv.
+    struct VecEnvConfig{
+        //Number of emulated instances
+        std::size_t instance_count = 1;
+
+        //Frames run by each instance per step
+        uint32_t frames_per_step = 1;
+
+        //Threads stepping the instances including the calling thread, 0 uses the hardware concurrency
+        std::size_t thread_count = 0;
+
+        //Addresses written to the observations of each instance in this order, read through a RamWatch
+        std::vector<uint16_t> observation_addresses;
+
+        //Ends the episode of the instance after a step, nullptr never ends it
+        //Called from the stepping threads, once per instance per step
+        std::function<bool(GBC&)> done_condition;
+    };
+
+    /// @brief Steps a batch of GBC instances running the same ROM, as in vectorized reinforcement learning environments.
+    /// @details Each step applies one joypad action per instance, runs every instance for the configured frames on
+    ///         a worker pool and writes the observations and done flags to caller provided arrays.
+    ///         Steps do not allocate. Inputs are not recorded for replay.
+    class VecEnv{
+        public:
+
+        /// @brief Creates the instances and loads the ROM to each of them.
+        /// @param binary ROM to run.
+        /// @param config Configuration of the environment.
+        VecEnv(GBCBinary& binary, const VecEnvConfig& config);
+
+        /// @brief Returns the status of the ROM loading.
+        /// @return Status of the construction.
+        const Status& get_init_status() const noexcept;
+
+        /// @brief Runs every instance for the configured frames.
+        /// @details Instances that fail keep their state and report done.
+        /// @param actions Pressed joypad buttons per instance, see MemoryController::set_joypad_state.
+        /// @param observations Observations of the instances, instance_count * get_observation_size() bytes.
+        /// @param dones Done flags per instance, 1 when done.
+        /// @return Status of the first failed instance or ok.
+        Status step(const uint8_t* actions, uint8_t* observations, uint8_t* dones);
+
+        /// @brief Returns the number of instances.
+        /// @return Number of instances.
+        std::size_t get_instance_count() const noexcept;
+
+        /// @brief Returns the size of the observation of an instance.
+        /// @return Observation bytes per instance.
+        std::size_t get_observation_size() const noexcept;
+
+        /// @brief Grants access to an instance.
+        /// @param index Index of the instance.
+        /// @return Instance.
+        GBC& get_instance(const std::size_t index);
+
+        private:
+
+        /// @brief Steps a single instance, run by the worker pool.
+        /// @param context The environment.
+        /// @param index Index of the instance.
+        static void step_instance(void* context, const std::size_t index);
+
+        //Configuration of the environment
+        const VecEnvConfig config_;
+
+        //Watch list of the observation addresses
+        const RamWatch observation_watch_;
+
+        //Instances, GBC is not movable
+        std::vector<std::unique_ptr<GBC>> instances_;
+
+        //Status of each instance after the last step
+        std::vector<Status> step_statuses_;
+
+        //Status of the ROM loading
+        Status init_status_;
+
+        //Threads stepping the instances
+        WorkerPool worker_pool_;
+
+        //Arrays of the current step
+        const uint8_t* step_actions_;
+        uint8_t* step_observations_;
+        uint8_t* step_dones_;
+    };
+
+}//namespace_mygbc
+
+#endif
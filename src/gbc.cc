@@ -1,25 +1,379 @@
+#include <algorithm> //std::min, std::find
+#include <chrono> //std::chrono::steady_clock
+#include <limits> //std::numeric_limits
+#include <utility> //std::move
+#include "util/io/log_message.h" //LOG
+#include "profile/trace_events.h" //MYGBC_TRACE_SPAN
 #include "gbc.h"//GBC
 
 namespace mygbc{
 
+    /// @brief Initializes stopped GBC.
+    /// @details Registers the dirty page consumer used by the snapshots.
+    GBC::GBC()
+    :cycle_count_(0), record_inputs_(true), next_input_index_(0), next_input_cycle_(std::numeric_limits<uint64_t>::max()),
+    metrics_dump_interval_(0), control_queue_(control_queue_capacity), frame_pacer_(nullptr), run_status_(Status::ok_status()), runner_exited_(false){
+        snapshot_consumer_id_ = register_dirty_page_consumer();
+    }
+
+    /// @brief Stops the GBC thread if it runs.
+    GBC::~GBC(){
+        stop();
+    }
+
     /// @brief Inits the gbc internals.
     /// @return 
     Status GBC::init(){
-        run_flag_.store(true);
+        return Status::ok_status();
     }
 
+    /// @brief Starts executing the GBC in its own thread.
+    /// @details Runs main_loop on a std::jthread. Commands queued while the GBC was not running are dropped.
+    ///         Does nothing if the thread already runs. Do not access the GBC from other threads while it runs,
+    ///         except through post_command and get_metrics.
+    void GBC::run(){
+        if(runner_.joinable()){
+            return;
+        }
+        ControlCommand stale_command;
+        while(control_queue_.pop(stale_command)){
+        }
+        runner_exited_.store(false, std::memory_order_relaxed);
+        runner_ = std::jthread([this](){
+            run_status_ = main_loop();
+            runner_exited_.store(true, std::memory_order_release);
+        });
+    }
+
+    /// @brief Stops the execution of the GBC
+    /// @details Queues a stop command and waits for the thread, which exits at the next frame boundary.
+    ///         A thread that already exited on an error is joined without queuing. Does nothing if the thread does not run.
+    void GBC::stop(){
+        if(!runner_.joinable()){
+            return;
+        }
+        while(!runner_exited_.load(std::memory_order_acquire) && !post_command(ControlCommand{ControlCommandType::STOP})){
+            //The main loop drains the queue at its next frame boundary
+            std::this_thread::yield();
+        }
+        runner_.join();
+    }
 
     /// @brief Runs the main loop of the GBC.
+    /// @details Runs whole frames until a stop command. The control commands are drained at frame boundaries,
+    ///         so the instruction loop checks nothing but the cycle count. Paused GBCs block until the next command.
     /// @return Exit status of the GBC.
     Status GBC::main_loop(){
-        StatusOr<uint8_t> instruction_emulation;
-        while(run_flag_.load()){
-            instruction_emulation = processing_unit.fetch_decode_execute(memory_controller_);
-            if(instruction_emulation.ok()){
+        bool paused = false;
+        while(true){
+            ControlCommand command;
+            while(control_queue_.pop(command)){
+                if(apply_control_command(command, paused)){
+                    return Status::ok_status();
+                }
+            }
+            if(paused){
+                control_queue_.wait();
+                continue;
+            }
+            Status frame_status = run_frame();
+            if(!frame_status.ok()){
+                return frame_status;
+            }
+            if(frame_pacer_ != nullptr){
+                frame_pacer_->wait_for_next_frame();
+            }
+        }
+    }
+
+    /// @brief Queues a command for the main loop, applied at its next frame boundary.
+    /// @details Lock-free, safe to call from any thread.
+    /// @param command Command to queue.
+    /// @return Was the command queued? False when control_queue_capacity commands are pending.
+    bool GBC::post_command(const ControlCommand& command) noexcept{
+        return control_queue_.push(command);
+    }
+
+    /// @brief Sets the receiver of the snapshots taken by snapshot commands.
+    /// @details Called on the thread of the main loop. Do not call while the GBC runs.
+    /// @param callback Receiver of the snapshots, nullptr drops them.
+    void GBC::set_snapshot_callback(std::function<void(GBCSnapshot&&)> callback){
+        snapshot_callback_ = std::move(callback);
+    }
+
+    /// @brief Paces the frames of the main loop to the host clock.
+    /// @details The main loop waits on the pacer after each frame and restarts its schedule when resumed.
+    ///         Do not call while the GBC runs.
+    /// @param pacer Pacer to wait on, nullptr runs unpaced. Must outlive its use by the GBC.
+    void GBC::set_frame_pacer(FramePacer* pacer) noexcept{
+        frame_pacer_ = pacer;
+    }
+
+    /// @brief Returns the exit status of the last run started by run().
+    /// @details Valid after stop().
+    /// @return Exit status of the main loop.
+    const Status& GBC::get_run_status() const noexcept{
+        return run_status_;
+    }
+
+    /// @brief Applies a control command at a frame boundary.
+    /// @param command Command to apply.
+    /// @param paused Is the main loop paused? Updated by pause and resume commands.
+    /// @return Was it a stop command?
+    bool GBC::apply_control_command(const ControlCommand& command, bool& paused){
+        switch(command.type){
+            case ControlCommandType::SET_JOYPAD:
+                set_joypad_state(command.buttons);
+                break;
+            case ControlCommandType::PAUSE:
+                paused = true;
+                break;
+            case ControlCommandType::RESUME:
+                if(paused && frame_pacer_ != nullptr){
+                    //Time spent paused must not be caught up
+                    frame_pacer_->reset();
+                }
+                paused = false;
+                break;
+            case ControlCommandType::SNAPSHOT:
+                if(snapshot_callback_){
+                    snapshot_callback_(save_snapshot());
+                }
+                break;
+            case ControlCommandType::STOP:
+                return true;
+        }
+        return false;
+    }
+
+    /// @brief Executes instructions until the next frame boundary.
+    /// @return Status of the execution.
+    Status GBC::run_frame(){
+        MYGBC_TRACE_SPAN("frame");
+        const std::chrono::steady_clock::time_point frame_start = std::chrono::steady_clock::now();
+        Status frame_status = run_until_cycle((get_frame_count() + 1) * cycles_per_frame);
+        metrics_.record_frame(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frame_start).count()
+        ));
+        if(metrics_dump_interval_ != 0 && get_frame_count() % metrics_dump_interval_ == 0){
+            MetricsSnapshot metrics = get_metrics();
+            MetricsSnapshot interval_metrics = metrics;
+            interval_metrics -= last_metrics_dump_;
+            last_metrics_dump_ = metrics;
+            if(metrics_dump_callback_){
+                metrics_dump_callback_(interval_metrics);
+            }
+            else{
+                LOG(INFO) << "GBC metrics: " << interval_metrics.to_string();
+            }
+        }
+        return frame_status;
+    }
+
+    /// @brief Executes instructions until the cycle count reaches the target.
+    /// @details Stops at the first instruction boundary at or after the target cycle.
+    /// @param target_cycle T-cycle to run to.
+    /// @return Status of the execution.
+    Status GBC::run_until_cycle(const uint64_t target_cycle){
+        MYGBC_TRACE_SPAN("cpu_run");
+        const std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
+        Status run_status = Status::ok_status();
+        while(cycle_count_ < target_cycle){
+            run_status = step();
+            if(!run_status.ok()){
+                break;
+            }
+        }
+        metrics_.record_run_time(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - run_start).count()
+        ));
+        return run_status;
+    }
+
+    /// @brief Executes instructions for the given cycles, the quantum of cooperative schedulers.
+    /// @details Stops at the first instruction boundary at or after the current cycle count plus the cycles.
+    /// @param cycles T-cycles to run.
+    /// @return Status of the execution.
+    Status GBC::run_for(const uint64_t cycles){
+        return run_until_cycle(cycle_count_ + cycles);
+    }
+
+    /// @brief Executes instructions until the end of the segment or a per instruction condition is met.
+    /// @details The checks are template parameters, the loop of a run without them only steps.
+    /// @param conditions Conditions to stop at.
+    /// @param segment_end T-cycle at which the segment ends.
+    /// @param stop_reason Set when the segment stopped early.
+    /// @return Did the segment stop early?
+    template<bool check_pc, bool check_memory>
+    bool GBC::run_segment(const RunConditions& conditions, const uint64_t segment_end, StatusOr<RunStopReason>& stop_reason){
+        while(cycle_count_ < segment_end){
+            Status step_status = step();
+            if(!step_status.ok()){
+                stop_reason = step_status;
+                return true;
+            }
+            if constexpr(check_pc){
+                if(conditions.is_pc_breakpoint(processing_unit.get_register_file().pc.get_word())){
+                    stop_reason = RunStopReason::PC_HIT;
+                    return true;
+                }
+            }
+            if constexpr(check_memory){
+                //Set by the write path of the memory controller, only for the watched addresses
+                if(memory_controller_.has_watched_writes() && conditions.memory_condition_met(memory_controller_, memory_controller_.take_watched_writes())){
+                    stop_reason = RunStopReason::MEMORY_MATCH;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
 
+    /// @brief Executes instructions until a condition is met or the cycle budget is used up.
+    /// @details Stops at the first instruction boundary where a condition is met. Frame conditions are checked at
+    ///         the frame boundaries crossed by the run, before the budget. The loop is picked once per run from
+    ///         variants compiled with only the per instruction checks of the registered kinds of conditions.
+    /// @param conditions Conditions to stop at.
+    /// @param max_cycles Budget of T-cycles, stops at the first instruction boundary at or after it.
+    /// @return Why the run stopped or the error status of the execution.
+    StatusOr<RunStopReason> GBC::run_until(const RunConditions& conditions, const uint64_t max_cycles){
+        MYGBC_TRACE_SPAN("cpu_run");
+        const std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
+        const uint64_t target_cycle = cycle_count_ + max_cycles;
+        const bool check_pc = conditions.has_pc_breakpoints();
+        const bool check_memory = conditions.has_memory_conditions();
+        const bool check_frames = conditions.stops_at_frame_end() || conditions.get_frame_predicate();
+        using SegmentRunner = bool (GBC::*)(const RunConditions&, const uint64_t, StatusOr<RunStopReason>&);
+        static constexpr SegmentRunner segment_runners[4] = {
+            &GBC::run_segment<false, false>, &GBC::run_segment<true, false>, &GBC::run_segment<false, true>, &GBC::run_segment<true, true>
+        };
+        const SegmentRunner run_checked_segment = segment_runners[(check_pc ? 1 : 0) | (check_memory ? 2 : 0)];
+        if(check_memory){
+            //Only writes made by this run may trigger the memory conditions
+            memory_controller_.set_write_watch(&conditions.get_watched_addresses());
+        }
+        StatusOr<RunStopReason> stop_reason = RunStopReason::CYCLE_BUDGET;
+        bool stopped = false;
+        while(!stopped && cycle_count_ < target_cycle){
+            //Frame conditions split the run into segments ending at the frame boundaries
+            const uint64_t frame_end = (get_frame_count() + 1) * cycles_per_frame;
+            const uint64_t segment_end = check_frames ? std::min(target_cycle, frame_end) : target_cycle;
+            stopped = (this->*run_checked_segment)(conditions, segment_end, stop_reason);
+            if(!stopped && check_frames && cycle_count_ >= frame_end){
+                if(conditions.stops_at_frame_end()){
+                    stop_reason = RunStopReason::FRAME_END;
+                    stopped = true;
+                }
+                else if(conditions.get_frame_predicate()(*this)){
+                    stop_reason = RunStopReason::FRAME_PREDICATE;
+                    stopped = true;
+                }
             }
-            return instruction_emulation.status();
         }
+        if(check_memory){
+            memory_controller_.set_write_watch(nullptr);
+        }
+        metrics_.record_run_time(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - run_start).count()
+        ));
+        return stop_reason;
+    }
+
+    /// @brief Sets the pressed joypad buttons at the current cycle and records them for replay.
+    /// @details Recorded inputs after the current cycle are dropped as the timeline diverges, the input divergence
+    ///         listeners are notified with the current cycle.
+    /// @param buttons Pressed buttons, see MemoryController::set_joypad_state.
+    void GBC::set_joypad_state(const uint8_t buttons){
+        if(record_inputs_){
+            input_log_.record(cycle_count_, buttons);
+        }
+        memory_controller_.set_joypad_state(buttons);
+        next_input_index_ = input_log_.get_events().size();
+        next_input_cycle_ = std::numeric_limits<uint64_t>::max();
+        notify_input_divergence(cycle_count_);
+    }
+
+    /// @brief Adds a listener notified when the input history diverges at a cycle.
+    /// @details States captured after the cycle belong to an abandoned timeline once notified.
+    /// @param listener Receives the cycle from which on the inputs changed.
+    /// @return Id of the listener, its slot may be reused once removed.
+    std::size_t GBC::add_input_divergence_listener(std::function<void(uint64_t)> listener){
+        for(std::size_t listener_id = 0; listener_id < input_divergence_listeners_.size(); ++listener_id){
+            if(!input_divergence_listeners_[listener_id]){
+                input_divergence_listeners_[listener_id] = std::move(listener);
+                return listener_id;
+            }
+        }
+        input_divergence_listeners_.push_back(std::move(listener));
+        return input_divergence_listeners_.size() - 1;
+    }
+
+    /// @brief Removes an input divergence listener.
+    /// @details Call from the destructor of the owner of the id.
+    /// @param listener_id Id returned by add_input_divergence_listener.
+    void GBC::remove_input_divergence_listener(const std::size_t listener_id){
+        if(listener_id < input_divergence_listeners_.size()){
+            input_divergence_listeners_[listener_id] = nullptr;
+        }
+    }
+
+    /// @brief Enables or disables recording the joypad inputs for replay.
+    /// @details Recording is enabled by default. Disabled recording keeps set_joypad_state free of allocations
+    ///         for callers that never rewind, inputs set while disabled are not replayed.
+    /// @param enabled Record the inputs?
+    void GBC::set_input_recording(const bool enabled) noexcept{
+        record_inputs_ = enabled;
+    }
+
+    /// @brief Returns the inputs recorded for replay.
+    /// @return Recorded inputs.
+    const InputLog& GBC::get_input_log() const noexcept{
+        return input_log_;
+    }
+
+    /// @brief Executes a single instruction and advances the cycle count.
+    /// @return Status of the execution.
+    Status GBC::step(){
+        if(cycle_count_ >= next_input_cycle_){
+            apply_recorded_inputs();
+        }
+        StatusOr<uint8_t> instruction_emulation = processing_unit.fetch_decode_execute(memory_controller_);
+        if(instruction_emulation.ok()){
+            cycle_count_ += instruction_emulation.value();
+            metrics_.record_instruction(instruction_emulation.value());
+        }
+        return instruction_emulation.status();
+    }
+
+    /// @brief Returns the cycle of the next recorded input to replay.
+    /// @details Instructions executed outside of the GBC must stop before this cycle.
+    /// @return T-cycle of the next input or UINT64_MAX when there is none.
+    uint64_t GBC::get_next_input_cycle() const noexcept{
+        return next_input_cycle_;
+    }
+
+    /// @brief Applies instructions executed outside of the GBC, such as by a lockstep engine.
+    /// @details Sets the registers and the cycle count and counts the instructions in the metrics. The instructions
+    ///         must not have crossed get_next_input_cycle.
+    /// @param register_words Register words in the order of GBCSnapshot::register_words.
+    /// @param cycle_count T-cycles executed since power on after the instructions.
+    /// @param instruction_count Executed instructions.
+    void GBC::commit_external_execution(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const uint64_t instruction_count){
+        processing_unit.get_register_file().set_register_words(register_words);
+        metrics_.record_instructions(instruction_count, cycle_count - cycle_count_);
+        cycle_count_ = cycle_count;
+    }
+
+    /// @brief Returns the T-cycles executed since power on.
+    /// @return Executed T-cycles.
+    uint64_t GBC::get_cycle_count() const noexcept{
+        return cycle_count_;
+    }
+
+    /// @brief Returns the frames completed since power on.
+    /// @return Completed frames.
+    uint64_t GBC::get_frame_count() const noexcept{
+        return cycle_count_ / cycles_per_frame;
     }
 
     /// @brief Grants access to the processing unit and its internals.
@@ -33,5 +387,221 @@ namespace mygbc{
     MemoryController& GBC::get_memory(){
         return memory_controller_;
     }
-}
 
+    /// @brief Captures the whole state of the GBC.
+    /// @details Following incremental snapshots are taken relative to this snapshot.
+    /// @return Full snapshot.
+    GBCSnapshot GBC::save_snapshot(){
+        PageBitmap all_pages;
+        all_pages.set_all();
+        return capture_snapshot(all_pages, false);
+    }
+
+    /// @brief Captures the state of the GBC relative to the previous snapshot.
+    /// @details Only the pages written to since the previous snapshot are stored.
+    /// @return Incremental snapshot.
+    GBCSnapshot GBC::save_incremental_snapshot(){
+        collect_dirty_pages();
+        return capture_snapshot(dirty_page_consumers_[snapshot_consumer_id_], true);
+    }
+
+    /// @brief Restores the state stored in the snapshot.
+    /// @details Incremental snapshots must be restored in order on top of the snapshot they were taken relative to.
+    /// @param snapshot Snapshot to restore.
+    /// @return Status of the restore.
+    Status GBC::restore_snapshot(const GBCSnapshot& snapshot){
+        if(snapshot.page_data.size() != snapshot.stored_pages.count() * PageBitmap::page_size){
+            return Status::invalid_input_error(
+                "Snapshot page data does not match the stored pages! (Bytes: " +
+                std::to_string(snapshot.page_data.size()) + "/ Pages: " + std::to_string(snapshot.stored_pages.count()) + ")."
+            );
+        }
+        restore_state(snapshot.register_words, snapshot.cycle_count, snapshot.stored_pages, snapshot.page_data.data());
+        return Status::ok_status();
+    }
+
+    /// @brief Restores the registers and the given pages.
+    /// @details Used to restore states stored outside of a GBCSnapshot, such as mapped archives.
+    /// @param register_words Register words in the order of GBCSnapshot::register_words.
+    /// @param cycle_count T-cycles executed since power on.
+    /// @param stored_pages Pages stored in the page data.
+    /// @param page_data Contents of the stored pages in ascending page order.
+    void GBC::restore_state(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const PageBitmap& stored_pages, const uint8_t* page_data){
+        MYGBC_TRACE_SPAN("snapshot_restore");
+        processing_unit.get_register_file().set_register_words(register_words);
+        cycle_count_ = cycle_count;
+        const uint8_t* page_source = page_data;
+        for(std::size_t page = stored_pages.find_next(0); page < PageBitmap::page_count; page = stored_pages.find_next(page + 1)){
+            memory_controller_.write_page(static_cast<uint8_t>(page), page_source);
+            page_source += PageBitmap::page_size;
+        }
+        sync_recorded_inputs();
+        //State now matches the snapshot
+        collect_dirty_pages();
+        dirty_page_consumers_[snapshot_consumer_id_].clear();
+    }
+
+    /// @brief Restores the registers and the given pages from an image of the whole address space.
+    /// @details Pages outside the set keep their contents, so restoring only the pages that differ from the image is enough.
+    /// @param register_words Register words in the order of GBCSnapshot::register_words.
+    /// @param cycle_count T-cycles executed since power on.
+    /// @param pages Pages to restore.
+    /// @param address_space Image of MemoryController::address_space_size bytes.
+    void GBC::restore_state_from_image(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const PageBitmap& pages, const uint8_t* address_space){
+        MYGBC_TRACE_SPAN("snapshot_restore");
+        processing_unit.get_register_file().set_register_words(register_words);
+        cycle_count_ = cycle_count;
+        for(std::size_t page = pages.find_next(0); page < PageBitmap::page_count; page = pages.find_next(page + 1)){
+            memory_controller_.write_page(static_cast<uint8_t>(page), address_space + (page * PageBitmap::page_size));
+        }
+        sync_recorded_inputs();
+        //Restored pages are not relative to the previous snapshot
+        collect_dirty_pages();
+    }
+
+    /// @brief Captures the registers and the given pages.
+    /// @param pages Pages to store.
+    /// @param incremental Is the snapshot relative to the previous snapshot?
+    /// @return Snapshot of the state.
+    GBCSnapshot GBC::capture_snapshot(const PageBitmap& pages, const bool incremental){
+        MYGBC_TRACE_SPAN("snapshot_save");
+        GBCSnapshot snapshot;
+        snapshot.register_words = processing_unit.get_register_file().get_register_words();
+        snapshot.cycle_count = cycle_count_;
+        snapshot.incremental = incremental;
+        snapshot.stored_pages = pages;
+        snapshot.page_data.resize(pages.count() * PageBitmap::page_size);
+        uint8_t* page_destination = snapshot.page_data.data();
+        for(std::size_t page = pages.find_next(0); page < PageBitmap::page_count; page = pages.find_next(page + 1)){
+            memory_controller_.read_page(static_cast<uint8_t>(page), page_destination);
+            page_destination += PageBitmap::page_size;
+        }
+        collect_dirty_pages();
+        dirty_page_consumers_[snapshot_consumer_id_].clear();
+        return snapshot;
+    }
+
+    /// @brief Returns the execution metrics and the memory accesses since power on or the last reset.
+    /// @details Safe to call from any thread while the GBC runs. Host time is only measured, it never feeds the emulation.
+    /// @return Metrics of this GBC.
+    MetricsSnapshot GBC::get_metrics() const noexcept{
+        MetricsSnapshot metrics;
+        metrics_.add_to(metrics);
+        memory_controller_.get_access_counters().add_to(metrics);
+        return metrics;
+    }
+
+    /// @brief Zeroes the metrics. Call from the thread running the GBC.
+    void GBC::reset_metrics() noexcept{
+        metrics_.reset();
+        memory_controller_.reset_access_counters();
+        last_metrics_dump_ = MetricsSnapshot();
+    }
+
+    /// @brief Reports the metrics every given number of frames.
+    /// @details Each report covers the frames since the previous report.
+    /// @param interval_frames Frames between reports, 0 disables the reports.
+    /// @param callback Receiver of the reports, nullptr logs them with the Logger.
+    void GBC::set_metrics_dump(const uint64_t interval_frames, std::function<void(const MetricsSnapshot&)> callback){
+        metrics_dump_interval_ = interval_frames;
+        metrics_dump_callback_ = std::move(callback);
+        last_metrics_dump_ = get_metrics();
+    }
+
+    /// @brief Returns the memory used by this GBC broken down by component.
+    /// @details Components are reported with their own size and the heap memory they own, the remaining
+    ///         members of the GBC are reported as gbc_state. The total is the size of the GBC plus its heap memory.
+    ///         Attached trace recorders and profilers are included, snapshot stores and rewind buffers report their own usage.
+    ///         Call from the thread running the GBC.
+    /// @return Memory footprint of this GBC.
+    MemoryFootprint GBC::get_memory_footprint() const{
+        MemoryFootprint footprint;
+        processing_unit.add_memory_footprint(footprint);
+        footprint.add("memory_controller", sizeof(memory_controller_) + memory_controller_.get_memory_usage());
+        footprint.add("dirty_pages", MemoryFootprint::get_vector_usage(dirty_page_consumers_) +
+            MemoryFootprint::get_vector_usage(active_dirty_page_consumers_) + MemoryFootprint::get_vector_usage(free_dirty_page_consumers_));
+        footprint.add("input_log", sizeof(input_log_) + input_log_.get_memory_usage());
+        footprint.add("metrics", sizeof(metrics_) + sizeof(last_metrics_dump_));
+        footprint.add("control_queue", sizeof(control_queue_) + control_queue_.get_memory_usage());
+        const std::size_t component_bytes = sizeof(memory_controller_) + sizeof(LR35902RegisterFile) + sizeof(InstructionSetLR35902) +
+            sizeof(InstructionExecutorLR35902) + sizeof(input_log_) + sizeof(metrics_) + sizeof(last_metrics_dump_) + sizeof(control_queue_);
+        footprint.add("gbc_state", sizeof(GBC) - component_bytes);
+        return footprint;
+    }
+
+    /// @brief Registers a new consumer of the dirty pages.
+    /// @details Each consumer sees every page written to since it last took its pages.
+    /// @return Id of the consumer.
+    std::size_t GBC::register_dirty_page_consumer(){
+        collect_dirty_pages();
+        std::size_t consumer_id = dirty_page_consumers_.size();
+        if(!free_dirty_page_consumers_.empty()){
+            consumer_id = free_dirty_page_consumers_.back();
+            free_dirty_page_consumers_.pop_back();
+            dirty_page_consumers_[consumer_id].clear();
+        }
+        else{
+            dirty_page_consumers_.emplace_back();
+        }
+        active_dirty_page_consumers_.push_back(consumer_id);
+        return consumer_id;
+    }
+
+    /// @brief Unregisters a consumer of the dirty pages, its id may be reused by the next registration.
+    /// @details Call from the destructor of the owner of the id.
+    /// @param consumer_id Id returned by register_dirty_page_consumer.
+    void GBC::unregister_dirty_page_consumer(const std::size_t consumer_id){
+        const std::vector<std::size_t>::iterator active = std::find(active_dirty_page_consumers_.begin(), active_dirty_page_consumers_.end(), consumer_id);
+        if(active == active_dirty_page_consumers_.end()){
+            return;
+        }
+        active_dirty_page_consumers_.erase(active);
+        free_dirty_page_consumers_.push_back(consumer_id);
+    }
+
+    /// @brief Returns the pages written to since the consumer last took them and clears them.
+    /// @param consumer_id Id returned by register_dirty_page_consumer.
+    /// @return Pages written to since the consumer last took them.
+    PageBitmap GBC::take_dirty_pages(const std::size_t consumer_id) noexcept{
+        collect_dirty_pages();
+        PageBitmap dirty_pages = dirty_page_consumers_[consumer_id];
+        dirty_page_consumers_[consumer_id].clear();
+        return dirty_pages;
+    }
+
+    /// @brief Moves the dirty pages of the memory controller to the consumers.
+    void GBC::collect_dirty_pages() noexcept{
+        const PageBitmap dirty_pages = memory_controller_.take_dirty_pages();
+        for(const std::size_t consumer_id : active_dirty_page_consumers_){
+            dirty_page_consumers_[consumer_id] |= dirty_pages;
+        }
+    }
+
+    /// @brief Applies the recorded inputs due at the current cycle.
+    void GBC::apply_recorded_inputs() noexcept{
+        const std::vector<InputEvent>& events = input_log_.get_events();
+        while(next_input_index_ < events.size() && events[next_input_index_].cycle <= cycle_count_){
+            memory_controller_.set_joypad_state(events[next_input_index_].buttons);
+            ++next_input_index_;
+        }
+        next_input_cycle_ = next_input_index_ < events.size() ? events[next_input_index_].cycle : std::numeric_limits<uint64_t>::max();
+    }
+
+    /// @brief Notifies the input divergence listeners.
+    /// @param cycle T-cycle from which on the inputs changed.
+    void GBC::notify_input_divergence(const uint64_t cycle){
+        for(const std::function<void(uint64_t)>& listener : input_divergence_listeners_){
+            if(listener){
+                listener(cycle);
+            }
+        }
+    }
+
+    /// @brief Points the input replay at the first input after the current cycle.
+    void GBC::sync_recorded_inputs() noexcept{
+        memory_controller_.set_joypad_state(input_log_.get_buttons_at(cycle_count_));
+        next_input_index_ = input_log_.find_next(cycle_count_);
+        const std::vector<InputEvent>& events = input_log_.get_events();
+        next_input_cycle_ = next_input_index_ < events.size() ? events[next_input_index_].cycle : std::numeric_limits<uint64_t>::max();
+    }
+}
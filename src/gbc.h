@@ -1,31 +1,161 @@
 #ifndef GBC_H
 #define GBC_H
 
-#include <atomic>
+#include <array> //std::array
+#include <atomic> //std::atomic
+#include <vector> //std::vector
+#include <cstddef> //std::size_t
+#include <functional> //std::function
+#include <thread> //std::jthread
 #include "components/memory_controller.h" //MemoryController
 #include "components/lr35902.h" //LR35902
+#include "control/control_queue.h" //ControlQueue
+#include "control/frame_pacer.h" //FramePacer
+#include "control/run_conditions.h" //RunConditions
+#include "memory/page_bitmap.h" //PageBitmap
+#include "snapshot/gbc_snapshot.h" //GBCSnapshot
+#include "snapshot/input_log.h" //InputLog
+#include "profile/emulation_metrics.h" //EmulationMetrics
+#include "profile/memory_footprint.h" //MemoryFootprint
 
 namespace mygbc{
 
     /// @brief Executes the functions of a GBC.
+    /// @details Execution is deterministic: the state only depends on the starting state and the recorded inputs.
+    ///         Host time must never feed the emulation.
     class GBC{
         
         public:
 
+        //T-cycles in a single frame (154 lines of 456 cycles)
+        static constexpr uint32_t cycles_per_frame = 70224;
+
+        //Commands that can be queued to a running GBC
+        static constexpr std::size_t control_queue_capacity = 64;
+
+        /// @brief Initializes stopped GBC.
+        /// @details Registers the dirty page consumer used by the snapshots.
+        GBC();
+
+        /// @brief Stops the GBC thread if it runs.
+        ~GBC();
+
         /// @brief Inits the gbc internals.
         /// @return 
         Status init();
 
         /// @brief Starts executing the GBC in its own thread.
+        /// @details Runs main_loop on a std::jthread. Commands queued while the GBC was not running are dropped.
+        ///         Does nothing if the thread already runs. Do not access the GBC from other threads while it runs,
+        ///         except through post_command and get_metrics.
         void run();
 
         /// @brief Stops the execution of the GBC
+        /// @details Queues a stop command and waits for the thread, which exits at the next frame boundary.
+        ///         A thread that already exited on an error is joined without queuing. Does nothing if the thread does not run.
         void stop();
 
         /// @brief Runs the main loop of the GBC.
+        /// @details Runs whole frames until a stop command. The control commands are drained at frame boundaries,
+        ///         so the instruction loop checks nothing but the cycle count. Paused GBCs block until the next command.
         /// @return Exit status of the GBC.
         Status main_loop();
 
+        /// @brief Queues a command for the main loop, applied at its next frame boundary.
+        /// @details Lock-free, safe to call from any thread.
+        /// @param command Command to queue.
+        /// @return Was the command queued? False when control_queue_capacity commands are pending.
+        bool post_command(const ControlCommand& command) noexcept;
+
+        /// @brief Sets the receiver of the snapshots taken by snapshot commands.
+        /// @details Called on the thread of the main loop. Do not call while the GBC runs.
+        /// @param callback Receiver of the snapshots, nullptr drops them.
+        void set_snapshot_callback(std::function<void(GBCSnapshot&&)> callback);
+
+        /// @brief Paces the frames of the main loop to the host clock.
+        /// @details The main loop waits on the pacer after each frame and restarts its schedule when resumed.
+        ///         Do not call while the GBC runs.
+        /// @param pacer Pacer to wait on, nullptr runs unpaced. Must outlive its use by the GBC.
+        void set_frame_pacer(FramePacer* pacer) noexcept;
+
+        /// @brief Returns the exit status of the last run started by run().
+        /// @details Valid after stop().
+        /// @return Exit status of the main loop.
+        const Status& get_run_status() const noexcept;
+
+        /// @brief Executes instructions until the next frame boundary.
+        /// @return Status of the execution.
+        Status run_frame();
+
+        /// @brief Executes instructions until the cycle count reaches the target.
+        /// @details Stops at the first instruction boundary at or after the target cycle.
+        /// @param target_cycle T-cycle to run to.
+        /// @return Status of the execution.
+        Status run_until_cycle(const uint64_t target_cycle);
+
+        /// @brief Executes instructions for the given cycles, the quantum of cooperative schedulers.
+        /// @details Stops at the first instruction boundary at or after the current cycle count plus the cycles.
+        /// @param cycles T-cycles to run.
+        /// @return Status of the execution.
+        Status run_for(const uint64_t cycles);
+
+        /// @brief Executes instructions until a condition is met or the cycle budget is used up.
+        /// @details Stops at the first instruction boundary where a condition is met. Frame conditions are checked at
+        ///         the frame boundaries crossed by the run, before the budget. The loop is picked once per run from
+        ///         variants compiled with only the per instruction checks of the registered kinds of conditions.
+        /// @param conditions Conditions to stop at.
+        /// @param max_cycles Budget of T-cycles, stops at the first instruction boundary at or after it.
+        /// @return Why the run stopped or the error status of the execution.
+        StatusOr<RunStopReason> run_until(const RunConditions& conditions, const uint64_t max_cycles);
+
+        /// @brief Sets the pressed joypad buttons at the current cycle and records them for replay.
+        /// @details Recorded inputs after the current cycle are dropped as the timeline diverges, the input divergence
+        ///         listeners are notified with the current cycle.
+        /// @param buttons Pressed buttons, see MemoryController::set_joypad_state.
+        void set_joypad_state(const uint8_t buttons);
+
+        /// @brief Returns the inputs recorded for replay.
+        /// @return Recorded inputs.
+        const InputLog& get_input_log() const noexcept;
+
+        /// @brief Adds a listener notified when the input history diverges at a cycle.
+        /// @details States captured after the cycle belong to an abandoned timeline once notified.
+        /// @param listener Receives the cycle from which on the inputs changed.
+        /// @return Id of the listener, its slot may be reused once removed.
+        std::size_t add_input_divergence_listener(std::function<void(uint64_t)> listener);
+
+        /// @brief Removes an input divergence listener.
+        /// @details Call from the destructor of the owner of the id.
+        /// @param listener_id Id returned by add_input_divergence_listener.
+        void remove_input_divergence_listener(const std::size_t listener_id);
+
+        /// @brief Enables or disables recording the joypad inputs for replay.
+        /// @details Recording is enabled by default. Disabled recording keeps set_joypad_state free of allocations
+        ///         for callers that never rewind, inputs set while disabled are not replayed.
+        /// @param enabled Record the inputs?
+        void set_input_recording(const bool enabled) noexcept;
+
+        /// @brief Returns the cycle of the next recorded input to replay.
+        /// @details Instructions executed outside of the GBC must stop before this cycle.
+        /// @return T-cycle of the next input or UINT64_MAX when there is none.
+        uint64_t get_next_input_cycle() const noexcept;
+
+        /// @brief Applies instructions executed outside of the GBC, such as by a lockstep engine.
+        /// @details Sets the registers and the cycle count and counts the instructions in the metrics. The instructions
+        ///         must not have crossed get_next_input_cycle.
+        /// @param register_words Register words in the order of GBCSnapshot::register_words.
+        /// @param cycle_count T-cycles executed since power on after the instructions.
+        /// @param instruction_count Executed instructions.
+        void commit_external_execution(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const uint64_t instruction_count);
+
+        /// @brief Returns the T-cycles executed since power on.
+        /// @return Executed T-cycles.
+        uint64_t get_cycle_count() const noexcept;
+
+        /// @brief Returns the frames completed since power on.
+        /// @return Completed frames.
+        uint64_t get_frame_count() const noexcept;
+
         /// @brief Grants access to the processing unit and its internals.
         /// @return Processing unit.
         LR35902& get_processing_unit();
@@ -34,15 +164,181 @@ namespace mygbc{
         /// @return Memory controller.
         MemoryController& get_memory();
 
+        /// @brief Captures the whole state of the GBC.
+        /// @details Following incremental snapshots are taken relative to this snapshot.
+        /// @return Full snapshot.
+        GBCSnapshot save_snapshot();
+
+        /// @brief Captures the state of the GBC relative to the previous snapshot.
+        /// @details Only the pages written to since the previous snapshot are stored.
+        /// @return Incremental snapshot.
+        GBCSnapshot save_incremental_snapshot();
+
+        /// @brief Restores the state stored in the snapshot.
+        /// @details Incremental snapshots must be restored in order on top of the snapshot they were taken relative to.
+        ///         Recorded inputs after the snapshot are replayed by the following execution.
+        /// @param snapshot Snapshot to restore.
+        /// @return Status of the restore.
+        Status restore_snapshot(const GBCSnapshot& snapshot);
+
+        /// @brief Restores the registers and the given pages.
+        /// @details Used to restore states stored outside of a GBCSnapshot, such as mapped archives.
+        /// @param register_words Register words in the order of GBCSnapshot::register_words.
+        /// @param cycle_count T-cycles executed since power on.
+        /// @param stored_pages Pages stored in the page data.
+        /// @param page_data Contents of the stored pages in ascending page order.
+        void restore_state(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const PageBitmap& stored_pages, const uint8_t* page_data);
+
+        /// @brief Restores the registers and the given pages from an image of the whole address space.
+        /// @details Pages outside the set keep their contents, so restoring only the pages that differ from the image is enough.
+        /// @param register_words Register words in the order of GBCSnapshot::register_words.
+        /// @param cycle_count T-cycles executed since power on.
+        /// @param pages Pages to restore.
+        /// @param address_space Image of MemoryController::address_space_size bytes.
+        void restore_state_from_image(const std::array<uint16_t, GBCSnapshot::register_count>& register_words, const uint64_t cycle_count, const PageBitmap& pages, const uint8_t* address_space);
+
+        /// @brief Returns the execution metrics and the memory accesses since power on or the last reset.
+        /// @details Safe to call from any thread while the GBC runs. Host time is only measured, it never feeds the emulation.
+        /// @return Metrics of this GBC.
+        MetricsSnapshot get_metrics() const noexcept;
+
+        /// @brief Zeroes the metrics. Call from the thread running the GBC.
+        void reset_metrics() noexcept;
+
+        /// @brief Reports the metrics every given number of frames.
+        /// @details Each report covers the frames since the previous report.
+        /// @param interval_frames Frames between reports, 0 disables the reports.
+        /// @param callback Receiver of the reports, nullptr logs them with the Logger.
+        void set_metrics_dump(const uint64_t interval_frames, std::function<void(const MetricsSnapshot&)> callback);
+
+        /// @brief Returns the memory used by this GBC broken down by component.
+        /// @details Components are reported with their own size and the heap memory they own, the remaining
+        ///         members of the GBC are reported as gbc_state. The total is the size of the GBC plus its heap memory.
+        ///         Attached trace recorders and profilers are included, snapshot stores and rewind buffers report their own usage.
+        ///         Call from the thread running the GBC.
+        /// @return Memory footprint of this GBC.
+        MemoryFootprint get_memory_footprint() const;
+
+        /// @brief Registers a new consumer of the dirty pages.
+        /// @details Each consumer sees every page written to since it last took its pages.
+        /// @return Id of the consumer.
+        std::size_t register_dirty_page_consumer();
+
+        /// @brief Unregisters a consumer of the dirty pages, its id may be reused by the next registration.
+        /// @details Call from the destructor of the owner of the id.
+        /// @param consumer_id Id returned by register_dirty_page_consumer.
+        void unregister_dirty_page_consumer(const std::size_t consumer_id);
+
+        /// @brief Returns the pages written to since the consumer last took them and clears them.
+        /// @param consumer_id Id returned by register_dirty_page_consumer.
+        /// @return Pages written to since the consumer last took them.
+        PageBitmap take_dirty_pages(const std::size_t consumer_id) noexcept;
+
         private:
 
-        std::atomic<bool> run_flag_;
+        /// @brief Executes a single instruction and advances the cycle count.
+        /// @return Status of the execution.
+        Status step();
+
+        /// @brief Executes instructions until the end of the segment or a per instruction condition is met.
+        /// @details The checks are template parameters, the loop of a run without them only steps.
+        /// @param conditions Conditions to stop at.
+        /// @param segment_end T-cycle at which the segment ends.
+        /// @param stop_reason Set when the segment stopped early.
+        /// @return Did the segment stop early?
+        template<bool check_pc, bool check_memory>
+        bool run_segment(const RunConditions& conditions, const uint64_t segment_end, StatusOr<RunStopReason>& stop_reason);
+
+        /// @brief Captures the registers and the given pages.
+        /// @param pages Pages to store.
+        /// @param incremental Is the snapshot relative to the previous snapshot?
+        /// @return Snapshot of the state.
+        GBCSnapshot capture_snapshot(const PageBitmap& pages, const bool incremental);
+
+        /// @brief Moves the dirty pages of the memory controller to the consumers.
+        void collect_dirty_pages() noexcept;
+
+        /// @brief Applies the recorded inputs due at the current cycle.
+        void apply_recorded_inputs() noexcept;
+
+        /// @brief Notifies the input divergence listeners.
+        /// @param cycle T-cycle from which on the inputs changed.
+        void notify_input_divergence(const uint64_t cycle);
+
+        /// @brief Applies a control command at a frame boundary.
+        /// @param command Command to apply.
+        /// @param paused Is the main loop paused? Updated by pause and resume commands.
+        /// @return Was it a stop command?
+        bool apply_control_command(const ControlCommand& command, bool& paused);
+
+        /// @brief Points the input replay at the first input after the current cycle.
+        void sync_recorded_inputs() noexcept;
 
         //Components of the GBC
         MemoryController memory_controller_;
         LR35902 processing_unit;
+
+        //T-cycles executed since power on
+        uint64_t cycle_count_;
+
+        //Pages written to since each consumer last took them, indexed by consumer id
+        std::vector<PageBitmap> dirty_page_consumers_;
+
+        //Ids of the registered consumers, the only ones collect_dirty_pages updates
+        std::vector<std::size_t> active_dirty_page_consumers_;
+
+        //Ids of unregistered consumers available for reuse
+        std::vector<std::size_t> free_dirty_page_consumers_;
+
+        //Consumer id of the snapshots
+        std::size_t snapshot_consumer_id_;
+
+        //Inputs recorded for replay
+        InputLog input_log_;
+
+        //Listeners notified when the input history diverges, empty slots are free
+        std::vector<std::function<void(uint64_t)>> input_divergence_listeners_;
+
+        //Are the inputs recorded?
+        bool record_inputs_;
+
+        //Index of the next recorded input to replay
+        std::size_t next_input_index_;
+
+        //Cycle of the next recorded input to replay, UINT64_MAX when there is none
+        uint64_t next_input_cycle_;
+
+        //Execution metrics, memory accesses are counted by the memory controller
+        EmulationMetrics metrics_;
+
+        //Frames between metrics reports, 0 when disabled
+        uint64_t metrics_dump_interval_;
+
+        //Receiver of the metrics reports, nullptr logs them
+        std::function<void(const MetricsSnapshot&)> metrics_dump_callback_;
+
+        //Metrics at the previous report
+        MetricsSnapshot last_metrics_dump_;
+
+        //Commands for the main loop
+        ControlQueue control_queue_;
+
+        //Receiver of the snapshot commands, nullptr drops them
+        std::function<void(GBCSnapshot&&)> snapshot_callback_;
+
+        //Paces the frames of the main loop, nullptr when unpaced
+        FramePacer* frame_pacer_;
+
+        //Exit status of the last threaded run
+        Status run_status_;
+
+        //Has the main loop of the thread returned? Nothing drains the queue after it has
+        std::atomic<bool> runner_exited_;
+
+        //Thread running the main loop, declared last so it stops before the other members are destroyed
+        std::jthread runner_;
     };
 
 }
 
-#endif
\ No newline at end of file
+#endif
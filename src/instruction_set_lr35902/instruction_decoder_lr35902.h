@@ -11,6 +11,15 @@
 
 namespace mygbc{
 
+    /// @brief Decoded instruction referencing its entry in the instruction set.
+    /// @details Decoding by reference does not copy the instruction, the read value is kept beside it.
+    struct DecodedInstructionLR35902{
+        //Entry of the instruction set, owned by the set
+        const InstructionLR35902* instruction = nullptr;
+        //Immidiate bytes following the opcode
+        uint16_t read_value = 0;
+    };
+
     /// @brief Static decoder class. Decodes bytes in stream to instructions.
     class InstructionDecoderLR35902{
         public:
@@ -42,8 +51,62 @@ namespace mygbc{
                 return instruction_fetch.status();
             }
 
+            /// @brief Tries to decode the instruction from the given address without copying it.
+            /// @details Used by the CPU on every instruction, does not allocate unless the decode fails.
+            /// @tparam T typename derived from AddressableMemory for read functions.
+            /// @param memory AddressableMemory derived container
+            /// @param address Address of the instruction
+            /// @param instruction_set Instruction set, must outlive the decoded instruction.
+            /// @return Decoded instruction or error status
+            template <typename T>
+            requires std::derived_from<T, AddressableMemory>
+            static StatusOr<DecodedInstructionLR35902> decode_reference(T& memory, const uint16_t address, const InstructionSetLR35902& instruction_set) noexcept{
+                StatusOr<uint16_t> opcode_fetch = get_opcode_from_address(memory, address);
+                if(!opcode_fetch.ok()){
+                    return opcode_fetch.status();
+                }
+                DecodedInstructionLR35902 decoded;
+                decoded.instruction = instruction_set.find_by_opcode(opcode_fetch.value());
+                if(decoded.instruction == nullptr){
+                    return Status::invalid_opcode_error(
+                        "Read value was not a valid opcode! Read value: " + std::to_string(opcode_fetch.value())
+                    );
+                }
+                if(decoded.instruction->has_read_value){
+                    //Determine the address of read by determining the size of the opcode (total size - value size)
+                    const uint16_t value_address = (address + (decoded.instruction->size_in_bytes - decoded.instruction->read_value_size_in_bytes));
+                    StatusOr<uint16_t> value_fetch = get_value_from_address(memory, value_address, decoded.instruction->read_value_size_in_bytes);
+                    if(!value_fetch.ok()){
+                        return value_fetch.status();
+                    }
+                    decoded.read_value = value_fetch.value();
+                }
+                return decoded;
+            }
+
             private:
 
+            /// @brief Fetches the opcode present at the given address.
+            /// @details Reads the second byte of 0xCB prefixed opcodes.
+            /// @tparam T typename derived from AddressableMemory for read functions.
+            /// @param memory AddressableMemory derived container.
+            /// @param address Address of the instruction.
+            /// @return Opcode or error status.
+            template<typename T>
+            requires std::derived_from<T, AddressableMemory>
+            static StatusOr<uint16_t> get_opcode_from_address(T& memory, const uint16_t address) noexcept{
+                StatusOr<uint8_t> non_prefixed_opcode_fetch = memory.get_byte(address);
+                if(!non_prefixed_opcode_fetch.ok()){
+                    return non_prefixed_opcode_fetch.status();
+                }
+                //If first byte is 0xCB, we need second byte to determine the opcode.
+                const uint8_t two_byte_opcode_prefix_ = 0xCB;
+                if(non_prefixed_opcode_fetch.value() == two_byte_opcode_prefix_){
+                    return memory.get_word(address);
+                }
+                return static_cast<uint16_t>(non_prefixed_opcode_fetch.value());
+            }
+
             /// @brief Fetches the instruction info matching to the opcode present at the given address.
             /// @details If memory fetches or opcode at the address is invalid returns error state.
             /// @tparam T typename derived from AddressableMemory for read functions.
@@ -53,23 +116,12 @@ namespace mygbc{
             template<typename T>
             requires std::derived_from<T, AddressableMemory>
             static StatusOr<InstructionLR35902> get_instruction_from_address(T& memory, const uint16_t address, const InstructionSetLR35902& instruction_set) noexcept{
-                StatusOr<uint8_t> non_prefixed_opcode_fetch = memory.get_byte(address);
-                if(non_prefixed_opcode_fetch.ok()){
-                    uint16_t opcode = static_cast<uint16_t>(non_prefixed_opcode_fetch.value());
-                    //If first byte is 0xCB, we need second byte to determine the opcode.
-                    const uint8_t two_byte_opcode_prefix_ = 0xCB;
-                    if(opcode == two_byte_opcode_prefix_){
-                        StatusOr<uint16_t> prefixed_opcode_fetch = memory.get_word(address);
-                        //If we could not read the word, return the status of the read
-                        if(!prefixed_opcode_fetch.ok()){
-                            return prefixed_opcode_fetch.status();
-                        }
-                        opcode = prefixed_opcode_fetch.value();
-                    }
+                StatusOr<uint16_t> opcode_fetch = get_opcode_from_address(memory, address);
+                if(opcode_fetch.ok()){
                     //Fetch details from the instruction set
-                    return instruction_set.get_by_opcode(opcode);
+                    return instruction_set.get_by_opcode(opcode_fetch.value());
                 }
-                return non_prefixed_opcode_fetch.status();
+                return opcode_fetch.status();
             }
 
             /// @brief Fetches the value present at the given address.
@@ -3,44 +3,80 @@
 
 namespace mygbc{
 
-    /// @brief Initializes the executor and fetches the jump table.
-    /// @details Fetches the jump table to avoid link issues.
+    /// @brief Initializes the executor on the shared jump table.
+    /// @details The shared table is built by the first executor of the process.
     InstructionExecutorLR35902::InstructionExecutorLR35902()
-    :jump_map_(std::move(get_jump_table())){
+    :jump_table_(&get_jump_table()){
     }
 
     /// @brief Executes the instruction if valid instruction. 
     /// @param instruction Instruction to execute.
+    /// @param read_value Immidiate bytes following the opcode.
     /// @param register_file Registers of the cpu.
     /// @param memory_controller Memory controller.
     /// @return Execution time in ticks or Status if can't execute. 
-    StatusOr<uint8_t> InstructionExecutorLR35902::execute_instruction(const InstructionLR35902& instruction, LR35902RegisterFile& register_file, MemoryController& memory_controller) const{
+    StatusOr<uint8_t> InstructionExecutorLR35902::execute_instruction(const InstructionLR35902& instruction, const uint16_t read_value, LR35902RegisterFile& register_file, MemoryController& memory_controller) const{
         //Check executor table
-        if(jump_map_.find(instruction.short_mnemonic) != jump_map_.end()){
-            return jump_map_.at(instruction.short_mnemonic)(instruction, register_file, memory_controller);
+        const std::size_t index = InstructionSetLR35902::get_lookup_index(instruction.opcode);
+        const ExecuteFunction executor = index < jump_table_->size() ? (*jump_table_)[index] : nullptr;
+        if(executor != nullptr){
+            return executor(instruction, read_value, register_file, memory_controller);
         }
         return Status::invalid_index_error(
             "Could not find a executor for instruction " + instruction.full_mnemonic
         );
     }
 
+    /// @brief Returns the memory used by the shared jump table.
+    /// @details Shared by every executor, so it is not part of the footprint of an instance.
+    /// @return Memory usage in bytes.
+    std::size_t InstructionExecutorLR35902::get_shared_memory_usage() noexcept{
+        return sizeof(JumpTable);
+    }
+
     /// @brief Returns a built jump table containing executor functions for instructions
     /// @details Each function is keyd by the short mnemonic of the instruction
     /// @return jump table for instruction execution functions
-    std::unordered_map<std::string, std::function<StatusOr<uint8_t>(const InstructionLR35902&, LR35902RegisterFile&, MemoryController&)>> InstructionExecutorLR35902::get_jump_table() const{
+    std::unordered_map<std::string, InstructionExecutorLR35902::ExecuteFunction> InstructionExecutorLR35902::get_mnemonic_table(){
         //Jump map for executes
-        return std::unordered_map<std::string, std::function<StatusOr<uint8_t>(const InstructionLR35902&, LR35902RegisterFile&, MemoryController&)>>{
+        return std::unordered_map<std::string, ExecuteFunction>{
             {"JP", InstructionExecutorLR35902::exec_jp}
         };
     }
 
+    /// @brief Returns the shared jump table, builds it on first use.
+    /// @details Resolves the mnemonic of every instruction in the set to its executor.
+    /// @return Shared jump table.
+    const InstructionExecutorLR35902::JumpTable& InstructionExecutorLR35902::get_jump_table(){
+        static const JumpTable jump_table = [](){
+            const std::unordered_map<std::string, ExecuteFunction> mnemonic_table = get_mnemonic_table();
+            const InstructionSetLR35902 instruction_set;
+            JumpTable built{};
+            for(std::size_t opcode = 0; opcode < 0x100; ++opcode){
+                for(const uint16_t prefix : {uint16_t{0x0000}, uint16_t{0xCB00}}){
+                    const InstructionLR35902* instruction = instruction_set.find_by_opcode(static_cast<uint16_t>(prefix | opcode));
+                    if(instruction == nullptr){
+                        continue;
+                    }
+                    const auto executor = mnemonic_table.find(instruction->short_mnemonic);
+                    if(executor != mnemonic_table.end()){
+                        built[InstructionSetLR35902::get_lookup_index(instruction->opcode)] = executor->second;
+                    }
+                }
+            }
+            return built;
+        }();
+        return jump_table;
+    }
+
     /// @brief Executor for all of the JP instructions
     /// @details Handles and executes all of the absolute jump variations
     /// @param instruction JP variation
+    /// @param read_value Jump address when the variation has a read value
     /// @param register_file CPU register file
     /// @param memory_controller Memory access
     /// @return Execution time in ticks or Status if can't execute.
-    StatusOr<uint8_t> InstructionExecutorLR35902::exec_jp(const InstructionLR35902& instruction, LR35902RegisterFile& register_file, MemoryController& memory_controller){
+    StatusOr<uint8_t> InstructionExecutorLR35902::exec_jp(const InstructionLR35902& instruction, const uint16_t read_value, LR35902RegisterFile& register_file, MemoryController& memory_controller){
         bool jump_condition_satisfied = true;
         if(instruction.execution_condition != InstructionLR35902::ExecutionCondition::NONE){
             //JP exists with Z,C,Not Z, Not C conditionals
@@ -77,7 +113,7 @@ namespace mygbc{
             //JP either uses a 16-bit read value or the register HL
             if(instruction.has_read_value){
                 //Read value jump
-                pc = instruction.read_value;
+                pc = read_value;
             }
             else if(instruction.operand_registers.size() > 0){
                 //HL jump
@@ -2,46 +2,67 @@
 #define INSTRUCTION_EXECUTOR_LR35902_H
 
 #include "instruction_lr35902.h"
+#include "instruction_set_lr35902.h" //InstructionSetLR35902
 #include "../util/status/status_or.h"
 #include "../components/lr35902_register_file.h"
 #include "../components/memory_controller.h"
+#include <array> //std::array
 #include <unordered_map> //std::unordered_map
-#include <functional> //std::function
 #include <string> //std::string
 
 namespace mygbc{
 
+    /// @brief Executes the LR35902 instructions.
+    /// @details The jump table is built once per process and shared read-only by every executor.
     class InstructionExecutorLR35902{
         public:
 
-        /// @brief Initializes the executor and fetches the jump table.
-        /// @details Fetches the jump table to avoid link issues.
+        //Executor function of an instruction
+        using ExecuteFunction = StatusOr<uint8_t>(*)(const InstructionLR35902&, const uint16_t, LR35902RegisterFile&, MemoryController&);
+
+        /// @brief Initializes the executor on the shared jump table.
+        /// @details The shared table is built by the first executor of the process.
         InstructionExecutorLR35902();
 
         /// @brief Executes the instruction if valid instruction. 
         /// @param instruction Instruction to execute.
+        /// @param read_value Immidiate bytes following the opcode.
         /// @param register_file Registers of the cpu.
         /// @param memory_controller Memory controller.
         /// @return Execution time in ticks or Status if can't execute. 
-        StatusOr<uint8_t> execute_instruction(const InstructionLR35902& instruction, LR35902RegisterFile& register_file, MemoryController& memory_controller) const;
+        StatusOr<uint8_t> execute_instruction(const InstructionLR35902& instruction, const uint16_t read_value, LR35902RegisterFile& register_file, MemoryController& memory_controller) const;
+
+        /// @brief Returns the memory used by the shared jump table.
+        /// @details Shared by every executor, so it is not part of the footprint of an instance.
+        /// @return Memory usage in bytes.
+        static std::size_t get_shared_memory_usage() noexcept;
         
         private:
 
+        //Opcode lookup index => Execute function, nullptr for instructions without an executor
+        using JumpTable = std::array<ExecuteFunction, InstructionSetLR35902::opcode_lookup_size>;
+
         /// @brief Returns a built jump table containing executor functions for instructions
         /// @details Each function is keyd by the short mnemonic of the instruction
         /// @return jump table for instruction execution functions
-        std::unordered_map<std::string, std::function<StatusOr<uint8_t>(const InstructionLR35902&, LR35902RegisterFile&, MemoryController&)>> get_jump_table() const;
+        static std::unordered_map<std::string, ExecuteFunction> get_mnemonic_table();
+
+        /// @brief Returns the shared jump table, builds it on first use.
+        /// @details Resolves the mnemonic of every instruction in the set to its executor.
+        /// @return Shared jump table.
+        static const JumpTable& get_jump_table();
 
-        //Mnemonic => Execute function jump table
-        std::unordered_map<std::string, std::function<StatusOr<uint8_t>(const InstructionLR35902&, LR35902RegisterFile&, MemoryController&)>> jump_map_;
+        //Jump table of the executor, owned by get_jump_table
+        const JumpTable* jump_table_;
 
         /// @brief Executor for all of the JP instructions
         /// @details Handles and executes all of the absolute jump variations
         /// @param instruction JP variation
+        /// @param read_value Jump address when the variation has a read value
         /// @param register_file CPU register file
         /// @param memory_controller Memory access
         /// @return Execution time in ticks or Status if can't execute.
-        static StatusOr<uint8_t> exec_jp(const InstructionLR35902& instruction, LR35902RegisterFile& register_file, MemoryController& memory_controller);
+        static StatusOr<uint8_t> exec_jp(const InstructionLR35902& instruction, const uint16_t read_value, LR35902RegisterFile& register_file, MemoryController& memory_controller);
 
 
     };
@@ -0,0 +1,51 @@
+#include <cstdio> //std::snprintf
+#include "instruction_formatter_lr35902.h" //InstructionFormatterLR35902
+#include "instruction_decoder_lr35902.h" //InstructionDecoderLR35902
+#include "../memory/addressable_memory.h" //AddressableMemory
+
+namespace mygbc{
+
+    /// @brief Formats the decoded instruction as assembly.
+    /// @details Replaces the read value marker of replace_mnenomic with the read value.
+    ///         Values are written as $hex, signed values as +/- decimal.
+    /// @param instruction Decoded instruction.
+    /// @return Assembly text of the instruction.
+    std::string InstructionFormatterLR35902::format(const InstructionLR35902& instruction){
+        if(!instruction.has_read_value){
+            return instruction.full_mnemonic;
+        }
+        char value[8];
+        if(instruction.read_value_operand_interp_hint == InstructionLR35902::OperandValueInterpHint::SIGNED){
+            std::snprintf(value, sizeof(value), "%+d", static_cast<int8_t>(instruction.read_value & 0xFF));
+        }
+        else if(instruction.read_value_size_in_bytes > 1){
+            std::snprintf(value, sizeof(value), "$%04X", instruction.read_value);
+        }
+        else{
+            std::snprintf(value, sizeof(value), "$%02X", instruction.read_value & 0xFF);
+        }
+        //Marker is % followed by the operand position
+        std::string text = instruction.replace_mnenomic;
+        char marker[8];
+        const int marker_size = std::snprintf(marker, sizeof(marker), "%%%u", static_cast<unsigned>(instruction.read_value_operand_position));
+        const std::size_t marker_position = text.find(marker);
+        if(marker_position != std::string::npos){
+            text.replace(marker_position, static_cast<std::size_t>(marker_size), value);
+        }
+        return text;
+    }
+
+    /// @brief Decodes and formats the instruction at the start of the bytes.
+    /// @param bytes Bytes of the instruction, at least the size of the instruction.
+    /// @param instruction_set Instruction set to decode with.
+    /// @return Assembly text of the instruction or error status.
+    StatusOr<std::string> InstructionFormatterLR35902::disassemble(const std::vector<uint8_t>& bytes, const InstructionSetLR35902& instruction_set){
+        AddressableMemory memory(bytes, true);
+        StatusOr<InstructionLR35902> instruction = InstructionDecoderLR35902::decode(memory, 0x0000, instruction_set);
+        if(!instruction.ok()){
+            return instruction.status();
+        }
+        return format(instruction.value());
+    }
+
+}//namespace_mygbc
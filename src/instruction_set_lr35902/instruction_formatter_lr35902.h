@@ -0,0 +1,32 @@
+#ifndef INSTRUCTION_FORMATTER_LR35902_H
+#define INSTRUCTION_FORMATTER_LR35902_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include "instruction_lr35902.h" //InstructionLR35902
+#include "instruction_set_lr35902.h" //InstructionSetLR35902
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Static formatter class. Turns instructions into assembly text.
+    class InstructionFormatterLR35902{
+        public:
+            /// @brief Formats the decoded instruction as assembly.
+            /// @details Replaces the read value marker of replace_mnenomic with the read value.
+            ///         Values are written as $hex, signed values as +/- decimal.
+            /// @param instruction Decoded instruction.
+            /// @return Assembly text of the instruction.
+            static std::string format(const InstructionLR35902& instruction);
+
+            /// @brief Decodes and formats the instruction at the start of the bytes.
+            /// @param bytes Bytes of the instruction, at least the size of the instruction.
+            /// @param instruction_set Instruction set to decode with.
+            /// @return Assembly text of the instruction or error status.
+            static StatusOr<std::string> disassemble(const std::vector<uint8_t>& bytes, const InstructionSetLR35902& instruction_set);
+    };
+
+}//namespace_mygbc
+
+#endif
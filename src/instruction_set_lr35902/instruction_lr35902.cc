@@ -1,4 +1,5 @@
 #include "instruction_lr35902.h"
+#include "../profile/memory_footprint.h" //MemoryFootprint
 
 namespace mygbc{
 
@@ -130,4 +131,16 @@ namespace mygbc{
         return (opcode == other.opcode);
     }
 
+    /// @brief Returns the heap memory owned by the operands, mnemonics and costs.
+    /// @return Owned bytes.
+    std::size_t InstructionLR35902::get_memory_usage() const noexcept{
+        std::size_t bytes = MemoryFootprint::get_vector_usage(operand_registers) + MemoryFootprint::get_vector_usage(operand_const_values) +
+            MemoryFootprint::get_vector_usage(t_cycles_costs);
+        for(const OperandRegister& operand_register : operand_registers){
+            bytes += MemoryFootprint::get_string_usage(operand_register.id);
+        }
+        return bytes + MemoryFootprint::get_string_usage(short_mnemonic) + MemoryFootprint::get_string_usage(full_mnemonic) +
+            MemoryFootprint::get_string_usage(replace_mnenomic);
+    }
+
 }//namespace_mygbc
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <cstdint> //Fixed lenght variables
 #include <vector> //std::vector
 #include <string> //std::string
+#include <cstddef> //std::size_t
 
 namespace mygbc{
     
@@ -179,6 +180,10 @@ namespace mygbc{
         /// @param other 
         /// @return are the structs a match data wise?
         bool operator==(const InstructionLR35902& other) const noexcept;
+
+        /// @brief Returns the heap memory owned by the operands, mnemonics and costs.
+        /// @return Owned bytes.
+        std::size_t get_memory_usage() const noexcept;
     };
 
 }//namespace_mygbc
@@ -1,12 +1,13 @@
 #include "instruction_set_lr35902.h"
+#include "../profile/memory_footprint.h" //MemoryFootprint
 #include <utility>
 
 namespace mygbc{
 
-    /// @brief Initializes the decoder and fetches the instruction table.
-    /// @details Fetches the instruction table.
+    /// @brief Initializes the set on the shared instruction table.
+    /// @details The shared table is built by the first set of the process.
     InstructionSetLR35902::InstructionSetLR35902()
-    :instruction_table_(std::move(get_instruction_table())){
+    :tables_(&get_shared_tables()){
     }
 
     /// @brief Fetches instruction details by given opcode.
@@ -14,8 +15,9 @@ namespace mygbc{
     /// @return Instruction details or error status.
     StatusOr<InstructionLR35902> InstructionSetLR35902::get_by_opcode(uint16_t opcode) const noexcept{
         //Check legitimacy of the opcode
-        if(instruction_table_.find(opcode) != instruction_table_.end()){
-            return instruction_table_.at(opcode);
+        const InstructionLR35902* instruction = find_by_opcode(opcode);
+        if(instruction != nullptr){
+            return *instruction;
         }
         //Valid opcode was not found for the input
         return Status::invalid_opcode_error(
@@ -23,9 +25,61 @@ namespace mygbc{
         );
     }
 
+    /// @brief Finds the instruction details by given opcode without copying them.
+    /// @param opcode Opcode 1-2 bytes long.
+    /// @return Instruction details owned by the set or nullptr if the opcode is illegal.
+    const InstructionLR35902* InstructionSetLR35902::find_by_opcode(const uint16_t opcode) const noexcept{
+        const std::size_t index = get_lookup_index(opcode);
+        return index < opcode_lookup_size ? tables_->opcode_lookup[index] : nullptr;
+    }
+
+    /// @brief Returns the index of the opcode in the opcode lookup.
+    /// @param opcode Opcode 1-2 bytes long.
+    /// @return Index or opcode_lookup_size if the opcode can not be legal.
+    std::size_t InstructionSetLR35902::get_lookup_index(const uint16_t opcode) noexcept{
+        if(opcode < 0x100){
+            return opcode;
+        }
+        if((opcode & 0xFF00) == 0xCB00){
+            return 0x100 + (opcode & 0xFF);
+        }
+        return opcode_lookup_size;
+    }
+
+    /// @brief Returns the memory used by the shared instruction table.
+    /// @details Shared by every set, so it is not part of the footprint of an instance.
+    /// @return Memory usage in bytes.
+    std::size_t InstructionSetLR35902::get_shared_memory_usage() noexcept{
+        const SharedTables& tables = get_shared_tables();
+        std::size_t bytes = sizeof(SharedTables) + MemoryFootprint::get_unordered_map_usage(tables.instruction_table);
+        for(const std::pair<const uint16_t, InstructionLR35902>& entry : tables.instruction_table){
+            bytes += entry.second.get_memory_usage();
+        }
+        return bytes;
+    }
+
+    /// @brief Returns the shared tables, builds them on first use.
+    /// @return Shared tables.
+    const InstructionSetLR35902::SharedTables& InstructionSetLR35902::get_shared_tables(){
+        static const SharedTables tables;
+        return tables;
+    }
+
+    /// @brief Builds the instruction table and points the opcode lookup at it.
+    InstructionSetLR35902::SharedTables::SharedTables()
+    :instruction_table(get_instruction_table()), opcode_lookup{}{
+        //Map nodes are stable, point the flat lookup at them
+        for(const std::pair<const uint16_t, InstructionLR35902>& entry : instruction_table){
+            const std::size_t index = get_lookup_index(entry.first);
+            if(index < opcode_lookup_size){
+                opcode_lookup[index] = &entry.second;
+            }
+        }
+    }
+
     /// @brief Returns a built instruction table.
     /// @return Instruction table, keyd by hex represatation of opcodes.
-    std::unordered_map<uint16_t, InstructionLR35902> InstructionSetLR35902::get_instruction_table() const{
+    std::unordered_map<uint16_t, InstructionLR35902> InstructionSetLR35902::get_instruction_table(){
         //Map based on the information profided by https://gbdev.io/gb-opcodes//optables/dark
         return std::unordered_map<uint16_t, InstructionLR35902>{
             {0x0000, InstructionLR35902(0x0000,1,std::vector<InstructionLR35902::OperandRegister>{},std::vector<InstructionLR35902::OperandConstValue>{},false, 0, 0, InstructionLR35902::OperandValueInterpHint::NONE,InstructionLR35902::ExecutionCondition::NONE,"NOP","NOP","NOP",std::vector<uint8_t>{4},InstructionLR35902::FlagOperation::NO_CHANGE,InstructionLR35902::FlagOperation::NO_CHANGE,InstructionLR35902::FlagOperation::NO_CHANGE,InstructionLR35902::FlagOperation::NO_CHANGE)},
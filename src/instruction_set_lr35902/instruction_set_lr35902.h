@@ -3,15 +3,20 @@
 
 #include "instruction_lr35902.h" //InstructionLR35902
 #include "../util/status/status_or.h" //StatusOr
+#include <array> //std::array
 #include <unordered_map> //std::unordered_map
 
 namespace mygbc{
 
     /// @brief Rerpersents the whole instruction set of the LR35902
+    /// @details The instruction table is built once per process and shared read-only by every set.
     class InstructionSetLR35902{
         public:
-        /// @brief Initializes the set by fetching the instruction table.
-        /// @details Fetches the instruction table.
+        //Entries of the opcode lookup, 0x00-0xFF followed by 0xCB00-0xCBFF
+        static constexpr std::size_t opcode_lookup_size = 0x200;
+
+        /// @brief Initializes the set on the shared instruction table.
+        /// @details The shared table is built by the first set of the process.
         InstructionSetLR35902();
 
         /// @brief Fetches instruction details by given opcode.
@@ -19,13 +24,44 @@ namespace mygbc{
         /// @return Instruction details or error status.
         StatusOr<InstructionLR35902> get_by_opcode(uint16_t opcode) const noexcept;
 
+        /// @brief Finds the instruction details by given opcode without copying them.
+        /// @param opcode Opcode 1-2 bytes long.
+        /// @return Instruction details owned by the set or nullptr if the opcode is illegal.
+        const InstructionLR35902* find_by_opcode(const uint16_t opcode) const noexcept;
+
+        /// @brief Returns the index of the opcode in the opcode lookup.
+        /// @param opcode Opcode 1-2 bytes long.
+        /// @return Index or opcode_lookup_size if the opcode can not be legal.
+        static std::size_t get_lookup_index(const uint16_t opcode) noexcept;
+
+        /// @brief Returns the memory used by the shared instruction table.
+        /// @details Shared by every set, so it is not part of the footprint of an instance.
+        /// @return Memory usage in bytes.
+        static std::size_t get_shared_memory_usage() noexcept;
+
         private:
+        //Tables shared by every set
+        struct SharedTables{
+            /// @brief Builds the instruction table and points the opcode lookup at it.
+            SharedTables();
+
+            //Hex opcode => Instruction details
+            const std::unordered_map<uint16_t, InstructionLR35902> instruction_table;
+
+            //Lookup index => Instruction details in the table, nullptr for illegal opcodes
+            std::array<const InstructionLR35902*, opcode_lookup_size> opcode_lookup;
+        };
+
+        /// @brief Returns the shared tables, builds them on first use.
+        /// @return Shared tables.
+        static const SharedTables& get_shared_tables();
+
         /// @brief Returns a built instruction table.
         /// @return Instruction table, keyd by hex represatation of opcodes.
-        std::unordered_map<uint16_t, InstructionLR35902> get_instruction_table() const;
+        static std::unordered_map<uint16_t, InstructionLR35902> get_instruction_table();
 
-        //Hex opcode => Instruction details
-        std::unordered_map<uint16_t, InstructionLR35902> instruction_table_;
+        //Tables of the set, owned by get_shared_tables
+        const SharedTables* tables_;
     };
 
 }//namespace_mygbc
@@ -1,4 +1,5 @@
 #include "addressable_memory.h" //AddressableMemory
+#include <utility> //std::move
 #include "../util/util.h" //Util
 
 namespace mygbc{
@@ -16,6 +17,14 @@ namespace mygbc{
     :memory_(memory), read_only_memory_(read_only), memory_mutex_(std::make_shared<std::shared_mutex>()){
     }
 
+    /// @brief Setter constructor taking over the given contents.
+    /// @details Avoids copying the contents when they are built for the memory.
+    /// @param memory Contents of the addressable memory
+    /// @param read_only Is the memory read only?
+    AddressableMemory::AddressableMemory(std::vector<uint8_t>&& memory, const bool read_only)
+    :memory_(std::move(memory)), read_only_memory_(read_only), memory_mutex_(std::make_shared<std::shared_mutex>()){
+    }
+
     /// @brief Returns the read only memory flag.
     /// @details Returns the read only memory flag.
     /// @return The read only memory flag.
@@ -23,6 +32,15 @@ namespace mygbc{
         return read_only_memory_;
     }
 
+    /// @brief Returns the heap memory owned by the memory object.
+    /// @details Counts the reserved bytes and the shared mutex with its control block.
+    /// @return Owned bytes.
+    std::size_t AddressableMemory::get_memory_usage() const noexcept{
+        //make_shared control block holds a vtable pointer and the two reference counts
+        const std::size_t mutex_bytes = memory_mutex_ ? sizeof(std::shared_mutex) + sizeof(void*) + (2 * sizeof(int)) : 0;
+        return memory_.capacity() + mutex_bytes;
+    }
+
     /// @brief Returns the byte located at the given address.
     /// @details Returns the byte located at the given address. Address is zero-based indexed. 
     /// @param addr Zero based address.
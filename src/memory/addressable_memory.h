@@ -25,6 +25,12 @@ namespace mygbc{
         /// @param memory Contents of the addressable memory
         /// @param read_only Is the memory read only?
         AddressableMemory(const std::vector<uint8_t> & memory, const bool read_only);
+
+        /// @brief Setter constructor taking over the given contents.
+        /// @details Avoids copying the contents when they are built for the memory.
+        /// @param memory Contents of the addressable memory
+        /// @param read_only Is the memory read only?
+        AddressableMemory(std::vector<uint8_t>&& memory, const bool read_only);
         
         /// @brief Returns the byte located at the given address.
         /// @details Returns the byte located at the given address. Address is zero-based indexed. 
@@ -76,6 +82,11 @@ namespace mygbc{
         /// @return The read only memory flag.
         bool is_read_only() const noexcept;
 
+        /// @brief Returns the heap memory owned by the memory object.
+        /// @details Counts the reserved bytes and the shared mutex with its control block.
+        /// @return Owned bytes.
+        std::size_t get_memory_usage() const noexcept;
+
         protected:
             //Binary bytes
             std::vector<uint8_t> memory_;
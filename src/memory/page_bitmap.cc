@@ -0,0 +1,92 @@
+#include <bit> //std::popcount, std::countr_zero
+#include "page_bitmap.h" //PageBitmap
+
+namespace mygbc{
+
+    /// @brief Initializes a bitmap with no pages set.
+    PageBitmap::PageBitmap():words_{}{
+    }
+
+    /// @brief Marks the given page.
+    /// @param page Index of the page.
+    void PageBitmap::set(const uint8_t page) noexcept{
+        words_[page >> 6] |= (uint64_t{1} << (page & 0x3F));
+    }
+
+    /// @brief Marks every page.
+    void PageBitmap::set_all() noexcept{
+        words_.fill(~uint64_t{0});
+    }
+
+    /// @brief Is the given page marked?
+    /// @param page Index of the page.
+    /// @return Is the page marked?
+    bool PageBitmap::test(const uint8_t page) const noexcept{
+        return (words_[page >> 6] >> (page & 0x3F)) & 0x01;
+    }
+
+    /// @brief Are any of the pages marked?
+    /// @return Are any of the pages marked?
+    bool PageBitmap::any() const noexcept{
+        for(const uint64_t word : words_){
+            if(word != 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Returns the number of marked pages.
+    /// @return Number of marked pages.
+    std::size_t PageBitmap::count() const noexcept{
+        std::size_t marked_pages = 0;
+        for(const uint64_t word : words_){
+            marked_pages += std::popcount(word);
+        }
+        return marked_pages;
+    }
+
+    /// @brief Unmarks every page.
+    void PageBitmap::clear() noexcept{
+        words_.fill(0);
+    }
+
+    /// @brief Finds the next marked page starting from the given page.
+    /// @details Used to iterate marked pages in ascending order.
+    /// @param from First page to consider.
+    /// @return Index of the next marked page or page_count if there is none.
+    std::size_t PageBitmap::find_next(const std::size_t from) const noexcept{
+        if(from >= page_count){
+            return page_count;
+        }
+        std::size_t word_index = from >> 6;
+        //Drop the pages before from in the first word
+        uint64_t word = words_[word_index] & (~uint64_t{0} << (from & 0x3F));
+        while(word == 0){
+            ++word_index;
+            if(word_index >= words_.size()){
+                return page_count;
+            }
+            word = words_[word_index];
+        }
+        return (word_index << 6) + std::countr_zero(word);
+    }
+
+    /// @brief Marks every page marked in the other bitmap.
+    /// @param other Bitmap to merge.
+    /// @return Reference to this bitmap.
+    PageBitmap& PageBitmap::operator|=(const PageBitmap& other) noexcept{
+        for(std::size_t word_index = 0; word_index < words_.size(); ++word_index){
+            words_[word_index] |= other.words_[word_index];
+        }
+        return *this;
+    }
+
+    /// @brief Comparison operator for the data type
+    /// @param other
+    /// @return are the bitmaps a match data wise?
+    bool PageBitmap::operator==(const PageBitmap& other) const noexcept{
+        return words_ == other.words_;
+    }
+
+}//namespace_mygbc
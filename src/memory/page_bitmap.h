@@ -0,0 +1,85 @@
+#ifndef PAGE_BITMAP_H
+#define PAGE_BITMAP_H
+
+#include <array> //std::array
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Bitmap with one bit per 256 byte page of the 16-bit address space.
+    /// @details Used to track which pages have been written to since the bitmap was last cleared.
+    class PageBitmap{
+        public:
+            //Number of pages in the 16-bit address space
+            static constexpr std::size_t page_count = 0x100;
+
+            //Size of a single page in bytes
+            static constexpr std::size_t page_size = 0x100;
+
+            /// @brief Initializes a bitmap with no pages set.
+            PageBitmap();
+
+            /// @brief Marks the page containing the given address.
+            /// @details Defined in the header, it is called on every memory write.
+            /// @param addr Address inside the page.
+            void mark_address(const uint16_t addr) noexcept{
+                words_[addr >> 14] |= (uint64_t{1} << ((addr >> 8) & 0x3F));
+            }
+
+            /// @brief Does the bitmap share a marked page with the other bitmap?
+            /// @details Defined in the header, it is called per instruction by conditional runs.
+            /// @param other Bitmap to compare.
+            /// @return Is any page marked in both bitmaps?
+            bool intersects(const PageBitmap& other) const noexcept{
+                return ((words_[0] & other.words_[0]) | (words_[1] & other.words_[1]) |
+                    (words_[2] & other.words_[2]) | (words_[3] & other.words_[3])) != 0;
+            }
+
+            /// @brief Marks the given page.
+            /// @param page Index of the page.
+            void set(const uint8_t page) noexcept;
+
+            /// @brief Marks every page.
+            void set_all() noexcept;
+
+            /// @brief Is the given page marked?
+            /// @param page Index of the page.
+            /// @return Is the page marked?
+            bool test(const uint8_t page) const noexcept;
+
+            /// @brief Are any of the pages marked?
+            /// @return Are any of the pages marked?
+            bool any() const noexcept;
+
+            /// @brief Returns the number of marked pages.
+            /// @return Number of marked pages.
+            std::size_t count() const noexcept;
+
+            /// @brief Unmarks every page.
+            void clear() noexcept;
+
+            /// @brief Finds the next marked page starting from the given page.
+            /// @details Used to iterate marked pages in ascending order.
+            /// @param from First page to consider.
+            /// @return Index of the next marked page or page_count if there is none.
+            std::size_t find_next(const std::size_t from) const noexcept;
+
+            /// @brief Marks every page marked in the other bitmap.
+            /// @param other Bitmap to merge.
+            /// @return Reference to this bitmap.
+            PageBitmap& operator|=(const PageBitmap& other) noexcept;
+
+            /// @brief Comparison operator for the data type
+            /// @param other
+            /// @return are the bitmaps a match data wise?
+            bool operator==(const PageBitmap& other) const noexcept;
+
+        private:
+            //64 pages per word
+            std::array<uint64_t, page_count / 64> words_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,206 @@
+#include <algorithm> //std::sort, std::fill, std::min
+#include <cstdio> //std::snprintf
+#include <map> //std::map
+#include <utility> //std::pair
+#include "cpu_profiler.h" //CpuProfiler
+
+namespace mygbc{
+
+    namespace{
+        /// @brief Formats the location as in the .sym files.
+        /// @param bank Bank of the address.
+        /// @param address Address to format.
+        /// @return Location as "BB:AAAA".
+        std::string format_location(const uint16_t bank, const uint16_t address){
+            char location[16];
+            std::snprintf(location, sizeof(location), "%02X:%04X", bank, address);
+            return location;
+        }
+    }
+
+    /// @brief Returns the number of ROM banks given by the header rom size.
+    /// @param rom_size Header rom size (0x148).
+    /// @return Number of ROM banks, 2 for unknown sizes.
+    std::size_t CpuProfiler::get_rom_bank_count(const uint8_t rom_size) noexcept{
+        if(rom_size <= 0x08){
+            return std::size_t{2} << rom_size;
+        }
+        switch(rom_size){
+            case 0x52: return 72;
+            case 0x53: return 80;
+            case 0x54: return 96;
+            default: return 2;
+        }
+    }
+
+    /// @brief Initializes counters sized to the ROM of the binary.
+    /// @param binary Binary to profile.
+    CpuProfiler::CpuProfiler(const GBCBinary& binary)
+    :CpuProfiler(get_rom_bank_count(binary.get_header_data().rom_size)){
+    }
+
+    /// @brief Initializes counters for the given number of ROM banks.
+    /// @param rom_bank_count Number of ROM banks, at least 2.
+    CpuProfiler::CpuProfiler(const std::size_t rom_bank_count)
+    :rom_bank_count_(std::max<std::size_t>(rom_bank_count, 2)), switchable_bank_slot_(bank_size),
+    ram_slot_(rom_bank_count_ * bank_size), counters_(ram_slot_ + (0x10000 - rom_end_addr), Counter{0, 0}){
+    }
+
+    /// @brief Sets the bank mapped at 0x4000 => 0x7FFF.
+    /// @details Out of range banks are ignored. Without a MBC bank 1 stays mapped.
+    /// @param bank ROM bank.
+    void CpuProfiler::set_rom_bank(const uint16_t bank) noexcept{
+        if(bank > 0 && bank < rom_bank_count_){
+            switchable_bank_slot_ = static_cast<std::size_t>(bank) * bank_size;
+        }
+    }
+
+    /// @brief Returns the bank mapped at 0x4000 => 0x7FFF.
+    /// @return ROM bank.
+    uint16_t CpuProfiler::get_rom_bank() const noexcept{
+        return static_cast<uint16_t>(switchable_bank_slot_ / bank_size);
+    }
+
+    /// @brief Returns the number of profiled ROM banks.
+    /// @return Number of ROM banks.
+    std::size_t CpuProfiler::get_rom_bank_count() const noexcept{
+        return rom_bank_count_;
+    }
+
+    /// @brief Returns the cycles executed at the address.
+    /// @param bank Bank of the address, ignored past the ROM.
+    /// @param address Address of the instructions.
+    /// @return Executed cycles.
+    uint64_t CpuProfiler::get_cycles(const uint16_t bank, const uint16_t address) const noexcept{
+        const std::size_t slot = get_slot(bank, address);
+        return slot < counters_.size() ? counters_[slot].cycles : 0;
+    }
+
+    /// @brief Returns the number of instructions executed at the address.
+    /// @param bank Bank of the address, ignored past the ROM.
+    /// @param address Address of the instructions.
+    /// @return Executed instructions.
+    uint64_t CpuProfiler::get_executions(const uint16_t bank, const uint16_t address) const noexcept{
+        const std::size_t slot = get_slot(bank, address);
+        return slot < counters_.size() ? counters_[slot].executions : 0;
+    }
+
+    /// @brief Returns the cycles executed at every address.
+    /// @return Executed cycles.
+    uint64_t CpuProfiler::get_total_cycles() const noexcept{
+        uint64_t total_cycles = 0;
+        for(const Counter& counter : counters_){
+            total_cycles += counter.cycles;
+        }
+        return total_cycles;
+    }
+
+    /// @brief Zeroes every counter.
+    void CpuProfiler::reset() noexcept{
+        std::fill(counters_.begin(), counters_.end(), Counter{0, 0});
+    }
+
+    /// @brief Returns the memory used by the counters.
+    /// @return Memory usage in bytes.
+    std::size_t CpuProfiler::get_memory_usage() const noexcept{
+        return counters_.size() * sizeof(Counter);
+    }
+
+    /// @brief Sums the counters per function.
+    /// @details Addresses resolve to the closest preceding symbol. Addresses without a symbol are reported on their own.
+    /// @param symbols Symbols of the ROM.
+    /// @return Executed functions, most cycles first.
+    std::vector<FunctionProfile> CpuProfiler::get_function_profile(const SymbolTable& symbols) const{
+        std::map<std::pair<uint16_t, uint16_t>, FunctionProfile> functions;
+        for(std::size_t slot = 0; slot < counters_.size(); ++slot){
+            const Counter& counter = counters_[slot];
+            if(counter.executions == 0){
+                continue;
+            }
+            uint16_t bank;
+            uint16_t address;
+            if(slot < ram_slot_){
+                bank = static_cast<uint16_t>(slot / bank_size);
+                address = static_cast<uint16_t>((slot % bank_size) + (bank == 0 ? 0 : bank_size));
+            }
+            else{
+                address = static_cast<uint16_t>(rom_end_addr + (slot - ram_slot_));
+                //RGBDS places WRAMX at bank 1 when WRAM is not banked
+                bank = SymbolTable::get_section_start(address) == 0xD000 ? 1 : 0;
+            }
+            const Symbol* symbol = symbols.find(bank, address);
+            const std::pair<uint16_t, uint16_t> key = symbol != nullptr ? std::make_pair(symbol->bank, symbol->address) : std::make_pair(bank, address);
+            std::map<std::pair<uint16_t, uint16_t>, FunctionProfile>::iterator function = functions.find(key);
+            if(function == functions.end()){
+                FunctionProfile profile{
+                    key.first, key.second, SymbolTable::get_section_type(key.second),
+                    symbol != nullptr ? symbol->name : format_location(key.first, key.second), 0, 0
+                };
+                function = functions.emplace(key, std::move(profile)).first;
+            }
+            function->second.cycles += counter.cycles;
+            function->second.executions += counter.executions;
+        }
+        std::vector<FunctionProfile> profile;
+        profile.reserve(functions.size());
+        for(std::pair<const std::pair<uint16_t, uint16_t>, FunctionProfile>& function : functions){
+            profile.push_back(std::move(function.second));
+        }
+        std::stable_sort(profile.begin(), profile.end(), [](const FunctionProfile& first, const FunctionProfile& second){
+            return first.cycles > second.cycles;
+        });
+        return profile;
+    }
+
+    /// @brief Formats the functions with the most executed cycles as a table.
+    /// @param symbols Symbols of the ROM.
+    /// @param max_functions Maximum number of functions to list.
+    /// @return Table text.
+    std::string CpuProfiler::format_hot_functions(const SymbolTable& symbols, const std::size_t max_functions) const{
+        const std::vector<FunctionProfile> profile = get_function_profile(symbols);
+        const uint64_t total_cycles = get_total_cycles();
+        std::string text = "      cycles       %   executions  location  name\n";
+        char line[96];
+        for(std::size_t index = 0; index < std::min(max_functions, profile.size()); ++index){
+            const FunctionProfile& function = profile[index];
+            const double percent = total_cycles == 0 ? 0.0 : 100.0 * static_cast<double>(function.cycles) / static_cast<double>(total_cycles);
+            std::snprintf(
+                line, sizeof(line), "%12llu  %6.2f  %11llu  %s  ",
+                static_cast<unsigned long long>(function.cycles), percent,
+                static_cast<unsigned long long>(function.executions), format_location(function.bank, function.address).c_str()
+            );
+            text += line + function.name + "\n";
+        }
+        return text;
+    }
+
+    /// @brief Formats the functions in the collapsed stack format of flamegraph tools.
+    /// @details One "SECTION;name cycles" line per function. Stacks are not tracked, so the section is the only parent frame.
+    /// @param symbols Symbols of the ROM.
+    /// @return Collapsed stack text.
+    std::string CpuProfiler::format_collapsed_stacks(const SymbolTable& symbols) const{
+        std::string text;
+        for(const FunctionProfile& function : get_function_profile(symbols)){
+            text += function.section + ";" + function.name + " " + std::to_string(function.cycles) + "\n";
+        }
+        return text;
+    }
+
+    /// @brief Returns the slot of the address.
+    /// @param bank Bank of the address, ignored past the ROM.
+    /// @param address Address to locate.
+    /// @return Slot of the address or counters_.size() if the bank is out of range.
+    std::size_t CpuProfiler::get_slot(const uint16_t bank, const uint16_t address) const noexcept{
+        if(address >= rom_end_addr){
+            return ram_slot_ + (address - rom_end_addr);
+        }
+        if(address < bank_size){
+            return address;
+        }
+        if(bank == 0 || bank >= rom_bank_count_){
+            return counters_.size();
+        }
+        return static_cast<std::size_t>(bank) * bank_size + (address - bank_size);
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,149 @@
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "symbol_table.h" //SymbolTable
+#include "../memory/gbc_binary.h" //GBCBinary
+
+namespace mygbc{
+
+    /// @brief Executed cycles of a function or of an address without a symbol.
+    struct FunctionProfile{
+        uint16_t bank;
+        uint16_t address;
+        std::string section;
+        std::string name;
+        uint64_t cycles;
+        uint64_t executions;
+    };
+
+    /// @brief Accumulates the executed cycles per (bank, PC) of the emulated code.
+    /// @details Counters are kept in a flat array with a slot for every ROM address of every bank and every
+    ///         address past the ROM, so recording is a single indexed add.
+    class CpuProfiler{
+        public:
+        //Size of a ROM bank in bytes
+        static constexpr uint32_t bank_size = 0x4000;
+
+        //End of the cartridge ROM area (Exclusive)
+        static constexpr uint32_t rom_end_addr = 0x8000;
+
+        /// @brief Returns the number of ROM banks given by the header rom size.
+        /// @param rom_size Header rom size (0x148).
+        /// @return Number of ROM banks, 2 for unknown sizes.
+        static std::size_t get_rom_bank_count(const uint8_t rom_size) noexcept;
+
+        /// @brief Initializes counters sized to the ROM of the binary.
+        /// @param binary Binary to profile.
+        explicit CpuProfiler(const GBCBinary& binary);
+
+        /// @brief Initializes counters for the given number of ROM banks.
+        /// @param rom_bank_count Number of ROM banks, at least 2.
+        explicit CpuProfiler(const std::size_t rom_bank_count);
+
+        /// @brief Adds the cycles of an instruction executed at the PC.
+        /// @details Defined in the header, it is called on every instruction.
+        /// @param pc Address of the instruction.
+        /// @param cycles Cycles of the instruction.
+        void record(const uint16_t pc, const uint8_t cycles) noexcept{
+            std::size_t slot;
+            if(pc < bank_size){
+                slot = pc;
+            }
+            else if(pc < rom_end_addr){
+                slot = switchable_bank_slot_ + (pc - bank_size);
+            }
+            else{
+                slot = ram_slot_ + (pc - rom_end_addr);
+            }
+            counters_[slot].cycles += cycles;
+            ++counters_[slot].executions;
+        }
+
+        /// @brief Sets the bank mapped at 0x4000 => 0x7FFF.
+        /// @details Out of range banks are ignored. Without a MBC bank 1 stays mapped.
+        /// @param bank ROM bank.
+        void set_rom_bank(const uint16_t bank) noexcept;
+
+        /// @brief Returns the bank mapped at 0x4000 => 0x7FFF.
+        /// @return ROM bank.
+        uint16_t get_rom_bank() const noexcept;
+
+        /// @brief Returns the number of profiled ROM banks.
+        /// @return Number of ROM banks.
+        std::size_t get_rom_bank_count() const noexcept;
+
+        /// @brief Returns the cycles executed at the address.
+        /// @param bank Bank of the address, ignored past the ROM.
+        /// @param address Address of the instructions.
+        /// @return Executed cycles.
+        uint64_t get_cycles(const uint16_t bank, const uint16_t address) const noexcept;
+
+        /// @brief Returns the number of instructions executed at the address.
+        /// @param bank Bank of the address, ignored past the ROM.
+        /// @param address Address of the instructions.
+        /// @return Executed instructions.
+        uint64_t get_executions(const uint16_t bank, const uint16_t address) const noexcept;
+
+        /// @brief Returns the cycles executed at every address.
+        /// @return Executed cycles.
+        uint64_t get_total_cycles() const noexcept;
+
+        /// @brief Zeroes every counter.
+        void reset() noexcept;
+
+        /// @brief Returns the memory used by the counters.
+        /// @return Memory usage in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        /// @brief Sums the counters per function.
+        /// @details Addresses resolve to the closest preceding symbol. Addresses without a symbol are reported on their own.
+        /// @param symbols Symbols of the ROM.
+        /// @return Executed functions, most cycles first.
+        std::vector<FunctionProfile> get_function_profile(const SymbolTable& symbols) const;
+
+        /// @brief Formats the functions with the most executed cycles as a table.
+        /// @param symbols Symbols of the ROM.
+        /// @param max_functions Maximum number of functions to list.
+        /// @return Table text.
+        std::string format_hot_functions(const SymbolTable& symbols, const std::size_t max_functions) const;
+
+        /// @brief Formats the functions in the collapsed stack format of flamegraph tools.
+        /// @details One "SECTION;name cycles" line per function. Stacks are not tracked, so the section is the only parent frame.
+        /// @param symbols Symbols of the ROM.
+        /// @return Collapsed stack text.
+        std::string format_collapsed_stacks(const SymbolTable& symbols) const;
+
+        private:
+
+        /// @brief Counters of a single address.
+        struct Counter{
+            uint64_t cycles;
+            uint64_t executions;
+        };
+
+        /// @brief Returns the slot of the address.
+        /// @param bank Bank of the address, ignored past the ROM.
+        /// @param address Address to locate.
+        /// @return Slot of the address or counters_.size() if the bank is out of range.
+        std::size_t get_slot(const uint16_t bank, const uint16_t address) const noexcept;
+
+        //Number of profiled ROM banks
+        std::size_t rom_bank_count_;
+
+        //Slot of 0x4000 in the mapped bank
+        std::size_t switchable_bank_slot_;
+
+        //Slot of 0x8000, after every ROM bank
+        std::size_t ram_slot_;
+
+        //Counters of every ROM bank followed by 0x8000 => 0xFFFF
+        std::vector<Counter> counters_;
+    };
+
+}//namespace_mygbc
+
+#endif
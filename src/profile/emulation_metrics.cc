@@ -0,0 +1,165 @@
+#include <algorithm> //std::min
+#include <bit> //std::bit_width
+#include <cstdio> //std::snprintf
+#include "emulation_metrics.h" //EmulationMetrics
+
+namespace mygbc{
+
+    namespace{
+        //Region names in the order of MemoryRegion
+        constexpr const char* region_names[memory_region_count] = {"rom", "vram", "sram", "wram", "echo", "oam", "io", "hram"};
+    }
+
+    /// @brief Initializes zeroed snapshot.
+    MetricsSnapshot::MetricsSnapshot()
+    :instructions(0), cycles(0), frames(0), run_time_ns(0), frame_time_ns(0), frame_time_histogram{}, memory_reads{}, memory_writes{}{
+    }
+
+    /// @brief Returns the emulated clock speed.
+    /// @return Emulated cycles per host microsecond.
+    double MetricsSnapshot::get_emulated_mhz() const noexcept{
+        return run_time_ns == 0 ? 0.0 : static_cast<double>(cycles) * 1000.0 / static_cast<double>(run_time_ns);
+    }
+
+    /// @brief Returns the mean host time of a frame.
+    /// @return Mean frame time in milliseconds.
+    double MetricsSnapshot::get_mean_frame_time_ms() const noexcept{
+        return frames == 0 ? 0.0 : static_cast<double>(frame_time_ns) / 1000000.0 / static_cast<double>(frames);
+    }
+
+    /// @brief Returns the upper bound of the frame time bucket holding the percentile.
+    /// @param percentile Percentile between 0 and 100.
+    /// @return Frame time upper bound in microseconds, 0 without frames.
+    uint64_t MetricsSnapshot::get_frame_time_percentile_us(const double percentile) const noexcept{
+        uint64_t histogram_frames = 0;
+        for(const uint64_t bucket_frames : frame_time_histogram){
+            histogram_frames += bucket_frames;
+        }
+        if(histogram_frames == 0){
+            return 0;
+        }
+        const double target = static_cast<double>(histogram_frames) * std::min(percentile, 100.0) / 100.0;
+        uint64_t seen_frames = 0;
+        for(std::size_t bucket = 0; bucket < frame_time_bucket_count; ++bucket){
+            seen_frames += frame_time_histogram[bucket];
+            if(static_cast<double>(seen_frames) >= target && frame_time_histogram[bucket] != 0){
+                return uint64_t{1} << (bucket + 1);
+            }
+        }
+        return uint64_t{1} << frame_time_bucket_count;
+    }
+
+    /// @brief Sums the other snapshot to this snapshot.
+    /// @param other Snapshot to add.
+    /// @return Reference to this snapshot.
+    MetricsSnapshot& MetricsSnapshot::operator+=(const MetricsSnapshot& other) noexcept{
+        instructions += other.instructions;
+        cycles += other.cycles;
+        frames += other.frames;
+        run_time_ns += other.run_time_ns;
+        frame_time_ns += other.frame_time_ns;
+        for(std::size_t bucket = 0; bucket < frame_time_bucket_count; ++bucket){
+            frame_time_histogram[bucket] += other.frame_time_histogram[bucket];
+        }
+        for(std::size_t region = 0; region < memory_region_count; ++region){
+            memory_reads[region] += other.memory_reads[region];
+            memory_writes[region] += other.memory_writes[region];
+        }
+        return *this;
+    }
+
+    /// @brief Subtracts an earlier snapshot of the same counters.
+    /// @param earlier Snapshot taken before this one.
+    /// @return Reference to this snapshot.
+    MetricsSnapshot& MetricsSnapshot::operator-=(const MetricsSnapshot& earlier) noexcept{
+        instructions -= earlier.instructions;
+        cycles -= earlier.cycles;
+        frames -= earlier.frames;
+        run_time_ns -= earlier.run_time_ns;
+        frame_time_ns -= earlier.frame_time_ns;
+        for(std::size_t bucket = 0; bucket < frame_time_bucket_count; ++bucket){
+            frame_time_histogram[bucket] -= earlier.frame_time_histogram[bucket];
+        }
+        for(std::size_t region = 0; region < memory_region_count; ++region){
+            memory_reads[region] -= earlier.memory_reads[region];
+            memory_writes[region] -= earlier.memory_writes[region];
+        }
+        return *this;
+    }
+
+    /// @brief Formats the snapshot as a single line.
+    /// @return Formatted metrics.
+    std::string MetricsSnapshot::to_string() const{
+        char summary[256];
+        std::snprintf(
+            summary, sizeof(summary), "frames=%llu instructions=%llu cycles=%llu emulated_mhz=%.3f frame_ms_mean=%.3f frame_us_p50<=%llu frame_us_p99<=%llu",
+            static_cast<unsigned long long>(frames), static_cast<unsigned long long>(instructions), static_cast<unsigned long long>(cycles),
+            get_emulated_mhz(), get_mean_frame_time_ms(),
+            static_cast<unsigned long long>(get_frame_time_percentile_us(50.0)), static_cast<unsigned long long>(get_frame_time_percentile_us(99.0))
+        );
+        std::string text = summary;
+        for(std::size_t region = 0; region < memory_region_count; ++region){
+            text += std::string(" ") + region_names[region] + "_rw=" + std::to_string(memory_reads[region]) + "/" + std::to_string(memory_writes[region]);
+        }
+        return text;
+    }
+
+    /// @brief Adds the counters to the snapshot.
+    /// @param snapshot Snapshot to add to.
+    void MemoryAccessCounters::add_to(MetricsSnapshot& snapshot) const noexcept{
+        for(std::size_t region = 0; region < memory_region_count; ++region){
+            snapshot.memory_reads[region] += reads_[region].get();
+            snapshot.memory_writes[region] += writes_[region].get();
+        }
+    }
+
+    /// @brief Zeroes every counter.
+    void MemoryAccessCounters::reset() noexcept{
+        for(std::size_t region = 0; region < memory_region_count; ++region){
+            reads_[region].reset();
+            writes_[region].reset();
+        }
+    }
+
+    /// @brief Adds host time spent executing instructions.
+    /// @param nanoseconds Elapsed host time.
+    void EmulationMetrics::record_run_time(const uint64_t nanoseconds) noexcept{
+        run_time_ns_.add(nanoseconds);
+    }
+
+    /// @brief Counts a frame and its host time.
+    /// @param nanoseconds Host time of the frame.
+    void EmulationMetrics::record_frame(const uint64_t nanoseconds) noexcept{
+        frames_.add(1);
+        frame_time_ns_.add(nanoseconds);
+        const uint64_t microseconds = nanoseconds / 1000;
+        const std::size_t bucket = microseconds == 0 ? 0 : static_cast<std::size_t>(std::bit_width(microseconds)) - 1;
+        frame_time_histogram_[std::min(bucket, frame_time_bucket_count - 1)].add(1);
+    }
+
+    /// @brief Adds the counters to the snapshot.
+    /// @param snapshot Snapshot to add to.
+    void EmulationMetrics::add_to(MetricsSnapshot& snapshot) const noexcept{
+        snapshot.instructions += instructions_.get();
+        snapshot.cycles += cycles_.get();
+        snapshot.frames += frames_.get();
+        snapshot.run_time_ns += run_time_ns_.get();
+        snapshot.frame_time_ns += frame_time_ns_.get();
+        for(std::size_t bucket = 0; bucket < frame_time_bucket_count; ++bucket){
+            snapshot.frame_time_histogram[bucket] += frame_time_histogram_[bucket].get();
+        }
+    }
+
+    /// @brief Zeroes every counter.
+    void EmulationMetrics::reset() noexcept{
+        instructions_.reset();
+        cycles_.reset();
+        frames_.reset();
+        run_time_ns_.reset();
+        frame_time_ns_.reset();
+        for(MetricsCounter& bucket : frame_time_histogram_){
+            bucket.reset();
+        }
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,205 @@
+#ifndef EMULATION_METRICS_H
+#define EMULATION_METRICS_H
+
+#include <array> //std::array
+#include <atomic> //std::atomic
+#include <string> //std::string
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Regions of the 16-bit address space counted by the metrics.
+    enum class MemoryRegion : uint8_t{
+        ROM = 0,
+        VRAM = 1,
+        SRAM = 2,
+        WRAM = 3,
+        ECHO = 4,
+        OAM = 5,
+        IO = 6,
+        HRAM = 7
+    };
+
+    //Number of counted memory regions
+    static constexpr std::size_t memory_region_count = 8;
+
+    //Number of frame time buckets, bucket i holds frames of [2^i, 2^(i+1)) microseconds
+    static constexpr std::size_t frame_time_bucket_count = 24;
+
+    /// @brief Returns the region of the address.
+    /// @param addr Address to check.
+    /// @return Region of the address.
+    constexpr MemoryRegion get_memory_region(const uint16_t addr) noexcept{
+        if(addr < 0x8000){ return MemoryRegion::ROM; }
+        if(addr < 0xA000){ return MemoryRegion::VRAM; }
+        if(addr < 0xC000){ return MemoryRegion::SRAM; }
+        if(addr < 0xE000){ return MemoryRegion::WRAM; }
+        if(addr < 0xFE00){ return MemoryRegion::ECHO; }
+        if(addr < 0xFF00){ return MemoryRegion::OAM; }
+        if(addr < 0xFF80){ return MemoryRegion::IO; }
+        return MemoryRegion::HRAM;
+    }
+
+    /// @brief Counter written by a single thread and read by any thread.
+    /// @details Increments are a relaxed load and store instead of a locked read-modify-write,
+    ///         so counting costs the same as a plain integer while reads from other threads stay defined.
+    class MetricsCounter{
+        public:
+        /// @brief Initializes zeroed counter.
+        MetricsCounter():value_(0){
+        }
+
+        /// @brief Adds to the counter. Only the owning thread may add.
+        /// @param amount Amount to add.
+        void add(const uint64_t amount) noexcept{
+            value_.store(value_.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        /// @brief Returns the value of the counter.
+        /// @return Value of the counter.
+        uint64_t get() const noexcept{
+            return value_.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Zeroes the counter. Only the owning thread may reset.
+        void reset() noexcept{
+            value_.store(0, std::memory_order_relaxed);
+        }
+
+        private:
+        std::atomic<uint64_t> value_;
+    };
+
+    /// @brief Values of the metrics at a point in time.
+    /// @details Snapshots of several instances or threads sum with operator+=, the difference of two snapshots
+    ///         covers the time between them.
+    struct MetricsSnapshot{
+        //Executed instructions
+        uint64_t instructions;
+
+        //Emulated T-cycles
+        uint64_t cycles;
+
+        //Frames run with GBC::run_frame
+        uint64_t frames;
+
+        //Host time spent executing instructions in nanoseconds
+        uint64_t run_time_ns;
+
+        //Host time spent in GBC::run_frame in nanoseconds
+        uint64_t frame_time_ns;
+
+        //Frames per frame time bucket
+        std::array<uint64_t, frame_time_bucket_count> frame_time_histogram;
+
+        //CPU reads and writes per memory region
+        std::array<uint64_t, memory_region_count> memory_reads;
+        std::array<uint64_t, memory_region_count> memory_writes;
+
+        /// @brief Initializes zeroed snapshot.
+        MetricsSnapshot();
+
+        /// @brief Returns the emulated clock speed.
+        /// @return Emulated cycles per host microsecond.
+        double get_emulated_mhz() const noexcept;
+
+        /// @brief Returns the mean host time of a frame.
+        /// @return Mean frame time in milliseconds.
+        double get_mean_frame_time_ms() const noexcept;
+
+        /// @brief Returns the upper bound of the frame time bucket holding the percentile.
+        /// @param percentile Percentile between 0 and 100.
+        /// @return Frame time upper bound in microseconds, 0 without frames.
+        uint64_t get_frame_time_percentile_us(const double percentile) const noexcept;
+
+        /// @brief Sums the other snapshot to this snapshot.
+        /// @param other Snapshot to add.
+        /// @return Reference to this snapshot.
+        MetricsSnapshot& operator+=(const MetricsSnapshot& other) noexcept;
+
+        /// @brief Subtracts an earlier snapshot of the same counters.
+        /// @param earlier Snapshot taken before this one.
+        /// @return Reference to this snapshot.
+        MetricsSnapshot& operator-=(const MetricsSnapshot& earlier) noexcept;
+
+        /// @brief Formats the snapshot as a single line.
+        /// @return Formatted metrics.
+        std::string to_string() const;
+    };
+
+    /// @brief CPU memory access counters per region.
+    class MemoryAccessCounters{
+        public:
+        /// @brief Counts a read of the address.
+        /// @details Defined in the header, it is called on every memory read.
+        /// @param addr Read address.
+        void record_read(const uint16_t addr) noexcept{
+            reads_[static_cast<std::size_t>(get_memory_region(addr))].add(1);
+        }
+
+        /// @brief Counts a write of the address.
+        /// @details Defined in the header, it is called on every memory write.
+        /// @param addr Written address.
+        void record_write(const uint16_t addr) noexcept{
+            writes_[static_cast<std::size_t>(get_memory_region(addr))].add(1);
+        }
+
+        /// @brief Adds the counters to the snapshot.
+        /// @param snapshot Snapshot to add to.
+        void add_to(MetricsSnapshot& snapshot) const noexcept;
+
+        /// @brief Zeroes every counter.
+        void reset() noexcept;
+
+        private:
+        std::array<MetricsCounter, memory_region_count> reads_;
+        std::array<MetricsCounter, memory_region_count> writes_;
+    };
+
+    /// @brief Execution counters of a GBC.
+    class EmulationMetrics{
+        public:
+        /// @brief Counts an executed instruction.
+        /// @details Defined in the header, it is called on every instruction.
+        /// @param cycles Cycles of the instruction.
+        void record_instruction(const uint8_t cycles) noexcept{
+            instructions_.add(1);
+            cycles_.add(cycles);
+        }
+
+        /// @brief Counts instructions executed outside of the GBC.
+        /// @param instruction_count Executed instructions.
+        /// @param cycles Cycles of the instructions.
+        void record_instructions(const uint64_t instruction_count, const uint64_t cycles) noexcept{
+            instructions_.add(instruction_count);
+            cycles_.add(cycles);
+        }
+
+        /// @brief Adds host time spent executing instructions.
+        /// @param nanoseconds Elapsed host time.
+        void record_run_time(const uint64_t nanoseconds) noexcept;
+
+        /// @brief Counts a frame and its host time.
+        /// @param nanoseconds Host time of the frame.
+        void record_frame(const uint64_t nanoseconds) noexcept;
+
+        /// @brief Adds the counters to the snapshot.
+        /// @param snapshot Snapshot to add to.
+        void add_to(MetricsSnapshot& snapshot) const noexcept;
+
+        /// @brief Zeroes every counter.
+        void reset() noexcept;
+
+        private:
+        MetricsCounter instructions_;
+        MetricsCounter cycles_;
+        MetricsCounter frames_;
+        MetricsCounter run_time_ns_;
+        MetricsCounter frame_time_ns_;
+        std::array<MetricsCounter, frame_time_bucket_count> frame_time_histogram_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,72 @@
+#include <cstdio> //std::snprintf
+#include <cstring> //std::strcmp
+#include "memory_footprint.h" //MemoryFootprint
+
+namespace mygbc{
+
+    /// @brief Adds the memory used by a component.
+    /// @param component Name of the component, must be a string literal.
+    /// @param bytes Used bytes.
+    void MemoryFootprint::add(const char* component, const std::size_t bytes){
+        components_.push_back(ComponentFootprint{component, bytes});
+    }
+
+    /// @brief Returns the memory used by the named component.
+    /// @param component Name of the component.
+    /// @return Used bytes, 0 if the component was not reported.
+    std::size_t MemoryFootprint::get_bytes(const std::string& component) const noexcept{
+        std::size_t bytes = 0;
+        for(const ComponentFootprint& footprint : components_){
+            if(std::strcmp(footprint.component, component.c_str()) == 0){
+                bytes += footprint.bytes;
+            }
+        }
+        return bytes;
+    }
+
+    /// @brief Returns the memory used by every component.
+    /// @return Used bytes.
+    std::size_t MemoryFootprint::get_total_bytes() const noexcept{
+        std::size_t bytes = 0;
+        for(const ComponentFootprint& footprint : components_){
+            bytes += footprint.bytes;
+        }
+        return bytes;
+    }
+
+    /// @brief Returns the reported components in the order they were added.
+    /// @return Reported components.
+    const std::vector<ComponentFootprint>& MemoryFootprint::get_components() const noexcept{
+        return components_;
+    }
+
+    /// @brief Formats the footprint as a table.
+    /// @return Table text.
+    std::string MemoryFootprint::to_string() const{
+        const std::size_t total_bytes = get_total_bytes();
+        std::string text = "       bytes       %  component\n";
+        char line[64];
+        for(const ComponentFootprint& footprint : components_){
+            const double percent = total_bytes == 0 ? 0.0 : 100.0 * static_cast<double>(footprint.bytes) / static_cast<double>(total_bytes);
+            std::snprintf(line, sizeof(line), "%12zu  %6.2f  ", footprint.bytes, percent);
+            text += std::string(line) + footprint.component + "\n";
+        }
+        std::snprintf(line, sizeof(line), "%12zu  100.00  ", total_bytes);
+        text += std::string(line) + "total\n";
+        return text;
+    }
+
+    /// @brief Returns the heap memory owned by the string.
+    /// @param text String to measure.
+    /// @return Owned bytes, 0 for strings held in the small string buffer.
+    std::size_t MemoryFootprint::get_string_usage(const std::string& text) noexcept{
+        const char* data = text.data();
+        const char* object = reinterpret_cast<const char*>(&text);
+        if(data >= object && data < object + sizeof(std::string)){
+            return 0;
+        }
+        //Capacity excludes the terminator
+        return text.capacity() + 1;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,78 @@
+#ifndef MEMORY_FOOTPRINT_H
+#define MEMORY_FOOTPRINT_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Memory used by a single component.
+    struct ComponentFootprint{
+        //Name of the component, must be a string literal
+        const char* component;
+
+        //Used bytes
+        std::size_t bytes;
+    };
+
+    /// @brief Memory used by an instance, broken down by component.
+    /// @details Components report the heap memory they own from the capacities of their containers, the instance
+    ///         itself is reported once with its size. Allocator overhead is not included.
+    class MemoryFootprint{
+        public:
+
+        /// @brief Adds the memory used by a component.
+        /// @param component Name of the component, must be a string literal.
+        /// @param bytes Used bytes.
+        void add(const char* component, const std::size_t bytes);
+
+        /// @brief Returns the memory used by the named component.
+        /// @param component Name of the component.
+        /// @return Used bytes, 0 if the component was not reported.
+        std::size_t get_bytes(const std::string& component) const noexcept;
+
+        /// @brief Returns the memory used by every component.
+        /// @return Used bytes.
+        std::size_t get_total_bytes() const noexcept;
+
+        /// @brief Returns the reported components in the order they were added.
+        /// @return Reported components.
+        const std::vector<ComponentFootprint>& get_components() const noexcept;
+
+        /// @brief Formats the footprint as a table.
+        /// @return Table text.
+        std::string to_string() const;
+
+        /// @brief Returns the heap memory owned by the string.
+        /// @param text String to measure.
+        /// @return Owned bytes, 0 for strings held in the small string buffer.
+        static std::size_t get_string_usage(const std::string& text) noexcept;
+
+        /// @brief Returns the heap memory owned by the vector, not counting memory owned by its elements.
+        /// @param values Vector to measure.
+        /// @return Owned bytes.
+        template<typename Value>
+        static std::size_t get_vector_usage(const std::vector<Value>& values) noexcept{
+            return values.capacity() * sizeof(Value);
+        }
+
+        /// @brief Returns the heap memory of the buckets and nodes of the unordered map, not counting memory owned by its entries.
+        /// @details Nodes hold the next pointer, the entry and the cached hash.
+        /// @param map Map to measure.
+        /// @return Owned bytes.
+        template<typename Map>
+        static std::size_t get_unordered_map_usage(const Map& map) noexcept{
+            const std::size_t node_size = sizeof(void*) + sizeof(typename Map::value_type) + sizeof(std::size_t);
+            //A single bucket is stored inline in the map
+            const std::size_t bucket_bytes = map.bucket_count() > 1 ? map.bucket_count() * sizeof(void*) : 0;
+            return bucket_bytes + (map.size() * node_size);
+        }
+
+        private:
+        std::vector<ComponentFootprint> components_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,139 @@
+#include <algorithm> //std::stable_sort, std::upper_bound
+#include <cctype> //std::isxdigit
+#include <sstream> //std::istringstream
+#include "symbol_table.h" //SymbolTable
+#include "../util/io/binary_reader.h" //BinaryReader
+
+namespace mygbc{
+
+    namespace{
+        /// @brief Parses a hex number filling the whole string.
+        /// @param text Text to parse.
+        /// @param value Parsed value.
+        /// @return Was the text a 1-4 digit hex number?
+        bool parse_hex_word(const std::string& text, uint16_t& value){
+            if(text.empty() || text.size() > 4){
+                return false;
+            }
+            for(const char digit : text){
+                if(!std::isxdigit(static_cast<unsigned char>(digit))){
+                    return false;
+                }
+            }
+            value = static_cast<uint16_t>(std::stoul(text, nullptr, 16));
+            return true;
+        }
+
+        /// @brief Orders symbols by bank and address.
+        bool symbol_less(const Symbol& first, const Symbol& second){
+            return first.bank != second.bank ? first.bank < second.bank : first.address < second.address;
+        }
+    }
+
+    /// @brief Parses the contents of a .sym file.
+    /// @param text Contents of the file.
+    /// @return Parsed symbols or error Status.
+    StatusOr<SymbolTable> SymbolTable::parse(const std::string& text){
+        SymbolTable table;
+        std::istringstream lines(text);
+        std::string line;
+        std::size_t line_number = 0;
+        while(std::getline(lines, line)){
+            ++line_number;
+            line = line.substr(0, line.find(';'));
+            std::istringstream fields(line);
+            std::string location;
+            std::string name;
+            if(!(fields >> location)){
+                continue;
+            }
+            const std::size_t separator = location.find(':');
+            Symbol symbol;
+            if(!(fields >> name) || separator == std::string::npos ||
+                !parse_hex_word(location.substr(0, separator), symbol.bank) ||
+                !parse_hex_word(location.substr(separator + 1), symbol.address)){
+                return Status::invalid_input_error("Malformed symbol on line " + std::to_string(line_number) + "!");
+            }
+            if(name.find('.') != std::string::npos){
+                continue;
+            }
+            symbol.name = name;
+            table.symbols_.push_back(std::move(symbol));
+        }
+        std::stable_sort(table.symbols_.begin(), table.symbols_.end(), symbol_less);
+        return table;
+    }
+
+    /// @brief Reads and parses the .sym file.
+    /// @param file_path Path to the file.
+    /// @return Parsed symbols or error Status.
+    StatusOr<SymbolTable> SymbolTable::load(const std::string& file_path){
+        StatusOr<std::vector<uint8_t>> bytes = BinaryReader::read_as_bytes(file_path);
+        if(!bytes.ok()){
+            return bytes.status();
+        }
+        return parse(std::string(bytes.value().begin(), bytes.value().end()));
+    }
+
+    /// @brief Returns the name of the memory section type containing the address.
+    /// @details Names follow the RGBDS section types (ROM0, ROMX, VRAM, SRAM, WRAM0, WRAMX, OAM, HRAM).
+    /// @param address Address to check.
+    /// @return Name of the section type.
+    const char* SymbolTable::get_section_type(const uint16_t address) noexcept{
+        if(address < 0x4000){ return "ROM0"; }
+        if(address < 0x8000){ return "ROMX"; }
+        if(address < 0xA000){ return "VRAM"; }
+        if(address < 0xC000){ return "SRAM"; }
+        if(address < 0xD000){ return "WRAM0"; }
+        if(address < 0xE000){ return "WRAMX"; }
+        if(address < 0xFE00){ return "ECHO"; }
+        if(address < 0xFF00){ return "OAM"; }
+        if(address < 0xFF80){ return "IO"; }
+        return "HRAM";
+    }
+
+    /// @brief Returns the first address of the memory section containing the address.
+    /// @param address Address to check.
+    /// @return First address of the section.
+    uint16_t SymbolTable::get_section_start(const uint16_t address) noexcept{
+        if(address < 0x4000){ return 0x0000; }
+        if(address < 0x8000){ return 0x4000; }
+        if(address < 0xA000){ return 0x8000; }
+        if(address < 0xC000){ return 0xA000; }
+        if(address < 0xD000){ return 0xC000; }
+        if(address < 0xE000){ return 0xD000; }
+        if(address < 0xFE00){ return 0xE000; }
+        if(address < 0xFF00){ return 0xFE00; }
+        if(address < 0xFF80){ return 0xFF00; }
+        return 0xFF80;
+    }
+
+    /// @brief Initializes empty table.
+    SymbolTable::SymbolTable(){
+    }
+
+    /// @brief Finds the symbol the address belongs to.
+    /// @details Closest symbol at or before the address in the same bank and section.
+    /// @param bank Bank of the address.
+    /// @param address Address to resolve.
+    /// @return Symbol or nullptr if there is none.
+    const Symbol* SymbolTable::find(const uint16_t bank, const uint16_t address) const noexcept{
+        const Symbol key{bank, address, ""};
+        std::vector<Symbol>::const_iterator after = std::upper_bound(symbols_.begin(), symbols_.end(), key, symbol_less);
+        if(after == symbols_.begin()){
+            return nullptr;
+        }
+        const Symbol& symbol = *(after - 1);
+        if(symbol.bank != bank || symbol.address < get_section_start(address)){
+            return nullptr;
+        }
+        return &symbol;
+    }
+
+    /// @brief Returns the symbols sorted by bank and address.
+    /// @return Symbols.
+    const std::vector<Symbol>& SymbolTable::get_symbols() const noexcept{
+        return symbols_;
+    }
+
+}//namespace_mygbc
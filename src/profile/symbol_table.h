@@ -0,0 +1,67 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Named address of the emulated code.
+    struct Symbol{
+        uint16_t bank;
+        uint16_t address;
+        std::string name;
+    };
+
+    /// @brief Symbols of a ROM parsed from a RGBDS .sym file.
+    /// @details Lines are "BB:AAAA Name" in hex, ';' starts a comment. Local labels (Parent.local) are skipped
+    ///         so addresses resolve to the enclosing function.
+    class SymbolTable{
+        public:
+
+        /// @brief Parses the contents of a .sym file.
+        /// @param text Contents of the file.
+        /// @return Parsed symbols or error Status.
+        static StatusOr<SymbolTable> parse(const std::string& text);
+
+        /// @brief Reads and parses the .sym file.
+        /// @param file_path Path to the file.
+        /// @return Parsed symbols or error Status.
+        static StatusOr<SymbolTable> load(const std::string& file_path);
+
+        /// @brief Returns the name of the memory section type containing the address.
+        /// @details Names follow the RGBDS section types (ROM0, ROMX, VRAM, SRAM, WRAM0, WRAMX, OAM, HRAM).
+        /// @param address Address to check.
+        /// @return Name of the section type.
+        static const char* get_section_type(const uint16_t address) noexcept;
+
+        /// @brief Returns the first address of the memory section containing the address.
+        /// @param address Address to check.
+        /// @return First address of the section.
+        static uint16_t get_section_start(const uint16_t address) noexcept;
+
+        /// @brief Initializes empty table.
+        SymbolTable();
+
+        /// @brief Finds the symbol the address belongs to.
+        /// @details Closest symbol at or before the address in the same bank and section.
+        /// @param bank Bank of the address.
+        /// @param address Address to resolve.
+        /// @return Symbol or nullptr if there is none.
+        const Symbol* find(const uint16_t bank, const uint16_t address) const noexcept;
+
+        /// @brief Returns the symbols sorted by bank and address.
+        /// @return Symbols.
+        const std::vector<Symbol>& get_symbols() const noexcept;
+
+        private:
+        //Symbols sorted by bank and address
+        std::vector<Symbol> symbols_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,178 @@
+#include <cstdio> //std::snprintf
+#include <fstream> //std::ofstream
+#include "trace_events.h" //TraceEventRecorder
+
+namespace mygbc{
+
+    namespace{
+        //Buffer of the calling thread, registered on first use
+        thread_local void* thread_buffer = nullptr;
+
+        /// @brief Escapes the text for a JSON string.
+        /// @param text Text to escape.
+        /// @return Escaped text.
+        std::string escape_json(const std::string& text){
+            std::string escaped;
+            escaped.reserve(text.size());
+            for(const char character : text){
+                if(character == '"' || character == '\\'){
+                    escaped += '\\';
+                    escaped += character;
+                }
+                else if(static_cast<unsigned char>(character) < 0x20){
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", character);
+                    escaped += code;
+                }
+                else{
+                    escaped += character;
+                }
+            }
+            return escaped;
+        }
+    }
+
+    /// @brief Gets a static instance of the recorder
+    /// @return Static instance of the recorder
+    TraceEventRecorder& TraceEventRecorder::instance(){
+        static TraceEventRecorder recorder;
+        return recorder;
+    }
+
+    /// @brief Initializes stopped recorder.
+    TraceEventRecorder::TraceEventRecorder()
+    :recording_(false), generation_(1),
+    start_time_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()){
+    }
+
+    /// @brief Drops the recorded events and starts recording.
+    /// @details Waits for the spans being recorded. Spans opened before the restart are dropped when they close.
+    ///         Thread names are kept.
+    void TraceEventRecorder::start(){
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        //Every buffer is held until the new generation is published, a span appended later checks against it
+        std::vector<std::unique_lock<std::mutex>> buffer_locks;
+        buffer_locks.reserve(buffers_.size());
+        for(const std::unique_ptr<ThreadBuffer>& buffer : buffers_){
+            buffer_locks.emplace_back(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped_events = 0;
+        }
+        start_time_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        //Released after the start time, a span that sees the new generation also sees the new start
+        generation_.fetch_add(1, std::memory_order_release);
+        recording_.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief Stops recording.
+    void TraceEventRecorder::stop() noexcept{
+        recording_.store(false, std::memory_order_relaxed);
+    }
+
+    /// @brief Appends the span to the buffer of the calling thread.
+    /// @details Spans of an earlier generation are dropped, their times are relative to an earlier start.
+    /// @param name Name of the span, must outlive the recorder.
+    /// @param generation Generation the span was opened in, see get_generation.
+    /// @param start_ns Start of the span, see now_ns.
+    /// @param duration_ns Duration of the span.
+    void TraceEventRecorder::record(const char* name, const uint64_t generation, const uint64_t start_ns, const uint64_t duration_ns){
+        ThreadBuffer& buffer = get_thread_buffer();
+        std::lock_guard<std::mutex> buffer_lock(buffer.mutex);
+        if(generation != generation_.load(std::memory_order_relaxed)){
+            return;
+        }
+        if(buffer.events.size() >= max_events_per_thread){
+            ++buffer.dropped_events;
+            return;
+        }
+        buffer.events.push_back(TraceEvent{name, start_ns, duration_ns});
+    }
+
+    /// @brief Names the calling thread in the exported timeline.
+    /// @param name Name of the thread.
+    void TraceEventRecorder::set_thread_name(const std::string& name){
+        ThreadBuffer& buffer = get_thread_buffer();
+        std::lock_guard<std::mutex> buffer_lock(buffer.mutex);
+        buffer.thread_name = name;
+    }
+
+    /// @brief Returns the number of recorded events.
+    /// @return Number of events in every buffer.
+    std::size_t TraceEventRecorder::get_event_count(){
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        std::size_t event_count = 0;
+        for(const std::unique_ptr<ThreadBuffer>& buffer : buffers_){
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            event_count += buffer->events.size();
+        }
+        return event_count;
+    }
+
+    /// @brief Returns the number of events dropped by full buffers.
+    /// @return Number of dropped events.
+    std::size_t TraceEventRecorder::get_dropped_event_count(){
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        std::size_t dropped_events = 0;
+        for(const std::unique_ptr<ThreadBuffer>& buffer : buffers_){
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            dropped_events += buffer->dropped_events;
+        }
+        return dropped_events;
+    }
+
+    /// @brief Formats the recorded events as Chrome trace-event JSON.
+    /// @details Call after stop once the recording threads have closed their spans.
+    /// @return JSON text.
+    std::string TraceEventRecorder::to_json(){
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first_event = true;
+        char times[96];
+        for(const std::unique_ptr<ThreadBuffer>& buffer : buffers_){
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            const std::string thread_id = std::to_string(buffer->thread_id);
+            if(!buffer->thread_name.empty()){
+                json += std::string(first_event ? "" : ",") + "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + thread_id +
+                    ",\"args\":{\"name\":\"" + escape_json(buffer->thread_name) + "\"}}";
+                first_event = false;
+            }
+            for(const TraceEvent& event : buffer->events){
+                //Timestamps are in microseconds
+                std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", event.start_ns / 1000.0, event.duration_ns / 1000.0);
+                json += std::string(first_event ? "" : ",") + "\n{\"name\":\"" + escape_json(event.name) + "\",\"cat\":\"mygbc\",\"ph\":\"X\"," +
+                    times + ",\"pid\":1,\"tid\":" + thread_id + "}";
+                first_event = false;
+            }
+        }
+        json += "\n]}\n";
+        return json;
+    }
+
+    /// @brief Writes the recorded events as Chrome trace-event JSON.
+    /// @param file_path Path to the file.
+    /// @return Status of the write.
+    Status TraceEventRecorder::write_json(const std::string& file_path){
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if(!file){
+            return Status::io_error("Could not open the trace event file for writing!");
+        }
+        file << to_json();
+        if(!file){
+            return Status::io_error("Could not write the trace event file!");
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the buffer of the calling thread, registers it on first use.
+    /// @return Buffer of the calling thread.
+    TraceEventRecorder::ThreadBuffer& TraceEventRecorder::get_thread_buffer(){
+        if(thread_buffer == nullptr){
+            std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+            buffers_.push_back(std::make_unique<ThreadBuffer>());
+            buffers_.back()->thread_id = static_cast<uint32_t>(buffers_.size());
+            thread_buffer = buffers_.back().get();
+        }
+        return *static_cast<ThreadBuffer*>(thread_buffer);
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,171 @@
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+#include <atomic> //std::atomic
+#include <chrono> //std::chrono::steady_clock
+#include <memory> //std::unique_ptr
+#include <mutex> //std::mutex
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../util/status/status.h" //Status
+
+//Records a span covering the rest of the scope, compiled out unless MYGBC_TRACE_EVENTS is defined
+//Name must be a string literal
+#if defined(MYGBC_TRACE_EVENTS)
+#define MYGBC_TRACE_CONCAT_INNER(first, second) first##second
+#define MYGBC_TRACE_CONCAT(first, second) MYGBC_TRACE_CONCAT_INNER(first, second)
+#define MYGBC_TRACE_SPAN(NAME) \
+    mygbc::ScopedTraceSpan MYGBC_TRACE_CONCAT(trace_span_, __LINE__)(NAME)
+#else
+#define MYGBC_TRACE_SPAN(NAME) ((void)0)
+#endif
+
+namespace mygbc{
+
+    /// @brief Completed span of host time.
+    struct TraceEvent{
+        const char* name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    /// @brief Records spans of host time into per-thread buffers and exports them as Chrome trace-event JSON.
+    /// @details The JSON opens in Perfetto and chrome://tracing. Each thread appends to its own buffer under the lock of
+    ///         the buffer, which only start and the readers contend for. The buffer is registered on the first span of the thread
+    ///         and kept for the lifetime of the recorder.
+    class TraceEventRecorder{
+        public:
+        //Maximum number of events kept per thread, later events are dropped
+        static constexpr std::size_t max_events_per_thread = 1 << 20;
+
+        /// @brief Gets a static instance of the recorder
+        /// @return Static instance of the recorder
+        static TraceEventRecorder& instance();
+
+        /// @brief Drops the recorded events and starts recording.
+        /// @details Waits for the spans being recorded. Spans opened before the restart are dropped when they close.
+        ///         Thread names are kept.
+        void start();
+
+        /// @brief Stops recording.
+        void stop() noexcept;
+
+        /// @brief Is the recorder recording?
+        /// @return Is the recorder recording?
+        bool is_recording() const noexcept{
+            return recording_.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Returns the recording generation, incremented by every start.
+        /// @details Read before now_ns so the start time belongs to the generation or a later one.
+        /// @return Recording generation.
+        uint64_t get_generation() const noexcept{
+            return generation_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Returns the host time since start.
+        /// @return Elapsed nanoseconds.
+        uint64_t now_ns() const noexcept{
+            const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            return static_cast<uint64_t>(now - start_time_ns_.load(std::memory_order_relaxed));
+        }
+
+        /// @brief Appends the span to the buffer of the calling thread.
+        /// @details Spans of an earlier generation are dropped, their times are relative to an earlier start.
+        /// @param name Name of the span, must outlive the recorder.
+        /// @param generation Generation the span was opened in, see get_generation.
+        /// @param start_ns Start of the span, see now_ns.
+        /// @param duration_ns Duration of the span.
+        void record(const char* name, const uint64_t generation, const uint64_t start_ns, const uint64_t duration_ns);
+
+        /// @brief Names the calling thread in the exported timeline.
+        /// @param name Name of the thread.
+        void set_thread_name(const std::string& name);
+
+        /// @brief Returns the number of recorded events.
+        /// @return Number of events in every buffer.
+        std::size_t get_event_count();
+
+        /// @brief Returns the number of events dropped by full buffers.
+        /// @return Number of dropped events.
+        std::size_t get_dropped_event_count();
+
+        /// @brief Formats the recorded events as Chrome trace-event JSON.
+        /// @details Call after stop once the recording threads have closed their spans.
+        /// @return JSON text.
+        std::string to_json();
+
+        /// @brief Writes the recorded events as Chrome trace-event JSON.
+        /// @param file_path Path to the file.
+        /// @return Status of the write.
+        Status write_json(const std::string& file_path);
+
+        private:
+
+        /// @brief Events of a single thread.
+        struct ThreadBuffer{
+            //Guards the other members, held by the owning thread while it appends
+            std::mutex mutex;
+            uint32_t thread_id = 0;
+            std::string thread_name;
+            std::vector<TraceEvent> events;
+            std::size_t dropped_events = 0;
+        };
+
+        /// @brief Initializes stopped recorder.
+        TraceEventRecorder();
+
+        /// @brief Returns the buffer of the calling thread, registers it on first use.
+        /// @return Buffer of the calling thread.
+        ThreadBuffer& get_thread_buffer();
+
+        //Is the recorder recording?
+        std::atomic<bool> recording_;
+
+        //Incremented by start, spans of an earlier generation are dropped
+        std::atomic<uint64_t> generation_;
+
+        //Host time of start in nanoseconds of the steady clock
+        std::atomic<int64_t> start_time_ns_;
+
+        //Guards the buffer list, taken before the lock of any buffer
+        std::mutex buffers_mutex_;
+
+        //Buffers of the threads in registration order
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    };
+
+    /// @brief Records a span from construction to destruction while the recorder is recording.
+    /// @details Use through MYGBC_TRACE_SPAN so it is compiled out by default.
+    class ScopedTraceSpan{
+        public:
+        /// @brief Opens the span.
+        /// @param name Name of the span, must outlive the recorder.
+        explicit ScopedTraceSpan(const char* name) noexcept
+        :name_(name), recording_(TraceEventRecorder::instance().is_recording()),
+        generation_(recording_ ? TraceEventRecorder::instance().get_generation() : 0), start_ns_(recording_ ? TraceEventRecorder::instance().now_ns() : 0){
+        }
+
+        /// @brief Closes the span and records it.
+        ~ScopedTraceSpan(){
+            if(recording_){
+                TraceEventRecorder& recorder = TraceEventRecorder::instance();
+                recorder.record(name_, generation_, start_ns_, recorder.now_ns() - start_ns_);
+            }
+        }
+
+        ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+        ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+        private:
+        const char* name_;
+        const bool recording_;
+        const uint64_t generation_;
+        const uint64_t start_ns_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,94 @@
+#include <cstring> //std::memcpy, std::memcmp
+#include "content_addressed_pool.h" //ContentAddressedPool
+#include "../util/hash/content_hash.h" //ContentHash
+
+namespace mygbc{
+
+    /// @brief Initializes empty pool.
+    /// @param entry_size Size of a single entry in bytes.
+    ContentAddressedPool::ContentAddressedPool(const std::size_t entry_size):entry_size_(entry_size){
+    }
+
+    /// @brief Finds or stores the content and adds a reference to it.
+    /// @param data Content of entry_size bytes.
+    /// @param inserted Set to true if the content was not stored before.
+    /// @return Identifier of the entry.
+    ContentAddressedPool::EntryId ContentAddressedPool::intern(const uint8_t* data, bool& inserted){
+        const uint64_t hash = ContentHash::hash(data, entry_size_);
+        const auto [first, last] = lookup_.equal_range(hash);
+        for(auto candidate = first; candidate != last; ++candidate){
+            if(std::memcmp(get(candidate->second), data, entry_size_) == 0){
+                ++reference_counts_[candidate->second];
+                inserted = false;
+                return candidate->second;
+            }
+        }
+        EntryId id;
+        if(!free_ids_.empty()){
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else{
+            id = static_cast<EntryId>(reference_counts_.size());
+            reference_counts_.push_back(0);
+            hashes_.push_back(0);
+            data_.resize(data_.size() + entry_size_);
+        }
+        std::memcpy(&data_[id * entry_size_], data, entry_size_);
+        reference_counts_[id] = 1;
+        hashes_[id] = hash;
+        lookup_.emplace(hash, id);
+        inserted = true;
+        return id;
+    }
+
+    /// @brief Adds a reference to the entry.
+    /// @param id Identifier of the entry.
+    void ContentAddressedPool::add_reference(const EntryId id) noexcept{
+        ++reference_counts_[id];
+    }
+
+    /// @brief Removes a reference from the entry, frees the entry at zero references.
+    /// @param id Identifier of the entry.
+    /// @return Was the entry freed?
+    bool ContentAddressedPool::release(const EntryId id){
+        if(--reference_counts_[id] > 0){
+            return false;
+        }
+        const auto [first, last] = lookup_.equal_range(hashes_[id]);
+        for(auto candidate = first; candidate != last; ++candidate){
+            if(candidate->second == id){
+                lookup_.erase(candidate);
+                break;
+            }
+        }
+        free_ids_.push_back(id);
+        return true;
+    }
+
+    /// @brief Returns the content of the entry.
+    /// @param id Identifier of the entry.
+    /// @return Pointer to entry_size bytes, valid until the next intern.
+    const uint8_t* ContentAddressedPool::get(const EntryId id) const noexcept{
+        return &data_[id * entry_size_];
+    }
+
+    /// @brief Returns the number of stored entries.
+    /// @return Number of stored entries.
+    std::size_t ContentAddressedPool::get_entry_count() const noexcept{
+        return reference_counts_.size() - free_ids_.size();
+    }
+
+    /// @brief Returns an estimate of the bytes used by the pool.
+    /// @return Used bytes.
+    std::size_t ContentAddressedPool::get_memory_usage() const noexcept{
+        //Lookup nodes hold the key, value and next pointer, plus a bucket pointer
+        const std::size_t lookup_entry_size = sizeof(uint64_t) + sizeof(EntryId) + (2 * sizeof(void*));
+        return data_.capacity() +
+            (reference_counts_.capacity() * sizeof(uint32_t)) +
+            (hashes_.capacity() * sizeof(uint64_t)) +
+            (free_ids_.capacity() * sizeof(EntryId)) +
+            (lookup_.size() * lookup_entry_size);
+    }
+
+}//namespace_mygbc
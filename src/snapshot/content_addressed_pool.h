@@ -0,0 +1,72 @@
+#ifndef CONTENT_ADDRESSED_POOL_H
+#define CONTENT_ADDRESSED_POOL_H
+
+#include <unordered_map> //std::unordered_multimap
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Reference counted pool of fixed size entries, each unique content is stored once.
+    /// @details Entries are found by ContentHash and confirmed with a byte compare. Freed slots are reused.
+    class ContentAddressedPool{
+        public:
+        //Identifier of a stored entry
+        using EntryId = uint32_t;
+
+        /// @brief Initializes empty pool.
+        /// @param entry_size Size of a single entry in bytes.
+        explicit ContentAddressedPool(const std::size_t entry_size);
+
+        /// @brief Finds or stores the content and adds a reference to it.
+        /// @param data Content of entry_size bytes.
+        /// @param inserted Set to true if the content was not stored before.
+        /// @return Identifier of the entry.
+        EntryId intern(const uint8_t* data, bool& inserted);
+
+        /// @brief Adds a reference to the entry.
+        /// @param id Identifier of the entry.
+        void add_reference(const EntryId id) noexcept;
+
+        /// @brief Removes a reference from the entry, frees the entry at zero references.
+        /// @param id Identifier of the entry.
+        /// @return Was the entry freed?
+        bool release(const EntryId id);
+
+        /// @brief Returns the content of the entry.
+        /// @param id Identifier of the entry.
+        /// @return Pointer to entry_size bytes, valid until the next intern.
+        const uint8_t* get(const EntryId id) const noexcept;
+
+        /// @brief Returns the number of stored entries.
+        /// @return Number of stored entries.
+        std::size_t get_entry_count() const noexcept;
+
+        /// @brief Returns an estimate of the bytes used by the pool.
+        /// @return Used bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        //Size of a single entry in bytes
+        const std::size_t entry_size_;
+
+        //Contents of the entries back to back
+        std::vector<uint8_t> data_;
+
+        //References per entry, 0 for free slots
+        std::vector<uint32_t> reference_counts_;
+
+        //Hash per entry, used to drop freed entries from the lookup
+        std::vector<uint64_t> hashes_;
+
+        //Free slots to reuse
+        std::vector<EntryId> free_ids_;
+
+        //Hash => Entries with the hash
+        std::unordered_multimap<uint64_t, EntryId> lookup_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,97 @@
+#include <algorithm> //std::equal
+#include <array> //std::array
+#include <cstring> //std::memcpy
+#include "gbc_snapshot.h" //GBCSnapshot
+#include "../util/compression/snapshot_codec.h" //SnapshotCodec
+
+namespace mygbc{
+
+    namespace{
+        //Save state magic and format version
+        constexpr std::array<uint8_t, 4> save_state_magic = {'M', 'G', 'S', 'S'};
+        constexpr uint8_t save_state_version = 1;
+
+        //Magic, version, incremental flag, registers, cycle count and stored pages
+        constexpr std::size_t save_state_header_size = sizeof(save_state_magic) + 2 + (GBCSnapshot::register_count * sizeof(uint16_t)) + sizeof(uint64_t) + (PageBitmap::page_count / 8);
+    }
+
+    /// @brief Initializes empty full snapshot.
+    GBCSnapshot::GBCSnapshot():register_words{}, cycle_count(0), incremental(false), stored_pages(), page_data(){
+    }
+
+    /// @brief Returns the amount of bytes used by the snapshot.
+    /// @return Size of the snapshot in bytes.
+    std::size_t GBCSnapshot::get_size_in_bytes() const noexcept{
+        return sizeof(GBCSnapshot) + page_data.capacity();
+    }
+
+    /// @brief Serializes the snapshot as a save state.
+    /// @details Header with the registers, cycle count and stored pages followed by the page data compressed with SnapshotCodec.
+    /// @return Save state bytes.
+    std::vector<uint8_t> GBCSnapshot::to_bytes() const{
+        std::vector<uint8_t> compressed_pages;
+        SnapshotCodec::compress(page_data.data(), page_data.size(), compressed_pages);
+        std::vector<uint8_t> bytes;
+        bytes.reserve(save_state_header_size + compressed_pages.size());
+        bytes.resize(save_state_magic.size());
+        std::memcpy(bytes.data(), save_state_magic.data(), save_state_magic.size());
+        bytes.push_back(save_state_version);
+        bytes.push_back(incremental ? 0x01 : 0x00);
+        for(const uint16_t word : register_words){
+            bytes.push_back(static_cast<uint8_t>(word & 0xFF));
+            bytes.push_back(static_cast<uint8_t>(word >> 8));
+        }
+        for(uint8_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index){
+            bytes.push_back(static_cast<uint8_t>(cycle_count >> (byte_index * 8)));
+        }
+        for(std::size_t page_group = 0; page_group < PageBitmap::page_count; page_group += 8){
+            uint8_t page_bits = 0;
+            for(uint8_t bit = 0; bit < 8; ++bit){
+                page_bits |= static_cast<uint8_t>(stored_pages.test(static_cast<uint8_t>(page_group + bit)) << bit);
+            }
+            bytes.push_back(page_bits);
+        }
+        bytes.insert(bytes.end(), compressed_pages.begin(), compressed_pages.end());
+        return bytes;
+    }
+
+    /// @brief Parses a save state produced by to_bytes.
+    /// @param bytes Save state bytes.
+    /// @return Parsed snapshot or error Status.
+    StatusOr<GBCSnapshot> GBCSnapshot::from_bytes(const std::vector<uint8_t>& bytes){
+        if(
+            bytes.size() < save_state_header_size ||
+            !std::equal(save_state_magic.begin(), save_state_magic.end(), bytes.begin()) ||
+            bytes[sizeof(save_state_magic)] != save_state_version
+        ){
+            return Status::invalid_input_error("Given bytes are not a supported save state!");
+        }
+        GBCSnapshot snapshot;
+        const uint8_t* source = bytes.data() + sizeof(save_state_magic) + 1;
+        snapshot.incremental = (*source++ != 0x00);
+        for(uint16_t& word : snapshot.register_words){
+            word = static_cast<uint16_t>(source[0] | (source[1] << 8));
+            source += 2;
+        }
+        for(uint8_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index){
+            snapshot.cycle_count |= static_cast<uint64_t>(*source++) << (byte_index * 8);
+        }
+        for(std::size_t page_group = 0; page_group < PageBitmap::page_count; page_group += 8){
+            const uint8_t page_bits = *source++;
+            for(uint8_t bit = 0; bit < 8; ++bit){
+                if((page_bits >> bit) & 0x01){
+                    snapshot.stored_pages.set(static_cast<uint8_t>(page_group + bit));
+                }
+            }
+        }
+        Status decompress_status = SnapshotCodec::decompress(source, bytes.size() - save_state_header_size, snapshot.page_data);
+        if(!decompress_status.ok()){
+            return decompress_status;
+        }
+        if(snapshot.page_data.size() != snapshot.stored_pages.count() * PageBitmap::page_size){
+            return Status::invalid_input_error("Save state page data does not match the stored pages!");
+        }
+        return snapshot;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,55 @@
+#ifndef GBC_SNAPSHOT_H
+#define GBC_SNAPSHOT_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../memory/page_bitmap.h" //PageBitmap
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Captured state of a GBC, restored with GBC::restore_snapshot.
+    /// @details Full snapshots store every page of the address space. Incremental snapshots only store
+    ///         the pages written to since the previous snapshot and are restored on top of it.
+    struct GBCSnapshot{
+        //Number of 16-bit registers in the LR35902RegisterFile
+        static constexpr std::size_t register_count = 7;
+
+        //Register words in the order ir_ie, a_f, b_c, d_e, h_l, pc, sp
+        std::array<uint16_t, register_count> register_words;
+
+        //T-cycles executed since power on
+        uint64_t cycle_count;
+
+        //Was the snapshot taken relative to the previous snapshot?
+        bool incremental;
+
+        //Pages stored in page_data
+        PageBitmap stored_pages;
+
+        //Contents of the stored pages in ascending page order
+        std::vector<uint8_t> page_data;
+
+        /// @brief Initializes empty full snapshot.
+        GBCSnapshot();
+
+        /// @brief Returns the amount of bytes used by the snapshot.
+        /// @return Size of the snapshot in bytes.
+        std::size_t get_size_in_bytes() const noexcept;
+
+        /// @brief Serializes the snapshot as a save state.
+        /// @details Header with the registers, cycle count and stored pages followed by the page data compressed with SnapshotCodec.
+        /// @return Save state bytes.
+        std::vector<uint8_t> to_bytes() const;
+
+        /// @brief Parses a save state produced by to_bytes.
+        /// @param bytes Save state bytes.
+        /// @return Parsed snapshot or error Status.
+        static StatusOr<GBCSnapshot> from_bytes(const std::vector<uint8_t>& bytes);
+    };
+
+}//namespace_mygbc
+
+#endif
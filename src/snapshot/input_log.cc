@@ -0,0 +1,56 @@
+#include <algorithm> //std::upper_bound, std::lower_bound
+#include "input_log.h" //InputLog
+
+namespace mygbc{
+
+    /// @brief Records the joypad state at the cycle.
+    /// @details Events at or after the cycle belong to an abandoned timeline and are dropped.
+    /// @param cycle T-cycle the state was applied at.
+    /// @param buttons Pressed buttons.
+    void InputLog::record(const uint64_t cycle, const uint8_t buttons){
+        auto abandoned = std::lower_bound(events_.begin(), events_.end(), cycle,
+            [](const InputEvent& event, const uint64_t value){return event.cycle < value;}
+        );
+        events_.erase(abandoned, events_.end());
+        events_.push_back(InputEvent{cycle, buttons});
+    }
+
+    /// @brief Returns the joypad state in effect at the cycle.
+    /// @param cycle T-cycle to query.
+    /// @return Pressed buttons, 0 if there was no input before the cycle.
+    uint8_t InputLog::get_buttons_at(const uint64_t cycle) const noexcept{
+        const std::size_t next_event = find_next(cycle);
+        if(next_event == 0){
+            return 0;
+        }
+        return events_[next_event - 1].buttons;
+    }
+
+    /// @brief Returns the index of the first event after the cycle.
+    /// @param cycle T-cycle to query.
+    /// @return Index of the event or the event count if there is none.
+    std::size_t InputLog::find_next(const uint64_t cycle) const noexcept{
+        auto next_event = std::upper_bound(events_.begin(), events_.end(), cycle,
+            [](const uint64_t value, const InputEvent& event){return value < event.cycle;}
+        );
+        return static_cast<std::size_t>(next_event - events_.begin());
+    }
+
+    /// @brief Returns the recorded events.
+    /// @return Recorded events in cycle order.
+    const std::vector<InputEvent>& InputLog::get_events() const noexcept{
+        return events_;
+    }
+
+    /// @brief Drops every recorded event.
+    void InputLog::clear() noexcept{
+        events_.clear();
+    }
+
+    /// @brief Returns the memory used by the recorded events.
+    /// @return Memory usage in bytes.
+    std::size_t InputLog::get_memory_usage() const noexcept{
+        return events_.capacity() * sizeof(InputEvent);
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,54 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Joypad state change at a cycle.
+    struct InputEvent{
+        uint64_t cycle; //T-cycle the state was applied at
+        uint8_t buttons; //Pressed buttons, see MemoryController::set_joypad_state
+    };
+
+    /// @brief Recorded joypad inputs in cycle order, used for deterministic replay.
+    class InputLog{
+        public:
+
+        /// @brief Records the joypad state at the cycle.
+        /// @details Events at or after the cycle belong to an abandoned timeline and are dropped.
+        /// @param cycle T-cycle the state was applied at.
+        /// @param buttons Pressed buttons.
+        void record(const uint64_t cycle, const uint8_t buttons);
+
+        /// @brief Returns the joypad state in effect at the cycle.
+        /// @param cycle T-cycle to query.
+        /// @return Pressed buttons, 0 if there was no input before the cycle.
+        uint8_t get_buttons_at(const uint64_t cycle) const noexcept;
+
+        /// @brief Returns the index of the first event after the cycle.
+        /// @param cycle T-cycle to query.
+        /// @return Index of the event or the event count if there is none.
+        std::size_t find_next(const uint64_t cycle) const noexcept;
+
+        /// @brief Returns the recorded events.
+        /// @return Recorded events in cycle order.
+        const std::vector<InputEvent>& get_events() const noexcept;
+
+        /// @brief Drops every recorded event.
+        void clear() noexcept;
+
+        /// @brief Returns the memory used by the recorded events.
+        /// @return Memory usage in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        //Events in cycle order
+        std::vector<InputEvent> events_;
+    };
+
+}//namespace_mygbc
+
+#endif
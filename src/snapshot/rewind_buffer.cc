@@ -0,0 +1,239 @@
+#include <cstring> //std::memcpy
+#include "rewind_buffer.h" //RewindBuffer
+#include "../util/compression/snapshot_codec.h" //SnapshotCodec
+
+namespace mygbc{
+
+    /// @brief Initializes empty buffer for the given GBC.
+    /// @param gbc GBC to capture and rewind. Must outlive the buffer.
+    /// @param memory_budget_in_bytes Maximum memory used by the captures, see get_scratch_memory_usage for the fixed overhead.
+    /// @param frame_interval Capture every N frames.
+    /// @param keyframe_interval Store a keyframe every N captures.
+    RewindBuffer::RewindBuffer(GBC& gbc, const std::size_t memory_budget_in_bytes, const uint32_t frame_interval, const uint32_t keyframe_interval)
+    :gbc_(gbc), dirty_page_consumer_id_(gbc.register_dirty_page_consumer()), memory_budget_in_bytes_(memory_budget_in_bytes),
+    frame_interval_(frame_interval > 0 ? frame_interval : 1), keyframe_interval_(keyframe_interval > 0 ? keyframe_interval : 1),
+    memory_usage_(0), keyframe_group_memory_usage_(0), captures_since_keyframe_(0), previous_state_(state_size, 0x00), delta_buffer_(state_size, 0x00){
+    }
+
+    /// @brief Unregisters the dirty page consumer.
+    RewindBuffer::~RewindBuffer(){
+        gbc_.unregister_dirty_page_consumer(dirty_page_consumer_id_);
+    }
+
+    /// @brief Captures the state if the current frame is on the capture interval.
+    /// @details Call after each GBC::run_frame.
+    /// @return Status of the capture.
+    Status RewindBuffer::on_frame_end(){
+        const uint64_t frame = gbc_.get_frame_count();
+        if((frame % frame_interval_) != 0 || (!captures_.empty() && captures_.back().frame == frame)){
+            return Status::ok_status();
+        }
+        return capture();
+    }
+
+    /// @brief Captures the current state of the GBC.
+    /// @return Status of the capture.
+    Status RewindBuffer::capture(){
+        //A new keyframe lets enforce_budget drop the older groups, so no group outgrows half of the budget
+        const bool keyframe = captures_.empty() || captures_since_keyframe_ >= keyframe_interval_ ||
+            keyframe_group_memory_usage_ >= memory_budget_in_bytes_ / 2;
+        PageBitmap pages = gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        if(keyframe){
+            pages.set_all();
+        }
+        //Header is always part of the delta
+        const std::size_t header_size = state_size - MemoryController::address_space_size;
+        uint8_t header[header_size];
+        write_state_header(header);
+        for(std::size_t index = 0; index < header_size; ++index){
+            delta_buffer_[index] = keyframe ? header[index] : (header[index] ^ previous_state_[index]);
+            previous_state_[index] = header[index];
+        }
+        //Only the written pages are read and stored, the others are unchanged since the previous capture
+        std::size_t delta_size = header_size;
+        MemoryController& memory = gbc_.get_memory();
+        for(std::size_t page = pages.find_next(0); page < PageBitmap::page_count; page = pages.find_next(page + 1)){
+            uint8_t* delta_page = &delta_buffer_[delta_size];
+            uint8_t* previous_page = &previous_state_[header_size + (page * PageBitmap::page_size)];
+            memory.read_page(static_cast<uint8_t>(page), delta_page);
+            if(keyframe){
+                std::memcpy(previous_page, delta_page, PageBitmap::page_size);
+            }
+            else{
+                for(std::size_t index = 0; index < PageBitmap::page_size; ++index){
+                    const uint8_t byte = delta_page[index];
+                    delta_page[index] = byte ^ previous_page[index];
+                    previous_page[index] = byte;
+                }
+            }
+            delta_size += PageBitmap::page_size;
+        }
+        SnapshotCodec::compress(delta_buffer_.data(), delta_size, encode_buffer_);
+        Capture capture{gbc_.get_frame_count(), keyframe, pages, std::vector<uint8_t>(encode_buffer_.begin(), encode_buffer_.end())};
+        const std::size_t capture_memory_usage = sizeof(Capture) + capture.data.capacity();
+        memory_usage_ += capture_memory_usage;
+        keyframe_group_memory_usage_ = keyframe ? capture_memory_usage : (keyframe_group_memory_usage_ + capture_memory_usage);
+        captures_.push_back(std::move(capture));
+        captures_since_keyframe_ = keyframe ? 1 : (captures_since_keyframe_ + 1);
+        enforce_budget();
+        return Status::ok_status();
+    }
+
+    /// @brief Restores the GBC to the given frame.
+    /// @details Restores the nearest capture at or before the frame and runs the remaining frames.
+    ///         Captures after the frame are discarded.
+    /// @param frame Frame to rewind to.
+    /// @return Status of the rewind.
+    Status RewindBuffer::rewind_to_frame(const uint64_t frame){
+        if(captures_.empty() || frame < captures_.front().frame){
+            return Status::invalid_index_error(
+                "Frame is outside of the rewind window! (Frame: " + std::to_string(frame) + "/ Oldest: " +
+                std::to_string(get_oldest_frame()) + ")."
+            );
+        }
+        //Nearest capture at or before the frame and the keyframe it depends on
+        std::size_t target = captures_.size() - 1;
+        while(captures_[target].frame > frame){
+            --target;
+        }
+        std::size_t keyframe = target;
+        while(!captures_[keyframe].keyframe){
+            --keyframe;
+        }
+        std::vector<uint8_t> state(state_size, 0x00);
+        for(std::size_t index = keyframe; index <= target; ++index){
+            Status apply_status = apply_delta(captures_[index], state);
+            if(!apply_status.ok()){
+                return apply_status;
+            }
+        }
+        Status restore_status = restore_state(state);
+        if(!restore_status.ok()){
+            return restore_status;
+        }
+        //Timeline after the target is gone
+        while(captures_.size() > target + 1){
+            memory_usage_ -= sizeof(Capture) + captures_.back().data.capacity();
+            captures_.pop_back();
+        }
+        captures_since_keyframe_ = static_cast<uint32_t>(target - keyframe + 1);
+        keyframe_group_memory_usage_ = 0;
+        for(std::size_t index = keyframe; index <= target; ++index){
+            keyframe_group_memory_usage_ += sizeof(Capture) + captures_[index].data.capacity();
+        }
+        previous_state_ = std::move(state);
+        gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        //Replay the frames after the capture
+        while(gbc_.get_frame_count() < frame){
+            Status frame_status = gbc_.run_frame();
+            if(!frame_status.ok()){
+                return frame_status;
+            }
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of captures in the buffer.
+    /// @return Number of captures.
+    std::size_t RewindBuffer::get_capture_count() const noexcept{
+        return captures_.size();
+    }
+
+    /// @brief Returns the frame of the oldest capture.
+    /// @return Frame of the oldest capture or 0 if empty.
+    uint64_t RewindBuffer::get_oldest_frame() const noexcept{
+        return captures_.empty() ? 0 : captures_.front().frame;
+    }
+
+    /// @brief Returns the memory used by the captures.
+    /// @return Used memory in bytes.
+    std::size_t RewindBuffer::get_memory_usage() const noexcept{
+        return memory_usage_;
+    }
+
+    /// @brief Returns the memory of the buffers reused between captures.
+    /// @details Fixed overhead of about two states plus the codec buffers, not counted against the budget.
+    /// @return Used memory in bytes.
+    std::size_t RewindBuffer::get_scratch_memory_usage() const noexcept{
+        return previous_state_.capacity() + delta_buffer_.capacity() + encode_buffer_.capacity() + decode_buffer_.capacity();
+    }
+
+    /// @brief Serializes the registers and cycle count of the GBC.
+    /// @param destination Buffer of at least state_size bytes.
+    void RewindBuffer::write_state_header(uint8_t* destination){
+        const std::array<uint16_t, GBCSnapshot::register_count> register_words = gbc_.get_processing_unit().get_register_file().get_register_words();
+        for(const uint16_t word : register_words){
+            *destination++ = static_cast<uint8_t>(word & 0xFF);
+            *destination++ = static_cast<uint8_t>(word >> 8);
+        }
+        const uint64_t cycle_count = gbc_.get_cycle_count();
+        for(uint8_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index){
+            *destination++ = static_cast<uint8_t>(cycle_count >> (byte_index * 8));
+        }
+    }
+
+    /// @brief Restores the GBC from serialized state.
+    /// @param state Serialized state.
+    /// @return Status of the restore.
+    Status RewindBuffer::restore_state(const std::vector<uint8_t>& state){
+        GBCSnapshot snapshot;
+        const uint8_t* source = state.data();
+        for(uint16_t& word : snapshot.register_words){
+            word = static_cast<uint16_t>(source[0] | (source[1] << 8));
+            source += 2;
+        }
+        for(uint8_t byte_index = 0; byte_index < sizeof(uint64_t); ++byte_index){
+            snapshot.cycle_count |= static_cast<uint64_t>(*source++) << (byte_index * 8);
+        }
+        snapshot.stored_pages.set_all();
+        snapshot.page_data.assign(source, state.data() + state.size());
+        return gbc_.restore_snapshot(snapshot);
+    }
+
+    /// @brief Drops the oldest keyframe groups until the budget is met.
+    /// @details The newest keyframe group is always kept, capture forces a keyframe before it outgrows half of the budget.
+    void RewindBuffer::enforce_budget(){
+        while(memory_usage_ > memory_budget_in_bytes_){
+            //Find the start of the second keyframe group
+            std::size_t next_keyframe = 1;
+            while(next_keyframe < captures_.size() && !captures_[next_keyframe].keyframe){
+                ++next_keyframe;
+            }
+            if(next_keyframe >= captures_.size()){
+                return;
+            }
+            for(std::size_t index = 0; index < next_keyframe; ++index){
+                memory_usage_ -= sizeof(Capture) + captures_.front().data.capacity();
+                captures_.pop_front();
+            }
+        }
+    }
+
+    /// @brief XORs the encoded delta of the capture into the state.
+    /// @param capture Capture to apply.
+    /// @param state State to apply the delta to.
+    /// @return Status of the apply.
+    Status RewindBuffer::apply_delta(const Capture& capture, std::vector<uint8_t>& state){
+        Status decompress_status = SnapshotCodec::decompress(capture.data, decode_buffer_);
+        if(!decompress_status.ok()){
+            return decompress_status;
+        }
+        const std::size_t header_size = state_size - MemoryController::address_space_size;
+        if(decode_buffer_.size() != header_size + (capture.pages.count() * PageBitmap::page_size)){
+            return Status::invalid_input_error("Rewind delta does not match its pages!");
+        }
+        for(std::size_t index = 0; index < header_size; ++index){
+            state[index] ^= decode_buffer_[index];
+        }
+        const uint8_t* delta_page = decode_buffer_.data() + header_size;
+        for(std::size_t page = capture.pages.find_next(0); page < PageBitmap::page_count; page = capture.pages.find_next(page + 1)){
+            uint8_t* state_page = state.data() + header_size + (page * PageBitmap::page_size);
+            for(std::size_t index = 0; index < PageBitmap::page_size; ++index){
+                state_page[index] ^= delta_page[index];
+            }
+            delta_page += PageBitmap::page_size;
+        }
+        return Status::ok_status();
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,134 @@
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include <deque> //std::deque
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Ring of GBC states captured every N frames within a fixed memory budget.
+    /// @details Each capture stores only the pages written since the previous capture, as XOR deltas against the previous capture
+    ///         compressed with SnapshotCodec, so a capture costs the dirty pages instead of the address space. Every keyframe_interval
+    ///         captures a keyframe (every page, delta against zeroed state) is stored instead. Oldest keyframe groups are
+    ///         dropped when the budget is exceeded. A keyframe is also forced once the newest group uses half of the budget,
+    ///         so the memory stays within the budget whatever the keyframe interval, as long as a capture fits in half of it.
+    class RewindBuffer{
+        public:
+
+        /// @brief Initializes empty buffer for the given GBC.
+        /// @param gbc GBC to capture and rewind. Must outlive the buffer.
+        /// @param memory_budget_in_bytes Maximum memory used by the captures, see get_scratch_memory_usage for the fixed overhead.
+        /// @param frame_interval Capture every N frames.
+        /// @param keyframe_interval Store a keyframe every N captures.
+        RewindBuffer(GBC& gbc, const std::size_t memory_budget_in_bytes, const uint32_t frame_interval, const uint32_t keyframe_interval);
+
+        /// @brief Unregisters the dirty page consumer.
+        ~RewindBuffer();
+
+        RewindBuffer(const RewindBuffer&) = delete;
+        RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+        /// @brief Captures the state if the current frame is on the capture interval.
+        /// @details Call after each GBC::run_frame.
+        /// @return Status of the capture.
+        Status on_frame_end();
+
+        /// @brief Captures the current state of the GBC.
+        /// @return Status of the capture.
+        Status capture();
+
+        /// @brief Restores the GBC to the given frame.
+        /// @details Restores the nearest capture at or before the frame and runs the remaining frames.
+        ///         Captures after the frame are discarded.
+        /// @param frame Frame to rewind to.
+        /// @return Status of the rewind.
+        Status rewind_to_frame(const uint64_t frame);
+
+        /// @brief Returns the number of captures in the buffer.
+        /// @return Number of captures.
+        std::size_t get_capture_count() const noexcept;
+
+        /// @brief Returns the frame of the oldest capture.
+        /// @return Frame of the oldest capture or 0 if empty.
+        uint64_t get_oldest_frame() const noexcept;
+
+        /// @brief Returns the memory used by the captures.
+        /// @details Counted against the budget.
+        /// @return Used memory in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        /// @brief Returns the memory of the buffers reused between captures.
+        /// @details Fixed overhead of about two states plus the codec buffers, not counted against the budget.
+        /// @return Used memory in bytes.
+        std::size_t get_scratch_memory_usage() const noexcept;
+
+        //Size of the serialized state (registers, cycle count and address space)
+        static constexpr std::size_t state_size = (GBCSnapshot::register_count * sizeof(uint16_t)) + sizeof(uint64_t) + MemoryController::address_space_size;
+
+        private:
+        //Single capture in the buffer
+        struct Capture{
+            uint64_t frame; //Frame of the capture
+            bool keyframe; //Delta against zeroed state?
+            PageBitmap pages; //Pages in the delta
+            std::vector<uint8_t> data; //Encoded delta of the header and the pages
+        };
+
+        /// @brief Serializes the registers and cycle count of the GBC.
+        /// @param destination Buffer of at least state_size bytes.
+        void write_state_header(uint8_t* destination);
+
+        /// @brief Restores the GBC from serialized state.
+        /// @param state Serialized state.
+        /// @return Status of the restore.
+        Status restore_state(const std::vector<uint8_t>& state);
+
+        /// @brief Drops the oldest keyframe groups until the budget is met.
+        /// @details The newest keyframe group is always kept, capture forces a keyframe before it outgrows half of the budget.
+        void enforce_budget();
+
+        /// @brief XORs the encoded delta of the capture into the state.
+        /// @param capture Capture to apply.
+        /// @param state State to apply the delta to.
+        /// @return Status of the apply.
+        Status apply_delta(const Capture& capture, std::vector<uint8_t>& state);
+
+        //Captured GBC
+        GBC& gbc_;
+
+        //Dirty page consumer id of the buffer
+        const std::size_t dirty_page_consumer_id_;
+
+        //Configuration of the buffer
+        const std::size_t memory_budget_in_bytes_;
+        const uint32_t frame_interval_;
+        const uint32_t keyframe_interval_;
+
+        //Captures from oldest to newest
+        std::deque<Capture> captures_;
+
+        //Memory used by the captures
+        std::size_t memory_usage_;
+
+        //Memory used by the captures of the newest keyframe group
+        std::size_t keyframe_group_memory_usage_;
+
+        //Captures since the newest keyframe
+        uint32_t captures_since_keyframe_;
+
+        //State at the newest capture
+        std::vector<uint8_t> previous_state_;
+
+        //Scratch buffers reused between captures, the delta holds the header and the stored pages back to back
+        std::vector<uint8_t> delta_buffer_;
+        std::vector<uint8_t> encode_buffer_;
+        std::vector<uint8_t> decode_buffer_;
+    };
+
+}//namespace_mygbc
+
+#endif
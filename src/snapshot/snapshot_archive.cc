@@ -0,0 +1,241 @@
+#include <algorithm> //std::equal, std::min
+#include <filesystem> //std::filesystem
+#include <string> //std::to_string
+#include "snapshot_archive.h" //SnapshotArchiveWriter, SnapshotArchive
+#include "../util/hash/content_hash.h" //ContentHash
+
+namespace mygbc{
+
+    namespace{
+
+        /// @brief Writes the value little-endian.
+        /// @param value Value to write.
+        /// @param byte_count Number of bytes to write.
+        /// @param destination Buffer to write to.
+        void write_le(const uint64_t value, const std::size_t byte_count, uint8_t* destination) noexcept{
+            for(std::size_t byte = 0; byte < byte_count; ++byte){
+                destination[byte] = static_cast<uint8_t>(value >> (byte * 8));
+            }
+        }
+
+        /// @brief Reads little-endian value.
+        /// @param source Buffer to read from.
+        /// @param byte_count Number of bytes to read.
+        /// @return Read value.
+        uint64_t read_le(const uint8_t* source, const std::size_t byte_count) noexcept{
+            uint64_t value = 0;
+            for(std::size_t byte = 0; byte < byte_count; ++byte){
+                value |= static_cast<uint64_t>(source[byte]) << (byte * 8);
+            }
+            return value;
+        }
+
+        /// @brief Validates the file header.
+        /// @param header File header of SnapshotArchiveFormat::file_header_size bytes.
+        /// @return Status of the validation.
+        Status validate_file_header(const uint8_t* header){
+            if(!std::equal(SnapshotArchiveFormat::magic.begin(), SnapshotArchiveFormat::magic.end(), header)){
+                return Status::invalid_input_error("File is not a snapshot archive!");
+            }
+            if(read_le(header + SnapshotArchiveFormat::magic.size(), 2) != SnapshotArchiveFormat::version){
+                return Status::invalid_input_error("Unsupported snapshot archive version!");
+            }
+            if(read_le(header + SnapshotArchiveFormat::record_size_offset, 4) != SnapshotArchiveFormat::record_size){
+                return Status::invalid_input_error("Unsupported snapshot archive record size!");
+            }
+            return Status::ok_status();
+        }
+    }
+
+    /// @brief Initializes closed writer.
+    SnapshotArchiveWriter::SnapshotArchiveWriter():record_count_(0){
+    }
+
+    /// @brief Opens the archive for appending, creates it if it does not exist.
+    /// @param file_path Path to the archive.
+    /// @return Status of the open.
+    Status SnapshotArchiveWriter::open(const std::string& file_path){
+        std::error_code error;
+        const bool exists = std::filesystem::exists(file_path, error) && std::filesystem::file_size(file_path, error) > 0;
+        if(!exists){
+            std::ofstream create(file_path, std::ios::binary | std::ios::trunc);
+            std::array<uint8_t, SnapshotArchiveFormat::file_header_size> header{};
+            std::copy(SnapshotArchiveFormat::magic.begin(), SnapshotArchiveFormat::magic.end(), header.begin());
+            write_le(SnapshotArchiveFormat::version, 2, &header[SnapshotArchiveFormat::magic.size()]);
+            write_le(SnapshotArchiveFormat::record_size, 4, &header[SnapshotArchiveFormat::record_size_offset]);
+            create.write(reinterpret_cast<const char*>(header.data()), header.size());
+            if(!create){
+                return Status::io_error("Could not create snapshot archive at " + file_path + "!");
+            }
+        }
+        file_.open(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        if(!file_){
+            return Status::io_error("Could not open snapshot archive at " + file_path + "!");
+        }
+        std::array<uint8_t, SnapshotArchiveFormat::file_header_size> header{};
+        file_.read(reinterpret_cast<char*>(header.data()), header.size());
+        if(!file_){
+            return Status::invalid_input_error("Snapshot archive header is truncated!");
+        }
+        Status header_status = validate_file_header(header.data());
+        if(!header_status.ok()){
+            return header_status;
+        }
+        record_count_ = read_le(&header[SnapshotArchiveFormat::record_count_offset], 8);
+        return Status::ok_status();
+    }
+
+    /// @brief Appends the full snapshot.
+    /// @param snapshot Full snapshot to append.
+    /// @return Index of the appended record or error Status.
+    StatusOr<std::size_t> SnapshotArchiveWriter::append(const GBCSnapshot& snapshot){
+        if(!file_.is_open()){
+            return Status::io_error("Snapshot archive is not open!");
+        }
+        if(snapshot.incremental || snapshot.page_data.size() != PageBitmap::page_count * PageBitmap::page_size){
+            return Status::invalid_input_error("Only full snapshots can be archived!");
+        }
+        std::array<uint8_t, SnapshotArchiveFormat::record_header_size> record_header{};
+        for(std::size_t word = 0; word < GBCSnapshot::register_count; ++word){
+            write_le(snapshot.register_words[word], 2, &record_header[word * 2]);
+        }
+        write_le(snapshot.cycle_count, 8, &record_header[SnapshotArchiveFormat::cycle_count_offset]);
+        write_le(ContentHash::hash(snapshot.page_data.data(), snapshot.page_data.size()), 8, &record_header[SnapshotArchiveFormat::page_hash_offset]);
+        //Records are written after the last complete record, a torn append is overwritten by the next one
+        const std::size_t record_offset = SnapshotArchiveFormat::file_header_size + (record_count_ * SnapshotArchiveFormat::record_size);
+        file_.seekp(static_cast<std::streamoff>(record_offset));
+        file_.write(reinterpret_cast<const char*>(record_header.data()), record_header.size());
+        file_.write(reinterpret_cast<const char*>(snapshot.page_data.data()), snapshot.page_data.size());
+        file_.flush();
+        std::array<uint8_t, 8> record_count{};
+        write_le(record_count_ + 1, record_count.size(), record_count.data());
+        file_.seekp(SnapshotArchiveFormat::record_count_offset);
+        file_.write(reinterpret_cast<const char*>(record_count.data()), record_count.size());
+        file_.flush();
+        if(!file_){
+            return Status::io_error("Could not write to the snapshot archive!");
+        }
+        return record_count_++;
+    }
+
+    /// @brief Returns the number of records in the archive.
+    /// @return Number of records.
+    std::size_t SnapshotArchiveWriter::get_snapshot_count() const noexcept{
+        return record_count_;
+    }
+
+    /// @brief Initializes closed archive.
+    SnapshotArchive::SnapshotArchive():record_count_(0){
+    }
+
+    /// @brief Maps the archive and validates the file header.
+    /// @param file_path Path to the archive.
+    /// @return Status of the open.
+    Status SnapshotArchive::open(const std::string& file_path){
+        close();
+        //Records are restored by index, reading ahead of them is wasted
+        Status open_status = file_.open(file_path, MappedFile::AccessPattern::random);
+        if(!open_status.ok()){
+            return open_status;
+        }
+        if(file_.size() < SnapshotArchiveFormat::file_header_size){
+            close();
+            return Status::invalid_input_error("Snapshot archive header is truncated!");
+        }
+        Status header_status = validate_file_header(file_.data());
+        if(!header_status.ok()){
+            close();
+            return header_status;
+        }
+        //Ignore a torn record at the end
+        const std::size_t complete_records = (file_.size() - SnapshotArchiveFormat::file_header_size) / SnapshotArchiveFormat::record_size;
+        record_count_ = std::min<std::size_t>(read_le(file_.data() + SnapshotArchiveFormat::record_count_offset, 8), complete_records);
+        return Status::ok_status();
+    }
+
+    /// @brief Unmaps the archive.
+    void SnapshotArchive::close() noexcept{
+        file_.close();
+        record_count_ = 0;
+    }
+
+    /// @brief Returns the number of records in the archive.
+    /// @return Number of records.
+    std::size_t SnapshotArchive::get_snapshot_count() const noexcept{
+        return record_count_;
+    }
+
+    /// @brief Returns the cycle count of the record.
+    /// @param index Index of the record.
+    /// @return Cycle count or error Status.
+    StatusOr<uint64_t> SnapshotArchive::get_cycle_count(const std::size_t index) const{
+        StatusOr<const uint8_t*> record = get_record(index);
+        if(!record.ok()){
+            return record.status();
+        }
+        return read_le(record.value() + SnapshotArchiveFormat::cycle_count_offset, 8);
+    }
+
+    /// @brief Returns the address space of the record in place.
+    /// @param index Index of the record.
+    /// @return Pointer to the 64 KiB address space, valid until close, or error Status.
+    StatusOr<const uint8_t*> SnapshotArchive::get_page_data(const std::size_t index) const{
+        StatusOr<const uint8_t*> record = get_record(index);
+        if(!record.ok()){
+            return record.status();
+        }
+        const uint8_t* page_data = record.value() + SnapshotArchiveFormat::record_header_size;
+        return page_data;
+    }
+
+    /// @brief Checks the address space of the record against its stored hash.
+    /// @param index Index of the record.
+    /// @return Status of the check.
+    Status SnapshotArchive::verify(const std::size_t index) const{
+        StatusOr<const uint8_t*> record = get_record(index);
+        if(!record.ok()){
+            return record.status();
+        }
+        const uint8_t* page_data = record.value() + SnapshotArchiveFormat::record_header_size;
+        const uint64_t stored_hash = read_le(record.value() + SnapshotArchiveFormat::page_hash_offset, 8);
+        if(ContentHash::hash(page_data, SnapshotArchiveFormat::record_size - SnapshotArchiveFormat::record_header_size) != stored_hash){
+            return Status::invalid_input_error("Snapshot archive record " + std::to_string(index) + " is corrupted!");
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Restores the record to the GBC.
+    /// @details Pages are copied straight from the mapping.
+    /// @param index Index of the record.
+    /// @param gbc GBC to restore.
+    /// @return Status of the restore.
+    Status SnapshotArchive::restore(const std::size_t index, GBC& gbc) const{
+        StatusOr<const uint8_t*> record = get_record(index);
+        if(!record.ok()){
+            return record.status();
+        }
+        std::array<uint16_t, GBCSnapshot::register_count> register_words;
+        for(std::size_t word = 0; word < GBCSnapshot::register_count; ++word){
+            register_words[word] = static_cast<uint16_t>(read_le(record.value() + (word * 2), 2));
+        }
+        const uint64_t cycle_count = read_le(record.value() + SnapshotArchiveFormat::cycle_count_offset, 8);
+        PageBitmap all_pages;
+        all_pages.set_all();
+        gbc.restore_state(register_words, cycle_count, all_pages, record.value() + SnapshotArchiveFormat::record_header_size);
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the record.
+    /// @param index Index of the record.
+    /// @return Pointer to the record header or error Status.
+    StatusOr<const uint8_t*> SnapshotArchive::get_record(const std::size_t index) const{
+        if(index >= record_count_){
+            return Status::invalid_index_error(
+                "Snapshot archive has no record " + std::to_string(index) + " (Records: " + std::to_string(record_count_) + ")."
+            );
+        }
+        const uint8_t* record = file_.data() + SnapshotArchiveFormat::file_header_size + (index * SnapshotArchiveFormat::record_size);
+        return record;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,129 @@
+#ifndef SNAPSHOT_ARCHIVE_H
+#define SNAPSHOT_ARCHIVE_H
+
+#include <array> //std::array
+#include <fstream> //std::fstream
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "gbc_snapshot.h" //GBCSnapshot
+#include "../gbc.h" //GBC
+#include "../util/status/status.h" //Status
+#include "../util/io/mapped_file.h" //MappedFile
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Layout of the snapshot archive files.
+    /// @details Little-endian. The file header holds the record count and size, records follow back to back so the
+    ///         index of a record is its position. A record is a 32 byte header (registers, cycle count, page hash)
+    ///         followed by the raw 64 KiB address space, readable in place without decoding.
+    struct SnapshotArchiveFormat{
+        //File magic and format version, version 2 stores the page hashes of the block based ContentHash
+        static constexpr std::array<uint8_t, 4> magic = {'M', 'G', 'S', 'A'};
+        static constexpr uint16_t version = 2;
+
+        //File header: magic, version, reserved, record size, reserved, record count, reserved
+        static constexpr std::size_t file_header_size = 32;
+        static constexpr std::size_t record_size_offset = 8;
+        static constexpr std::size_t record_count_offset = 16;
+
+        //Record header: registers, reserved, cycle count, page hash
+        static constexpr std::size_t record_header_size = 32;
+        static constexpr std::size_t cycle_count_offset = 16;
+        static constexpr std::size_t page_hash_offset = 24;
+
+        //Record header followed by every page
+        static constexpr std::size_t record_size = record_header_size + (PageBitmap::page_count * PageBitmap::page_size);
+    };
+
+    /// @brief Appends full snapshots to an archive file.
+    /// @details The record count in the file header is updated after each record is written.
+    class SnapshotArchiveWriter{
+        public:
+
+        /// @brief Initializes closed writer.
+        SnapshotArchiveWriter();
+
+        /// @brief Opens the archive for appending, creates it if it does not exist.
+        /// @param file_path Path to the archive.
+        /// @return Status of the open.
+        Status open(const std::string& file_path);
+
+        /// @brief Appends the full snapshot.
+        /// @param snapshot Full snapshot to append.
+        /// @return Index of the appended record or error Status.
+        StatusOr<std::size_t> append(const GBCSnapshot& snapshot);
+
+        /// @brief Returns the number of records in the archive.
+        /// @return Number of records.
+        std::size_t get_snapshot_count() const noexcept;
+
+        private:
+        //Opened archive
+        std::fstream file_;
+
+        //Records in the archive
+        std::size_t record_count_;
+    };
+
+    /// @brief Read only view of an archive file.
+    /// @details The file is read through MappedFile with random access, records are used in place.
+    class SnapshotArchive{
+        public:
+
+        /// @brief Initializes closed archive.
+        SnapshotArchive();
+
+        /// @brief Maps the archive and validates the file header.
+        /// @param file_path Path to the archive.
+        /// @return Status of the open.
+        Status open(const std::string& file_path);
+
+        /// @brief Unmaps the archive.
+        void close() noexcept;
+
+        /// @brief Returns the number of records in the archive.
+        /// @return Number of records.
+        std::size_t get_snapshot_count() const noexcept;
+
+        /// @brief Returns the cycle count of the record.
+        /// @param index Index of the record.
+        /// @return Cycle count or error Status.
+        StatusOr<uint64_t> get_cycle_count(const std::size_t index) const;
+
+        /// @brief Returns the address space of the record in place.
+        /// @param index Index of the record.
+        /// @return Pointer to the 64 KiB address space, valid until close, or error Status.
+        StatusOr<const uint8_t*> get_page_data(const std::size_t index) const;
+
+        /// @brief Checks the address space of the record against its stored hash.
+        /// @param index Index of the record.
+        /// @return Status of the check.
+        Status verify(const std::size_t index) const;
+
+        /// @brief Restores the record to the GBC.
+        /// @details Pages are copied straight from the mapping.
+        /// @param index Index of the record.
+        /// @param gbc GBC to restore.
+        /// @return Status of the restore.
+        Status restore(const std::size_t index, GBC& gbc) const;
+
+        private:
+
+        /// @brief Returns the record.
+        /// @param index Index of the record.
+        /// @return Pointer to the record header or error Status.
+        StatusOr<const uint8_t*> get_record(const std::size_t index) const;
+
+        //Mapped archive
+        MappedFile file_;
+
+        //Records in the archive
+        std::size_t record_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
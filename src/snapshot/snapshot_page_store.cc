@@ -0,0 +1,193 @@
+#include <cstring> //std::memcpy
+#include <string> //std::to_string
+#include "snapshot_page_store.h" //SnapshotPageStore
+
+namespace mygbc{
+
+    namespace{
+        //Page ids of a single group
+        using GroupPageIds = std::array<ContentAddressedPool::EntryId, SnapshotPageStore::pages_per_group>;
+    }
+
+    /// @brief Initializes empty store.
+    SnapshotPageStore::SnapshotPageStore()
+    :pages_(PageBitmap::page_size), groups_(sizeof(GroupPageIds)){
+    }
+
+    /// @brief Stores the full snapshot.
+    /// @param snapshot Full snapshot to store.
+    /// @return Identifier of the stored snapshot or error Status.
+    StatusOr<SnapshotPageStore::SnapshotId> SnapshotPageStore::store(const GBCSnapshot& snapshot){
+        if(snapshot.incremental || snapshot.stored_pages.count() != PageBitmap::page_count){
+            return Status::invalid_input_error("Only full snapshots can be stored without a base!");
+        }
+        if(snapshot.page_data.size() != PageBitmap::page_count * PageBitmap::page_size){
+            return Status::invalid_input_error("Snapshot page data does not match the stored pages!");
+        }
+        return store_pages(snapshot, nullptr);
+    }
+
+    /// @brief Stores the incremental snapshot on top of a stored snapshot.
+    /// @details Only the pages stored in the incremental snapshot are hashed, the rest are shared with the base.
+    /// @param snapshot Incremental snapshot taken right after the base snapshot.
+    /// @param base Identifier of the stored base snapshot.
+    /// @return Identifier of the stored snapshot or error Status.
+    StatusOr<SnapshotPageStore::SnapshotId> SnapshotPageStore::store(const GBCSnapshot& snapshot, const SnapshotId base){
+        Status base_check = check_id(base);
+        if(!base_check.ok()){
+            return base_check;
+        }
+        if(snapshot.page_data.size() != snapshot.stored_pages.count() * PageBitmap::page_size){
+            return Status::invalid_input_error("Snapshot page data does not match the stored pages!");
+        }
+        //Copy, storing may grow snapshots_
+        const std::array<ContentAddressedPool::EntryId, group_count> base_group_ids = snapshots_[base].group_ids;
+        return store_pages(snapshot, &base_group_ids);
+    }
+
+    /// @brief Rebuilds the stored snapshot as a full snapshot.
+    /// @param id Identifier of the snapshot.
+    /// @return Full snapshot or error Status.
+    StatusOr<GBCSnapshot> SnapshotPageStore::load(const SnapshotId id) const{
+        Status id_check = check_id(id);
+        if(!id_check.ok()){
+            return id_check;
+        }
+        const StoredSnapshot& stored = snapshots_[id];
+        GBCSnapshot snapshot;
+        snapshot.register_words = stored.register_words;
+        snapshot.cycle_count = stored.cycle_count;
+        snapshot.stored_pages.set_all();
+        snapshot.page_data.resize(PageBitmap::page_count * PageBitmap::page_size);
+        uint8_t* page_destination = snapshot.page_data.data();
+        for(const ContentAddressedPool::EntryId group_id : stored.group_ids){
+            GroupPageIds page_ids;
+            std::memcpy(page_ids.data(), groups_.get(group_id), sizeof(GroupPageIds));
+            for(const ContentAddressedPool::EntryId page_id : page_ids){
+                std::memcpy(page_destination, pages_.get(page_id), PageBitmap::page_size);
+                page_destination += PageBitmap::page_size;
+            }
+        }
+        return snapshot;
+    }
+
+    /// @brief Restores the stored snapshot to the GBC.
+    /// @param id Identifier of the snapshot.
+    /// @param gbc GBC to restore.
+    /// @return Status of the restore.
+    Status SnapshotPageStore::restore(const SnapshotId id, GBC& gbc) const{
+        StatusOr<GBCSnapshot> snapshot = load(id);
+        if(!snapshot.ok()){
+            return snapshot.status();
+        }
+        return gbc.restore_snapshot(snapshot.value());
+    }
+
+    /// @brief Drops the snapshot, pages no longer referenced are freed.
+    /// @param id Identifier of the snapshot.
+    /// @return Status of the release.
+    Status SnapshotPageStore::release(const SnapshotId id){
+        Status id_check = check_id(id);
+        if(!id_check.ok()){
+            return id_check;
+        }
+        StoredSnapshot& stored = snapshots_[id];
+        for(const ContentAddressedPool::EntryId group_id : stored.group_ids){
+            GroupPageIds page_ids;
+            std::memcpy(page_ids.data(), groups_.get(group_id), sizeof(GroupPageIds));
+            //The group holds the page references
+            if(groups_.release(group_id)){
+                for(const ContentAddressedPool::EntryId page_id : page_ids){
+                    pages_.release(page_id);
+                }
+            }
+        }
+        stored.in_use = false;
+        free_snapshot_ids_.push_back(id);
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of stored snapshots.
+    /// @return Number of stored snapshots.
+    std::size_t SnapshotPageStore::get_snapshot_count() const noexcept{
+        return snapshots_.size() - free_snapshot_ids_.size();
+    }
+
+    /// @brief Returns the number of unique pages.
+    /// @return Number of unique pages.
+    std::size_t SnapshotPageStore::get_unique_page_count() const noexcept{
+        return pages_.get_entry_count();
+    }
+
+    /// @brief Returns an estimate of the bytes used by the store.
+    /// @return Used bytes.
+    std::size_t SnapshotPageStore::get_memory_usage() const noexcept{
+        return pages_.get_memory_usage() + groups_.get_memory_usage() +
+            (snapshots_.capacity() * sizeof(StoredSnapshot)) + (free_snapshot_ids_.capacity() * sizeof(SnapshotId));
+    }
+
+    /// @brief Stores the snapshot, pages not stored in the snapshot are taken from the base groups.
+    /// @param snapshot Snapshot to store.
+    /// @param base_group_ids Group ids of the base, nullptr for full snapshots.
+    /// @return Identifier of the stored snapshot.
+    SnapshotPageStore::SnapshotId SnapshotPageStore::store_pages(const GBCSnapshot& snapshot, const std::array<ContentAddressedPool::EntryId, group_count>* base_group_ids){
+        StoredSnapshot stored;
+        stored.register_words = snapshot.register_words;
+        stored.cycle_count = snapshot.cycle_count;
+        stored.in_use = true;
+        const uint8_t* page_source = snapshot.page_data.data();
+        for(std::size_t group = 0; group < group_count; ++group){
+            GroupPageIds page_ids{};
+            std::array<bool, pages_per_group> page_stored{};
+            bool group_changed = base_group_ids == nullptr;
+            if(base_group_ids != nullptr){
+                std::memcpy(page_ids.data(), groups_.get((*base_group_ids)[group]), sizeof(GroupPageIds));
+            }
+            for(std::size_t group_page = 0; group_page < pages_per_group; ++group_page){
+                if(!snapshot.stored_pages.test(static_cast<uint8_t>((group * pages_per_group) + group_page))){
+                    continue;
+                }
+                bool inserted = false;
+                page_ids[group_page] = pages_.intern(page_source, inserted);
+                page_stored[group_page] = true;
+                page_source += PageBitmap::page_size;
+                group_changed = true;
+            }
+            if(!group_changed){
+                groups_.add_reference((*base_group_ids)[group]);
+                stored.group_ids[group] = (*base_group_ids)[group];
+                continue;
+            }
+            bool group_inserted = false;
+            stored.group_ids[group] = groups_.intern(reinterpret_cast<const uint8_t*>(page_ids.data()), group_inserted);
+            //A new group references all of its pages, an existing group already does
+            for(std::size_t group_page = 0; group_page < pages_per_group; ++group_page){
+                if(group_inserted && !page_stored[group_page]){
+                    pages_.add_reference(page_ids[group_page]);
+                }
+                else if(!group_inserted && page_stored[group_page]){
+                    pages_.release(page_ids[group_page]);
+                }
+            }
+        }
+        if(!free_snapshot_ids_.empty()){
+            const SnapshotId id = free_snapshot_ids_.back();
+            free_snapshot_ids_.pop_back();
+            snapshots_[id] = stored;
+            return id;
+        }
+        snapshots_.push_back(stored);
+        return static_cast<SnapshotId>(snapshots_.size() - 1);
+    }
+
+    /// @brief Is the id a stored snapshot?
+    /// @param id Identifier to check.
+    /// @return Status of the check.
+    Status SnapshotPageStore::check_id(const SnapshotId id) const{
+        if(id >= snapshots_.size() || !snapshots_[id].in_use){
+            return Status::invalid_index_error("No stored snapshot with id " + std::to_string(id) + "!");
+        }
+        return Status::ok_status();
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,109 @@
+#ifndef SNAPSHOT_PAGE_STORE_H
+#define SNAPSHOT_PAGE_STORE_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "content_addressed_pool.h" //ContentAddressedPool
+#include "gbc_snapshot.h" //GBCSnapshot
+#include "../gbc.h" //GBC
+#include "../util/status/status.h" //Status
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Deduplicating store for large numbers of snapshots.
+    /// @details Unique 256 byte pages are stored once. Pages are grouped into 4 KiB groups, a group is a list of
+    ///         16 page ids and is deduplicated the same way. A stored snapshot is the registers and 16 group ids,
+    ///         so snapshots sharing most of their memory cost a few hundred bytes each.
+    class SnapshotPageStore{
+        public:
+        //Identifier of a stored snapshot
+        using SnapshotId = uint32_t;
+
+        //Pages per 4 KiB group
+        static constexpr std::size_t pages_per_group = 16;
+
+        //Groups in the address space
+        static constexpr std::size_t group_count = PageBitmap::page_count / pages_per_group;
+
+        /// @brief Initializes empty store.
+        SnapshotPageStore();
+
+        /// @brief Stores the full snapshot.
+        /// @param snapshot Full snapshot to store.
+        /// @return Identifier of the stored snapshot or error Status.
+        StatusOr<SnapshotId> store(const GBCSnapshot& snapshot);
+
+        /// @brief Stores the incremental snapshot on top of a stored snapshot.
+        /// @details Only the pages stored in the incremental snapshot are hashed, the rest are shared with the base.
+        /// @param snapshot Incremental snapshot taken right after the base snapshot.
+        /// @param base Identifier of the stored base snapshot.
+        /// @return Identifier of the stored snapshot or error Status.
+        StatusOr<SnapshotId> store(const GBCSnapshot& snapshot, const SnapshotId base);
+
+        /// @brief Rebuilds the stored snapshot as a full snapshot.
+        /// @param id Identifier of the snapshot.
+        /// @return Full snapshot or error Status.
+        StatusOr<GBCSnapshot> load(const SnapshotId id) const;
+
+        /// @brief Restores the stored snapshot to the GBC.
+        /// @param id Identifier of the snapshot.
+        /// @param gbc GBC to restore.
+        /// @return Status of the restore.
+        Status restore(const SnapshotId id, GBC& gbc) const;
+
+        /// @brief Drops the snapshot, pages no longer referenced are freed.
+        /// @param id Identifier of the snapshot.
+        /// @return Status of the release.
+        Status release(const SnapshotId id);
+
+        /// @brief Returns the number of stored snapshots.
+        /// @return Number of stored snapshots.
+        std::size_t get_snapshot_count() const noexcept;
+
+        /// @brief Returns the number of unique pages.
+        /// @return Number of unique pages.
+        std::size_t get_unique_page_count() const noexcept;
+
+        /// @brief Returns an estimate of the bytes used by the store.
+        /// @return Used bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        //Stored snapshot
+        struct StoredSnapshot{
+            std::array<uint16_t, GBCSnapshot::register_count> register_words;
+            uint64_t cycle_count;
+            std::array<ContentAddressedPool::EntryId, group_count> group_ids;
+            bool in_use;
+        };
+
+        /// @brief Stores the snapshot, pages not stored in the snapshot are taken from the base groups.
+        /// @param snapshot Snapshot to store.
+        /// @param base_group_ids Group ids of the base, nullptr for full snapshots.
+        /// @return Identifier of the stored snapshot.
+        SnapshotId store_pages(const GBCSnapshot& snapshot, const std::array<ContentAddressedPool::EntryId, group_count>* base_group_ids);
+
+        /// @brief Is the id a stored snapshot?
+        /// @param id Identifier to check.
+        /// @return Status of the check.
+        Status check_id(const SnapshotId id) const;
+
+        //Unique pages
+        ContentAddressedPool pages_;
+
+        //Unique groups of page ids
+        ContentAddressedPool groups_;
+
+        //Snapshots, indexed by SnapshotId
+        std::vector<StoredSnapshot> snapshots_;
+
+        //Free snapshot slots to reuse
+        std::vector<SnapshotId> free_snapshot_ids_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,58 @@
+#include <cstring> //std::memcmp
+#include <utility> //std::move
+#include "start_state_pool.h" //StartStatePool
+
+namespace mygbc{
+
+    /// @brief Initializes empty pool.
+    StartStatePool::StartStatePool(){
+    }
+
+    /// @brief Adds a start state captured with GBC::save_snapshot.
+    /// @param snapshot Full snapshot storing every page.
+    /// @param joypad_buttons Pressed joypad buttons at the snapshot, the snapshot only holds the selected half of them.
+    /// @return Status of the add.
+    Status StartStatePool::add(const GBCSnapshot& snapshot, const uint8_t joypad_buttons){
+        if(snapshot.incremental || snapshot.stored_pages.count() != PageBitmap::page_count ||
+            snapshot.page_data.size() != MemoryController::address_space_size){
+            return Status::invalid_input_error("Start states must be full snapshots storing every page!");
+        }
+        StartState state{snapshot.register_words, snapshot.cycle_count, snapshot.page_data, PageBitmap(), joypad_buttons};
+        if(!states_.empty()){
+            //ROM is never written, only RAM pages can differ
+            const std::vector<uint8_t>& first_space = states_.front().address_space;
+            for(std::size_t page = MemoryController::rom_end_addr / PageBitmap::page_size; page < PageBitmap::page_count; ++page){
+                const std::size_t page_offset = page * PageBitmap::page_size;
+                if(std::memcmp(&state.address_space[page_offset], &first_space[page_offset], PageBitmap::page_size) != 0){
+                    state.differing_pages.set(static_cast<uint8_t>(page));
+                }
+            }
+        }
+        states_.push_back(std::move(state));
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of start states.
+    /// @return Number of start states.
+    std::size_t StartStatePool::get_size() const noexcept{
+        return states_.size();
+    }
+
+    /// @brief Returns the start state.
+    /// @param index Index of the state, below get_size().
+    /// @return Start state.
+    const StartStatePool::StartState& StartStatePool::get_state(const std::size_t index) const noexcept{
+        return states_[index];
+    }
+
+    /// @brief Returns the memory used by the start states.
+    /// @return Used memory in bytes.
+    std::size_t StartStatePool::get_memory_usage() const noexcept{
+        std::size_t memory_usage = states_.capacity() * sizeof(StartState);
+        for(const StartState& state : states_){
+            memory_usage += state.address_space.capacity();
+        }
+        return memory_usage;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,68 @@
+#ifndef START_STATE_POOL_H
+#define START_STATE_POOL_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "gbc_snapshot.h" //GBCSnapshot
+#include "../components/memory_controller.h" //MemoryController
+#include "../memory/page_bitmap.h" //PageBitmap
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Start states of episodes, such as the states after the boot and menus, shared by many GBC instances.
+    /// @details Each state keeps an image of the whole address space and the RAM pages differing from the first state,
+    ///         so switching between two states only touches the pages where either differs from the first.
+    ///         Read only after the states are added, safe to share between threads.
+    class StartStatePool{
+        public:
+        /// @brief Single start state.
+        struct StartState{
+            //Register words in the order of GBCSnapshot::register_words
+            std::array<uint16_t, GBCSnapshot::register_count> register_words;
+
+            //T-cycles executed since power on
+            uint64_t cycle_count;
+
+            //Contents of the whole address space
+            std::vector<uint8_t> address_space;
+
+            //RAM pages differing from the first start state
+            PageBitmap differing_pages;
+
+            //Pressed joypad buttons at the start state, see MemoryController::set_joypad_state
+            uint8_t joypad_buttons;
+        };
+
+        /// @brief Initializes empty pool.
+        StartStatePool();
+
+        /// @brief Adds a start state captured with GBC::save_snapshot.
+        /// @param snapshot Full snapshot storing every page.
+        /// @param joypad_buttons Pressed joypad buttons at the snapshot, the snapshot only holds the selected half of them.
+        /// @return Status of the add.
+        Status add(const GBCSnapshot& snapshot, const uint8_t joypad_buttons = 0);
+
+        /// @brief Returns the number of start states.
+        /// @return Number of start states.
+        std::size_t get_size() const noexcept;
+
+        /// @brief Returns the start state.
+        /// @param index Index of the state, below get_size().
+        /// @return Start state.
+        const StartState& get_state(const std::size_t index) const noexcept;
+
+        /// @brief Returns the memory used by the start states.
+        /// @return Used memory in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        //Start states in the order they were added
+        std::vector<StartState> states_;
+    };
+
+}//namespace_mygbc
+
+#endif
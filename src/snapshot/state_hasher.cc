@@ -0,0 +1,115 @@
+#include "state_hasher.h" //StateHasher
+#include "../util/hash/content_hash.h" //ContentHash
+#include "../profile/trace_events.h" //MYGBC_TRACE_SPAN
+
+namespace mygbc{
+
+    namespace{
+
+        /// @brief Writes the value little-endian.
+        /// @param value Value to write.
+        /// @param byte_count Number of bytes to write.
+        /// @param destination Buffer to write to.
+        void write_le(const uint64_t value, const std::size_t byte_count, uint8_t* destination) noexcept{
+            for(std::size_t byte = 0; byte < byte_count; ++byte){
+                destination[byte] = static_cast<uint8_t>(value >> (byte * 8));
+            }
+        }
+    }
+
+    /// @brief Initializes hasher for the given GBC, every page is hashed on the first update.
+    /// @param gbc GBC to hash. Must outlive the hasher.
+    StateHasher::StateHasher(GBC& gbc)
+    :gbc_(gbc), dirty_page_consumer_id_(gbc.register_dirty_page_consumer()), rehash_all_(true), page_hashes_{}, page_hash_bytes_{}, page_buffer_{}{
+    }
+
+    /// @brief Unregisters the dirty page consumer.
+    StateHasher::~StateHasher(){
+        gbc_.unregister_dirty_page_consumer(dirty_page_consumer_id_);
+    }
+
+    /// @brief Rehashes the dirty pages and returns the state hash.
+    /// @return Hash of the current state.
+    uint64_t StateHasher::update(){
+        MYGBC_TRACE_SPAN("state_hash");
+        PageBitmap pages = gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        if(rehash_all_){
+            pages.set_all();
+            rehash_all_ = false;
+        }
+        MemoryController& memory = gbc_.get_memory();
+        for(std::size_t page = pages.find_next(0); page < PageBitmap::page_count; page = pages.find_next(page + 1)){
+            memory.read_page(static_cast<uint8_t>(page), page_buffer_.data());
+            page_hashes_[page] = ContentHash::hash(page_buffer_.data(), page_buffer_.size(), page);
+            write_le(page_hashes_[page], sizeof(uint64_t), &page_hash_bytes_[page * sizeof(uint64_t)]);
+        }
+        //Registers, cycle count and joypad state seed the hash over the page hashes
+        const std::array<uint16_t, GBCSnapshot::register_count> register_words = gbc_.get_processing_unit().get_register_file().get_register_words();
+        uint8_t register_bytes[GBCSnapshot::register_count * sizeof(uint16_t)];
+        for(std::size_t index = 0; index < register_words.size(); ++index){
+            write_le(register_words[index], sizeof(uint16_t), &register_bytes[index * sizeof(uint16_t)]);
+        }
+        uint64_t seed = ContentHash::hash(register_bytes, sizeof(register_bytes), gbc_.get_cycle_count());
+        seed ^= memory.get_joypad_state();
+        return ContentHash::hash(page_hash_bytes_.data(), page_hash_bytes_.size(), seed);
+    }
+
+    /// @brief Records the state hash of the current frame.
+    /// @details Call after each GBC::run_frame.
+    /// @return Hash of the current state.
+    uint64_t StateHasher::on_frame_end(){
+        const uint64_t frame = gbc_.get_frame_count();
+        //Drop hashes of frames undone by rewinds or seeks
+        while(!frame_hashes_.empty() && frame_hashes_.back().frame >= frame){
+            frame_hashes_.pop_back();
+        }
+        const uint64_t hash = update();
+        frame_hashes_.push_back(FrameHash{frame, hash});
+        return hash;
+    }
+
+    /// @brief Hashes every page on the next update.
+    void StateHasher::reset() noexcept{
+        rehash_all_ = true;
+    }
+
+    /// @brief Returns the hash of the page as of the last update.
+    /// @param page Index of the page.
+    /// @return Hash of the page.
+    uint64_t StateHasher::get_page_hash(const uint8_t page) const noexcept{
+        return page_hashes_[page];
+    }
+
+    /// @brief Returns the hashes recorded by on_frame_end.
+    /// @return Recorded frame hashes in recording order.
+    const std::vector<FrameHash>& StateHasher::get_frame_hashes() const noexcept{
+        return frame_hashes_;
+    }
+
+    /// @brief Finds the first frame where the hash streams differ.
+    /// @details Only frames present in both streams are compared.
+    /// @param first First hash stream.
+    /// @param second Second hash stream.
+    /// @return First diverging frame or no_divergence.
+    uint64_t StateHasher::find_first_divergence(const std::vector<FrameHash>& first, const std::vector<FrameHash>& second){
+        std::size_t first_index = 0;
+        std::size_t second_index = 0;
+        while(first_index < first.size() && second_index < second.size()){
+            if(first[first_index].frame < second[second_index].frame){
+                ++first_index;
+            }
+            else if(first[first_index].frame > second[second_index].frame){
+                ++second_index;
+            }
+            else{
+                if(first[first_index].hash != second[second_index].hash){
+                    return first[first_index].frame;
+                }
+                ++first_index;
+                ++second_index;
+            }
+        }
+        return no_divergence;
+    }
+
+}//namespace_mygbc
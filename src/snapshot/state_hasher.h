@@ -0,0 +1,91 @@
+#ifndef STATE_HASHER_H
+#define STATE_HASHER_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../memory/page_bitmap.h" //PageBitmap
+
+namespace mygbc{
+
+    /// @brief Hash of the GBC state at the end of a frame.
+    struct FrameHash{
+        uint64_t frame;
+        uint64_t hash;
+    };
+
+    /// @brief Computes a hash of the whole GBC state, only rehashing the pages written to since the last update.
+    /// @details The state hash covers the page hashes, registers, cycle count and joypad state. Two runs with equal
+    ///         hash streams executed identically, comparing streams finds the first diverging frame.
+    ///         ROM pages are never dirty, call reset after loading a ROM to rehash every page.
+    class StateHasher{
+        public:
+        //Value returned when no divergence is found
+        static constexpr uint64_t no_divergence = UINT64_MAX;
+
+        /// @brief Initializes hasher for the given GBC, every page is hashed on the first update.
+        /// @param gbc GBC to hash. Must outlive the hasher.
+        explicit StateHasher(GBC& gbc);
+
+        /// @brief Unregisters the dirty page consumer.
+        ~StateHasher();
+
+        StateHasher(const StateHasher&) = delete;
+        StateHasher& operator=(const StateHasher&) = delete;
+
+        /// @brief Rehashes the dirty pages and returns the state hash.
+        /// @return Hash of the current state.
+        uint64_t update();
+
+        /// @brief Records the state hash of the current frame.
+        /// @details Call after each GBC::run_frame.
+        /// @return Hash of the current state.
+        uint64_t on_frame_end();
+
+        /// @brief Hashes every page on the next update.
+        void reset() noexcept;
+
+        /// @brief Returns the hash of the page as of the last update.
+        /// @param page Index of the page.
+        /// @return Hash of the page.
+        uint64_t get_page_hash(const uint8_t page) const noexcept;
+
+        /// @brief Returns the hashes recorded by on_frame_end.
+        /// @return Recorded frame hashes in recording order.
+        const std::vector<FrameHash>& get_frame_hashes() const noexcept;
+
+        /// @brief Finds the first frame where the hash streams differ.
+        /// @details Only frames present in both streams are compared.
+        /// @param first First hash stream.
+        /// @param second Second hash stream.
+        /// @return First diverging frame or no_divergence.
+        static uint64_t find_first_divergence(const std::vector<FrameHash>& first, const std::vector<FrameHash>& second);
+
+        private:
+        //Hashed GBC
+        GBC& gbc_;
+
+        //Dirty page consumer of the hasher
+        const std::size_t dirty_page_consumer_id_;
+
+        //Rehash every page on the next update?
+        bool rehash_all_;
+
+        //Hash per page as of the last update
+        std::array<uint64_t, PageBitmap::page_count> page_hashes_;
+
+        //Page hashes as little-endian bytes, keeps the state hash independent of the host byte order
+        std::array<uint8_t, PageBitmap::page_count * sizeof(uint64_t)> page_hash_bytes_;
+
+        //Page being hashed
+        std::array<uint8_t, PageBitmap::page_size> page_buffer_;
+
+        //Hashes recorded by on_frame_end
+        std::vector<FrameHash> frame_hashes_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,77 @@
+#include "../profile/trace_events.h" //MYGBC_TRACE_SPAN
+#include "state_slot.h" //StateSlot
+
+namespace mygbc{
+
+    /// @brief Initializes empty slot and copies the address space of the GBC.
+    /// @param gbc GBC to save. Must outlive the slot.
+    StateSlot::StateSlot(GBC& gbc)
+    :gbc_(gbc), dirty_page_consumer_id_(gbc.register_dirty_page_consumer()), address_space_(MemoryController::address_space_size),
+    register_words_{}, cycle_count_(0), joypad_buttons_(0), has_state_(false), last_saved_page_count_(0), last_restored_page_count_(0){
+        for(std::size_t page = 0; page < PageBitmap::page_count; ++page){
+            gbc_.get_memory().read_page(static_cast<uint8_t>(page), address_space_.data() + (page * PageBitmap::page_size));
+        }
+    }
+
+    /// @brief Unregisters the dirty page consumer.
+    StateSlot::~StateSlot(){
+        gbc_.unregister_dirty_page_consumer(dirty_page_consumer_id_);
+    }
+
+    /// @brief Saves the current state of the GBC, replacing the saved state.
+    void StateSlot::save(){
+        MYGBC_TRACE_SPAN("snapshot_save");
+        const PageBitmap written_pages = gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        for(std::size_t page = written_pages.find_next(0); page < PageBitmap::page_count; page = written_pages.find_next(page + 1)){
+            gbc_.get_memory().read_page(static_cast<uint8_t>(page), address_space_.data() + (page * PageBitmap::page_size));
+        }
+        register_words_ = gbc_.get_processing_unit().get_register_file().get_register_words();
+        cycle_count_ = gbc_.get_cycle_count();
+        joypad_buttons_ = gbc_.get_memory().get_joypad_state();
+        has_state_ = true;
+        last_saved_page_count_ = written_pages.count();
+    }
+
+    /// @brief Restores the saved state.
+    /// @details The slot keeps the state, it can be restored again. The joypad state is restored from the slot,
+    ///         so it does not depend on the inputs being recorded.
+    /// @return Status of the restore, error when nothing was saved.
+    Status StateSlot::restore(){
+        if(!has_state_){
+            return Status::invalid_input_error("State slot is empty!");
+        }
+        const PageBitmap written_pages = gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        gbc_.restore_state_from_image(register_words_, cycle_count_, written_pages, address_space_.data());
+        //Without recorded inputs the restore releases every button, the register page then matches the image again
+        gbc_.get_memory().set_joypad_state(joypad_buttons_);
+        //The restored pages match the image again
+        gbc_.take_dirty_pages(dirty_page_consumer_id_);
+        last_restored_page_count_ = written_pages.count();
+        return Status::ok_status();
+    }
+
+    /// @brief Has a state been saved?
+    /// @return Has a state been saved?
+    bool StateSlot::has_state() const noexcept{
+        return has_state_;
+    }
+
+    /// @brief Returns the number of pages copied by the last save.
+    /// @return Saved pages.
+    std::size_t StateSlot::get_last_saved_page_count() const noexcept{
+        return last_saved_page_count_;
+    }
+
+    /// @brief Returns the number of pages copied by the last restore.
+    /// @return Restored pages.
+    std::size_t StateSlot::get_last_restored_page_count() const noexcept{
+        return last_restored_page_count_;
+    }
+
+    /// @brief Returns the heap memory used by the slot.
+    /// @return Used heap memory in bytes.
+    std::size_t StateSlot::get_memory_usage() const noexcept{
+        return address_space_.capacity();
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,87 @@
+#ifndef STATE_SLOT_H
+#define STATE_SLOT_H
+
+#include <array> //std::array
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Single in-place save slot of a GBC for frequent short lived saves, such as run-ahead.
+    /// @details Keeps an image of the whole address space that matches the memory of the GBC except for the pages
+    ///         the GBC wrote since the last save or restore, tracked through its own dirty page consumer. A save only
+    ///         copies those pages into the image and a restore only copies the pages written since the save back,
+    ///         so both cost O(dirty pages) and neither allocates.
+    class StateSlot{
+        public:
+
+        /// @brief Initializes empty slot and copies the address space of the GBC.
+        /// @param gbc GBC to save. Must outlive the slot.
+        explicit StateSlot(GBC& gbc);
+
+        /// @brief Unregisters the dirty page consumer.
+        ~StateSlot();
+
+        StateSlot(const StateSlot&) = delete;
+        StateSlot& operator=(const StateSlot&) = delete;
+
+        /// @brief Saves the current state of the GBC, replacing the saved state.
+        void save();
+
+        /// @brief Restores the saved state.
+        /// @details The slot keeps the state, it can be restored again. The joypad state is restored from the slot,
+        ///         so it does not depend on the inputs being recorded.
+        /// @return Status of the restore, error when nothing was saved.
+        Status restore();
+
+        /// @brief Has a state been saved?
+        /// @return Has a state been saved?
+        bool has_state() const noexcept;
+
+        /// @brief Returns the number of pages copied by the last save.
+        /// @return Saved pages.
+        std::size_t get_last_saved_page_count() const noexcept;
+
+        /// @brief Returns the number of pages copied by the last restore.
+        /// @return Restored pages.
+        std::size_t get_last_restored_page_count() const noexcept;
+
+        /// @brief Returns the heap memory used by the slot.
+        /// @return Used heap memory in bytes.
+        std::size_t get_memory_usage() const noexcept;
+
+        private:
+        //Saved GBC
+        GBC& gbc_;
+
+        //Dirty page consumer id of the slot
+        const std::size_t dirty_page_consumer_id_;
+
+        //Image of the address space, stale for the pages of the consumer
+        std::vector<uint8_t> address_space_;
+
+        //Saved registers in the order of GBCSnapshot::register_words
+        std::array<uint16_t, GBCSnapshot::register_count> register_words_;
+
+        //Saved cycle count
+        uint64_t cycle_count_;
+
+        //Saved pressed joypad buttons
+        uint8_t joypad_buttons_;
+
+        //Has a state been saved?
+        bool has_state_;
+
+        //Pages copied by the last save
+        std::size_t last_saved_page_count_;
+
+        //Pages copied by the last restore
+        std::size_t last_restored_page_count_;
+    };
+
+}//namespace_mygbc
+
+#endif
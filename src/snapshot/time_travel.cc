@@ -0,0 +1,73 @@
+#include "time_travel.h" //TimeTravel
+
+namespace mygbc{
+
+    /// @brief Initializes recorder for the given GBC.
+    /// @param gbc GBC to record and seek. Must outlive the recorder.
+    /// @param frame_interval Record a snapshot every N frames.
+    TimeTravel::TimeTravel(GBC& gbc, const uint32_t frame_interval)
+    :gbc_(gbc), frame_interval_(frame_interval > 0 ? frame_interval : 1),
+    input_divergence_listener_id_(gbc.add_input_divergence_listener([this](const uint64_t cycle){
+        snapshots_.erase(snapshots_.upper_bound(cycle), snapshots_.end());
+    })){
+    }
+
+    /// @brief Removes the input divergence listener.
+    TimeTravel::~TimeTravel(){
+        gbc_.remove_input_divergence_listener(input_divergence_listener_id_);
+    }
+
+    /// @brief Records a snapshot if the current frame is on the interval.
+    /// @details Call after each GBC::run_frame.
+    /// @return Status of the record.
+    Status TimeTravel::on_frame_end(){
+        if((gbc_.get_frame_count() % frame_interval_) != 0){
+            return Status::ok_status();
+        }
+        return record();
+    }
+
+    /// @brief Records a snapshot at the current cycle.
+    /// @return Status of the record.
+    Status TimeTravel::record(){
+        snapshots_.insert_or_assign(gbc_.get_cycle_count(), gbc_.save_snapshot());
+        return Status::ok_status();
+    }
+
+    /// @brief Seeks the GBC to the cycle.
+    /// @details Ends at the first instruction boundary at or after the cycle.
+    /// @param cycle T-cycle to seek to.
+    /// @return Status of the seek.
+    Status TimeTravel::seek_to_cycle(const uint64_t cycle){
+        auto nearest = snapshots_.upper_bound(cycle);
+        if(nearest == snapshots_.begin()){
+            return Status::invalid_index_error(
+                "No snapshot recorded before the seek target! (Cycle: " + std::to_string(cycle) + ")."
+            );
+        }
+        --nearest;
+        //Running forward from the current state is cheaper when it is closer than the snapshot
+        const uint64_t current_cycle = gbc_.get_cycle_count();
+        if(current_cycle > cycle || current_cycle < nearest->first){
+            Status restore_status = gbc_.restore_snapshot(nearest->second);
+            if(!restore_status.ok()){
+                return restore_status;
+            }
+        }
+        return gbc_.run_until_cycle(cycle);
+    }
+
+    /// @brief Seeks the GBC to the start of the frame.
+    /// @param frame Frame to seek to.
+    /// @return Status of the seek.
+    Status TimeTravel::seek_to_frame(const uint64_t frame){
+        return seek_to_cycle(frame * GBC::cycles_per_frame);
+    }
+
+    /// @brief Returns the number of recorded snapshots.
+    /// @return Number of recorded snapshots.
+    std::size_t TimeTravel::get_snapshot_count() const noexcept{
+        return snapshots_.size();
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,71 @@
+#ifndef TIME_TRAVEL_H
+#define TIME_TRAVEL_H
+
+#include <map> //std::map
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../gbc.h" //GBC
+#include "gbc_snapshot.h" //GBCSnapshot
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Seeks a GBC to any cycle of a recorded run.
+    /// @details Snapshots are recorded every N frames. Seeking restores the nearest snapshot at or before the target
+    ///         and re-executes with the recorded inputs, so the cost of a seek is bounded by the snapshot interval.
+    ///         Snapshots after a cycle where the input history diverges are dropped, they belong to the abandoned timeline.
+    class TimeTravel{
+        public:
+
+        /// @brief Initializes recorder for the given GBC.
+        /// @param gbc GBC to record and seek. Must outlive the recorder.
+        /// @param frame_interval Record a snapshot every N frames.
+        TimeTravel(GBC& gbc, const uint32_t frame_interval);
+
+        /// @brief Removes the input divergence listener.
+        ~TimeTravel();
+
+        TimeTravel(const TimeTravel&) = delete;
+        TimeTravel& operator=(const TimeTravel&) = delete;
+
+        /// @brief Records a snapshot if the current frame is on the interval.
+        /// @details Call after each GBC::run_frame.
+        /// @return Status of the record.
+        Status on_frame_end();
+
+        /// @brief Records a snapshot at the current cycle.
+        /// @return Status of the record.
+        Status record();
+
+        /// @brief Seeks the GBC to the cycle.
+        /// @details Ends at the first instruction boundary at or after the cycle.
+        /// @param cycle T-cycle to seek to.
+        /// @return Status of the seek.
+        Status seek_to_cycle(const uint64_t cycle);
+
+        /// @brief Seeks the GBC to the start of the frame.
+        /// @param frame Frame to seek to.
+        /// @return Status of the seek.
+        Status seek_to_frame(const uint64_t frame);
+
+        /// @brief Returns the number of recorded snapshots.
+        /// @return Number of recorded snapshots.
+        std::size_t get_snapshot_count() const noexcept;
+
+        private:
+        //Recorded GBC
+        GBC& gbc_;
+
+        //Record a snapshot every N frames
+        const uint32_t frame_interval_;
+
+        //Cycle => Snapshot
+        std::map<uint64_t, GBCSnapshot> snapshots_;
+
+        //Input divergence listener id of the recorder
+        const std::size_t input_divergence_listener_id_;
+    };
+
+}//namespace_mygbc
+
+#endif
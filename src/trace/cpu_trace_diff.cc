@@ -0,0 +1,126 @@
+#include <algorithm> //std::min
+#include <cstring> //std::memcmp
+#include <deque> //std::deque
+#include "cpu_trace_diff.h" //CpuTraceDiff
+#include "../instruction_set_lr35902/instruction_formatter_lr35902.h" //InstructionFormatterLR35902
+
+namespace mygbc{
+
+    namespace{
+        //Register word names in the order of CpuTraceEntry::register_words
+        constexpr const char* register_names[CpuTraceEntry::register_count] = {"IR/IE", "AF", "BC", "DE", "HL", "PC", "SP"};
+
+        /// @brief Formats the entry as a gameboy-doctor line followed by the disassembled instruction.
+        /// @param prefix Line prefix.
+        /// @param entry Entry to format.
+        /// @param instruction_set Instruction set to disassemble with.
+        /// @return Formatted line with a line break.
+        std::string format_entry(const std::string& prefix, const CpuTraceEntry& entry, const InstructionSetLR35902& instruction_set){
+            StatusOr<std::string> instruction = InstructionFormatterLR35902::disassemble(
+                std::vector<uint8_t>(entry.pc_memory.begin(), entry.pc_memory.end()), instruction_set
+            );
+            return prefix + "#" + std::to_string(entry.index) + " " + entry.to_doctor_line() + " ; " +
+                (instruction.ok() ? instruction.value() : "???") + "\n";
+        }
+    }
+
+    /// @brief Initializes result without a divergence.
+    CpuTraceDivergence::CpuTraceDivergence():diverged(false), index(0), first_ended(false), second_ended(false){
+    }
+
+    /// @brief Finds the first entry where the traces differ.
+    /// @param first First trace.
+    /// @param second Second trace.
+    /// @param context_size Number of matching entries to keep before the divergence.
+    /// @return First divergence or error Status.
+    StatusOr<CpuTraceDivergence> CpuTraceDiff::find_first_divergence(CpuTraceReader& first, CpuTraceReader& second, const std::size_t context_size){
+        //Skip the equal chunks, memcmp is vectorized by the C library
+        const std::size_t common_chunks = std::min(first.get_chunk_count(), second.get_chunk_count());
+        std::size_t chunk = 0;
+        for(; chunk < common_chunks; ++chunk){
+            const CpuTraceChunk first_chunk = first.get_chunk(chunk).value();
+            const CpuTraceChunk second_chunk = second.get_chunk(chunk).value();
+            if(first_chunk.size != second_chunk.size || std::memcmp(first_chunk.data, second_chunk.data, first_chunk.size) != 0){
+                break;
+            }
+        }
+        CpuTraceDivergence divergence;
+        if(chunk == common_chunks && first.get_chunk_count() == second.get_chunk_count()){
+            return divergence;
+        }
+        //Decode from the previous chunk for the context
+        const std::size_t start_chunk = chunk > 0 ? chunk - 1 : 0;
+        Status first_seek = first.seek_to_chunk(start_chunk);
+        Status second_seek = second.seek_to_chunk(start_chunk);
+        if(!first_seek.ok()){
+            return first_seek;
+        }
+        if(!second_seek.ok()){
+            return second_seek;
+        }
+        std::deque<CpuTraceEntry> context;
+        CpuTraceEntry first_entry;
+        CpuTraceEntry second_entry;
+        while(true){
+            StatusOr<bool> first_next = first.next(first_entry);
+            if(!first_next.ok()){
+                return first_next.status();
+            }
+            StatusOr<bool> second_next = second.next(second_entry);
+            if(!second_next.ok()){
+                return second_next.status();
+            }
+            if(!first_next.value() && !second_next.value()){
+                //Chunked differently but decoded equal
+                return divergence;
+            }
+            if(!first_next.value() || !second_next.value() || !(first_entry == second_entry)){
+                divergence.diverged = true;
+                divergence.first_ended = !first_next.value();
+                divergence.second_ended = !second_next.value();
+                divergence.first = first_entry;
+                divergence.second = second_entry;
+                divergence.index = divergence.first_ended ? second_entry.index : first_entry.index;
+                divergence.context.assign(context.begin(), context.end());
+                return divergence;
+            }
+            context.push_back(first_entry);
+            if(context.size() > context_size){
+                context.pop_front();
+            }
+        }
+    }
+
+    /// @brief Formats the divergence as text with disassembled instructions.
+    /// @param divergence Divergence to format.
+    /// @param instruction_set Instruction set to disassemble with.
+    /// @return Report text.
+    std::string CpuTraceDiff::format_report(const CpuTraceDivergence& divergence, const InstructionSetLR35902& instruction_set){
+        if(!divergence.diverged){
+            return "Traces match.\n";
+        }
+        std::string report = "Traces diverge at entry #" + std::to_string(divergence.index) + "\n";
+        for(const CpuTraceEntry& entry : divergence.context){
+            report += format_entry("  ", entry, instruction_set);
+        }
+        report += divergence.first_ended ? std::string("- <end of trace>\n") : format_entry("- ", divergence.first, instruction_set);
+        report += divergence.second_ended ? std::string("+ <end of trace>\n") : format_entry("+ ", divergence.second, instruction_set);
+        if(!divergence.first_ended && !divergence.second_ended){
+            std::string differences;
+            for(std::size_t word = 0; word < CpuTraceEntry::register_count; ++word){
+                if(divergence.first.register_words[word] != divergence.second.register_words[word]){
+                    differences += std::string(" ") + register_names[word];
+                }
+            }
+            if(divergence.first.pc_memory != divergence.second.pc_memory){
+                differences += " PCMEM";
+            }
+            if(divergence.first.cycle != divergence.second.cycle || divergence.first.cycles != divergence.second.cycles){
+                differences += " CYCLES";
+            }
+            report += "Differs in:" + differences + "\n";
+        }
+        return report;
+    }
+
+}//namespace_mygbc
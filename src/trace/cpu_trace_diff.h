@@ -0,0 +1,60 @@
+#ifndef CPU_TRACE_DIFF_H
+#define CPU_TRACE_DIFF_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "cpu_trace_format.h" //CpuTraceEntry
+#include "cpu_trace_reader.h" //CpuTraceReader
+#include "../instruction_set_lr35902/instruction_set_lr35902.h" //InstructionSetLR35902
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief First point where two traces differ.
+    struct CpuTraceDivergence{
+        //Did the traces differ?
+        bool diverged;
+
+        //Index of the first differing entry
+        uint64_t index;
+
+        //Did a trace end before the other one?
+        bool first_ended;
+        bool second_ended;
+
+        //First differing entries, valid unless the trace ended
+        CpuTraceEntry first;
+        CpuTraceEntry second;
+
+        //Matching entries right before the divergence, oldest first
+        std::vector<CpuTraceEntry> context;
+
+        /// @brief Initializes result without a divergence.
+        CpuTraceDivergence();
+    };
+
+    /// @brief Finds the first divergence of two binary CPU traces.
+    /// @details Traces recorded from the same starting point chunk identically while they match, so equal chunks
+    ///         are skipped with a byte compare of the mapped files. Only the first differing chunk is decoded.
+    class CpuTraceDiff{
+        public:
+
+        /// @brief Finds the first entry where the traces differ.
+        /// @param first First trace.
+        /// @param second Second trace.
+        /// @param context_size Number of matching entries to keep before the divergence.
+        /// @return First divergence or error Status.
+        static StatusOr<CpuTraceDivergence> find_first_divergence(CpuTraceReader& first, CpuTraceReader& second, const std::size_t context_size);
+
+        /// @brief Formats the divergence as text with disassembled instructions.
+        /// @param divergence Divergence to format.
+        /// @param instruction_set Instruction set to disassemble with.
+        /// @return Report text.
+        static std::string format_report(const CpuTraceDivergence& divergence, const InstructionSetLR35902& instruction_set);
+    };
+
+}//namespace_mygbc
+
+#endif
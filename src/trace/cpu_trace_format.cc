@@ -0,0 +1,73 @@
+#include <cstdio> //std::snprintf
+#include "cpu_trace_format.h" //CpuTraceEntry, CpuTracePcMemoryCache
+
+namespace mygbc{
+
+    /// @brief Initializes zeroed entry.
+    CpuTraceEntry::CpuTraceEntry():index(0), cycle(0), register_words{}, pc_memory{}, cycles(0){
+    }
+
+    /// @brief Formats the entry as a gameboy-doctor log line.
+    /// @details A:00 F:00 B:00 C:00 D:00 E:00 H:00 L:00 SP:0000 PC:0000 PCMEM:00,00,00,00
+    /// @return Log line without a line break.
+    std::string CpuTraceEntry::to_doctor_line() const{
+        char line[96];
+        std::snprintf(
+            line, sizeof(line), "A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X",
+            register_words[1] >> 8, register_words[1] & 0xFF,
+            register_words[2] >> 8, register_words[2] & 0xFF,
+            register_words[3] >> 8, register_words[3] & 0xFF,
+            register_words[4] >> 8, register_words[4] & 0xFF,
+            register_words[6], register_words[5],
+            pc_memory[0], pc_memory[1], pc_memory[2], pc_memory[3]
+        );
+        return std::string(line);
+    }
+
+    /// @brief Comparison operator for the data type
+    /// @param other
+    /// @return are the entries a match data wise?
+    bool CpuTraceEntry::operator==(const CpuTraceEntry& other) const noexcept{
+        return index == other.index && cycle == other.cycle && register_words == other.register_words &&
+            pc_memory == other.pc_memory && cycles == other.cycles;
+    }
+
+    /// @brief Initializes empty cache.
+    CpuTracePcMemoryCache::CpuTracePcMemoryCache():generation_(1), slots_(slot_count, Slot{0, 0, {}}){
+    }
+
+    /// @brief Forgets every entry.
+    void CpuTracePcMemoryCache::clear() noexcept{
+        ++generation_;
+    }
+
+    /// @brief Does the cache hold the bytes for the PC?
+    /// @param pc Program counter.
+    /// @param pc_memory Bytes at the PC.
+    /// @return Are the bytes cached?
+    bool CpuTracePcMemoryCache::contains(const uint16_t pc, const std::array<uint8_t, 4>& pc_memory) const noexcept{
+        const Slot& slot = slots_[pc % slot_count];
+        return slot.generation == generation_ && slot.pc == pc && slot.pc_memory == pc_memory;
+    }
+
+    /// @brief Returns the cached bytes for the PC.
+    /// @param pc Program counter.
+    /// @param pc_memory Set to the cached bytes.
+    /// @return Were bytes cached for the PC?
+    bool CpuTracePcMemoryCache::lookup(const uint16_t pc, std::array<uint8_t, 4>& pc_memory) const noexcept{
+        const Slot& slot = slots_[pc % slot_count];
+        if(slot.generation != generation_ || slot.pc != pc){
+            return false;
+        }
+        pc_memory = slot.pc_memory;
+        return true;
+    }
+
+    /// @brief Caches the bytes for the PC.
+    /// @param pc Program counter.
+    /// @param pc_memory Bytes at the PC.
+    void CpuTracePcMemoryCache::store(const uint16_t pc, const std::array<uint8_t, 4>& pc_memory) noexcept{
+        slots_[pc % slot_count] = Slot{generation_, pc, pc_memory};
+    }
+
+}//namespace_mygbc
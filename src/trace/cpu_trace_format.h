@@ -0,0 +1,119 @@
+#ifndef CPU_TRACE_FORMAT_H
+#define CPU_TRACE_FORMAT_H
+
+#include <array> //std::array
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief State of the CPU before a traced instruction.
+    struct CpuTraceEntry{
+        //Number of 16-bit registers in the LR35902RegisterFile
+        static constexpr std::size_t register_count = 7;
+
+        //Index of the entry in the trace
+        uint64_t index;
+
+        //T-cycles executed since power on before the instruction
+        uint64_t cycle;
+
+        //Register words before the instruction in the order ir_ie, a_f, b_c, d_e, h_l, pc, sp
+        std::array<uint16_t, register_count> register_words;
+
+        //Bytes at PC, the instruction and what follows it
+        std::array<uint8_t, 4> pc_memory;
+
+        //T-cycles taken by the instruction
+        uint8_t cycles;
+
+        /// @brief Initializes zeroed entry.
+        CpuTraceEntry();
+
+        /// @brief Formats the entry as a gameboy-doctor log line.
+        /// @details A:00 F:00 B:00 C:00 D:00 E:00 H:00 L:00 SP:0000 PC:0000 PCMEM:00,00,00,00
+        /// @return Log line without a line break.
+        std::string to_doctor_line() const;
+
+        /// @brief Comparison operator for the data type
+        /// @param other
+        /// @return are the entries a match data wise?
+        bool operator==(const CpuTraceEntry& other) const noexcept;
+    };
+
+    /// @brief Layout of the binary CPU trace files.
+    /// @details Little-endian. A file header is followed by independent chunks. A chunk header holds a keyframe
+    ///         (index, cycle and registers before its first record) and the payload size. Each record holds a mask
+    ///         byte, the cycles byte and the changed values: bits 0-6 of the mask mark changed register words
+    ///         (PC as zigzag varint delta, others as raw words), bit 7 marks PC memory bytes that differ from the
+    ///         last ones seen at the PC within the chunk.
+    struct CpuTraceFormat{
+        //File magic and format version
+        static constexpr std::array<uint8_t, 4> magic = {'M', 'G', 'T', 'R'};
+        static constexpr uint16_t version = 1;
+        static constexpr std::size_t file_header_size = 8;
+
+        //Record count, payload size, first index, first cycle and keyframe registers
+        static constexpr std::size_t chunk_header_size = 4 + 4 + 8 + 8 + (CpuTraceEntry::register_count * 2);
+
+        //Records per chunk
+        static constexpr std::size_t records_per_chunk = 4096;
+
+        //Index of the PC in the register words
+        static constexpr std::size_t pc_index = 5;
+
+        //Mask bit marking literal PC memory bytes
+        static constexpr uint8_t pc_memory_flag = 0x80;
+
+        //Largest encoded record: mask, cycles, PC varint, six words and the PC memory
+        static constexpr std::size_t max_record_size = 2 + 3 + (6 * 2) + 4;
+    };
+
+    /// @brief Remembers the last PC memory bytes seen per PC, used to skip repeated instruction bytes.
+    /// @details Direct mapped on the PC. Cleared per chunk by bumping the generation so chunks decode independently.
+    class CpuTracePcMemoryCache{
+        public:
+        /// @brief Initializes empty cache.
+        CpuTracePcMemoryCache();
+
+        /// @brief Forgets every entry.
+        void clear() noexcept;
+
+        /// @brief Does the cache hold the bytes for the PC?
+        /// @param pc Program counter.
+        /// @param pc_memory Bytes at the PC.
+        /// @return Are the bytes cached?
+        bool contains(const uint16_t pc, const std::array<uint8_t, 4>& pc_memory) const noexcept;
+
+        /// @brief Returns the cached bytes for the PC.
+        /// @param pc Program counter.
+        /// @param pc_memory Set to the cached bytes.
+        /// @return Were bytes cached for the PC?
+        bool lookup(const uint16_t pc, std::array<uint8_t, 4>& pc_memory) const noexcept;
+
+        /// @brief Caches the bytes for the PC.
+        /// @param pc Program counter.
+        /// @param pc_memory Bytes at the PC.
+        void store(const uint16_t pc, const std::array<uint8_t, 4>& pc_memory) noexcept;
+
+        private:
+        //Number of cache slots
+        static constexpr std::size_t slot_count = 4096;
+
+        struct Slot{
+            uint32_t generation;
+            uint16_t pc;
+            std::array<uint8_t, 4> pc_memory;
+        };
+
+        //Current generation, slots of older generations are empty
+        uint32_t generation_;
+
+        std::vector<Slot> slots_;
+    };
+
+}//namespace_mygbc
+
+#endif
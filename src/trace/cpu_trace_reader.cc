@@ -0,0 +1,185 @@
+#include <algorithm> //std::equal, std::copy
+#include <string> //std::to_string
+#include "cpu_trace_reader.h" //CpuTraceReader
+
+namespace mygbc{
+
+    namespace{
+
+        /// @brief Reads little-endian value.
+        /// @param source Buffer to read from.
+        /// @param byte_count Number of bytes to read.
+        /// @return Read value.
+        uint64_t read_le(const uint8_t* source, const std::size_t byte_count) noexcept{
+            uint64_t value = 0;
+            for(std::size_t byte = 0; byte < byte_count; ++byte){
+                value |= static_cast<uint64_t>(source[byte]) << (byte * 8);
+            }
+            return value;
+        }
+    }
+
+    /// @brief Initializes reader without a trace.
+    CpuTraceReader::CpuTraceReader():next_chunk_(0), position_(0), chunk_end_(0), chunk_records_left_(0), previous_cycles_(0){
+    }
+
+    /// @brief Maps the trace file and indexes its chunks.
+    /// @param file_path Path to the trace file.
+    /// @return Status of the open.
+    Status CpuTraceReader::open(const std::string& file_path){
+        //A reopened reader starts decoding from the first chunk of the new trace
+        chunk_offsets_.clear();
+        next_chunk_ = 0;
+        chunk_records_left_ = 0;
+        position_ = 0;
+        chunk_end_ = 0;
+        previous_ = CpuTraceEntry();
+        previous_cycles_ = 0;
+        pc_memory_cache_.clear();
+        Status open_status = file_.open(file_path);
+        if(!open_status.ok()){
+            return open_status;
+        }
+        const uint8_t* data = file_.data();
+        const std::size_t size = file_.size();
+        if(size < CpuTraceFormat::file_header_size || !std::equal(CpuTraceFormat::magic.begin(), CpuTraceFormat::magic.end(), data)){
+            return Status::invalid_input_error("File is not a CPU trace!");
+        }
+        if(read_le(data + CpuTraceFormat::magic.size(), 2) != CpuTraceFormat::version){
+            return Status::invalid_input_error("Unsupported CPU trace version!");
+        }
+        //Chunk headers hold the payload size, hop from header to header. A torn chunk at the end is ignored.
+        std::size_t offset = CpuTraceFormat::file_header_size;
+        while(size - offset >= CpuTraceFormat::chunk_header_size){
+            const std::size_t payload_size = read_le(data + offset + 4, 4);
+            if(size - offset - CpuTraceFormat::chunk_header_size < payload_size){
+                break;
+            }
+            chunk_offsets_.push_back(offset);
+            offset += CpuTraceFormat::chunk_header_size + payload_size;
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Returns the number of chunks in the trace.
+    /// @return Number of chunks.
+    std::size_t CpuTraceReader::get_chunk_count() const noexcept{
+        return chunk_offsets_.size();
+    }
+
+    /// @brief Returns the encoded chunk.
+    /// @param chunk Index of the chunk.
+    /// @return Encoded chunk or error Status.
+    StatusOr<CpuTraceChunk> CpuTraceReader::get_chunk(const std::size_t chunk) const{
+        if(chunk >= chunk_offsets_.size()){
+            return Status::invalid_index_error("CPU trace has no chunk " + std::to_string(chunk) + "!");
+        }
+        const uint8_t* header = file_.data() + chunk_offsets_[chunk];
+        CpuTraceChunk encoded_chunk;
+        encoded_chunk.data = header;
+        encoded_chunk.size = CpuTraceFormat::chunk_header_size + read_le(header + 4, 4);
+        encoded_chunk.first_index = read_le(header + 8, 8);
+        encoded_chunk.record_count = read_le(header, 4);
+        return encoded_chunk;
+    }
+
+    /// @brief Continues decoding from the start of the chunk.
+    /// @param chunk Index of the chunk.
+    /// @return Status of the seek.
+    Status CpuTraceReader::seek_to_chunk(const std::size_t chunk){
+        if(chunk > chunk_offsets_.size()){
+            return Status::invalid_index_error("CPU trace has no chunk " + std::to_string(chunk) + "!");
+        }
+        next_chunk_ = chunk;
+        chunk_records_left_ = 0;
+        position_ = 0;
+        chunk_end_ = 0;
+        return Status::ok_status();
+    }
+
+    /// @brief Decodes the next entry.
+    /// @param entry Set to the decoded entry.
+    /// @return Was an entry decoded (false at the end of the trace) or error Status.
+    StatusOr<bool> CpuTraceReader::next(CpuTraceEntry& entry){
+        while(chunk_records_left_ == 0){
+            if(position_ != chunk_end_){
+                return Status::invalid_input_error("CPU trace chunk has trailing bytes!");
+            }
+            if(next_chunk_ >= chunk_offsets_.size()){
+                return false;
+            }
+            begin_chunk(next_chunk_++);
+        }
+        const Status truncated = Status::invalid_input_error("CPU trace record is truncated!");
+        if(chunk_end_ - position_ < 2){
+            return truncated;
+        }
+        const uint8_t* data = file_.data();
+        const uint8_t mask = data[position_++];
+        entry = previous_;
+        entry.index = previous_.index + 1;
+        entry.cycle = previous_.cycle + previous_cycles_;
+        entry.cycles = data[position_++];
+        for(std::size_t word = 0; word < CpuTraceEntry::register_count; ++word){
+            if((mask & (1 << word)) == 0){
+                continue;
+            }
+            if(word == CpuTraceFormat::pc_index){
+                uint32_t zigzag = 0;
+                for(uint8_t shift = 0; ; shift += 7){
+                    if(position_ >= chunk_end_ || shift > 21){
+                        return truncated;
+                    }
+                    const uint8_t byte = data[position_++];
+                    zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                    if((byte & 0x80) == 0){
+                        break;
+                    }
+                }
+                const int32_t delta = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 0x01);
+                entry.register_words[word] = static_cast<uint16_t>(previous_.register_words[word] + delta);
+            }
+            else{
+                if(chunk_end_ - position_ < 2){
+                    return truncated;
+                }
+                entry.register_words[word] = static_cast<uint16_t>(read_le(&data[position_], 2));
+                position_ += 2;
+            }
+        }
+        const uint16_t pc = entry.register_words[CpuTraceFormat::pc_index];
+        if((mask & CpuTraceFormat::pc_memory_flag) != 0){
+            if(chunk_end_ - position_ < entry.pc_memory.size()){
+                return truncated;
+            }
+            std::copy(&data[position_], &data[position_] + entry.pc_memory.size(), entry.pc_memory.begin());
+            position_ += entry.pc_memory.size();
+            pc_memory_cache_.store(pc, entry.pc_memory);
+        }
+        else if(!pc_memory_cache_.lookup(pc, entry.pc_memory)){
+            return Status::invalid_input_error("CPU trace record refers to unknown PC memory!");
+        }
+        previous_ = entry;
+        previous_cycles_ = entry.cycles;
+        --chunk_records_left_;
+        return true;
+    }
+
+    /// @brief Parses the header of the chunk and resets the delta state.
+    /// @param chunk Index of the chunk.
+    void CpuTraceReader::begin_chunk(const std::size_t chunk){
+        const uint8_t* header = file_.data() + chunk_offsets_[chunk];
+        chunk_records_left_ = read_le(header, 4);
+        position_ = chunk_offsets_[chunk] + CpuTraceFormat::chunk_header_size;
+        chunk_end_ = position_ + read_le(header + 4, 4);
+        //The keyframe is the state before the first record, the index wraps back to it on the first record
+        previous_.index = read_le(header + 8, 8) - 1;
+        previous_.cycle = read_le(header + 16, 8);
+        previous_cycles_ = 0;
+        for(std::size_t word = 0; word < CpuTraceEntry::register_count; ++word){
+            previous_.register_words[word] = static_cast<uint16_t>(read_le(header + 24 + (word * 2), 2));
+        }
+        pc_memory_cache_.clear();
+    }
+
+}//namespace_mygbc
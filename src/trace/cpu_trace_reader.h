@@ -0,0 +1,92 @@
+#ifndef CPU_TRACE_READER_H
+#define CPU_TRACE_READER_H
+
+#include <array> //std::array
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "cpu_trace_format.h" //CpuTraceEntry, CpuTraceFormat, CpuTracePcMemoryCache
+#include "../util/io/mapped_file.h" //MappedFile
+#include "../util/status/status.h" //Status
+#include "../util/status/status_or.h" //StatusOr
+
+namespace mygbc{
+
+    /// @brief Encoded chunk of a trace, see CpuTraceFormat.
+    struct CpuTraceChunk{
+        //Chunk header followed by the payload
+        const uint8_t* data;
+        std::size_t size;
+
+        //Index of the first record
+        uint64_t first_index;
+
+        //Records in the chunk
+        std::size_t record_count;
+    };
+
+    /// @brief Decodes binary CPU traces written by CpuTraceRecorder.
+    /// @details The trace is read through MappedFile. The chunks are indexed on open, decoding can start at any chunk.
+    ///         A torn chunk at the end of the trace is ignored.
+    class CpuTraceReader{
+        public:
+
+        /// @brief Initializes reader without a trace.
+        CpuTraceReader();
+
+        /// @brief Maps the trace file and indexes its chunks.
+        /// @param file_path Path to the trace file.
+        /// @return Status of the open.
+        Status open(const std::string& file_path);
+
+        /// @brief Returns the number of chunks in the trace.
+        /// @return Number of chunks.
+        std::size_t get_chunk_count() const noexcept;
+
+        /// @brief Returns the encoded chunk.
+        /// @param chunk Index of the chunk.
+        /// @return Encoded chunk or error Status.
+        StatusOr<CpuTraceChunk> get_chunk(const std::size_t chunk) const;
+
+        /// @brief Continues decoding from the start of the chunk.
+        /// @param chunk Index of the chunk.
+        /// @return Status of the seek.
+        Status seek_to_chunk(const std::size_t chunk);
+
+        /// @brief Decodes the next entry.
+        /// @param entry Set to the decoded entry.
+        /// @return Was an entry decoded (false at the end of the trace) or error Status.
+        StatusOr<bool> next(CpuTraceEntry& entry);
+
+        private:
+
+        /// @brief Parses the header of the chunk and resets the delta state.
+        /// @param chunk Index of the chunk.
+        void begin_chunk(const std::size_t chunk);
+
+        //Mapped trace
+        MappedFile file_;
+
+        //Offset of each chunk header
+        std::vector<std::size_t> chunk_offsets_;
+
+        //Next chunk to decode
+        std::size_t next_chunk_;
+
+        //Read position and end of the current chunk payload
+        std::size_t position_;
+        std::size_t chunk_end_;
+
+        //Records left in the current chunk
+        std::size_t chunk_records_left_;
+
+        //State after the previous record
+        CpuTraceEntry previous_;
+        uint8_t previous_cycles_;
+        CpuTracePcMemoryCache pc_memory_cache_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,230 @@
+#include <algorithm> //std::max, std::copy
+#include "cpu_trace_recorder.h" //CpuTraceRecorder
+
+namespace mygbc{
+
+    namespace{
+
+        /// @brief Writes the value little-endian.
+        /// @param value Value to write.
+        /// @param byte_count Number of bytes to write.
+        /// @param destination Buffer to write to.
+        void write_le(const uint64_t value, const std::size_t byte_count, uint8_t* destination) noexcept{
+            for(std::size_t byte = 0; byte < byte_count; ++byte){
+                destination[byte] = static_cast<uint8_t>(value >> (byte * 8));
+            }
+        }
+    }
+
+    /// @brief Initializes closed recorder.
+    /// @param max_pending_chunks Full chunks that may wait for the writer before record blocks, at least 1.
+    CpuTraceRecorder::CpuTraceRecorder(const std::size_t max_pending_chunks)
+    :max_pending_chunks_(std::max<std::size_t>(max_pending_chunks, 1)), stall_count_(0), stopping_(false), write_failed_(false), chunk_record_count_(0), previous_words_{}, record_count_(0), cycle_(0), open_(false){
+    }
+
+    /// @brief Flushes and closes the trace.
+    CpuTraceRecorder::~CpuTraceRecorder(){
+        close();
+    }
+
+    /// @brief Creates the trace file and starts the writer thread.
+    /// @param file_path Path to the trace file.
+    /// @param start_cycle T-cycles executed before the first recorded instruction.
+    /// @return Status of the open.
+    Status CpuTraceRecorder::open(const std::string& file_path, const uint64_t start_cycle){
+        if(open_){
+            return Status::io_error("Trace recorder is already open!");
+        }
+        file_.open(file_path, std::ios::binary | std::ios::trunc);
+        std::array<uint8_t, CpuTraceFormat::file_header_size> header{};
+        std::copy(CpuTraceFormat::magic.begin(), CpuTraceFormat::magic.end(), header.begin());
+        write_le(CpuTraceFormat::version, 2, &header[CpuTraceFormat::magic.size()]);
+        file_.write(reinterpret_cast<const char*>(header.data()), header.size());
+        if(!file_){
+            file_.close();
+            return Status::io_error("Could not create trace file at " + file_path + "!");
+        }
+        stopping_ = false;
+        write_failed_ = false;
+        record_count_ = 0;
+        stall_count_ = 0;
+        cycle_ = start_cycle;
+        chunk_record_count_ = 0;
+        chunk_.clear();
+        chunk_.reserve(CpuTraceFormat::chunk_header_size + (CpuTraceFormat::records_per_chunk * CpuTraceFormat::max_record_size));
+        open_ = true;
+        writer_thread_ = std::thread(&CpuTraceRecorder::writer_loop, this);
+        return Status::ok_status();
+    }
+
+    /// @brief Records an executed instruction.
+    /// @param register_words Register words before the instruction, see CpuTraceEntry::register_words.
+    /// @param pc_memory Bytes at the PC before the instruction.
+    /// @param cycles T-cycles taken by the instruction.
+    void CpuTraceRecorder::record(const std::array<uint16_t, CpuTraceEntry::register_count>& register_words, const std::array<uint8_t, 4>& pc_memory, const uint8_t cycles){
+        if(!open_){
+            return;
+        }
+        if(chunk_record_count_ == 0){
+            begin_chunk(register_words);
+        }
+        //Reserve the mask, filled in once the changes are known
+        const std::size_t mask_position = chunk_.size();
+        chunk_.push_back(0);
+        chunk_.push_back(cycles);
+        uint8_t mask = 0;
+        for(std::size_t word = 0; word < CpuTraceEntry::register_count; ++word){
+            if(register_words[word] == previous_words_[word]){
+                continue;
+            }
+            mask |= static_cast<uint8_t>(1 << word);
+            if(word == CpuTraceFormat::pc_index){
+                //Zigzag varint of the PC delta, sequential code takes a single byte
+                const int32_t delta = static_cast<int16_t>(register_words[word] - previous_words_[word]);
+                uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+                while(zigzag >= 0x80){
+                    chunk_.push_back(static_cast<uint8_t>(zigzag | 0x80));
+                    zigzag >>= 7;
+                }
+                chunk_.push_back(static_cast<uint8_t>(zigzag));
+            }
+            else{
+                chunk_.push_back(static_cast<uint8_t>(register_words[word] & 0xFF));
+                chunk_.push_back(static_cast<uint8_t>(register_words[word] >> 8));
+            }
+        }
+        const uint16_t pc = register_words[CpuTraceFormat::pc_index];
+        if(!pc_memory_cache_.contains(pc, pc_memory)){
+            mask |= CpuTraceFormat::pc_memory_flag;
+            chunk_.insert(chunk_.end(), pc_memory.begin(), pc_memory.end());
+            pc_memory_cache_.store(pc, pc_memory);
+        }
+        chunk_[mask_position] = mask;
+        previous_words_ = register_words;
+        cycle_ += cycles;
+        ++record_count_;
+        if(++chunk_record_count_ == CpuTraceFormat::records_per_chunk){
+            submit_chunk();
+        }
+    }
+
+    /// @brief Writes the pending records and closes the trace.
+    /// @return Status of the writes.
+    Status CpuTraceRecorder::close(){
+        if(!open_){
+            return Status::ok_status();
+        }
+        if(chunk_record_count_ > 0){
+            submit_chunk();
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            stopping_ = true;
+        }
+        queue_condition_.notify_one();
+        writer_thread_.join();
+        file_.close();
+        open_ = false;
+        if(write_failed_){
+            return Status::io_error("Could not write the trace file!");
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Is the recorder open?
+    /// @return Is the recorder open?
+    bool CpuTraceRecorder::is_open() const noexcept{
+        return open_;
+    }
+
+    /// @brief Returns the number of recorded instructions.
+    /// @return Recorded instructions.
+    uint64_t CpuTraceRecorder::get_record_count() const noexcept{
+        return record_count_;
+    }
+
+    /// @brief Returns how often a full chunk waited for room in the writer queue.
+    /// @return Number of waits since open.
+    uint64_t CpuTraceRecorder::get_stall_count() const noexcept{
+        return stall_count_;
+    }
+
+    /// @brief Returns the memory used by the chunk being encoded and the queued and recycled chunks.
+    /// @return Memory usage in bytes.
+    std::size_t CpuTraceRecorder::get_memory_usage(){
+        std::size_t bytes = chunk_.capacity();
+        std::lock_guard<std::mutex> queue_lock(queue_mutex_);
+        for(const std::vector<uint8_t>& chunk : pending_chunks_){
+            bytes += chunk.capacity();
+        }
+        for(const std::vector<uint8_t>& chunk : free_chunks_){
+            bytes += chunk.capacity();
+        }
+        return bytes + (free_chunks_.capacity() * sizeof(std::vector<uint8_t>));
+    }
+
+    /// @brief Starts a new chunk with the given registers as keyframe.
+    /// @param register_words Registers before the first record of the chunk.
+    void CpuTraceRecorder::begin_chunk(const std::array<uint16_t, CpuTraceEntry::register_count>& register_words){
+        chunk_.resize(CpuTraceFormat::chunk_header_size);
+        write_le(record_count_, 8, &chunk_[8]);
+        write_le(cycle_, 8, &chunk_[16]);
+        for(std::size_t word = 0; word < CpuTraceEntry::register_count; ++word){
+            write_le(register_words[word], 2, &chunk_[24 + (word * 2)]);
+        }
+        previous_words_ = register_words;
+        pc_memory_cache_.clear();
+    }
+
+    /// @brief Completes the chunk header and queues the chunk for writing.
+    /// @details Waits for the writer while max_pending_chunks chunks are queued.
+    void CpuTraceRecorder::submit_chunk(){
+        write_le(chunk_record_count_, 4, &chunk_[0]);
+        write_le(chunk_.size() - CpuTraceFormat::chunk_header_size, 4, &chunk_[4]);
+        std::vector<uint8_t> next_chunk;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            if(pending_chunks_.size() >= max_pending_chunks_){
+                //A disk slower than the emulation slows the emulation down instead of growing the queue
+                ++stall_count_;
+                space_condition_.wait(lock, [this]{ return pending_chunks_.size() < max_pending_chunks_; });
+            }
+            pending_chunks_.push_back(std::move(chunk_));
+            if(!free_chunks_.empty()){
+                next_chunk = std::move(free_chunks_.back());
+                free_chunks_.pop_back();
+            }
+        }
+        queue_condition_.notify_one();
+        //Reuse written buffers, keeps the emulation thread free of allocations once warmed up
+        if(next_chunk.capacity() == 0){
+            next_chunk.reserve(CpuTraceFormat::chunk_header_size + (CpuTraceFormat::records_per_chunk * CpuTraceFormat::max_record_size));
+        }
+        next_chunk.clear();
+        chunk_ = std::move(next_chunk);
+        chunk_record_count_ = 0;
+    }
+
+    /// @brief Writes queued chunks until closed.
+    void CpuTraceRecorder::writer_loop(){
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        while(true){
+            queue_condition_.wait(lock, [this]{ return stopping_ || !pending_chunks_.empty(); });
+            while(!pending_chunks_.empty()){
+                std::vector<uint8_t> chunk = std::move(pending_chunks_.front());
+                pending_chunks_.pop_front();
+                space_condition_.notify_one();
+                lock.unlock();
+                file_.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+                const bool failed = !file_;
+                lock.lock();
+                write_failed_ = write_failed_ || failed;
+                free_chunks_.push_back(std::move(chunk));
+            }
+            if(stopping_){
+                return;
+            }
+        }
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,113 @@
+#ifndef CPU_TRACE_RECORDER_H
+#define CPU_TRACE_RECORDER_H
+
+#include <array> //std::array
+#include <condition_variable> //std::condition_variable
+#include <deque> //std::deque
+#include <fstream> //std::ofstream
+#include <mutex> //std::mutex
+#include <string> //std::string
+#include <thread> //std::thread
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "cpu_trace_format.h" //CpuTraceEntry, CpuTraceFormat, CpuTracePcMemoryCache
+#include "../util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Records executed instructions into a binary trace file.
+    /// @details Records are delta encoded into chunks on the emulation thread. Full chunks are handed to a background
+    ///         thread that writes them to the file. The emulation only waits on the disk when the writer falls more
+    ///         than max_pending_chunks behind, which bounds the memory of the trace.
+    class CpuTraceRecorder{
+        public:
+
+        //Default number of full chunks that may wait for the writer
+        static constexpr std::size_t default_max_pending_chunks = 32;
+
+        /// @brief Initializes closed recorder.
+        /// @param max_pending_chunks Full chunks that may wait for the writer before record blocks, at least 1.
+        explicit CpuTraceRecorder(const std::size_t max_pending_chunks = default_max_pending_chunks);
+
+        /// @brief Flushes and closes the trace.
+        ~CpuTraceRecorder();
+
+        CpuTraceRecorder(const CpuTraceRecorder&) = delete;
+        CpuTraceRecorder& operator=(const CpuTraceRecorder&) = delete;
+
+        /// @brief Creates the trace file and starts the writer thread.
+        /// @param file_path Path to the trace file.
+        /// @param start_cycle T-cycles executed before the first recorded instruction.
+        /// @return Status of the open.
+        Status open(const std::string& file_path, const uint64_t start_cycle);
+
+        /// @brief Records an executed instruction.
+        /// @param register_words Register words before the instruction, see CpuTraceEntry::register_words.
+        /// @param pc_memory Bytes at the PC before the instruction.
+        /// @param cycles T-cycles taken by the instruction.
+        void record(const std::array<uint16_t, CpuTraceEntry::register_count>& register_words, const std::array<uint8_t, 4>& pc_memory, const uint8_t cycles);
+
+        /// @brief Writes the pending records and closes the trace.
+        /// @return Status of the writes.
+        Status close();
+
+        /// @brief Is the recorder open?
+        /// @return Is the recorder open?
+        bool is_open() const noexcept;
+
+        /// @brief Returns the number of recorded instructions.
+        /// @return Recorded instructions.
+        uint64_t get_record_count() const noexcept;
+
+        /// @brief Returns how often a full chunk waited for room in the writer queue.
+        /// @return Number of waits since open.
+        uint64_t get_stall_count() const noexcept;
+
+        /// @brief Returns the memory used by the chunk being encoded and the queued and recycled chunks.
+        /// @return Memory usage in bytes.
+        std::size_t get_memory_usage();
+
+        private:
+
+        /// @brief Starts a new chunk with the given registers as keyframe.
+        /// @param register_words Registers before the first record of the chunk.
+        void begin_chunk(const std::array<uint16_t, CpuTraceEntry::register_count>& register_words);
+
+        /// @brief Completes the chunk header and queues the chunk for writing.
+        /// @details Waits for the writer while max_pending_chunks chunks are queued.
+        void submit_chunk();
+
+        /// @brief Writes queued chunks until closed.
+        void writer_loop();
+
+        //Written trace
+        std::ofstream file_;
+
+        //Writer thread and its queue
+        std::thread writer_thread_;
+        std::mutex queue_mutex_;
+        std::condition_variable queue_condition_;
+        std::condition_variable space_condition_;
+        std::deque<std::vector<uint8_t>> pending_chunks_;
+        std::size_t max_pending_chunks_;
+        uint64_t stall_count_;
+        std::vector<std::vector<uint8_t>> free_chunks_;
+        bool stopping_;
+        bool write_failed_;
+
+        //Chunk being encoded
+        std::vector<uint8_t> chunk_;
+        std::size_t chunk_record_count_;
+
+        //State after the previous record
+        std::array<uint16_t, CpuTraceEntry::register_count> previous_words_;
+        CpuTracePcMemoryCache pc_memory_cache_;
+        uint64_t record_count_;
+        uint64_t cycle_;
+        bool open_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,287 @@
+#include <array> //std::array
+#include <bit> //std::countr_zero, std::countl_zero, std::endian
+#include <cstring> //std::memcpy, std::memset
+#include <limits> //std::numeric_limits
+#if defined(__SSE2__)
+#include <emmintrin.h> //SSE2
+#endif
+#include "snapshot_codec.h" //SnapshotCodec
+
+namespace mygbc{
+
+    namespace{
+        //Token types
+        constexpr uint8_t token_zero = 0x00;
+        constexpr uint8_t token_fill = 0x01;
+        constexpr uint8_t token_literal = 0x02;
+        constexpr uint8_t token_match = 0x03;
+
+        //Shortest run or match worth a token
+        constexpr std::size_t min_run = 4;
+
+        //Token length field value continued by a varint
+        constexpr std::size_t extended_length = 0x3F;
+
+        //Match finder hash table
+        constexpr uint8_t hash_bits = 12;
+        constexpr uint32_t no_position = std::numeric_limits<uint32_t>::max();
+
+        //Largest accepted uncompressed size
+        constexpr std::size_t max_uncompressed_size = std::size_t{1} << 30;
+
+        /// @brief Appends the value as LEB128 varint.
+        /// @param value Value to append.
+        /// @param destination Buffer to append to.
+        void write_varint(std::size_t value, std::vector<uint8_t>& destination){
+            while(value >= 0x80){
+                destination.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            destination.push_back(static_cast<uint8_t>(value));
+        }
+
+        /// @brief Reads LEB128 varint at the position and advances it.
+        /// @param source Buffer to read from.
+        /// @param size Size of the buffer.
+        /// @param position Read position.
+        /// @param value Read value.
+        /// @return Was a complete varint read?
+        bool read_varint(const uint8_t* source, const std::size_t size, std::size_t& position, std::size_t& value){
+            value = 0;
+            for(uint8_t shift = 0; position < size && shift < 64; shift += 7){
+                const uint8_t byte = source[position++];
+                value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+                if((byte & 0x80) == 0){
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief Minimum length of the token type.
+        /// @param type Token type.
+        /// @return Minimum length of the token.
+        constexpr std::size_t min_token_length(const uint8_t type){
+            return type == token_literal ? 1 : min_run;
+        }
+
+        /// @brief Appends the token header.
+        /// @param type Token type.
+        /// @param length Token length.
+        /// @param destination Buffer to append to.
+        void write_token(const uint8_t type, const std::size_t length, std::vector<uint8_t>& destination){
+            const std::size_t stored_length = length - min_token_length(type);
+            if(stored_length < extended_length){
+                destination.push_back(static_cast<uint8_t>((type << 6) | stored_length));
+                return;
+            }
+            destination.push_back(static_cast<uint8_t>((type << 6) | extended_length));
+            write_varint(stored_length - extended_length, destination);
+        }
+
+        /// @brief Appends the pending literal bytes as a token.
+        /// @param source Start of the literal bytes.
+        /// @param length Number of literal bytes.
+        /// @param destination Buffer to append to.
+        void write_literal(const uint8_t* source, const std::size_t length, std::vector<uint8_t>& destination){
+            if(length == 0){
+                return;
+            }
+            write_token(token_literal, length, destination);
+            destination.insert(destination.end(), source, source + length);
+        }
+
+        /// @brief Hashes the 4 bytes for the match finder.
+        /// @param source Bytes to hash.
+        /// @return Hash table index.
+        uint32_t hash_sequence(const uint8_t* source){
+            uint32_t sequence;
+            std::memcpy(&sequence, source, sizeof(uint32_t));
+            return (sequence * 2654435761u) >> (32 - hash_bits);
+        }
+    }
+
+    /// @brief Compresses the bytes.
+    /// @param source Bytes to compress.
+    /// @param size Number of bytes to compress.
+    /// @param destination Compressed bytes, cleared before compressing.
+    void SnapshotCodec::compress(const uint8_t* source, const std::size_t size, std::vector<uint8_t>& destination){
+        destination.clear();
+        write_varint(size, destination);
+        std::array<uint32_t, (1 << hash_bits)> match_table;
+        match_table.fill(no_position);
+        std::size_t position = 0;
+        std::size_t literal_start = 0;
+        while(position + min_run <= size){
+            const std::size_t remaining = size - position;
+            //Zero runs dominate memory images, skip the scan on non-zero bytes
+            const std::size_t zero_run = source[position] == 0 ? count_zero_run(source + position, remaining) : 0;
+            if(zero_run >= min_run){
+                write_literal(source + literal_start, position - literal_start, destination);
+                write_token(token_zero, zero_run, destination);
+                position += zero_run;
+                literal_start = position;
+                continue;
+            }
+            //Runs of the same byte
+            const uint8_t byte = source[position];
+            std::size_t fill_run = 1;
+            while(fill_run < remaining && source[position + fill_run] == byte){
+                ++fill_run;
+            }
+            if(fill_run >= min_run){
+                write_literal(source + literal_start, position - literal_start, destination);
+                write_token(token_fill, fill_run, destination);
+                destination.push_back(byte);
+                position += fill_run;
+                literal_start = position;
+                continue;
+            }
+            //Repeated sequences
+            const uint32_t hash = hash_sequence(source + position);
+            const uint32_t candidate = match_table[hash];
+            match_table[hash] = static_cast<uint32_t>(position);
+            if(candidate != no_position && std::memcmp(source + candidate, source + position, min_run) == 0){
+                std::size_t match_length = min_run;
+                while(match_length < remaining && source[candidate + match_length] == source[position + match_length]){
+                    ++match_length;
+                }
+                write_literal(source + literal_start, position - literal_start, destination);
+                write_token(token_match, match_length, destination);
+                write_varint(position - candidate, destination);
+                position += match_length;
+                literal_start = position;
+                continue;
+            }
+            ++position;
+        }
+        write_literal(source + literal_start, size - literal_start, destination);
+    }
+
+    /// @brief Compresses the bytes.
+    /// @param source Bytes to compress.
+    /// @return Compressed bytes.
+    std::vector<uint8_t> SnapshotCodec::compress(const std::vector<uint8_t>& source){
+        std::vector<uint8_t> destination;
+        compress(source.data(), source.size(), destination);
+        return destination;
+    }
+
+    /// @brief Decompresses the bytes.
+    /// @param source Compressed bytes.
+    /// @param size Number of compressed bytes.
+    /// @param destination Decompressed bytes, resized to the uncompressed size.
+    /// @return Status of the decompression.
+    Status SnapshotCodec::decompress(const uint8_t* source, const std::size_t size, std::vector<uint8_t>& destination){
+        std::size_t read_position = 0;
+        std::size_t uncompressed_size = 0;
+        if(!read_varint(source, size, read_position, uncompressed_size) || uncompressed_size > max_uncompressed_size){
+            return Status::invalid_input_error("Compressed stream has no valid size header!");
+        }
+        destination.resize(uncompressed_size);
+        uint8_t* output = destination.data();
+        std::size_t write_position = 0;
+        while(read_position < size){
+            const uint8_t token = source[read_position++];
+            const uint8_t type = token >> 6;
+            std::size_t length = token & extended_length;
+            if(length == extended_length){
+                std::size_t extra_length = 0;
+                if(!read_varint(source, size, read_position, extra_length)){
+                    return Status::invalid_input_error("Compressed stream has a truncated token!");
+                }
+                length += extra_length;
+            }
+            length += min_token_length(type);
+            if(length > uncompressed_size - write_position){
+                return Status::invalid_input_error("Compressed stream exceeds the uncompressed size!");
+            }
+            switch(type){
+            case token_zero:
+                std::memset(output + write_position, 0x00, length);
+                break;
+            case token_fill:
+                if(read_position >= size){
+                    return Status::invalid_input_error("Compressed stream has a truncated fill!");
+                }
+                std::memset(output + write_position, source[read_position++], length);
+                break;
+            case token_literal:
+                if(length > size - read_position){
+                    return Status::invalid_input_error("Compressed stream has a truncated literal!");
+                }
+                std::memcpy(output + write_position, source + read_position, length);
+                read_position += length;
+                break;
+            default:{
+                std::size_t offset = 0;
+                if(!read_varint(source, size, read_position, offset) || offset == 0 || offset > write_position){
+                    return Status::invalid_input_error("Compressed stream has an invalid match offset!");
+                }
+                const uint8_t* match = output + write_position - offset;
+                if(offset >= length){
+                    std::memcpy(output + write_position, match, length);
+                }
+                else{
+                    //Overlapping match repeats the pattern
+                    for(std::size_t index = 0; index < length; ++index){
+                        output[write_position + index] = match[index];
+                    }
+                }
+                break;
+            }
+            }
+            write_position += length;
+        }
+        if(write_position != uncompressed_size){
+            return Status::invalid_input_error("Compressed stream ended before the uncompressed size!");
+        }
+        return Status::ok_status();
+    }
+
+    /// @brief Decompresses the bytes.
+    /// @param source Compressed bytes.
+    /// @param destination Decompressed bytes, resized to the uncompressed size.
+    /// @return Status of the decompression.
+    Status SnapshotCodec::decompress(const std::vector<uint8_t>& source, std::vector<uint8_t>& destination){
+        return decompress(source.data(), source.size(), destination);
+    }
+
+    /// @brief Returns the length of the zero run at the start of the bytes.
+    /// @details Scans 16 bytes at a time with SSE2 when available, 8 bytes at a time otherwise.
+    /// @param source Bytes to scan.
+    /// @param size Number of bytes to scan.
+    /// @return Number of leading zero bytes.
+    std::size_t SnapshotCodec::count_zero_run(const uint8_t* source, const std::size_t size) noexcept{
+        std::size_t run = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        while(run + 16 <= size){
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + run));
+            const uint32_t zero_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+            if(zero_mask != 0xFFFF){
+                return run + std::countr_zero(~zero_mask);
+            }
+            run += 16;
+        }
+#endif
+        while(run + sizeof(uint64_t) <= size){
+            uint64_t word;
+            std::memcpy(&word, source + run, sizeof(uint64_t));
+            if(word != 0){
+                if constexpr(std::endian::native == std::endian::little){
+                    return run + (std::countr_zero(word) / 8);
+                }
+                else{
+                    return run + (std::countl_zero(word) / 8);
+                }
+            }
+            run += sizeof(uint64_t);
+        }
+        while(run < size && source[run] == 0){
+            ++run;
+        }
+        return run;
+    }
+
+}//namespace_mygbc
@@ -0,0 +1,54 @@
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Fast byte oriented codec for GB memory images.
+    /// @details Tuned for images with long zero runs and repeated tiles. The stream starts with the uncompressed
+    ///         size as varint followed by tokens. A token byte holds the type in bits 6-7 and the length in bits 0-5,
+    ///         length 63 is continued by a varint.
+    ///         ZERO: length zero bytes. FILL: length copies of the following byte.
+    ///         LITERAL: length bytes follow. MATCH: length bytes copied from the varint offset back in the output.
+    class SnapshotCodec{
+        public:
+
+        /// @brief Compresses the bytes.
+        /// @param source Bytes to compress.
+        /// @param size Number of bytes to compress.
+        /// @param destination Compressed bytes, cleared before compressing.
+        static void compress(const uint8_t* source, const std::size_t size, std::vector<uint8_t>& destination);
+
+        /// @brief Compresses the bytes.
+        /// @param source Bytes to compress.
+        /// @return Compressed bytes.
+        static std::vector<uint8_t> compress(const std::vector<uint8_t>& source);
+
+        /// @brief Decompresses the bytes.
+        /// @param source Compressed bytes.
+        /// @param size Number of compressed bytes.
+        /// @param destination Decompressed bytes, resized to the uncompressed size.
+        /// @return Status of the decompression.
+        static Status decompress(const uint8_t* source, const std::size_t size, std::vector<uint8_t>& destination);
+
+        /// @brief Decompresses the bytes.
+        /// @param source Compressed bytes.
+        /// @param destination Decompressed bytes, resized to the uncompressed size.
+        /// @return Status of the decompression.
+        static Status decompress(const std::vector<uint8_t>& source, std::vector<uint8_t>& destination);
+
+        /// @brief Returns the length of the zero run at the start of the bytes.
+        /// @details Scans 16 bytes at a time with SSE2 when available, 8 bytes at a time otherwise.
+        /// @param source Bytes to scan.
+        /// @param size Number of bytes to scan.
+        /// @return Number of leading zero bytes.
+        static std::size_t count_zero_run(const uint8_t* source, const std::size_t size) noexcept;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,173 @@
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> //SSE2, AVX2
+#endif
+#include "content_hash.h" //ContentHash
+
+namespace mygbc{
+
+    namespace{
+        //Multipliers from xxHash64
+        constexpr uint64_t prime_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t prime_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t prime_3 = 0x165667B19E3779F9ull;
+
+        //Bytes per block, one 64-bit word per lane
+        constexpr std::size_t block_size = 32;
+
+        //Per lane keys and the key change per block, keeps the hash dependent on block order
+        constexpr uint64_t lane_keys[4] = {0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull};
+        constexpr uint64_t key_step = 0x78E5C0CC4EE679CBull;
+
+        /// @brief Rotates the value left.
+        /// @param value Value to rotate.
+        /// @param bits Bits to rotate by.
+        /// @return Rotated value.
+        constexpr uint64_t rotate_left(const uint64_t value, const uint8_t bits) noexcept{
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        /// @brief Mixes the word into the lane.
+        /// @param lane Lane accumulator.
+        /// @param word Word to mix in.
+        /// @return New lane accumulator.
+        constexpr uint64_t mix_word(const uint64_t lane, const uint64_t word) noexcept{
+            return rotate_left(lane + (word * prime_2), 31) * prime_1;
+        }
+
+        /// @brief Reads unaligned little-endian 64-bit word.
+        /// @param data Bytes to read.
+        /// @return Read word.
+        uint64_t read_word(const uint8_t* data) noexcept{
+            uint64_t word = 0;
+            for(std::size_t byte = 0; byte < sizeof(uint64_t); ++byte){
+                word |= static_cast<uint64_t>(data[byte]) << (byte * 8);
+            }
+            return word;
+        }
+
+        /// @brief Accumulates the whole blocks into the lanes without SIMD.
+        /// @details Each lane adds the 32x32 bit product of its keyed word and the raw word of its neighbour lane.
+        ///         Only needs 32-bit multiplies, so the SIMD versions produce the same lanes as this one.
+        /// @param data Bytes to accumulate.
+        /// @param block_count Number of whole blocks.
+        /// @param lanes Lane accumulators.
+        void accumulate_blocks_scalar(const uint8_t* data, const std::size_t block_count, uint64_t (&lanes)[4]) noexcept{
+            for(std::size_t block = 0; block < block_count; ++block){
+                for(std::size_t lane = 0; lane < 4; ++lane){
+                    const uint64_t word = read_word(data + (block * block_size) + (lane * 8));
+                    const uint64_t keyed = word ^ (lane_keys[lane] + (block * key_step));
+                    lanes[lane] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+                    lanes[lane ^ 1] += word;
+                }
+            }
+        }
+
+        /// @brief Accumulates the whole blocks into the lanes with the widest SIMD of the build.
+        /// @details Same lanes as accumulate_blocks_scalar.
+        /// @param data Bytes to accumulate.
+        /// @param block_count Number of whole blocks.
+        /// @param lanes Lane accumulators.
+        void accumulate_blocks(const uint8_t* data, const std::size_t block_count, uint64_t (&lanes)[4]) noexcept{
+#if defined(__AVX2__)
+            __m256i accumulator = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+            __m256i keys = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lane_keys));
+            const __m256i step = _mm256_set1_epi64x(static_cast<long long>(key_step));
+            for(std::size_t block = 0; block < block_count; ++block){
+                const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + (block * block_size)));
+                const __m256i keyed = _mm256_xor_si256(words, keys);
+                accumulator = _mm256_add_epi64(accumulator, _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32)));
+                accumulator = _mm256_add_epi64(accumulator, _mm256_shuffle_epi32(words, 0x4E));
+                keys = _mm256_add_epi64(keys, step);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), accumulator);
+#elif defined(__SSE2__)
+            __m128i accumulators[2] = {
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 2))
+            };
+            __m128i keys[2] = {
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane_keys)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane_keys + 2))
+            };
+            const __m128i step = _mm_set1_epi64x(static_cast<long long>(key_step));
+            for(std::size_t block = 0; block < block_count; ++block){
+                for(std::size_t half = 0; half < 2; ++half){
+                    const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (block * block_size) + (half * 16)));
+                    const __m128i keyed = _mm_xor_si128(words, keys[half]);
+                    accumulators[half] = _mm_add_epi64(accumulators[half], _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32)));
+                    accumulators[half] = _mm_add_epi64(accumulators[half], _mm_shuffle_epi32(words, 0x4E));
+                    keys[half] = _mm_add_epi64(keys[half], step);
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), accumulators[0]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 2), accumulators[1]);
+#else
+            accumulate_blocks_scalar(data, block_count, lanes);
+#endif
+        }
+
+        /// @brief Sets the starting lanes for the seed.
+        /// @param seed Starting value of the hash.
+        /// @param lanes Set to the lane accumulators.
+        void init_lanes(const uint64_t seed, uint64_t (&lanes)[4]) noexcept{
+            lanes[0] = seed + prime_1 + prime_2;
+            lanes[1] = seed + prime_2;
+            lanes[2] = seed;
+            lanes[3] = seed - prime_1;
+        }
+
+        /// @brief Folds the lanes and the bytes after the whole blocks into the hash.
+        /// @param lanes Lane accumulators of the whole blocks.
+        /// @param data Hashed bytes.
+        /// @param size Number of hashed bytes.
+        /// @return 64-bit hash of the bytes.
+        uint64_t finish_hash(const uint64_t (&lanes)[4], const uint8_t* data, const std::size_t size) noexcept{
+            std::size_t position = (size / block_size) * block_size;
+            uint64_t result = mix_word(0, lanes[0]);
+            result = mix_word(rotate_left(result, 7), lanes[1]);
+            result = mix_word(rotate_left(result, 12), lanes[2]);
+            result = mix_word(rotate_left(result, 18), lanes[3]);
+            result += size;
+            for(; position + 8 <= size; position += 8){
+                result = rotate_left(result ^ mix_word(0, read_word(data + position)), 27) * prime_1 + prime_3;
+            }
+            for(; position < size; ++position){
+                result = rotate_left(result ^ (data[position] * prime_3), 11) * prime_1;
+            }
+            //Final avalanche
+            result ^= result >> 33;
+            result *= prime_2;
+            result ^= result >> 29;
+            result *= prime_3;
+            result ^= result >> 32;
+            return result;
+        }
+    }
+
+    /// @brief Hashes the bytes.
+    /// @details The output is stored in snapshot archives, changing it needs a new SnapshotArchiveFormat::version.
+    /// @param data Bytes to hash.
+    /// @param size Number of bytes to hash.
+    /// @param seed Starting value of the hash.
+    /// @return 64-bit hash of the bytes.
+    uint64_t ContentHash::hash(const uint8_t* data, const std::size_t size, const uint64_t seed) noexcept{
+        uint64_t lanes[4];
+        init_lanes(seed, lanes);
+        accumulate_blocks(data, size / block_size, lanes);
+        return finish_hash(lanes, data, size);
+    }
+
+    /// @brief Hashes the bytes without SIMD.
+    /// @details Same result as hash, reference for the SIMD kernels.
+    /// @param data Bytes to hash.
+    /// @param size Number of bytes to hash.
+    /// @param seed Starting value of the hash.
+    /// @return 64-bit hash of the bytes.
+    uint64_t ContentHash::hash_portable(const uint8_t* data, const std::size_t size, const uint64_t seed) noexcept{
+        uint64_t lanes[4];
+        init_lanes(seed, lanes);
+        accumulate_blocks_scalar(data, size / block_size, lanes);
+        return finish_hash(lanes, data, size);
+    }
+
+}//namespace_mygbc
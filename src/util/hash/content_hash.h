@@ -0,0 +1,33 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Fast non-cryptographic 64-bit hash for memory contents.
+    /// @details Used to identify identical pages, equal hashes still need a byte compare.
+    class ContentHash{
+        public:
+
+        /// @brief Hashes the bytes.
+        /// @details The output is stored in snapshot archives, changing it needs a new SnapshotArchiveFormat::version.
+        /// @param data Bytes to hash.
+        /// @param size Number of bytes to hash.
+        /// @param seed Starting value of the hash.
+        /// @return 64-bit hash of the bytes.
+        static uint64_t hash(const uint8_t* data, const std::size_t size, const uint64_t seed = 0) noexcept;
+
+        /// @brief Hashes the bytes without SIMD.
+        /// @details Same result as hash, reference for the SIMD kernels.
+        /// @param data Bytes to hash.
+        /// @param size Number of bytes to hash.
+        /// @param seed Starting value of the hash.
+        /// @return 64-bit hash of the bytes.
+        static uint64_t hash_portable(const uint8_t* data, const std::size_t size, const uint64_t seed = 0) noexcept;
+    };
+
+}//namespace_mygbc
+
+#endif
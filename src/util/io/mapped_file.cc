@@ -0,0 +1,91 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h> //open
+#include <sys/mman.h> //mmap, munmap, madvise
+#include <sys/stat.h> //fstat
+#include <unistd.h> //close
+#define MYGBC_HAS_MMAP 1
+#endif
+#include <utility> //std::move
+#include "mapped_file.h" //MappedFile
+#include "binary_reader.h" //BinaryReader
+
+namespace mygbc{
+
+    /// @brief Initializes closed file.
+    MappedFile::MappedFile():data_(nullptr), size_(0), mapped_(false){
+    }
+
+    /// @brief Unmaps the file.
+    MappedFile::~MappedFile(){
+        close();
+    }
+
+    /// @brief Maps the file.
+    /// @param file_path Path to the file.
+    /// @param access_pattern How the contents are read.
+    /// @return Status of the open.
+    Status MappedFile::open(const std::string& file_path, const AccessPattern access_pattern){
+        close();
+#if defined(MYGBC_HAS_MMAP)
+        const int file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+        if(file_descriptor < 0){
+            return Status::io_error("Could not open the file at " + file_path + "!");
+        }
+        struct stat file_stat;
+        if(fstat(file_descriptor, &file_stat) != 0){
+            ::close(file_descriptor);
+            return Status::io_error("Could not read the size of the file at " + file_path + "!");
+        }
+        if(file_stat.st_size == 0){
+            //Empty files can't be mapped
+            ::close(file_descriptor);
+            return Status::ok_status();
+        }
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, file_descriptor, 0);
+        ::close(file_descriptor);
+        if(mapping == MAP_FAILED){
+            return Status::io_error("Could not map the file at " + file_path + "!");
+        }
+        madvise(mapping, static_cast<std::size_t>(file_stat.st_size), access_pattern == AccessPattern::random ? MADV_RANDOM : MADV_SEQUENTIAL);
+        data_ = static_cast<const uint8_t*>(mapping);
+        size_ = static_cast<std::size_t>(file_stat.st_size);
+        mapped_ = true;
+#else
+        (void)access_pattern;
+        StatusOr<std::vector<uint8_t>> contents = BinaryReader::read_as_bytes(file_path);
+        if(!contents.ok()){
+            return contents.status();
+        }
+        buffer_ = std::move(contents).value();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+        return Status::ok_status();
+    }
+
+    /// @brief Unmaps the file.
+    void MappedFile::close() noexcept{
+#if defined(MYGBC_HAS_MMAP)
+        if(mapped_){
+            munmap(const_cast<uint8_t*>(data_), size_);
+        }
+#endif
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    /// @brief Returns the start of the file contents.
+    /// @return Start of the contents, valid until close, nullptr when closed.
+    const uint8_t* MappedFile::data() const noexcept{
+        return data_;
+    }
+
+    /// @brief Returns the size of the file.
+    /// @return Size in bytes.
+    std::size_t MappedFile::size() const noexcept{
+        return size_;
+    }
+
+}//namespace_mygbc
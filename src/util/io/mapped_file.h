@@ -0,0 +1,67 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string> //std::string
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+#include "../status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Read only view of a whole file.
+    /// @details Memory maps the file where supported and reads it into memory otherwise.
+    class MappedFile{
+        public:
+
+        /// @brief How the contents are read, hints the kernel read ahead.
+        enum class AccessPattern{
+            //Front to back, read ahead aggressively
+            sequential,
+            //Scattered reads, no read ahead
+            random
+        };
+
+        /// @brief Initializes closed file.
+        MappedFile();
+
+        /// @brief Unmaps the file.
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @brief Maps the file.
+        /// @param file_path Path to the file.
+        /// @param access_pattern How the contents are read.
+        /// @return Status of the open.
+        Status open(const std::string& file_path, AccessPattern access_pattern = AccessPattern::sequential);
+
+        /// @brief Unmaps the file.
+        void close() noexcept;
+
+        /// @brief Returns the start of the file contents.
+        /// @return Start of the contents, valid until close, nullptr when closed.
+        const uint8_t* data() const noexcept;
+
+        /// @brief Returns the size of the file.
+        /// @return Size in bytes.
+        std::size_t size() const noexcept;
+
+        private:
+        //Start of the contents
+        const uint8_t* data_;
+
+        //Size of the contents
+        std::size_t size_;
+
+        //Is data_ a memory mapping?
+        bool mapped_;
+
+        //Contents when memory mapping is not supported
+        std::vector<uint8_t> buffer_;
+    };
+
+}//namespace_mygbc
+
+#endif
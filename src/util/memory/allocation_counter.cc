@@ -0,0 +1,102 @@
+#include <atomic> //std::atomic
+#include "allocation_counter.h" //AllocationCounter
+
+namespace mygbc{
+
+    namespace{
+        //Set once the hooks are linked
+        std::atomic<bool> hooked{false};
+
+        //Counts of the calling thread, trivially initialized so the hooks can use them at any time
+        thread_local uint64_t thread_allocations = 0;
+        thread_local uint64_t thread_allocated_bytes = 0;
+        thread_local uint64_t thread_deallocations = 0;
+        thread_local uint64_t thread_freed_bytes = 0;
+
+        //Allocations of every thread, constant initialized like the thread counts
+        std::atomic<uint64_t> process_allocations{0};
+    }
+
+    /// @brief Marks the hooks as linked, called by the hooks on static initialization.
+    void AllocationCounter::mark_hooked() noexcept{
+        hooked.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief Are the global operator new/delete hooks linked?
+    /// @return Are the allocations counted?
+    bool AllocationCounter::is_hooked() noexcept{
+        return hooked.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Counts an allocation of the calling thread, called by the hooks.
+    /// @param size Allocated bytes.
+    void AllocationCounter::record_allocation(const std::size_t size) noexcept{
+        ++thread_allocations;
+        thread_allocated_bytes += size;
+        process_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Counts a deallocation of the calling thread, called by the hooks.
+    /// @param size Freed bytes.
+    void AllocationCounter::record_deallocation(const std::size_t size) noexcept{
+        ++thread_deallocations;
+        thread_freed_bytes += size;
+    }
+
+    /// @brief Returns the allocations of the calling thread.
+    /// @return Number of allocations.
+    uint64_t AllocationCounter::get_allocation_count() noexcept{
+        return thread_allocations;
+    }
+
+    /// @brief Returns the allocations of every thread of the process.
+    /// @details Covers the worker threads of multi-threaded code under test.
+    /// @return Number of allocations.
+    uint64_t AllocationCounter::get_process_allocation_count() noexcept{
+        return process_allocations.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the bytes allocated by the calling thread.
+    /// @return Allocated bytes.
+    uint64_t AllocationCounter::get_allocated_bytes() noexcept{
+        return thread_allocated_bytes;
+    }
+
+    /// @brief Returns the deallocations of the calling thread.
+    /// @return Number of deallocations.
+    uint64_t AllocationCounter::get_deallocation_count() noexcept{
+        return thread_deallocations;
+    }
+
+    /// @brief Returns the bytes freed by the calling thread.
+    /// @return Freed bytes.
+    uint64_t AllocationCounter::get_freed_bytes() noexcept{
+        return thread_freed_bytes;
+    }
+
+    /// @brief Starts counting.
+    AllocationScope::AllocationScope() noexcept
+    :start_allocations_(AllocationCounter::get_allocation_count()), start_bytes_(AllocationCounter::get_allocated_bytes()),
+    start_freed_bytes_(AllocationCounter::get_freed_bytes()){
+    }
+
+    /// @brief Returns the allocations since construction.
+    /// @return Number of allocations.
+    uint64_t AllocationScope::get_allocation_count() const noexcept{
+        return AllocationCounter::get_allocation_count() - start_allocations_;
+    }
+
+    /// @brief Returns the bytes allocated since construction.
+    /// @return Allocated bytes.
+    uint64_t AllocationScope::get_allocated_bytes() const noexcept{
+        return AllocationCounter::get_allocated_bytes() - start_bytes_;
+    }
+
+    /// @brief Returns the growth of the live heap memory since construction.
+    /// @details Memory freed by other threads is not subtracted.
+    /// @return Allocated minus freed bytes, negative if more was freed.
+    int64_t AllocationScope::get_live_bytes() const noexcept{
+        return static_cast<int64_t>(get_allocated_bytes()) - static_cast<int64_t>(AllocationCounter::get_freed_bytes() - start_freed_bytes_);
+    }
+
+}//namespace_mygbc
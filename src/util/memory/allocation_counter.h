@@ -0,0 +1,80 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Counts the heap allocations of the calling thread.
+    /// @details The counts are only updated when the executable links the global operator new/delete hooks
+    ///         (mygbc_allocation_hooks), as the tests and benchmarks do.
+    class AllocationCounter{
+        public:
+
+        /// @brief Marks the hooks as linked, called by the hooks on static initialization.
+        static void mark_hooked() noexcept;
+
+        /// @brief Are the global operator new/delete hooks linked?
+        /// @return Are the allocations counted?
+        static bool is_hooked() noexcept;
+
+        /// @brief Counts an allocation of the calling thread, called by the hooks.
+        /// @param size Allocated bytes.
+        static void record_allocation(const std::size_t size) noexcept;
+
+        /// @brief Counts a deallocation of the calling thread, called by the hooks.
+        /// @param size Freed bytes.
+        static void record_deallocation(const std::size_t size) noexcept;
+
+        /// @brief Returns the allocations of the calling thread.
+        /// @return Number of allocations.
+        static uint64_t get_allocation_count() noexcept;
+
+        /// @brief Returns the allocations of every thread of the process.
+        /// @details Covers the worker threads of multi-threaded code under test.
+        /// @return Number of allocations.
+        static uint64_t get_process_allocation_count() noexcept;
+
+        /// @brief Returns the bytes allocated by the calling thread.
+        /// @return Allocated bytes.
+        static uint64_t get_allocated_bytes() noexcept;
+
+        /// @brief Returns the deallocations of the calling thread.
+        /// @return Number of deallocations.
+        static uint64_t get_deallocation_count() noexcept;
+
+        /// @brief Returns the bytes freed by the calling thread.
+        /// @return Freed bytes.
+        static uint64_t get_freed_bytes() noexcept;
+    };
+
+    /// @brief Counts the allocations of the calling thread from construction.
+    class AllocationScope{
+        public:
+        /// @brief Starts counting.
+        AllocationScope() noexcept;
+
+        /// @brief Returns the allocations since construction.
+        /// @return Number of allocations.
+        uint64_t get_allocation_count() const noexcept;
+
+        /// @brief Returns the bytes allocated since construction.
+        /// @return Allocated bytes.
+        uint64_t get_allocated_bytes() const noexcept;
+
+        /// @brief Returns the growth of the live heap memory since construction.
+        /// @details Memory freed by other threads is not subtracted.
+        /// @return Allocated minus freed bytes, negative if more was freed.
+        int64_t get_live_bytes() const noexcept;
+
+        private:
+        //Counts of the calling thread at construction
+        const uint64_t start_allocations_;
+        const uint64_t start_bytes_;
+        const uint64_t start_freed_bytes_;
+    };
+
+}//namespace_mygbc
+
+#endif
@@ -0,0 +1,99 @@
+#include <cstdlib> //std::malloc, std::free, std::aligned_alloc
+#include <malloc.h> //malloc_usable_size
+#include <new> //std::bad_alloc, std::align_val_t
+#include "allocation_counter.h" //AllocationCounter
+
+//Replaces the global operator new/delete to count the allocations of each thread
+//Linked into the test and benchmark executables only (mygbc_allocation_hooks), never into libmygbc
+//Bytes are counted as the usable size of the blocks so allocations and deallocations balance
+
+namespace{
+    const bool hooks_marked = (mygbc::AllocationCounter::mark_hooked(), true);
+
+    /// @brief Allocates and counts the bytes.
+    /// @param size Bytes to allocate.
+    /// @return Allocated memory or nullptr.
+    void* counted_malloc(const std::size_t size) noexcept{
+        void* memory = std::malloc(size == 0 ? 1 : size);
+        if(memory != nullptr){
+            mygbc::AllocationCounter::record_allocation(malloc_usable_size(memory));
+        }
+        return memory;
+    }
+
+    /// @brief Allocates aligned memory and counts the bytes.
+    /// @param size Bytes to allocate.
+    /// @param alignment Alignment of the memory.
+    /// @return Allocated memory or nullptr.
+    void* counted_aligned_alloc(const std::size_t size, const std::align_val_t alignment) noexcept{
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        //aligned_alloc requires a multiple of the alignment
+        void* memory = std::aligned_alloc(align, ((size == 0 ? 1 : size) + align - 1) / align * align);
+        if(memory != nullptr){
+            mygbc::AllocationCounter::record_allocation(malloc_usable_size(memory));
+        }
+        return memory;
+    }
+
+    /// @brief Frees and counts the memory.
+    /// @param memory Memory to free.
+    void counted_free(void* memory) noexcept{
+        if(memory != nullptr){
+            mygbc::AllocationCounter::record_deallocation(malloc_usable_size(memory));
+            std::free(memory);
+        }
+    }
+}
+
+void* operator new(std::size_t size){
+    void* memory = counted_malloc(size);
+    if(memory == nullptr){
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    return counted_malloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment){
+    void* memory = counted_aligned_alloc(size, alignment);
+    if(memory == nullptr){
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment){
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    return counted_aligned_alloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    return counted_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* memory) noexcept{ counted_free(memory); }
+void operator delete[](void* memory) noexcept{ counted_free(memory); }
+void operator delete(void* memory, std::size_t) noexcept{ counted_free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept{ counted_free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept{ counted_free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept{ counted_free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept{ counted_free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept{ counted_free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept{ counted_free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept{ counted_free(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept{ counted_free(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept{ counted_free(memory); }
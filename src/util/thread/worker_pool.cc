@@ -0,0 +1,123 @@
+#include <algorithm> //std::max
+#if defined(__linux__)
+#include <pthread.h> //pthread_setaffinity_np
+#include <sched.h> //cpu_set_t, sched_getaffinity
+#endif
+#include <vector> //std::vector
+#include "worker_pool.h" //WorkerPool
+
+namespace mygbc{
+
+    /// @brief Starts the workers.
+    /// @details Pinning is best effort and only supported on Linux. Worker N is pinned to the Nth CPU of the process
+    ///         affinity mask, so taskset and cpusets are respected. The calling thread is never pinned.
+    /// @param thread_count Threads running the batches including the calling thread, 0 uses the hardware concurrency.
+    /// @param pin_workers Pin each worker thread to its own core?
+    WorkerPool::WorkerPool(const std::size_t thread_count, const bool pin_workers)
+    :batch_generation_(0), active_workers_(0), stopping_(false), task_(nullptr), context_(nullptr), task_count_(0), next_task_(0){
+        const std::size_t core_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        const std::size_t total_threads = thread_count == 0 ? core_count : thread_count;
+        workers_.reserve(total_threads - 1);
+#if defined(__linux__)
+        //CPUs the process may run on, workers are spread over these only
+        std::vector<int> allowed_cpus;
+        cpu_set_t process_set;
+        CPU_ZERO(&process_set);
+        if(pin_workers && sched_getaffinity(0, sizeof(process_set), &process_set) == 0){
+            for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu){
+                if(CPU_ISSET(cpu, &process_set)){
+                    allowed_cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        for(std::size_t worker = 1; worker < total_threads; ++worker){
+            workers_.emplace_back(&WorkerPool::worker_loop, this);
+#if defined(__linux__)
+            if(!allowed_cpus.empty()){
+                cpu_set_t core_set;
+                CPU_ZERO(&core_set);
+                CPU_SET(allowed_cpus[worker % allowed_cpus.size()], &core_set);
+                pthread_setaffinity_np(workers_.back().native_handle(), sizeof(core_set), &core_set);
+            }
+#else
+            (void)pin_workers;
+#endif
+        }
+    }
+
+    /// @brief Stops and joins the workers.
+    WorkerPool::~WorkerPool(){
+        {
+            std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+            stopping_ = true;
+        }
+        start_condition_.notify_all();
+        for(std::thread& worker : workers_){
+            worker.join();
+        }
+    }
+
+    /// @brief Runs the task for every index below the task count and waits for them.
+    /// @details Call from a single thread at a time.
+    /// @param task_count Number of task indices.
+    /// @param task Task to run.
+    /// @param context Context passed to the task.
+    void WorkerPool::run(const std::size_t task_count, const Task task, void* context){
+        if(workers_.empty() || task_count <= 1){
+            for(std::size_t index = 0; index < task_count; ++index){
+                task(context, index);
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+            task_ = task;
+            context_ = context;
+            task_count_ = task_count;
+            next_task_.store(0, std::memory_order_relaxed);
+            active_workers_ = workers_.size();
+            ++batch_generation_;
+        }
+        start_condition_.notify_all();
+        run_tasks();
+        std::unique_lock<std::mutex> batch_lock(batch_mutex_);
+        done_condition_.wait(batch_lock, [this](){ return active_workers_ == 0; });
+    }
+
+    /// @brief Returns the number of threads running the batches.
+    /// @return Workers plus the calling thread.
+    std::size_t WorkerPool::get_thread_count() const noexcept{
+        return workers_.size() + 1;
+    }
+
+    /// @brief Runs the batches until stopped.
+    void WorkerPool::worker_loop(){
+        uint64_t seen_generation = 0;
+        while(true){
+            {
+                std::unique_lock<std::mutex> batch_lock(batch_mutex_);
+                start_condition_.wait(batch_lock, [this, seen_generation](){ return stopping_ || batch_generation_ != seen_generation; });
+                if(stopping_){
+                    return;
+                }
+                seen_generation = batch_generation_;
+            }
+            run_tasks();
+            std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+            if(--active_workers_ == 0){
+                done_condition_.notify_one();
+            }
+        }
+    }
+
+    /// @brief Runs tasks of the current batch until none are left.
+    void WorkerPool::run_tasks() noexcept{
+        std::size_t index = next_task_.fetch_add(1, std::memory_order_relaxed);
+        while(index < task_count_){
+            task_(context_, index);
+            index = next_task_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+}//namespace_mygbc
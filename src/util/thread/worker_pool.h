@@ -0,0 +1,83 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic> //std::atomic
+#include <condition_variable> //std::condition_variable
+#include <mutex> //std::mutex
+#include <thread> //std::thread
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include <cstddef> //std::size_t
+
+namespace mygbc{
+
+    /// @brief Fixed set of threads running batches of indexed tasks.
+    /// @details The calling thread takes part in every batch. Tasks are handed out through an atomic index,
+    ///         so a batch costs a single wake up per worker regardless of the number of tasks and never allocates.
+    class WorkerPool{
+        public:
+
+        //Task of a batch, called once per task index
+        using Task = void(*)(void* context, const std::size_t index);
+
+        /// @brief Starts the workers.
+        /// @details Pinning is best effort and only supported on Linux. Worker N is pinned to the Nth CPU of the process
+        ///         affinity mask, so taskset and cpusets are respected. The calling thread is never pinned.
+        /// @param thread_count Threads running the batches including the calling thread, 0 uses the hardware concurrency.
+        /// @param pin_workers Pin each worker thread to its own core?
+        explicit WorkerPool(const std::size_t thread_count, const bool pin_workers = false);
+
+        /// @brief Stops and joins the workers.
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /// @brief Runs the task for every index below the task count and waits for them.
+        /// @details Call from a single thread at a time.
+        /// @param task_count Number of task indices.
+        /// @param task Task to run.
+        /// @param context Context passed to the task.
+        void run(const std::size_t task_count, const Task task, void* context);
+
+        /// @brief Returns the number of threads running the batches.
+        /// @return Workers plus the calling thread.
+        std::size_t get_thread_count() const noexcept;
+
+        private:
+
+        /// @brief Runs the batches until stopped.
+        void worker_loop();
+
+        /// @brief Runs tasks of the current batch until none are left.
+        void run_tasks() noexcept;
+
+        //Worker threads, the calling thread is not included
+        std::vector<std::thread> workers_;
+
+        //Guards the batch state below
+        std::mutex batch_mutex_;
+        std::condition_variable start_condition_;
+        std::condition_variable done_condition_;
+
+        //Incremented for every batch
+        uint64_t batch_generation_;
+
+        //Workers still running the current batch
+        std::size_t active_workers_;
+
+        //Are the workers stopping?
+        bool stopping_;
+
+        //Current batch
+        Task task_;
+        void* context_;
+        std::size_t task_count_;
+
+        //Next task index to hand out
+        std::atomic<std::size_t> next_task_;
+    };
+
+}//namespace_mygbc
+
+#endif
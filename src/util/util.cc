@@ -53,6 +53,7 @@ namespace mygbc{
     }
 
     /// @brief Returns current unix timestamp in string format.
+    /// @details Host time, only meant for log messages. Must never feed the emulation, it would break deterministic replay.
     /// @return current unix timestamp in string format.
     std::string Util::get_unix_timestamp(){
         return std::to_string(
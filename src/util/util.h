@@ -31,6 +31,7 @@ namespace mygbc{
         static std::string trim_trailing_null_bytes(const std::string& str);
 
         /// @brief Returns current unix timestamp in string format.
+        /// @details Host time, only meant for log messages. Must never feed the emulation, it would break deterministic replay.
         /// @return current unix timestamp in string format.
         static std::string get_unix_timestamp();
     };
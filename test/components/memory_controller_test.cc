@@ -0,0 +1,71 @@
+#include "../../src/components/memory_controller.h" //MemoryController
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that RAM writes mark the page of the write dirty.
+TEST(MemoryControllerDirtyPageTest, ram_write_marks_page){
+    mygbc::MemoryController memory;
+    const uint16_t write_addr = 0xC123;
+    const uint8_t write_value = 0xAB;
+    const std::size_t expected_dirty_count = 1;
+    ASSERT_TRUE(memory.set_byte(write_addr, write_value).ok());
+    ASSERT_EQ(memory.get_byte(write_addr).value(), write_value);
+    ASSERT_EQ(memory.get_dirty_pages().count(), expected_dirty_count);
+    ASSERT_TRUE(memory.get_dirty_pages().test(0xC1));
+}
+
+/// @brief Checks that word writes across a page boundary mark both pages.
+TEST(MemoryControllerDirtyPageTest, word_write_marks_both_pages){
+    mygbc::MemoryController memory;
+    const uint16_t write_addr = 0xC0FF;
+    const uint16_t write_value = 0x1234;
+    ASSERT_TRUE(memory.set_word(write_addr, write_value).ok());
+    ASSERT_EQ(memory.get_word(write_addr).value(), write_value);
+    ASSERT_TRUE(memory.get_dirty_pages().test(0xC0));
+    ASSERT_TRUE(memory.get_dirty_pages().test(0xC1));
+}
+
+/// @brief Checks that ROM writes are ignored and do not mark pages.
+TEST(MemoryControllerDirtyPageTest, rom_write_is_ignored){
+    mygbc::MemoryController memory;
+    const uint16_t write_addr = 0x2000;
+    const uint8_t expected_value = 0x00;
+    ASSERT_TRUE(memory.set_byte(write_addr, 0x01).ok());
+    ASSERT_EQ(memory.get_byte(write_addr).value(), expected_value);
+    ASSERT_FALSE(memory.get_dirty_pages().any());
+}
+
+/// @brief Checks that taking the dirty pages clears them.
+TEST(MemoryControllerDirtyPageTest, take_clears_dirty_pages){
+    mygbc::MemoryController memory;
+    ASSERT_TRUE(memory.set_byte(0x8000, 0x01).ok());
+    mygbc::PageBitmap dirty_pages = memory.take_dirty_pages();
+    ASSERT_TRUE(dirty_pages.test(0x80));
+    ASSERT_FALSE(memory.get_dirty_pages().any());
+}
+
+/// @brief Checks that loading the ROM copies the ROM area without marking pages.
+TEST(MemoryControllerRomTest, load_rom_copies_rom_area){
+    mygbc::MemoryController memory;
+    std::vector<uint8_t> rom(0x8000, 0x00);
+    rom[0x0100] = 0xC3;
+    rom[0x7FFF] = 0x42;
+    mygbc::GBCBinary binary(mygbc::GBCBinary::GBCBinaryHeaderData(), true, true, rom);
+    ASSERT_TRUE(memory.load_rom(binary).ok());
+    ASSERT_EQ(memory.get_byte(0x0100).value(), 0xC3);
+    ASSERT_EQ(memory.get_byte(0x7FFF).value(), 0x42);
+    ASSERT_FALSE(memory.get_dirty_pages().any());
+}
+
+/// @brief Checks that ranges are copied back to back.
+TEST(MemoryControllerRangeTest, read_ranges_copies_back_to_back){
+    mygbc::MemoryController memory;
+    ASSERT_TRUE(memory.set_word(0xC0FF, 0x1234).ok());
+    ASSERT_TRUE(memory.set_byte(0xFFFF, 0x56).ok());
+    const mygbc::MemoryController::AddressRange ranges[] = {{0xC0FF, 2}, {0xFFFF, 1}};
+    std::vector<uint8_t> destination(3);
+    memory.read_ranges(ranges, 2, destination.data());
+    ASSERT_EQ(destination[0], memory.get_byte(0xC0FF).value());
+    ASSERT_EQ(destination[1], memory.get_byte(0xC100).value());
+    ASSERT_EQ(destination[2], 0x56);
+}
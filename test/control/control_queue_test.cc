@@ -0,0 +1,61 @@
+#include "../../src/control/control_queue.h" //ControlQueue
+#include <gtest/gtest.h> //GTest
+#include <thread> //std::thread
+#include <vector> //std::vector
+
+/// @brief Checks that commands come out in order and full queues reject pushes.
+TEST(ControlQueueTest, fifo_until_full){
+    mygbc::ControlQueue queue(3);
+    ASSERT_EQ(queue.get_capacity(), 4);
+    mygbc::ControlCommand command{mygbc::ControlCommandType::PAUSE};
+    ASSERT_FALSE(queue.pop(command));
+    for(uint8_t buttons = 0; buttons < 4; ++buttons){
+        ASSERT_TRUE(queue.push(mygbc::ControlCommand{mygbc::ControlCommandType::SET_JOYPAD, buttons}));
+    }
+    ASSERT_FALSE(queue.push(mygbc::ControlCommand{mygbc::ControlCommandType::STOP}));
+    for(uint8_t buttons = 0; buttons < 4; ++buttons){
+        ASSERT_TRUE(queue.pop(command));
+        ASSERT_EQ(command.type, mygbc::ControlCommandType::SET_JOYPAD);
+        ASSERT_EQ(command.buttons, buttons);
+    }
+    ASSERT_FALSE(queue.pop(command));
+    ASSERT_TRUE(queue.push(mygbc::ControlCommand{mygbc::ControlCommandType::STOP}));
+    queue.wait();
+    ASSERT_TRUE(queue.pop(command));
+    ASSERT_EQ(command.type, mygbc::ControlCommandType::STOP);
+}
+
+/// @brief Checks that commands of concurrent producers all arrive in per producer order.
+TEST(ControlQueueTest, concurrent_producers){
+    mygbc::ControlQueue queue(16);
+    const std::size_t producer_count = 4;
+    const uint8_t commands_per_producer = 200;
+    std::vector<std::thread> producers;
+    for(std::size_t producer = 0; producer < producer_count; ++producer){
+        producers.emplace_back([&queue, producer, commands_per_producer](){
+            for(uint8_t index = 0; index < commands_per_producer; ++index){
+                //Producer in the type, sequence in the buttons
+                const mygbc::ControlCommand command{static_cast<mygbc::ControlCommandType>(producer), index};
+                while(!queue.push(command)){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<uint8_t> next_index(producer_count, 0);
+    std::size_t received = 0;
+    while(received < producer_count * commands_per_producer){
+        mygbc::ControlCommand command{mygbc::ControlCommandType::STOP};
+        if(!queue.pop(command)){
+            queue.wait();
+            continue;
+        }
+        const std::size_t producer = static_cast<std::size_t>(command.type);
+        ASSERT_EQ(command.buttons, next_index[producer]);
+        ++next_index[producer];
+        ++received;
+    }
+    for(std::thread& producer : producers){
+        producer.join();
+    }
+}
@@ -0,0 +1,70 @@
+#include "../../src/control/frame_pacer.h" //FramePacer
+#include <gtest/gtest.h> //GTest
+#include <chrono> //std::chrono::steady_clock
+#include <thread> //std::this_thread::sleep_for
+
+/// @brief Returns the milliseconds since the start.
+/// @param start Start time.
+/// @return Elapsed milliseconds.
+static double elapsed_ms(const std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Checks that the speed multipliers scale the frame period and are clamped.
+TEST(FramePacerTest, speed_multipliers){
+    mygbc::FramePacer pacer(mygbc::FramePacerConfig{});
+    ASSERT_DOUBLE_EQ(pacer.get_speed(), 1.0);
+    pacer.set_speed(2.0);
+    ASSERT_NEAR(pacer.get_speed(), 2.0, 1e-6);
+    pacer.set_speed(0.1);
+    ASSERT_NEAR(pacer.get_speed(), mygbc::FramePacer::min_speed, 1e-6);
+    pacer.set_speed(mygbc::FramePacer::unlimited_speed);
+    ASSERT_EQ(pacer.get_speed(), mygbc::FramePacer::unlimited_speed);
+    //Unlimited speed has no schedule to fall behind
+    for(int frame = 0; frame < 1000; ++frame){
+        pacer.wait_for_next_frame();
+    }
+    ASSERT_EQ(pacer.get_frame_count(), 1000);
+    ASSERT_EQ(pacer.get_late_frame_count(), 0);
+    ASSERT_EQ(pacer.get_resync_count(), 0);
+}
+
+/// @brief Checks that the frames follow the schedule and slow frames are caught up without drift.
+TEST(FramePacerTest, paces_without_drift){
+    mygbc::FramePacerConfig config;
+    config.frame_period_ns = 4000000;
+    //Loaded machines may stall far longer than the slow frame
+    config.max_lag_frames = 50;
+    mygbc::FramePacer pacer(config);
+    pacer.wait_for_next_frame();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < 20; ++frame){
+        if(frame == 5){
+            //Slow frame spanning three deadlines, the next frames wait less
+            std::this_thread::sleep_for(std::chrono::milliseconds(14));
+        }
+        pacer.wait_for_next_frame();
+    }
+    //Deadlines are absolute, the frames never run ahead of the schedule
+    ASSERT_GE(elapsed_ms(start), 20 * 4.0 - 1.0);
+    //A drifting pacer would restart its deadlines after the slow frame and count a single late frame
+    ASSERT_GE(pacer.get_late_frame_count(), 2);
+    ASSERT_EQ(pacer.get_resync_count(), 0);
+}
+
+/// @brief Checks that stalls longer than the lag limit restart the schedule instead of running a burst.
+TEST(FramePacerTest, long_stall_resyncs){
+    mygbc::FramePacerConfig config;
+    config.frame_period_ns = 2000000;
+    config.max_lag_frames = 2;
+    mygbc::FramePacer pacer(config);
+    pacer.wait_for_next_frame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    pacer.wait_for_next_frame();
+    ASSERT_EQ(pacer.get_resync_count(), 1);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < 5; ++frame){
+        pacer.wait_for_next_frame();
+    }
+    ASSERT_GE(elapsed_ms(start), 5 * 2.0 - 1.0);
+}
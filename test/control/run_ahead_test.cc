@@ -0,0 +1,58 @@
+#include "../../src/control/run_ahead.h" //RunAhead
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that the presented frame is ahead while the real state matches a GBC without run-ahead.
+TEST(RunAheadTest, presents_ahead_and_keeps_real_state){
+    mygbc::GBC gbc;
+    mygbc::GBC reference;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(reference).ok());
+    const uint32_t ahead_frames = 2;
+    mygbc::RunAhead run_ahead(gbc, ahead_frames);
+    uint64_t presented_frame = 0;
+    run_ahead.set_present_callback([&presented_frame](mygbc::GBC& presented){
+        presented_frame = presented.get_frame_count();
+        //Writes of the frames run ahead must not reach the real state
+        ASSERT_TRUE(presented.get_memory().set_byte(0xC000, static_cast<uint8_t>(presented_frame)).ok());
+    });
+    const std::vector<uint8_t> inputs{0x00, 0x01, 0x01, 0x10, 0x00};
+    for(const uint8_t buttons : inputs){
+        ASSERT_TRUE(run_ahead.run_frame(buttons).ok());
+        reference.set_joypad_state(buttons);
+        ASSERT_TRUE(reference.run_frame().ok());
+        ASSERT_EQ(presented_frame, gbc.get_frame_count() + ahead_frames);
+        ASSERT_EQ(gbc.get_cycle_count(), reference.get_cycle_count());
+        ASSERT_EQ(gbc.get_processing_unit().get_register_file().get_register_words(), reference.get_processing_unit().get_register_file().get_register_words());
+        ASSERT_EQ(gbc.save_snapshot().page_data, reference.save_snapshot().page_data);
+        ASSERT_EQ(run_ahead.get_state_slot().get_last_restored_page_count(), 1);
+    }
+    //Unchanged inputs are not recorded again
+    ASSERT_EQ(gbc.get_input_log().get_events().size(), 3);
+    ASSERT_EQ(gbc.get_metrics().frames, inputs.size());
+
+    run_ahead.set_frames(0);
+    ASSERT_TRUE(run_ahead.run_frame(0x00).ok());
+    ASSERT_EQ(presented_frame, gbc.get_frame_count());
+}
+
+/// @brief Checks that run-ahead keeps the pressed buttons of the real state when the inputs are not recorded.
+TEST(RunAheadTest, keeps_buttons_without_input_recording){
+    mygbc::GBC gbc;
+    mygbc::GBC reference;
+    gbc.set_input_recording(false);
+    reference.set_input_recording(false);
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(reference).ok());
+    mygbc::RunAhead run_ahead(gbc, 2);
+    const std::vector<uint8_t> inputs{0x10, 0x10, 0x01, 0x00, 0x81};
+    for(const uint8_t buttons : inputs){
+        ASSERT_TRUE(run_ahead.run_frame(buttons).ok());
+        reference.set_joypad_state(buttons);
+        ASSERT_TRUE(reference.run_frame().ok());
+        ASSERT_EQ(gbc.get_memory().get_joypad_state(), buttons);
+        ASSERT_EQ(gbc.save_snapshot().page_data, reference.save_snapshot().page_data);
+    }
+    ASSERT_TRUE(gbc.get_input_log().get_events().empty());
+}
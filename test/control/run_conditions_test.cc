@@ -0,0 +1,119 @@
+#include "../../src/gbc.h" //GBC
+#include "../../src/control/run_conditions.h" //RunConditions
+#include "../test_rom.h" //load_test_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Loads a ROM jumping between 0x0000 and 0x0010.
+/// @param gbc GBC to load the ROM to.
+static void load_jump_pair_rom(mygbc::GBC& gbc){
+    std::vector<uint8_t> rom = mygbc::get_jump_loop_rom_image();
+    rom[0x0002] = 0x10; //JP 0x0010
+    rom[0x0010] = 0xC3; //JP 0x0000
+    ASSERT_TRUE(mygbc::load_test_rom(gbc, rom).ok());
+}
+
+/// @brief Checks that runs without conditions stop on the cycle budget.
+TEST(RunConditionsTest, empty_conditions_stop_on_budget){
+    mygbc::GBC gbc;
+    load_jump_pair_rom(gbc);
+    mygbc::RunConditions conditions;
+    mygbc::StatusOr<mygbc::RunStopReason> stop_reason = gbc.run_until(conditions, 2 * mygbc::GBC::cycles_per_frame + 1);
+    ASSERT_TRUE(stop_reason.ok());
+    ASSERT_EQ(stop_reason.value(), mygbc::RunStopReason::CYCLE_BUDGET);
+    mygbc::GBC reference;
+    load_jump_pair_rom(reference);
+    ASSERT_TRUE(reference.run_for(2 * mygbc::GBC::cycles_per_frame + 1).ok());
+    ASSERT_EQ(gbc.get_cycle_count(), reference.get_cycle_count());
+}
+
+/// @brief Checks that a PC breakpoint stops the run after the instruction reaching it but not at the start PC.
+TEST(RunConditionsTest, pc_breakpoint_stops_run){
+    mygbc::GBC gbc;
+    load_jump_pair_rom(gbc);
+    mygbc::RunConditions conditions;
+    conditions.add_pc_breakpoint(0x0010);
+    conditions.add_pc_breakpoint(0x0010);
+    ASSERT_TRUE(conditions.has_pc_breakpoints());
+    ASSERT_TRUE(conditions.is_pc_breakpoint(0x0010));
+    ASSERT_FALSE(conditions.is_pc_breakpoint(0x0011));
+    mygbc::StatusOr<mygbc::RunStopReason> stop_reason = gbc.run_until(conditions, 1000);
+    ASSERT_EQ(stop_reason.value(), mygbc::RunStopReason::PC_HIT);
+    ASSERT_EQ(gbc.get_cycle_count(), 16);
+    stop_reason = gbc.run_until(conditions, 1000);
+    ASSERT_EQ(stop_reason.value(), mygbc::RunStopReason::PC_HIT);
+    ASSERT_EQ(gbc.get_cycle_count(), 48);
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().pc.get_word(), 0x0010);
+}
+
+/// @brief Checks that frame conditions stop at the frame boundary before the budget.
+TEST(RunConditionsTest, frame_conditions_stop_at_boundary){
+    mygbc::GBC gbc;
+    load_jump_pair_rom(gbc);
+    mygbc::RunConditions frame_end;
+    frame_end.set_stop_at_frame_end(true);
+    mygbc::StatusOr<mygbc::RunStopReason> stop_reason = gbc.run_until(frame_end, 10 * mygbc::GBC::cycles_per_frame);
+    ASSERT_EQ(stop_reason.value(), mygbc::RunStopReason::FRAME_END);
+    ASSERT_EQ(gbc.get_frame_count(), 1);
+
+    mygbc::RunConditions predicate;
+    uint64_t predicate_calls = 0;
+    predicate.set_frame_predicate([&predicate_calls](mygbc::GBC& running_gbc){
+        ++predicate_calls;
+        return running_gbc.get_frame_count() == 4;
+    });
+    stop_reason = gbc.run_until(predicate, 10 * mygbc::GBC::cycles_per_frame);
+    ASSERT_EQ(stop_reason.value(), mygbc::RunStopReason::FRAME_PREDICATE);
+    ASSERT_EQ(predicate_calls, 3);
+    ASSERT_EQ(gbc.get_frame_count(), 4);
+}
+
+/// @brief Checks that memory conditions are only checked after writes to the watched bytes.
+TEST(RunConditionsTest, memory_condition_stops_after_write){
+    mygbc::GBC gbc;
+    load_jump_pair_rom(gbc);
+    const uint16_t watched_addr = 0xC000;
+    mygbc::RunConditions conditions;
+    conditions.add_memory_condition(watched_addr, 0x42);
+    ASSERT_TRUE(conditions.is_watched_address(watched_addr));
+    ASSERT_FALSE(conditions.is_watched_address(watched_addr + 1));
+    const mygbc::MemoryController::WatchedWrites watched_write{{watched_addr, 0}, 1};
+    ASSERT_FALSE(conditions.memory_condition_met(gbc.get_memory(), watched_write));
+    //A value set before the run does not stop it
+    ASSERT_TRUE(gbc.get_memory().set_byte(watched_addr, 0x42).ok());
+    ASSERT_TRUE(conditions.memory_condition_met(gbc.get_memory(), watched_write));
+    ASSERT_EQ(gbc.run_until(conditions, 1000).value(), mygbc::RunStopReason::CYCLE_BUDGET);
+
+    //A write during the run is picked up by the next instruction boundary
+    ASSERT_TRUE(gbc.get_memory().set_byte(watched_addr, 0x00).ok());
+    conditions.set_frame_predicate([watched_addr](mygbc::GBC& running_gbc){
+        return !running_gbc.get_memory().set_byte(watched_addr, 0x42).ok();
+    });
+    const uint64_t frame_end = (gbc.get_frame_count() + 1) * mygbc::GBC::cycles_per_frame;
+    ASSERT_EQ(gbc.run_until(conditions, 10 * mygbc::GBC::cycles_per_frame).value(), mygbc::RunStopReason::MEMORY_MATCH);
+    ASSERT_GT(gbc.get_cycle_count(), frame_end);
+    ASSERT_LE(gbc.get_cycle_count(), frame_end + 16);
+}
+
+/// @brief Checks that writes to other bytes of a watched page do not stop the run while the watched byte holds the value.
+TEST(RunConditionsTest, unrelated_write_does_not_stop_run){
+    mygbc::GBC gbc;
+    load_jump_pair_rom(gbc);
+    const uint16_t watched_addr = 0xC000;
+    ASSERT_TRUE(gbc.get_memory().set_byte(watched_addr, 0x42).ok());
+    mygbc::RunConditions conditions;
+    conditions.add_memory_condition(watched_addr, 0x42);
+    uint64_t predicate_calls = 0;
+    conditions.set_frame_predicate([watched_addr, &predicate_calls](mygbc::GBC& running_gbc){
+        ++predicate_calls;
+        return !running_gbc.get_memory().set_byte(watched_addr + 1, 0x42).ok();
+    });
+    ASSERT_EQ(gbc.run_until(conditions, 3 * mygbc::GBC::cycles_per_frame).value(), mygbc::RunStopReason::CYCLE_BUDGET);
+    ASSERT_EQ(predicate_calls, 3);
+
+    //Only the kept writes are checked, unless more writes happened than were kept
+    const mygbc::MemoryController::WatchedWrites other_write{{static_cast<uint16_t>(watched_addr + 1), 0}, 1};
+    ASSERT_FALSE(conditions.memory_condition_met(gbc.get_memory(), other_write));
+    const mygbc::MemoryController::WatchedWrites overflowed_writes{{static_cast<uint16_t>(watched_addr + 1), static_cast<uint16_t>(watched_addr + 2)}, 3};
+    ASSERT_TRUE(conditions.memory_condition_met(gbc.get_memory(), overflowed_writes));
+}
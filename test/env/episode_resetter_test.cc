@@ -0,0 +1,95 @@
+#include "../../src/env/episode_resetter.h" //EpisodeResetter
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Adds two start states, the second one frame later with a written byte.
+/// @param pool Pool to add to.
+static void add_start_states(mygbc::StartStatePool& pool){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    ASSERT_TRUE(pool.add(gbc.save_snapshot()).ok());
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x11).ok());
+    ASSERT_TRUE(pool.add(gbc.save_snapshot()).ok());
+}
+
+/// @brief Checks that resets restore the start states and only touch the needed pages.
+TEST(EpisodeResetterTest, reset_restores_start_states){
+    mygbc::StartStatePool pool;
+    add_start_states(pool);
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::EpisodeResetter resetter(gbc, pool);
+    ASSERT_EQ(resetter.get_current_index(), mygbc::EpisodeResetter::no_state);
+    ASSERT_TRUE(resetter.reset().ok());
+    ASSERT_EQ(resetter.get_current_index(), 0);
+    ASSERT_EQ(resetter.get_last_restored_page_count(), mygbc::PageBitmap::page_count);
+    //Episode writes a single page
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD123, 0x22).ok());
+    ASSERT_TRUE(resetter.reset_to(0).ok());
+    ASSERT_EQ(resetter.get_last_restored_page_count(), 1);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD123).value(), 0x00);
+    ASSERT_EQ(gbc.get_frame_count(), 0);
+    //Switching states also restores the pages where the states differ
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD123, 0x22).ok());
+    ASSERT_TRUE(resetter.reset().ok());
+    ASSERT_EQ(resetter.get_current_index(), 1);
+    ASSERT_EQ(resetter.get_last_restored_page_count(), 2);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x11);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD123).value(), 0x00);
+    ASSERT_EQ(gbc.get_frame_count(), 1);
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().get_register_words(), pool.get_state(1).register_words);
+    ASSERT_TRUE(resetter.reset().ok());
+    ASSERT_EQ(resetter.get_current_index(), 0);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x00);
+    ASSERT_FALSE(resetter.reset_to(2).ok());
+}
+
+/// @brief Checks that a reset does not replay the recorded inputs of the previous episode.
+TEST(EpisodeResetterTest, reset_drops_previous_episode_inputs){
+    mygbc::StartStatePool pool;
+    mygbc::GBC start_gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(start_gbc).ok());
+    ASSERT_TRUE(pool.add(start_gbc.save_snapshot(), 0x04).ok());
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::EpisodeResetter resetter(gbc, pool);
+    ASSERT_TRUE(resetter.reset().ok());
+    ASSERT_EQ(gbc.get_memory().get_joypad_state(), 0x04);
+    //Episode presses a button after a frame
+    ASSERT_TRUE(gbc.run_frame().ok());
+    gbc.set_joypad_state(0x01);
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(resetter.reset().ok());
+    ASSERT_EQ(gbc.get_memory().get_joypad_state(), 0x04);
+    ASSERT_EQ(gbc.get_input_log().get_events().size(), 1);
+    ASSERT_EQ(gbc.get_input_log().get_events().front().cycle, pool.get_state(0).cycle_count);
+    //Press of the previous episode is not replayed
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_EQ(gbc.get_memory().get_joypad_state(), 0x04);
+}
+
+/// @brief Checks that seeded random sampling is repeatable.
+TEST(EpisodeResetterTest, random_sampling_is_seeded){
+    mygbc::StartStatePool pool;
+    add_start_states(pool);
+    mygbc::GBC first_gbc;
+    mygbc::GBC second_gbc;
+    mygbc::EpisodeResetter first_resetter(first_gbc, pool);
+    mygbc::EpisodeResetter second_resetter(second_gbc, pool);
+    first_resetter.set_random_sampling(42);
+    second_resetter.set_random_sampling(42);
+    std::vector<std::size_t> sampled_counts(pool.get_size(), 0);
+    for(int episode = 0; episode < 32; ++episode){
+        ASSERT_TRUE(first_resetter.reset().ok());
+        ASSERT_TRUE(second_resetter.reset().ok());
+        ASSERT_EQ(first_resetter.get_current_index(), second_resetter.get_current_index());
+        ++sampled_counts[first_resetter.get_current_index()];
+    }
+    for(const std::size_t sampled_count : sampled_counts){
+        ASSERT_GT(sampled_count, 0);
+    }
+}
@@ -0,0 +1,83 @@
+#include "../../src/env/instance_scheduler.h" //InstanceScheduler
+#include "../../src/util/memory/allocation_counter.h" //AllocationCounter
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+
+/// @brief Checks that every instance ends where a single run_for of the cycles would have ended it.
+TEST(InstanceSchedulerTest, runs_every_instance_for_the_cycles){
+    mygbc::InstanceSchedulerConfig config;
+    config.thread_count = 3;
+    config.quantum_cycles = 1000;
+    mygbc::InstanceScheduler scheduler(config);
+    ASSERT_EQ(scheduler.get_thread_count(), 3);
+    std::vector<std::unique_ptr<mygbc::GBC>> instances;
+    for(std::size_t index = 0; index < 40; ++index){
+        instances.push_back(std::make_unique<mygbc::GBC>());
+        ASSERT_TRUE(mygbc::load_jump_loop_rom(*instances.back()).ok());
+        ASSERT_EQ(scheduler.add_instance(*instances.back(), static_cast<uint32_t>(1 + (index % 3))), index);
+    }
+    mygbc::GBC reference;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(reference).ok());
+    const uint64_t cycles = 10001;
+    for(int run = 0; run < 2; ++run){
+        ASSERT_TRUE(scheduler.run_for(cycles).ok());
+        ASSERT_TRUE(reference.run_for(cycles).ok());
+        for(std::size_t index = 0; index < instances.size(); ++index){
+            ASSERT_EQ(instances[index]->get_cycle_count(), reference.get_cycle_count());
+        }
+    }
+    //Every slice went through a queue
+    uint64_t slice_count = 0;
+    for(std::size_t index = 0; index < instances.size(); ++index){
+        slice_count += scheduler.get_slice_count(index);
+    }
+    ASSERT_EQ(scheduler.get_queued_slice_count(), slice_count);
+}
+
+/// @brief Checks that the priority scales the slice length and not the cycles of a run.
+TEST(InstanceSchedulerTest, priority_scales_slices){
+    mygbc::InstanceSchedulerConfig config;
+    config.thread_count = 1;
+    config.quantum_cycles = 1000;
+    mygbc::InstanceScheduler scheduler(config);
+    mygbc::GBC low_priority;
+    mygbc::GBC high_priority;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(low_priority).ok());
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(high_priority).ok());
+    const std::size_t low_id = scheduler.add_instance(low_priority);
+    const std::size_t high_id = scheduler.add_instance(high_priority, 4);
+    ASSERT_TRUE(scheduler.run_for(4000).ok());
+    ASSERT_EQ(low_priority.get_cycle_count(), high_priority.get_cycle_count());
+    ASSERT_GE(low_priority.get_cycle_count(), 4000);
+    ASSERT_EQ(scheduler.get_slice_count(low_id), 4);
+    ASSERT_EQ(scheduler.get_slice_count(high_id), 1);
+    scheduler.set_priority(low_id, 8);
+    ASSERT_TRUE(scheduler.run_for(4000).ok());
+    ASSERT_EQ(low_priority.get_cycle_count(), high_priority.get_cycle_count());
+    ASSERT_EQ(scheduler.get_slice_count(low_id), 5);
+    ASSERT_EQ(scheduler.get_slice_count(high_id), 2);
+    //A single thread never waits for another
+    ASSERT_EQ(scheduler.get_steal_count(), 0);
+    ASSERT_EQ(scheduler.get_idle_count(), 0);
+}
+
+/// @brief Checks that runs do not allocate on any thread.
+TEST(InstanceSchedulerTest, runs_do_not_allocate){
+    mygbc::InstanceSchedulerConfig config;
+    config.thread_count = 2;
+    config.quantum_cycles = 500;
+    mygbc::InstanceScheduler scheduler(config);
+    std::vector<std::unique_ptr<mygbc::GBC>> instances;
+    for(std::size_t index = 0; index < 8; ++index){
+        instances.push_back(std::make_unique<mygbc::GBC>());
+        ASSERT_TRUE(mygbc::load_jump_loop_rom(*instances.back()).ok());
+        scheduler.add_instance(*instances.back(), static_cast<uint32_t>(1 + (index % 2)));
+    }
+    ASSERT_TRUE(scheduler.run_for(2000).ok());
+    //Worker threads do not count towards an AllocationScope of this thread
+    const uint64_t start_allocations = mygbc::AllocationCounter::get_process_allocation_count();
+    ASSERT_TRUE(scheduler.run_for(2000).ok());
+    ASSERT_EQ(mygbc::AllocationCounter::get_process_allocation_count() - start_allocations, 0);
+}
@@ -0,0 +1,114 @@
+#include "../../src/env/lockstep_engine.h" //LockstepEngine
+#include "../test_rom.h" //load_test_rom
+#include <gtest/gtest.h> //GTest
+#include <memory> //std::unique_ptr
+#include <vector> //std::vector
+
+/// @brief Prepares an instance on a ROM where HL and the zero flag decide the path of a JP loop.
+/// @details 0x0000 JP HL jumps to 0x0010 or 0x0020. 0x0010 JP Z, 0xC300 jumps to a JP 0x0000 in RAM when taken and
+///         falls through to the JP 0x0000 at 0x0011 when not. 0x0020 is JP 0x0000.
+///         Instance 3 runs a JP 0xC000 loop in RAM and instance 4 has a recorded input due during the run.
+/// @param gbc Instance to prepare.
+/// @param index Index of the instance.
+static void prepare_instance(mygbc::GBC& gbc, const std::size_t index){
+    std::vector<uint8_t> rom(0x8000, 0x00);
+    rom[0x0000] = 0xE9; //JP HL
+    rom[0x0010] = 0xCA; //JP Z, a16
+    rom[0x0011] = 0xC3; //JP a16
+    rom[0x0020] = 0xC3; //JP a16
+    ASSERT_TRUE(mygbc::load_test_rom(gbc, rom).ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC300, 0xC3).ok());
+    //ir_ie, a_f, b_c, d_e, h_l, pc, sp
+    std::array<uint16_t, mygbc::GBCSnapshot::register_count> register_words{0, 0, 0, 0, 0, 0, 0};
+    register_words[1] = (index % 3 == 0) ? 0x0080 : 0x0000;
+    register_words[4] = (index % 2 == 0) ? 0x0010 : 0x0020;
+    if(index == 3){
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0xC3).ok());
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC001, 0xC0).ok());
+        register_words[5] = 0xC000;
+    }
+    gbc.get_processing_unit().get_register_file().set_register_words(register_words);
+    if(index == 4){
+        const mygbc::GBCSnapshot start = gbc.save_snapshot();
+        ASSERT_TRUE(gbc.run_until_cycle(500).ok());
+        gbc.set_joypad_state(0x01);
+        ASSERT_TRUE(gbc.restore_snapshot(start).ok());
+    }
+}
+
+/// @brief Checks that lockstep runs end in the same state as scalar runs.
+TEST(LockstepEngineTest, matches_scalar_execution){
+    const std::size_t instance_count = 11;
+    const uint32_t cycles = 2000;
+    std::vector<std::unique_ptr<mygbc::GBC>> lockstep_instances;
+    std::vector<std::unique_ptr<mygbc::GBC>> scalar_instances;
+    std::vector<mygbc::GBC*> lanes;
+    for(std::size_t index = 0; index < instance_count; ++index){
+        lockstep_instances.push_back(std::make_unique<mygbc::GBC>());
+        scalar_instances.push_back(std::make_unique<mygbc::GBC>());
+        prepare_instance(*lockstep_instances.back(), index);
+        prepare_instance(*scalar_instances.back(), index);
+        lanes.push_back(lockstep_instances.back().get());
+    }
+    mygbc::LockstepEngine engine(lanes);
+    for(int run = 0; run < 3; ++run){
+        ASSERT_TRUE(engine.run_for(cycles).ok());
+        for(std::size_t index = 0; index < instance_count; ++index){
+            mygbc::GBC& scalar = *scalar_instances[index];
+            mygbc::GBC& lockstep = *lockstep_instances[index];
+            ASSERT_TRUE(scalar.run_until_cycle(scalar.get_cycle_count() + cycles).ok());
+            ASSERT_EQ(lockstep.get_cycle_count(), scalar.get_cycle_count());
+            ASSERT_EQ(lockstep.get_processing_unit().get_register_file().get_register_words(), scalar.get_processing_unit().get_register_file().get_register_words());
+            ASSERT_EQ(lockstep.get_memory().get_joypad_state(), scalar.get_memory().get_joypad_state());
+            ASSERT_EQ(lockstep.get_metrics().instructions, scalar.get_metrics().instructions);
+        }
+    }
+    ASSERT_EQ(lockstep_instances[4]->get_memory().get_joypad_state(), 0x01);
+    ASSERT_GT(engine.get_lockstep_instruction_count(), engine.get_scalar_instruction_count());
+    ASSERT_GT(engine.get_scalar_instruction_count(), 0);
+    ASSERT_LT(engine.get_lockstep_pass_count(), engine.get_lockstep_instruction_count());
+}
+
+/// @brief Checks that lanes spread over many PCs and lane blocks end in the same state as scalar runs.
+TEST(LockstepEngineTest, diverged_lanes_match_scalar_execution){
+    const std::size_t instance_count = 21;
+    const std::size_t ring_size = 7;
+    const uint32_t cycles = 3000;
+    //Ring of JPs, each jumps to the next, the decoder reads the high byte of a16 first
+    std::vector<uint8_t> rom(0x8000, 0x00);
+    for(std::size_t jump = 0; jump < ring_size; ++jump){
+        const uint16_t target = static_cast<uint16_t>(0x0200 + (3 * ((jump + 1) % ring_size)));
+        rom[0x0200 + (3 * jump)] = 0xC3; //JP a16
+        rom[0x0201 + (3 * jump)] = static_cast<uint8_t>(target >> 8);
+        rom[0x0202 + (3 * jump)] = static_cast<uint8_t>(target & 0xFF);
+    }
+    std::vector<std::unique_ptr<mygbc::GBC>> lockstep_instances;
+    std::vector<std::unique_ptr<mygbc::GBC>> scalar_instances;
+    std::vector<mygbc::GBC*> lanes;
+    for(std::size_t index = 0; index < instance_count; ++index){
+        //ir_ie, a_f, b_c, d_e, h_l, pc, sp
+        const std::array<uint16_t, mygbc::GBCSnapshot::register_count> register_words{0, 0, 0, 0, 0, static_cast<uint16_t>(0x0200 + (3 * ((index * 5) % ring_size))), 0xFFFE};
+        for(std::vector<std::unique_ptr<mygbc::GBC>>* instances : {&lockstep_instances, &scalar_instances}){
+            instances->push_back(std::make_unique<mygbc::GBC>());
+            ASSERT_TRUE(mygbc::load_test_rom(*instances->back(), rom).ok());
+            instances->back()->get_processing_unit().get_register_file().set_register_words(register_words);
+        }
+        //Lanes start a few instructions apart
+        ASSERT_TRUE(lockstep_instances.back()->run_until_cycle(16 * ((index % 3) + 1)).ok());
+        ASSERT_TRUE(scalar_instances.back()->run_until_cycle(16 * ((index % 3) + 1)).ok());
+        lanes.push_back(lockstep_instances.back().get());
+    }
+    mygbc::LockstepEngine engine(lanes);
+    for(int run = 0; run < 2; ++run){
+        ASSERT_TRUE(engine.run_for(cycles).ok());
+        for(std::size_t index = 0; index < instance_count; ++index){
+            mygbc::GBC& scalar = *scalar_instances[index];
+            mygbc::GBC& lockstep = *lockstep_instances[index];
+            ASSERT_TRUE(scalar.run_until_cycle(scalar.get_cycle_count() + cycles).ok());
+            ASSERT_EQ(lockstep.get_cycle_count(), scalar.get_cycle_count());
+            ASSERT_EQ(lockstep.get_processing_unit().get_register_file().get_register_words(), scalar.get_processing_unit().get_register_file().get_register_words());
+        }
+    }
+    ASSERT_EQ(engine.get_scalar_instruction_count(), 0);
+    ASSERT_LT(engine.get_lockstep_pass_count(), engine.get_lockstep_instruction_count());
+}
@@ -0,0 +1,79 @@
+#include "../../src/env/observation_preprocessor.h" //ObservationPreprocessor
+#include <gtest/gtest.h> //GTest
+#include <random> //std::mt19937
+#include <vector> //std::vector
+
+/// @brief Returns a frame of random shade indices with random upper bits.
+/// @param seed Seed of the frame.
+/// @return Frame of shade indices.
+static std::vector<uint8_t> get_random_frame(const uint32_t seed){
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> frame(mygbc::ObservationPreprocessor::frame_width * mygbc::ObservationPreprocessor::frame_height);
+    for(uint8_t& pixel : frame){
+        pixel = static_cast<uint8_t>(generator());
+    }
+    return frame;
+}
+
+/// @brief Returns a frame filled with the shade.
+/// @param shade Shade of every pixel.
+/// @return Frame of shade indices.
+static std::vector<uint8_t> get_filled_frame(const uint8_t shade){
+    return std::vector<uint8_t>(mygbc::ObservationPreprocessor::frame_width * mygbc::ObservationPreprocessor::frame_height, shade);
+}
+
+/// @brief Tests the SIMD and block downscaling against a direct average of the blocks
+TEST(ObservationPreprocessorTest, downscale_matches_block_average){
+    const std::vector<uint8_t> frame = get_random_frame(7);
+    const std::array<uint8_t, 4> shade_grays{250, 161, 90, 3};
+    for(const uint32_t factor : {1u, 2u, 4u, 8u}){
+        const uint32_t width = mygbc::ObservationPreprocessor::frame_width / factor;
+        const uint32_t height = mygbc::ObservationPreprocessor::frame_height / factor;
+        std::vector<uint8_t> downscaled(width * height);
+        mygbc::ObservationPreprocessor::downscale(frame.data(), factor, shade_grays, downscaled.data());
+        for(uint32_t row = 0; row < height; ++row){
+            for(uint32_t column = 0; column < width; ++column){
+                uint32_t sum = 0;
+                for(uint32_t block_row = 0; block_row < factor; ++block_row){
+                    for(uint32_t block_column = 0; block_column < factor; ++block_column){
+                        const uint32_t pixel = (((row * factor) + block_row) * mygbc::ObservationPreprocessor::frame_width) + (column * factor) + block_column;
+                        sum += shade_grays[frame[pixel] & 0x03];
+                    }
+                }
+                ASSERT_EQ(downscaled[(row * width) + column], (sum + ((factor * factor) / 2)) / (factor * factor)) << "factor " << factor;
+            }
+        }
+    }
+}
+
+/// @brief Tests that the observation stacks the frames oldest first
+TEST(ObservationPreprocessorTest, stacks_frames_oldest_first){
+    mygbc::ObservationPreprocessor preprocessor(4, 3);
+    ASSERT_EQ(preprocessor.get_width(), 40);
+    ASSERT_EQ(preprocessor.get_height(), 36);
+    ASSERT_EQ(preprocessor.get_observation_size(), 3 * 40 * 36);
+    std::vector<uint8_t> observation(preprocessor.get_observation_size());
+    preprocessor.reset(get_filled_frame(0).data());
+    preprocessor.write_observation(observation.data());
+    ASSERT_EQ(observation.front(), 255);
+    ASSERT_EQ(observation.back(), 255);
+    preprocessor.push_frame(get_filled_frame(1).data());
+    preprocessor.push_frame(get_filled_frame(2).data());
+    preprocessor.push_frame(get_filled_frame(3).data());
+    preprocessor.push_frame(get_filled_frame(1).data());
+    preprocessor.write_observation(observation.data());
+    const std::size_t frame_size = preprocessor.get_frame_size();
+    ASSERT_EQ(observation[0], 85);
+    ASSERT_EQ(observation[frame_size], 0);
+    ASSERT_EQ(observation[2 * frame_size], 170);
+    ASSERT_EQ(observation[(3 * frame_size) - 1], 170);
+}
+
+/// @brief Tests that unsupported factors fall back to full size frames
+TEST(ObservationPreprocessorTest, invalid_factor_falls_back){
+    ASSERT_FALSE(mygbc::ObservationPreprocessor::is_valid_downscale_factor(3));
+    ASSERT_FALSE(mygbc::ObservationPreprocessor::is_valid_downscale_factor(0));
+    mygbc::ObservationPreprocessor preprocessor(3, 0);
+    ASSERT_EQ(preprocessor.get_width(), mygbc::ObservationPreprocessor::frame_width);
+    ASSERT_EQ(preprocessor.get_observation_size(), mygbc::ObservationPreprocessor::frame_width * mygbc::ObservationPreprocessor::frame_height);
+}
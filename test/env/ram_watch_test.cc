@@ -0,0 +1,47 @@
+#include "../../src/env/ram_watch.h" //RamWatch
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that consecutive addresses are merged into ranges.
+TEST(RamWatchTest, merges_consecutive_addresses){
+    const mygbc::RamWatch watch({0xC000, 0xC001, 0xC002, 0xD000, 0xFFFF, 0x0000, 0xC003});
+    const std::vector<mygbc::MemoryController::AddressRange>& ranges = watch.get_ranges();
+    ASSERT_EQ(watch.get_size(), 7);
+    ASSERT_EQ(ranges.size(), 5);
+    ASSERT_EQ(ranges[0].start_addr, 0xC000);
+    ASSERT_EQ(ranges[0].size, 3);
+    ASSERT_EQ(ranges[1].start_addr, 0xD000);
+    ASSERT_EQ(ranges[2].start_addr, 0xFFFF);
+    ASSERT_EQ(ranges[3].start_addr, 0x0000);
+    ASSERT_EQ(ranges[4].start_addr, 0xC003);
+}
+
+/// @brief Checks that reads write the watched bytes in order to the slot of the instance.
+TEST(RamWatchTest, reads_into_strided_slots){
+    const std::vector<uint16_t> addresses{0xC100, 0xC101, 0xFF00, 0xC0FF};
+    const mygbc::RamWatch watch(addresses);
+    const std::size_t stride = 6;
+    std::vector<mygbc::MemoryController> memories(3);
+    std::vector<uint8_t> output(memories.size() * stride, 0xEE);
+    for(std::size_t index = 0; index < memories.size(); ++index){
+        ASSERT_TRUE(memories[index].set_word(0xC100, static_cast<uint16_t>(0x1000 + index)).ok());
+        ASSERT_TRUE(memories[index].set_byte(0xC0FF, static_cast<uint8_t>(index)).ok());
+        watch.read_strided(memories[index], output.data(), stride, index);
+    }
+    for(std::size_t index = 0; index < memories.size(); ++index){
+        const uint8_t* slot = output.data() + (index * stride);
+        for(std::size_t address_index = 0; address_index < addresses.size(); ++address_index){
+            ASSERT_EQ(slot[address_index], memories[index].get_byte(addresses[address_index]).value());
+        }
+        ASSERT_EQ(slot[4], 0xEE);
+        ASSERT_EQ(slot[5], 0xEE);
+    }
+    //Watch reads are not CPU accesses
+    memories[0].reset_access_counters();
+    watch.read(memories[0], output.data());
+    mygbc::MetricsSnapshot snapshot;
+    memories[0].get_access_counters().add_to(snapshot);
+    for(const uint64_t reads : snapshot.memory_reads){
+        ASSERT_EQ(reads, 0);
+    }
+}
@@ -0,0 +1,69 @@
+#include "../../src/env/vec_env.h" //VecEnv
+#include "../../src/util/memory/allocation_counter.h" //AllocationCounter
+#include "../test_rom.h" //get_jump_loop_rom_image
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Returns a ROM with a JP 0x0000 loop at the boot address.
+/// @return ROM binary.
+static mygbc::GBCBinary get_jump_loop_binary(){
+    std::vector<uint8_t> rom = mygbc::get_jump_loop_rom_image();
+    rom[0x0100] = 0x42;
+    return mygbc::get_test_binary(rom);
+}
+
+/// @brief Returns the configuration used by the tests.
+/// @param instance_count Number of instances.
+/// @param thread_count Number of threads.
+/// @return Configuration.
+static mygbc::VecEnvConfig get_config(const std::size_t instance_count, const std::size_t thread_count){
+    mygbc::VecEnvConfig config;
+    config.instance_count = instance_count;
+    config.frames_per_step = 2;
+    config.thread_count = thread_count;
+    config.observation_addresses = {0x0000, 0x0100, 0xC000};
+    config.done_condition = [](mygbc::GBC& gbc){ return gbc.get_frame_count() >= 4; };
+    return config;
+}
+
+/// @brief Checks the observations, done flags and applied actions of a step.
+TEST(VecEnvTest, steps_every_instance){
+    mygbc::GBCBinary binary = get_jump_loop_binary();
+    mygbc::VecEnv env(binary, get_config(5, 3));
+    ASSERT_TRUE(env.get_init_status().ok());
+    ASSERT_EQ(env.get_observation_size(), 3);
+    const std::vector<uint8_t> actions{0x00, 0x01, 0x02, 0x04, 0x08};
+    std::vector<uint8_t> observations(env.get_instance_count() * env.get_observation_size(), 0xFF);
+    std::vector<uint8_t> dones(env.get_instance_count(), 0xFF);
+    ASSERT_TRUE(env.step(actions.data(), observations.data(), dones.data()).ok());
+    for(std::size_t index = 0; index < env.get_instance_count(); ++index){
+        ASSERT_EQ(env.get_instance(index).get_frame_count(), 2);
+        ASSERT_EQ(env.get_instance(index).get_memory().get_joypad_state(), actions[index]);
+        ASSERT_EQ(observations[(index * 3) + 0], 0xC3);
+        ASSERT_EQ(observations[(index * 3) + 1], 0x42);
+        ASSERT_EQ(observations[(index * 3) + 2], 0x00);
+        ASSERT_EQ(dones[index], 0);
+    }
+    ASSERT_TRUE(env.step(actions.data(), observations.data(), dones.data()).ok());
+    for(std::size_t index = 0; index < env.get_instance_count(); ++index){
+        ASSERT_EQ(dones[index], 1);
+        ASSERT_TRUE(env.get_instance(index).get_input_log().get_events().empty());
+    }
+}
+
+/// @brief Checks that steps do not allocate once warmed up.
+TEST(VecEnvTest, steps_do_not_allocate){
+    mygbc::GBCBinary binary = get_jump_loop_binary();
+    mygbc::VecEnv env(binary, get_config(4, 2));
+    std::vector<uint8_t> actions(env.get_instance_count(), 0x00);
+    std::vector<uint8_t> observations(env.get_instance_count() * env.get_observation_size());
+    std::vector<uint8_t> dones(env.get_instance_count());
+    ASSERT_TRUE(env.step(actions.data(), observations.data(), dones.data()).ok());
+    //Worker threads do not count towards an AllocationScope of this thread
+    const uint64_t start_allocations = mygbc::AllocationCounter::get_process_allocation_count();
+    for(int step = 0; step < 3; ++step){
+        actions[0] = static_cast<uint8_t>(step);
+        ASSERT_TRUE(env.step(actions.data(), observations.data(), dones.data()).ok());
+    }
+    ASSERT_EQ(mygbc::AllocationCounter::get_process_allocation_count() - start_allocations, 0);
+}
@@ -0,0 +1,141 @@
+#include "../src/gbc.h" //GBC
+#include "../src/snapshot/rewind_buffer.h" //RewindBuffer
+#include "test_rom.h" //load_jump_loop_rom, load_test_rom
+#include <gtest/gtest.h> //GTest
+#include <atomic> //std::atomic
+#include <thread> //std::this_thread::yield
+#include <vector> //std::vector
+
+/// @brief Checks that a full snapshot restores registers and memory.
+TEST(GBCSnapshotTest, full_snapshot_restores_state){
+    mygbc::GBC gbc;
+    const uint16_t pc_value = 0x0150;
+    const uint16_t write_addr = 0xC000;
+    const uint8_t write_value = 0x11;
+    gbc.get_processing_unit().get_register_file().pc.set_word(pc_value);
+    ASSERT_TRUE(gbc.get_memory().set_byte(write_addr, write_value).ok());
+    mygbc::GBCSnapshot snapshot = gbc.save_snapshot();
+    ASSERT_FALSE(snapshot.incremental);
+    ASSERT_EQ(snapshot.stored_pages.count(), mygbc::PageBitmap::page_count);
+
+    gbc.get_processing_unit().get_register_file().pc.set_word(0x0000);
+    ASSERT_TRUE(gbc.get_memory().set_byte(write_addr, 0x22).ok());
+    ASSERT_TRUE(gbc.restore_snapshot(snapshot).ok());
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().pc.get_word(), pc_value);
+    ASSERT_EQ(gbc.get_memory().get_byte(write_addr).value(), write_value);
+}
+
+/// @brief Checks that incremental snapshots only store pages dirtied since the previous snapshot.
+TEST(GBCSnapshotTest, incremental_snapshot_stores_dirty_pages){
+    mygbc::GBC gbc;
+    mygbc::GBCSnapshot base = gbc.save_snapshot();
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD0FF, 0x02).ok());
+    mygbc::GBCSnapshot first = gbc.save_incremental_snapshot();
+    const std::size_t expected_pages = 2;
+    ASSERT_TRUE(first.incremental);
+    ASSERT_EQ(first.stored_pages.count(), expected_pages);
+    ASSERT_EQ(first.page_data.size(), expected_pages * mygbc::PageBitmap::page_size);
+
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x03).ok());
+    mygbc::GBCSnapshot second = gbc.save_incremental_snapshot();
+    const std::size_t expected_second_pages = 1;
+    ASSERT_EQ(second.stored_pages.count(), expected_second_pages);
+
+    //Restore the chain up to the first incremental snapshot
+    ASSERT_TRUE(gbc.restore_snapshot(base).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x00);
+    ASSERT_TRUE(gbc.restore_snapshot(first).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x01);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD0FF).value(), 0x02);
+}
+
+/// @brief Checks that malformed snapshots are rejected.
+TEST(GBCSnapshotTest, malformed_snapshot_rejected){
+    mygbc::GBC gbc;
+    mygbc::GBCSnapshot snapshot = gbc.save_snapshot();
+    snapshot.page_data.pop_back();
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INPUT_ERROR;
+    ASSERT_EQ(gbc.restore_snapshot(snapshot).code(), expected_status);
+}
+
+/// @brief Checks that a serialized save state restores the state.
+TEST(GBCSnapshotTest, save_state_bytes_roundtrip){
+    mygbc::GBC gbc;
+    gbc.get_processing_unit().get_register_file().pc.set_word(0x0150);
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC123, 0x45).ok());
+    const std::vector<uint8_t> bytes = gbc.save_snapshot().to_bytes();
+    const std::size_t max_save_state_size = 4096;
+    ASSERT_LT(bytes.size(), max_save_state_size);
+
+    mygbc::StatusOr<mygbc::GBCSnapshot> snapshot = mygbc::GBCSnapshot::from_bytes(bytes);
+    ASSERT_TRUE(snapshot.ok());
+    mygbc::GBC restored;
+    ASSERT_TRUE(restored.restore_snapshot(snapshot.value()).ok());
+    ASSERT_EQ(restored.get_processing_unit().get_register_file().pc.get_word(), 0x0150);
+    ASSERT_EQ(restored.get_memory().get_byte(0xC123).value(), 0x45);
+
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + 8);
+    ASSERT_FALSE(mygbc::GBCSnapshot::from_bytes(truncated).ok());
+}
+
+/// @brief Checks that unregistered dirty page consumers stop collecting pages and their ids are reused.
+TEST(GBCSnapshotTest, dirty_page_consumers_are_reused){
+    mygbc::GBC gbc;
+    const std::size_t first = gbc.register_dirty_page_consumer();
+    const std::size_t second = gbc.register_dirty_page_consumer();
+    ASSERT_NE(first, second);
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    gbc.unregister_dirty_page_consumer(first);
+    const std::size_t reused = gbc.register_dirty_page_consumer();
+    ASSERT_EQ(reused, first);
+    //A reused id starts without pages
+    ASSERT_FALSE(gbc.take_dirty_pages(reused).any());
+    ASSERT_TRUE(gbc.take_dirty_pages(second).test(0xC0));
+    {
+        mygbc::RewindBuffer rewind(gbc, 4096, 1, 1);
+    }
+    ASSERT_EQ(gbc.register_dirty_page_consumer(), second + 1);
+}
+
+/// @brief Checks that the threaded main loop applies queued commands and stops on request.
+TEST(GBCRunTest, threaded_run_applies_commands){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    std::atomic<bool> snapshot_taken{false};
+    uint64_t snapshot_cycle = 0;
+    gbc.set_snapshot_callback([&snapshot_taken, &snapshot_cycle](mygbc::GBCSnapshot&& snapshot){
+        snapshot_cycle = snapshot.cycle_count;
+        snapshot_taken.store(true);
+    });
+    gbc.run();
+    ASSERT_TRUE(gbc.post_command(mygbc::ControlCommand{mygbc::ControlCommandType::SET_JOYPAD, 0x10}));
+    ASSERT_TRUE(gbc.post_command(mygbc::ControlCommand{mygbc::ControlCommandType::PAUSE}));
+    ASSERT_TRUE(gbc.post_command(mygbc::ControlCommand{mygbc::ControlCommandType::SNAPSHOT}));
+    while(!snapshot_taken.load()){
+        std::this_thread::yield();
+    }
+    gbc.stop();
+    ASSERT_TRUE(gbc.get_run_status().ok());
+    //Commands are applied at frame boundaries
+    ASSERT_EQ(gbc.get_cycle_count() % mygbc::GBC::cycles_per_frame, 0);
+    ASSERT_EQ(snapshot_cycle, gbc.get_cycle_count());
+    ASSERT_EQ(gbc.get_memory().get_joypad_state(), 0x10);
+    ASSERT_EQ(gbc.get_input_log().get_events().size(), 1);
+    //Stopping a stopped GBC does nothing
+    gbc.stop();
+}
+
+/// @brief Checks that stopping a thread that exited on an error does not wait for a full queue to drain.
+TEST(GBCRunTest, stop_returns_after_failed_run_with_full_queue){
+    mygbc::GBC gbc;
+    //NOP at the boot address is not implemented, the main loop returns an error
+    ASSERT_TRUE(mygbc::load_test_rom(gbc, std::vector<uint8_t>(0x8000, 0x00)).ok());
+    gbc.run();
+    //Only the exited thread leaves the queue full
+    while(gbc.post_command(mygbc::ControlCommand{mygbc::ControlCommandType::SET_JOYPAD, 0x01})){
+        std::this_thread::yield();
+    }
+    gbc.stop();
+    ASSERT_FALSE(gbc.get_run_status().ok());
+}
@@ -20,6 +20,17 @@ TEST_P(InstructionDecoderValidTest, instruction_decode_valid_instruction){
     ASSERT_EQ(fetch_value.value(), std::get<1>(test_values));
 }
 
+/// @brief Tests decoding valid instructions by reference into the instruction set
+/// @details Referenced instruction and read value checked against the copying decode
+TEST_P(InstructionDecoderValidTest, instruction_decode_reference_valid_instruction){
+    std::tuple<mygbc::AddressableMemory, mygbc::InstructionLR35902> test_values = GetParam();
+    const uint16_t read_address = 0x0;
+    mygbc::StatusOr<mygbc::DecodedInstructionLR35902> fetch_value = mygbc::InstructionDecoderLR35902::decode_reference(std::get<0>(test_values), read_address, instruction_set_);
+    ASSERT_TRUE(fetch_value.ok());
+    ASSERT_EQ(fetch_value.value().instruction, instruction_set_.find_by_opcode(std::get<1>(test_values).opcode));
+    ASSERT_EQ(fetch_value.value().read_value, std::get<1>(test_values).read_value);
+}
+
 /// @brief Initantiazation of instruction_decode_valid_instruction.
 /// @details  Initantiazation of instruction_decode_valid_instruction.
 INSTANTIATE_TEST_SUITE_P(
@@ -62,6 +73,15 @@ TEST_P(InstructionDecoderInvalidTest, instruction_decode_invalid_instruction){
     ASSERT_EQ(fetch_value.status().code(), expected_status);
 }
 
+/// @brief Tests that decoding by reference rejects illegal insturctions
+TEST_P(InstructionDecoderInvalidTest, instruction_decode_reference_invalid_instruction){
+    std::tuple<mygbc::AddressableMemory, mygbc::InstructionLR35902> test_values = GetParam();
+    const uint16_t read_address = 0x0;
+    mygbc::StatusOr<mygbc::DecodedInstructionLR35902> fetch_value = mygbc::InstructionDecoderLR35902::decode_reference(std::get<0>(test_values), read_address, instruction_set_);
+    ASSERT_FALSE(fetch_value.ok());
+    ASSERT_EQ(fetch_value.status().code(), mygbc::Status::StatusType::INVALID_OPCODE_ERROR);
+}
+
 /// @brief Initantiazation of instruction_decode_invalid_instruction.
 /// @details  Initantiazation of instruction_decode_invalid_instruction.
 INSTANTIATE_TEST_SUITE_P(
@@ -75,4 +95,14 @@ INSTANTIATE_TEST_SUITE_P(
         )
         //Two byte illegals dont exist
     )
-);
\ No newline at end of file
+);
+
+/// @brief Tests that every instruction set shares the same instruction table
+TEST(InstructionSetTest, instruction_sets_share_table){
+    const mygbc::InstructionSetLR35902 first_set;
+    const mygbc::InstructionSetLR35902 second_set;
+    ASSERT_NE(first_set.find_by_opcode(0xC3), nullptr);
+    ASSERT_EQ(first_set.find_by_opcode(0xC3), second_set.find_by_opcode(0xC3));
+    ASSERT_EQ(first_set.find_by_opcode(0xCB37), second_set.find_by_opcode(0xCB37));
+    ASSERT_GT(mygbc::InstructionSetLR35902::get_shared_memory_usage(), sizeof(mygbc::InstructionSetLR35902));
+}
@@ -0,0 +1,28 @@
+#include "../../src/instruction_set_lr35902/instruction_formatter_lr35902.h" //InstructionFormatterLR35902
+#include <gtest/gtest.h> //GTest
+#include <string> //std::string
+#include <tuple> //std::tuple
+#include <vector> //std::vector
+
+class InstructionFormatterLR35902Test : public ::testing::TestWithParam<std::tuple<std::vector<uint8_t>, std::string>> {};
+
+/// @brief Checks that instructions disassemble to the expected text.
+TEST_P(InstructionFormatterLR35902Test, disassemble_test){
+    const mygbc::InstructionSetLR35902 instruction_set;
+    mygbc::StatusOr<std::string> text = mygbc::InstructionFormatterLR35902::disassemble(std::get<0>(GetParam()), instruction_set);
+    ASSERT_TRUE(text.ok());
+    ASSERT_EQ(text.value(), std::get<1>(GetParam()));
+}
+
+/// @brief Initantiazation of disassemble_test.
+INSTANTIATE_TEST_SUITE_P(
+    disassemble_test_test_cases,
+    InstructionFormatterLR35902Test,
+    ::testing::Values(
+        std::make_tuple(std::vector<uint8_t>{0x00, 0x00}, "NOP"),
+        std::make_tuple(std::vector<uint8_t>{0xC3, 0x01, 0x50}, "JP $0150"),
+        std::make_tuple(std::vector<uint8_t>{0x3E, 0x42}, "LD A, $42"),
+        std::make_tuple(std::vector<uint8_t>{0x18, 0xFE}, "JR -2"),
+        std::make_tuple(std::vector<uint8_t>{0xCB, 0x00}, "RLC B")
+    )
+);
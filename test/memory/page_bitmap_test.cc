@@ -0,0 +1,67 @@
+#include "../../src/memory/page_bitmap.h" //PageBitmap
+#include <gtest/gtest.h> //GTest
+#include <cstdint> //Fixed lenght variables
+
+/// @brief Checks that a new bitmap has no pages marked.
+TEST(PageBitmapTest, new_bitmap_is_clear){
+    mygbc::PageBitmap bitmap;
+    const std::size_t expected_count = 0;
+    ASSERT_FALSE(bitmap.any());
+    ASSERT_EQ(bitmap.count(), expected_count);
+    ASSERT_EQ(bitmap.find_next(0), mygbc::PageBitmap::page_count);
+}
+
+/// @brief Checks that marking an address marks the page containing it.
+/// @details Checks the first and last byte of pages at word boundaries.
+TEST(PageBitmapTest, mark_address_marks_page){
+    mygbc::PageBitmap bitmap;
+    bitmap.mark_address(0x3FFF); //Page 0x3F, last page of the first word
+    bitmap.mark_address(0x4000); //Page 0x40, first page of the second word
+    bitmap.mark_address(0xFFFF); //Page 0xFF, last page
+    const std::size_t expected_count = 3;
+    ASSERT_EQ(bitmap.count(), expected_count);
+    ASSERT_TRUE(bitmap.test(0x3F));
+    ASSERT_TRUE(bitmap.test(0x40));
+    ASSERT_TRUE(bitmap.test(0xFF));
+    ASSERT_FALSE(bitmap.test(0x41));
+}
+
+/// @brief Checks that find_next iterates the marked pages in ascending order.
+TEST(PageBitmapTest, find_next_iterates_marked_pages){
+    mygbc::PageBitmap bitmap;
+    bitmap.set(0x02);
+    bitmap.set(0x80);
+    bitmap.set(0xC1);
+    ASSERT_EQ(bitmap.find_next(0), 0x02);
+    ASSERT_EQ(bitmap.find_next(0x03), 0x80);
+    ASSERT_EQ(bitmap.find_next(0x81), 0xC1);
+    ASSERT_EQ(bitmap.find_next(0xC2), mygbc::PageBitmap::page_count);
+}
+
+/// @brief Checks that merging and clearing bitmaps works.
+TEST(PageBitmapTest, merge_and_clear){
+    mygbc::PageBitmap first;
+    mygbc::PageBitmap second;
+    first.set(0x10);
+    second.set(0x20);
+    first |= second;
+    ASSERT_TRUE(first.test(0x10));
+    ASSERT_TRUE(first.test(0x20));
+    first.clear();
+    ASSERT_FALSE(first.any());
+    first.set_all();
+    ASSERT_EQ(first.count(), mygbc::PageBitmap::page_count);
+}
+
+/// @brief Checks that intersects only reports pages marked in both bitmaps.
+TEST(PageBitmapTest, intersects_shared_pages){
+    mygbc::PageBitmap first;
+    mygbc::PageBitmap second;
+    ASSERT_FALSE(first.intersects(second));
+    first.set(0xC0);
+    second.set(0xC1);
+    ASSERT_FALSE(first.intersects(second));
+    second.mark_address(0xC0FF);
+    ASSERT_TRUE(first.intersects(second));
+    ASSERT_TRUE(second.intersects(first));
+}
@@ -0,0 +1,58 @@
+#include "../../src/profile/cpu_profiler.h" //CpuProfiler
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that the counters are sized from the header rom size.
+TEST(CpuProfilerTest, sized_from_rom_size){
+    ASSERT_EQ(mygbc::CpuProfiler::get_rom_bank_count(0x00), 2);
+    ASSERT_EQ(mygbc::CpuProfiler::get_rom_bank_count(0x05), 64);
+    ASSERT_EQ(mygbc::CpuProfiler::get_rom_bank_count(0x52), 72);
+    mygbc::GBCBinary::GBCBinaryHeaderData header;
+    header.rom_size = 0x02;
+    mygbc::CpuProfiler profiler(mygbc::GBCBinary(header, true, true, std::vector<uint8_t>(0x20000, 0x00)));
+    ASSERT_EQ(profiler.get_rom_bank_count(), 8);
+    ASSERT_EQ(profiler.get_memory_usage(), (8 * 0x4000 + 0x8000) * 16);
+}
+
+/// @brief Checks that the cycles are counted per bank and address.
+TEST(CpuProfilerTest, counts_per_bank_and_address){
+    mygbc::CpuProfiler profiler(4);
+    profiler.record(0x0150, 4);
+    profiler.record(0x4000, 8);
+    profiler.set_rom_bank(3);
+    profiler.record(0x4000, 12);
+    profiler.record(0xC000, 4);
+    //Out of range banks keep the mapped bank
+    profiler.set_rom_bank(4);
+    ASSERT_EQ(profiler.get_rom_bank(), 3);
+    ASSERT_EQ(profiler.get_cycles(0, 0x0150), 4);
+    ASSERT_EQ(profiler.get_cycles(1, 0x4000), 8);
+    ASSERT_EQ(profiler.get_cycles(3, 0x4000), 12);
+    ASSERT_EQ(profiler.get_executions(0, 0xC000), 1);
+    ASSERT_EQ(profiler.get_total_cycles(), 28);
+    profiler.reset();
+    ASSERT_EQ(profiler.get_total_cycles(), 0);
+}
+
+/// @brief Checks the per function exports of a profiled frame.
+TEST(CpuProfilerTest, exports_profiled_frame){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::CpuProfiler profiler(2);
+    gbc.get_processing_unit().set_profiler(&profiler);
+    ASSERT_TRUE(gbc.run_frame().ok());
+    gbc.get_processing_unit().set_profiler(nullptr);
+    ASSERT_EQ(profiler.get_total_cycles(), gbc.get_cycle_count());
+    ASSERT_EQ(profiler.get_cycles(0, 0x0000), gbc.get_cycle_count());
+
+    mygbc::SymbolTable symbols = mygbc::SymbolTable::parse("00:0000 Boot\n").value();
+    std::vector<mygbc::FunctionProfile> profile = profiler.get_function_profile(symbols);
+    ASSERT_EQ(profile.size(), 1);
+    ASSERT_EQ(profile[0].name, "Boot");
+    ASSERT_EQ(profiler.format_collapsed_stacks(symbols), "ROM0;Boot " + std::to_string(gbc.get_cycle_count()) + "\n");
+    ASSERT_NE(profiler.format_hot_functions(symbols, 10).find("00:0000  Boot"), std::string::npos);
+    //Addresses without a symbol are named by their location
+    ASSERT_EQ(profiler.get_function_profile(mygbc::SymbolTable())[0].name, "00:0000");
+}
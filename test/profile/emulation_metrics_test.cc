@@ -0,0 +1,59 @@
+#include "../../src/profile/emulation_metrics.h" //EmulationMetrics
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks the counters of executed frames and memory accesses.
+TEST(EmulationMetricsTest, counts_execution_and_accesses){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    mygbc::MetricsSnapshot metrics = gbc.get_metrics();
+    ASSERT_EQ(metrics.frames, 2);
+    ASSERT_EQ(metrics.cycles, gbc.get_cycle_count());
+    ASSERT_EQ(metrics.instructions, gbc.get_cycle_count() / 16);
+    //Opcode byte and the jump address word
+    ASSERT_EQ(metrics.memory_reads[static_cast<std::size_t>(mygbc::MemoryRegion::ROM)], metrics.instructions * 3);
+    ASSERT_EQ(metrics.memory_writes[static_cast<std::size_t>(mygbc::MemoryRegion::WRAM)], 1);
+    ASSERT_GT(metrics.run_time_ns, 0);
+    ASSERT_GT(metrics.get_emulated_mhz(), 0.0);
+    ASSERT_GT(metrics.get_frame_time_percentile_us(99.0), 0);
+    gbc.reset_metrics();
+    ASSERT_EQ(gbc.get_metrics().instructions, 0);
+    ASSERT_EQ(gbc.get_metrics().memory_reads[static_cast<std::size_t>(mygbc::MemoryRegion::ROM)], 0);
+}
+
+/// @brief Checks that every report covers the frames since the previous report.
+TEST(EmulationMetricsTest, dumps_interval_metrics){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    std::vector<mygbc::MetricsSnapshot> reports;
+    gbc.set_metrics_dump(2, [&reports](const mygbc::MetricsSnapshot& metrics){ reports.push_back(metrics); });
+    for(int frame = 0; frame < 5; ++frame){
+        ASSERT_TRUE(gbc.run_frame().ok());
+    }
+    ASSERT_EQ(reports.size(), 2);
+    ASSERT_EQ(reports[0].frames, 2);
+    ASSERT_EQ(reports[1].frames, 2);
+    mygbc::MetricsSnapshot total = reports[0];
+    total += reports[1];
+    ASSERT_EQ(total.cycles, 4 * mygbc::GBC::cycles_per_frame);
+}
+
+/// @brief Checks the frame time percentiles of the histogram.
+TEST(EmulationMetricsTest, frame_time_percentiles){
+    mygbc::EmulationMetrics metrics;
+    for(int frame = 0; frame < 99; ++frame){
+        metrics.record_frame(1000000); //1ms
+    }
+    metrics.record_frame(40000000); //40ms
+    mygbc::MetricsSnapshot snapshot;
+    metrics.add_to(snapshot);
+    ASSERT_EQ(snapshot.frames, 100);
+    ASSERT_EQ(snapshot.get_frame_time_percentile_us(50.0), 1024);
+    ASSERT_EQ(snapshot.get_frame_time_percentile_us(100.0), 65536);
+    ASSERT_NEAR(snapshot.get_mean_frame_time_ms(), 1.39, 0.001);
+}
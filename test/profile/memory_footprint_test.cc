@@ -0,0 +1,65 @@
+#include "../../src/profile/memory_footprint.h" //MemoryFootprint
+#include "../../src/util/memory/allocation_counter.h" //AllocationScope
+#include "../../src/gbc.h" //GBC
+#include <gtest/gtest.h> //GTest
+#include <cstdlib> //std::llabs
+#include <memory> //std::unique_ptr
+#include <string> //std::string
+#include <unordered_map> //std::unordered_map
+#include <vector> //std::vector
+
+/// @brief Checks the totals and the lookup of the reported components.
+TEST(MemoryFootprintTest, sums_components){
+    mygbc::MemoryFootprint footprint;
+    footprint.add("first", 100);
+    footprint.add("second", 28);
+    ASSERT_EQ(footprint.get_total_bytes(), 128);
+    ASSERT_EQ(footprint.get_bytes("second"), 28);
+    ASSERT_EQ(footprint.get_bytes("missing"), 0);
+    ASSERT_EQ(footprint.get_components().size(), 2);
+    const std::string table = footprint.to_string();
+    ASSERT_NE(table.find("first"), std::string::npos);
+    ASSERT_NE(table.find("128  100.00  total"), std::string::npos);
+}
+
+/// @brief Checks the container helpers against the heap memory they allocate.
+TEST(MemoryFootprintTest, measures_containers){
+    ASSERT_EQ(mygbc::MemoryFootprint::get_string_usage(std::string("A")), 0);
+    const std::string long_text(100, 'x');
+    ASSERT_EQ(mygbc::MemoryFootprint::get_string_usage(long_text), long_text.capacity() + 1);
+    std::vector<uint32_t> values;
+    values.reserve(10);
+    ASSERT_EQ(mygbc::MemoryFootprint::get_vector_usage(values), 40);
+    std::unordered_map<uint16_t, uint64_t> map{{1, 1}, {2, 2}};
+    ASSERT_GE(mygbc::MemoryFootprint::get_unordered_map_usage(map), 2 * (sizeof(void*) + sizeof(std::pair<const uint16_t, uint64_t>)));
+}
+
+/// @brief Checks that the footprint of a GBC matches the memory its construction keeps allocated.
+TEST(MemoryFootprintTest, gbc_footprint_matches_allocations){
+    ASSERT_TRUE(mygbc::AllocationCounter::is_hooked());
+    //Build the shared tables
+    mygbc::GBC warm_up;
+    mygbc::AllocationScope scope;
+    std::unique_ptr<mygbc::GBC> gbc = std::make_unique<mygbc::GBC>();
+    const int64_t live_bytes = scope.get_live_bytes();
+    const mygbc::MemoryFootprint footprint = gbc->get_memory_footprint();
+    ASSERT_GE(footprint.get_bytes("memory_controller"), mygbc::MemoryController::address_space_size);
+    //Lookup tables are shared
+    ASSERT_LE(footprint.get_bytes("instruction_set"), 64);
+    ASSERT_LE(footprint.get_bytes("instruction_executor"), 64);
+    ASSERT_LE(footprint.get_total_bytes(), mygbc::MemoryController::address_space_size + 4096);
+    ASSERT_EQ(footprint.get_bytes("cpu_profiler"), 0);
+    //Allocator rounding of the small blocks is not reported
+    const int64_t reported_bytes = static_cast<int64_t>(footprint.get_total_bytes());
+    ASSERT_LE(std::llabs(live_bytes - reported_bytes), live_bytes / 10);
+}
+
+/// @brief Checks that attached profilers are reported.
+TEST(MemoryFootprintTest, reports_attached_profiler){
+    mygbc::GBC gbc;
+    mygbc::CpuProfiler profiler(4);
+    gbc.get_processing_unit().set_profiler(&profiler);
+    const mygbc::MemoryFootprint footprint = gbc.get_memory_footprint();
+    ASSERT_EQ(footprint.get_bytes("cpu_profiler"), sizeof(mygbc::CpuProfiler) + profiler.get_memory_usage());
+    gbc.get_processing_unit().set_profiler(nullptr);
+}
@@ -0,0 +1,38 @@
+#include "../../src/profile/symbol_table.h" //SymbolTable
+#include <gtest/gtest.h> //GTest
+#include <string> //std::string
+
+//Symbols in the layout written by rgblink
+static const std::string symbol_file =
+    "; File generated by rgblink\n"
+    "00:0150 Start\n"
+    "00:0160 Start.loop\n"
+    "00:0200 MainLoop ; comment\n"
+    "01:4000 PlayerUpdate\n"
+    "02:4000 LevelData\n"
+    "00:c000 wPlayerX\n"
+    "\n";
+
+/// @brief Checks that addresses resolve to the enclosing symbol of the same bank and section.
+TEST(SymbolTableTest, resolves_closest_preceding_symbol){
+    mygbc::StatusOr<mygbc::SymbolTable> table = mygbc::SymbolTable::parse(symbol_file);
+    ASSERT_TRUE(table.ok());
+    //Local labels are folded into their parent
+    ASSERT_EQ(table.value().get_symbols().size(), 5);
+    ASSERT_EQ(table.value().find(0, 0x0165)->name, "Start");
+    ASSERT_EQ(table.value().find(0, 0x0200)->name, "MainLoop");
+    ASSERT_EQ(table.value().find(1, 0x4100)->name, "PlayerUpdate");
+    ASSERT_EQ(table.value().find(2, 0x4100)->name, "LevelData");
+    ASSERT_EQ(table.value().find(0, 0xC004)->name, "wPlayerX");
+    ASSERT_EQ(table.value().find(0, 0x0100), nullptr);
+    ASSERT_EQ(table.value().find(3, 0x4000), nullptr);
+    //Symbols do not extend past their section
+    ASSERT_EQ(table.value().find(0, 0x8000), nullptr);
+}
+
+/// @brief Checks that malformed lines are rejected.
+TEST(SymbolTableTest, rejects_malformed_lines){
+    ASSERT_FALSE(mygbc::SymbolTable::parse("00:0150\n").ok());
+    ASSERT_FALSE(mygbc::SymbolTable::parse("000150 Start\n").ok());
+    ASSERT_FALSE(mygbc::SymbolTable::parse("00:XY50 Start\n").ok());
+}
@@ -0,0 +1,71 @@
+#include "../../src/profile/trace_events.h" //TraceEventRecorder
+#include <gtest/gtest.h> //GTest
+#include <string> //std::string
+#include <thread> //std::thread
+
+/// @brief Checks that spans of several threads are exported as trace-event JSON.
+TEST(TraceEventsTest, exports_spans_per_thread){
+    mygbc::TraceEventRecorder& recorder = mygbc::TraceEventRecorder::instance();
+    recorder.start();
+    recorder.set_thread_name("main");
+    {
+        mygbc::ScopedTraceSpan frame("frame");
+        mygbc::ScopedTraceSpan run("cpu_run");
+    }
+    std::thread worker([](){
+        mygbc::TraceEventRecorder::instance().set_thread_name("worker \"1\"");
+        mygbc::ScopedTraceSpan snapshot("snapshot_save");
+    });
+    worker.join();
+    recorder.stop();
+    {
+        //Not recorded while stopped
+        mygbc::ScopedTraceSpan frame("frame");
+    }
+    ASSERT_EQ(recorder.get_event_count(), 3);
+    ASSERT_EQ(recorder.get_dropped_event_count(), 0);
+    const std::string json = recorder.to_json();
+    ASSERT_NE(json.find("\"name\":\"cpu_run\",\"cat\":\"mygbc\",\"ph\":\"X\""), std::string::npos);
+    ASSERT_NE(json.find("\"name\":\"snapshot_save\""), std::string::npos);
+    ASSERT_NE(json.find("\"tid\":2"), std::string::npos);
+    ASSERT_NE(json.find("\"args\":{\"name\":\"worker \\\"1\\\"\"}"), std::string::npos);
+
+    //Restarting drops the previous events
+    recorder.start();
+    ASSERT_EQ(recorder.get_event_count(), 0);
+    recorder.stop();
+}
+
+/// @brief Checks that a span opened before a restart is dropped instead of recorded relative to the new start.
+TEST(TraceEventsTest, span_across_restart_is_dropped){
+    mygbc::TraceEventRecorder& recorder = mygbc::TraceEventRecorder::instance();
+    recorder.start();
+    {
+        mygbc::ScopedTraceSpan stale("frame");
+        recorder.start();
+        mygbc::ScopedTraceSpan fresh("cpu_run");
+    }
+    recorder.stop();
+    ASSERT_EQ(recorder.get_event_count(), 1);
+    ASSERT_NE(recorder.to_json().find("\"name\":\"cpu_run\""), std::string::npos);
+}
+
+/// @brief Checks that thread names survive a restart while the events are dropped.
+TEST(TraceEventsTest, restart_keeps_thread_names){
+    mygbc::TraceEventRecorder& recorder = mygbc::TraceEventRecorder::instance();
+    recorder.start();
+    recorder.set_thread_name("emulation");
+    {
+        mygbc::ScopedTraceSpan frame("frame");
+    }
+    recorder.stop();
+    recorder.start();
+    ASSERT_EQ(recorder.get_event_count(), 0);
+    {
+        mygbc::ScopedTraceSpan frame("frame");
+    }
+    recorder.stop();
+    const std::string json = recorder.to_json();
+    ASSERT_EQ(recorder.get_event_count(), 1);
+    ASSERT_NE(json.find("\"args\":{\"name\":\"emulation\"}"), std::string::npos);
+}
@@ -0,0 +1,26 @@
+#include "../../src/snapshot/input_log.h" //InputLog
+#include <gtest/gtest.h> //GTest
+
+/// @brief Checks that the joypad state in effect is found for a cycle.
+TEST(InputLogTest, buttons_at_cycle){
+    mygbc::InputLog log;
+    log.record(100, 0x01);
+    log.record(200, 0x80);
+    ASSERT_EQ(log.get_buttons_at(99), 0x00);
+    ASSERT_EQ(log.get_buttons_at(100), 0x01);
+    ASSERT_EQ(log.get_buttons_at(199), 0x01);
+    ASSERT_EQ(log.get_buttons_at(500), 0x80);
+    ASSERT_EQ(log.find_next(100), 1);
+}
+
+/// @brief Checks that recording in the past drops the abandoned timeline.
+TEST(InputLogTest, record_drops_later_events){
+    mygbc::InputLog log;
+    log.record(100, 0x01);
+    log.record(200, 0x02);
+    log.record(300, 0x04);
+    log.record(200, 0x08);
+    const std::size_t expected_events = 2;
+    ASSERT_EQ(log.get_events().size(), expected_events);
+    ASSERT_EQ(log.get_buttons_at(300), 0x08);
+}
@@ -0,0 +1,122 @@
+#include "../../src/snapshot/rewind_buffer.h" //RewindBuffer
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that rewinding restores the memory and frame of a capture.
+TEST(RewindBufferTest, rewind_restores_captured_frame){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 1024 * 1024;
+    mygbc::RewindBuffer rewind(gbc, budget, 1, 4);
+    ASSERT_TRUE(rewind.capture().ok());
+    for(uint8_t frame = 1; frame <= 10; ++frame){
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, frame).ok());
+        ASSERT_TRUE(rewind.on_frame_end().ok());
+    }
+    const std::size_t expected_captures = 11;
+    ASSERT_EQ(rewind.get_capture_count(), expected_captures);
+    const uint64_t rewind_frame = 6;
+    ASSERT_TRUE(rewind.rewind_to_frame(rewind_frame).ok());
+    ASSERT_EQ(gbc.get_frame_count(), rewind_frame);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), rewind_frame);
+    ASSERT_EQ(rewind.get_capture_count(), rewind_frame + 1);
+}
+
+/// @brief Checks that frames between captures are replayed.
+TEST(RewindBufferTest, rewind_between_captures_replays_frames){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 1024 * 1024;
+    mygbc::RewindBuffer rewind(gbc, budget, 4, 4);
+    ASSERT_TRUE(rewind.capture().ok());
+    for(int frame = 1; frame <= 8; ++frame){
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(rewind.on_frame_end().ok());
+    }
+    const std::size_t expected_captures = 3;
+    ASSERT_EQ(rewind.get_capture_count(), expected_captures);
+    const uint64_t rewind_frame = 5;
+    ASSERT_TRUE(rewind.rewind_to_frame(rewind_frame).ok());
+    ASSERT_EQ(gbc.get_frame_count(), rewind_frame);
+    ASSERT_EQ(gbc.get_cycle_count(), rewind_frame * mygbc::GBC::cycles_per_frame);
+}
+
+/// @brief Checks that the memory budget drops the oldest keyframe groups.
+TEST(RewindBufferTest, memory_budget_is_enforced){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 4096;
+    mygbc::RewindBuffer rewind(gbc, budget, 1, 2);
+    for(int frame = 0; frame < 64; ++frame){
+        //Noisy page so every capture carries data
+        for(uint16_t addr = 0xC000; addr < 0xC100; ++addr){
+            ASSERT_TRUE(gbc.get_memory().set_byte(addr, static_cast<uint8_t>(addr + frame)).ok());
+        }
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(rewind.on_frame_end().ok());
+    }
+    ASSERT_LE(rewind.get_memory_usage(), budget);
+    ASSERT_GT(rewind.get_oldest_frame(), 0);
+}
+
+/// @brief Checks that the budget holds when a keyframe group alone would outgrow it.
+TEST(RewindBufferTest, memory_budget_holds_with_long_keyframe_interval){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 8192;
+    mygbc::RewindBuffer rewind(gbc, budget, 1, 1000);
+    for(int frame = 0; frame < 128; ++frame){
+        for(uint16_t addr = 0xC000; addr < 0xC100; ++addr){
+            ASSERT_TRUE(gbc.get_memory().set_byte(addr, static_cast<uint8_t>((addr * 7) + frame)).ok());
+        }
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(rewind.on_frame_end().ok());
+        ASSERT_LE(rewind.get_memory_usage(), budget);
+    }
+    ASSERT_GT(rewind.get_oldest_frame(), 0);
+    //The forced keyframes still rewind
+    ASSERT_TRUE(rewind.rewind_to_frame(rewind.get_oldest_frame() + 1).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC001).value(), static_cast<uint8_t>((0xC001 * 7) + rewind.get_oldest_frame()));
+}
+
+/// @brief Checks that rewinding outside of the window fails.
+TEST(RewindBufferTest, rewind_outside_window_fails){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 1024 * 1024;
+    mygbc::RewindBuffer rewind(gbc, budget, 1, 4);
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INDEX_ERROR;
+    ASSERT_EQ(rewind.rewind_to_frame(0).code(), expected_status);
+}
+
+/// @brief Checks that captures storing only their written pages rewind to the memory of every frame.
+TEST(RewindBufferTest, dirty_page_captures_restore_every_page){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    const std::size_t budget = 1024 * 1024;
+    mygbc::RewindBuffer rewind(gbc, budget, 1, 8);
+    ASSERT_TRUE(rewind.capture().ok());
+    //Each frame writes one of three pages, the others stay out of its capture
+    const std::vector<uint16_t> addresses{0xC000, 0xC480, 0xFF90};
+    for(uint8_t frame = 1; frame <= 12; ++frame){
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(gbc.get_memory().set_byte(addresses[frame % addresses.size()], frame).ok());
+        ASSERT_TRUE(rewind.on_frame_end().ok());
+    }
+    for(uint64_t rewind_frame = 12; rewind_frame >= 3; --rewind_frame){
+        ASSERT_TRUE(rewind.rewind_to_frame(rewind_frame).ok());
+        for(std::size_t address_index = 0; address_index < addresses.size(); ++address_index){
+            //Latest frame at or before the rewind frame that wrote the address
+            uint64_t written_frame = rewind_frame;
+            while(written_frame % addresses.size() != address_index){
+                --written_frame;
+            }
+            ASSERT_EQ(gbc.get_memory().get_byte(addresses[address_index]).value(), written_frame);
+        }
+    }
+    //Scratch buffers hold at least the previous state and a full delta
+    ASSERT_GE(rewind.get_scratch_memory_usage(), 2 * mygbc::RewindBuffer::state_size);
+}
@@ -0,0 +1,69 @@
+#include "../../src/snapshot/snapshot_archive.h" //SnapshotArchiveWriter, SnapshotArchive
+#include "../../src/gbc.h" //GBC
+#include "../test_path.h" //get_unique_temp_path
+#include <gtest/gtest.h> //GTest
+#include <filesystem> //std::filesystem
+#include <string> //std::string
+
+/// @brief Returns a fresh archive path in the temp directory.
+/// @param name Name of the archive.
+/// @return Path to the archive.
+static std::string fresh_archive_path(const std::string& name){
+    return mygbc::get_unique_temp_path(name).string();
+}
+
+/// @brief Checks that archived snapshots restore in place.
+TEST(SnapshotArchiveTest, appended_snapshots_restore){
+    const std::string path = fresh_archive_path("mygbc_snapshot_archive_test.mgsa");
+    mygbc::GBC gbc;
+    {
+        mygbc::SnapshotArchiveWriter writer;
+        ASSERT_TRUE(writer.open(path).ok());
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x11).ok());
+        ASSERT_EQ(writer.append(gbc.save_snapshot()).value(), 0);
+    }
+    {
+        //Appending to an existing archive keeps the records
+        mygbc::SnapshotArchiveWriter writer;
+        ASSERT_TRUE(writer.open(path).ok());
+        ASSERT_EQ(writer.get_snapshot_count(), 1);
+        gbc.get_processing_unit().get_register_file().pc.set_word(0x0150);
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x22).ok());
+        ASSERT_EQ(writer.append(gbc.save_snapshot()).value(), 1);
+        ASSERT_FALSE(writer.append(gbc.save_incremental_snapshot()).ok());
+    }
+
+    mygbc::SnapshotArchive archive;
+    ASSERT_TRUE(archive.open(path).ok());
+    const std::size_t expected_records = 2;
+    ASSERT_EQ(archive.get_snapshot_count(), expected_records);
+    ASSERT_TRUE(archive.verify(1).ok());
+    ASSERT_EQ(archive.get_page_data(1).value()[0xC000], 0x22);
+
+    mygbc::GBC restored;
+    ASSERT_TRUE(archive.restore(0, restored).ok());
+    ASSERT_EQ(restored.get_memory().get_byte(0xC000).value(), 0x11);
+    ASSERT_TRUE(archive.restore(1, restored).ok());
+    ASSERT_EQ(restored.get_memory().get_byte(0xC000).value(), 0x22);
+    ASSERT_EQ(restored.get_processing_unit().get_register_file().pc.get_word(), 0x0150);
+
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INDEX_ERROR;
+    ASSERT_EQ(archive.restore(expected_records, restored).code(), expected_status);
+    archive.close();
+    std::filesystem::remove(path);
+}
+
+/// @brief Checks that files without the archive header are rejected.
+TEST(SnapshotArchiveTest, invalid_file_rejected){
+    const std::string path = fresh_archive_path("mygbc_snapshot_archive_invalid.mgsa");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not an archive, just some text that is long enough";
+    }
+    mygbc::SnapshotArchive archive;
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INPUT_ERROR;
+    ASSERT_EQ(archive.open(path).code(), expected_status);
+    mygbc::SnapshotArchiveWriter writer;
+    ASSERT_EQ(writer.open(path).code(), expected_status);
+    std::filesystem::remove(path);
+}
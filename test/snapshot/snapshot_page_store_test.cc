@@ -0,0 +1,83 @@
+#include "../../src/snapshot/snapshot_page_store.h" //SnapshotPageStore
+#include "../../src/gbc.h" //GBC
+#include <gtest/gtest.h> //GTest
+
+/// @brief Checks that identical pages are stored once and snapshots restore.
+TEST(SnapshotPageStoreTest, identical_pages_stored_once){
+    mygbc::GBC gbc;
+    mygbc::SnapshotPageStore store;
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> first = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(first.ok());
+    //Zeroed memory, a single unique page besides the P1 page
+    const std::size_t expected_initial_pages = 2;
+    ASSERT_EQ(store.get_unique_page_count(), expected_initial_pages);
+
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x11).ok());
+    gbc.get_processing_unit().get_register_file().pc.set_word(0x0150);
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> second = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(second.ok());
+    ASSERT_EQ(store.get_unique_page_count(), expected_initial_pages + 1);
+
+    ASSERT_TRUE(store.restore(first.value(), gbc).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x00);
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().pc.get_word(), 0x0000);
+    ASSERT_TRUE(store.restore(second.value(), gbc).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x11);
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().pc.get_word(), 0x0150);
+}
+
+/// @brief Checks that incremental snapshots share the pages of their base.
+TEST(SnapshotPageStoreTest, incremental_snapshot_shares_base_pages){
+    mygbc::GBC gbc;
+    mygbc::SnapshotPageStore store;
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> base = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(base.ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD123, 0x42).ok());
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> next = store.store(gbc.save_incremental_snapshot(), base.value());
+    ASSERT_TRUE(next.ok());
+
+    ASSERT_TRUE(store.restore(base.value(), gbc).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD123).value(), 0x00);
+    ASSERT_TRUE(store.restore(next.value(), gbc).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD123).value(), 0x42);
+    ASSERT_FALSE(store.store(gbc.save_incremental_snapshot()).ok());
+}
+
+/// @brief Checks that released snapshots free their unique pages.
+TEST(SnapshotPageStoreTest, release_frees_unique_pages){
+    mygbc::GBC gbc;
+    mygbc::SnapshotPageStore store;
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> base = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(base.ok());
+    const std::size_t base_pages = store.get_unique_page_count();
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> next = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(next.ok());
+    ASSERT_EQ(store.get_unique_page_count(), base_pages + 1);
+
+    ASSERT_TRUE(store.release(next.value()).ok());
+    ASSERT_EQ(store.get_unique_page_count(), base_pages);
+    ASSERT_EQ(store.get_snapshot_count(), 1);
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INDEX_ERROR;
+    ASSERT_EQ(store.release(next.value()).code(), expected_status);
+    ASSERT_TRUE(store.restore(base.value(), gbc).ok());
+    ASSERT_EQ(gbc.get_memory().get_byte(0xC000).value(), 0x00);
+}
+
+/// @brief Checks that many similar snapshots stay small.
+TEST(SnapshotPageStoreTest, similar_snapshots_stay_small){
+    mygbc::GBC gbc;
+    mygbc::SnapshotPageStore store;
+    mygbc::StatusOr<mygbc::SnapshotPageStore::SnapshotId> previous = store.store(gbc.save_snapshot());
+    ASSERT_TRUE(previous.ok());
+    const std::size_t snapshot_count = 1000;
+    for(std::size_t index = 1; index < snapshot_count; ++index){
+        ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, static_cast<uint8_t>(index)).ok());
+        previous = store.store(gbc.save_incremental_snapshot(), previous.value());
+        ASSERT_TRUE(previous.ok());
+    }
+    ASSERT_EQ(store.get_snapshot_count(), snapshot_count);
+    //A full snapshot is 64 KiB, the whole store stays below a few of them
+    const std::size_t max_memory_usage = 512 * 1024;
+    ASSERT_LT(store.get_memory_usage(), max_memory_usage);
+}
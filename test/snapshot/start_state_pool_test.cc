@@ -0,0 +1,30 @@
+#include "../../src/snapshot/start_state_pool.h" //StartStatePool
+#include "../../src/gbc.h" //GBC
+#include <gtest/gtest.h> //GTest
+
+/// @brief Checks that only the RAM pages differing from the first state are marked.
+TEST(StartStatePoolTest, marks_pages_differing_from_first_state){
+    mygbc::GBC gbc;
+    mygbc::StartStatePool pool;
+    ASSERT_TRUE(pool.add(gbc.save_snapshot()).ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC012, 0x01).ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD0FF, 0x02).ok());
+    ASSERT_TRUE(pool.add(gbc.save_snapshot()).ok());
+    ASSERT_EQ(pool.get_size(), 2);
+    ASSERT_FALSE(pool.get_state(0).differing_pages.any());
+    const mygbc::PageBitmap& differing_pages = pool.get_state(1).differing_pages;
+    ASSERT_EQ(differing_pages.count(), 2);
+    ASSERT_TRUE(differing_pages.test(0xC0));
+    ASSERT_TRUE(differing_pages.test(0xD0));
+    ASSERT_EQ(pool.get_state(1).address_space[0xD0FF], 0x02);
+}
+
+/// @brief Checks that incremental snapshots are rejected.
+TEST(StartStatePoolTest, rejects_incremental_snapshots){
+    mygbc::GBC gbc;
+    mygbc::StartStatePool pool;
+    gbc.save_snapshot();
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    ASSERT_FALSE(pool.add(gbc.save_incremental_snapshot()).ok());
+    ASSERT_EQ(pool.get_size(), 0);
+}
@@ -0,0 +1,60 @@
+#include "../../src/snapshot/state_hasher.h" //StateHasher
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that the incremental hash matches a full rehash.
+TEST(StateHasherTest, incremental_hash_matches_full_rehash){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::StateHasher hasher(gbc);
+    const uint64_t initial_hash = hasher.update();
+    ASSERT_EQ(hasher.update(), initial_hash);
+
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+    const uint64_t written_hash = hasher.update();
+    ASSERT_NE(written_hash, initial_hash);
+    hasher.reset();
+    ASSERT_EQ(hasher.update(), written_hash);
+
+    //Registers are part of the state
+    gbc.get_processing_unit().get_register_file().pc.set_word(0x0150);
+    ASSERT_NE(hasher.update(), written_hash);
+}
+
+/// @brief Checks that restoring a snapshot restores the hash.
+TEST(StateHasherTest, restored_snapshot_restores_hash){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::StateHasher hasher(gbc);
+    mygbc::GBCSnapshot snapshot = gbc.save_snapshot();
+    const uint64_t snapshot_hash = hasher.update();
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD000, 0x42).ok());
+    ASSERT_NE(hasher.update(), snapshot_hash);
+    ASSERT_TRUE(gbc.restore_snapshot(snapshot).ok());
+    ASSERT_EQ(hasher.update(), snapshot_hash);
+}
+
+/// @brief Checks that the first diverging frame of two runs is found.
+TEST(StateHasherTest, finds_first_diverging_frame){
+    const uint64_t frame_count = 8;
+    const uint64_t diverging_frame = 5;
+    std::vector<std::vector<mygbc::FrameHash>> streams;
+    for(std::size_t run = 0; run < 2; ++run){
+        mygbc::GBC gbc;
+        ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+        mygbc::StateHasher hasher(gbc);
+        for(uint64_t frame = 1; frame <= frame_count; ++frame){
+            ASSERT_TRUE(gbc.run_frame().ok());
+            if(run == 1 && frame == diverging_frame){
+                ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x01).ok());
+            }
+            hasher.on_frame_end();
+        }
+        streams.push_back(hasher.get_frame_hashes());
+    }
+    ASSERT_EQ(mygbc::StateHasher::find_first_divergence(streams[0], streams[0]), mygbc::StateHasher::no_divergence);
+    ASSERT_EQ(mygbc::StateHasher::find_first_divergence(streams[0], streams[1]), diverging_frame);
+}
@@ -0,0 +1,36 @@
+#include "../../src/snapshot/state_slot.h" //StateSlot
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that saves and restores only copy the pages written since the previous save.
+TEST(StateSlotTest, restores_written_pages){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::StateSlot slot(gbc);
+    ASSERT_FALSE(slot.has_state());
+    ASSERT_FALSE(slot.restore().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x11).ok());
+    slot.save();
+    ASSERT_TRUE(slot.has_state());
+    ASSERT_EQ(slot.get_last_saved_page_count(), 1);
+    const mygbc::GBCSnapshot saved = gbc.save_snapshot();
+
+    ASSERT_TRUE(gbc.run_frame().ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xC000, 0x22).ok());
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD100, 0x33).ok());
+    ASSERT_TRUE(slot.restore().ok());
+    ASSERT_EQ(slot.get_last_restored_page_count(), 2);
+    ASSERT_EQ(gbc.get_cycle_count(), saved.cycle_count);
+    ASSERT_EQ(gbc.get_processing_unit().get_register_file().get_register_words(), saved.register_words);
+    ASSERT_EQ(gbc.save_snapshot().page_data, saved.page_data);
+
+    //Restoring again only copies the pages written since the restore
+    ASSERT_TRUE(gbc.get_memory().set_byte(0xD100, 0x44).ok());
+    ASSERT_TRUE(slot.restore().ok());
+    ASSERT_EQ(slot.get_last_restored_page_count(), 1);
+    ASSERT_EQ(gbc.get_memory().get_byte(0xD100).value(), 0x00);
+    slot.save();
+    ASSERT_EQ(slot.get_last_saved_page_count(), 0);
+    ASSERT_EQ(slot.get_memory_usage(), mygbc::MemoryController::address_space_size);
+}
@@ -0,0 +1,96 @@
+#include "../../src/snapshot/time_travel.h" //TimeTravel
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that seeking lands on the cycle with the recorded input in effect.
+TEST(TimeTravelTest, seek_replays_recorded_inputs){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    //Select the direction lines
+    ASSERT_TRUE(gbc.get_memory().set_byte(mygbc::MemoryController::joypad_register_addr, 0x20).ok());
+    mygbc::TimeTravel time_travel(gbc, 2);
+    ASSERT_TRUE(time_travel.record().ok());
+    for(int frame = 0; frame < 6; ++frame){
+        ASSERT_TRUE(gbc.run_until_cycle(gbc.get_cycle_count() + 1600).ok());
+        gbc.set_joypad_state(static_cast<uint8_t>(frame + 1));
+        ASSERT_TRUE(gbc.run_frame().ok());
+        ASSERT_TRUE(time_travel.on_frame_end().ok());
+    }
+    const std::size_t expected_snapshots = 4;
+    ASSERT_EQ(time_travel.get_snapshot_count(), expected_snapshots);
+
+    //Frame 3 received input 4 at 1600 cycles into the frame
+    const uint64_t seek_cycle = (3 * mygbc::GBC::cycles_per_frame) + 3200;
+    ASSERT_TRUE(time_travel.seek_to_cycle(seek_cycle).ok());
+    ASSERT_GE(gbc.get_cycle_count(), seek_cycle);
+    ASSERT_LT(gbc.get_cycle_count(), seek_cycle + 16);
+    ASSERT_EQ(gbc.get_memory().get_joypad_state(), 0x04);
+    ASSERT_EQ(gbc.get_memory().get_byte(mygbc::MemoryController::joypad_register_addr).value(), 0xEB);
+}
+
+/// @brief Checks that a seek reproduces the state of an uninterrupted run.
+TEST(TimeTravelTest, seek_matches_straight_run){
+    mygbc::GBC recorded;
+    mygbc::GBC straight;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(recorded).ok());
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(straight).ok());
+    mygbc::TimeTravel time_travel(recorded, 1);
+    ASSERT_TRUE(time_travel.record().ok());
+    for(int frame = 0; frame < 4; ++frame){
+        recorded.set_joypad_state(static_cast<uint8_t>(0x10 << (frame % 4)));
+        straight.set_joypad_state(static_cast<uint8_t>(0x10 << (frame % 4)));
+        ASSERT_TRUE(recorded.run_frame().ok());
+        ASSERT_TRUE(straight.run_frame().ok());
+        ASSERT_TRUE(time_travel.on_frame_end().ok());
+    }
+    ASSERT_TRUE(time_travel.seek_to_frame(1).ok());
+    ASSERT_TRUE(time_travel.seek_to_frame(4).ok());
+    ASSERT_EQ(recorded.get_cycle_count(), straight.get_cycle_count());
+    ASSERT_EQ(recorded.get_memory().get_memory(), straight.get_memory().get_memory());
+    ASSERT_EQ(
+        recorded.get_processing_unit().get_register_file().get_register_words(),
+        straight.get_processing_unit().get_register_file().get_register_words()
+    );
+}
+
+/// @brief Checks that seeking before the first snapshot fails.
+TEST(TimeTravelTest, seek_before_first_snapshot_fails){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::TimeTravel time_travel(gbc, 1);
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INDEX_ERROR;
+    ASSERT_EQ(time_travel.seek_to_cycle(0).code(), expected_status);
+}
+
+/// @brief Checks that changing the input after a seek back drops the snapshots of the abandoned timeline.
+TEST(TimeTravelTest, diverging_input_drops_later_snapshots){
+    mygbc::GBC recorded;
+    mygbc::GBC straight;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(recorded).ok());
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(straight).ok());
+    mygbc::TimeTravel time_travel(recorded, 1);
+    ASSERT_TRUE(time_travel.record().ok());
+    for(int frame = 0; frame < 4; ++frame){
+        recorded.set_joypad_state(0x01);
+        ASSERT_TRUE(recorded.run_frame().ok());
+        ASSERT_TRUE(time_travel.on_frame_end().ok());
+    }
+    ASSERT_EQ(time_travel.get_snapshot_count(), 5);
+
+    ASSERT_TRUE(time_travel.seek_to_frame(1).ok());
+    recorded.set_joypad_state(0x80);
+    //Snapshots of frames 2 to 4 were taken with the old input
+    ASSERT_EQ(time_travel.get_snapshot_count(), 2);
+    straight.set_joypad_state(0x01);
+    ASSERT_TRUE(straight.run_frame().ok());
+    straight.set_joypad_state(0x80);
+    ASSERT_TRUE(straight.run_until_cycle(4 * mygbc::GBC::cycles_per_frame).ok());
+
+    ASSERT_TRUE(time_travel.seek_to_frame(4).ok());
+    ASSERT_EQ(recorded.get_cycle_count(), straight.get_cycle_count());
+    ASSERT_EQ(recorded.get_memory().get_joypad_state(), 0x80);
+    ASSERT_EQ(recorded.get_memory().get_memory(), straight.get_memory().get_memory());
+    ASSERT_EQ(recorded.get_input_log().get_events().size(), straight.get_input_log().get_events().size());
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_PATH_H
+#define TEST_PATH_H
+
+#include <atomic> //std::atomic
+#include <cstdint> //Fixed lenght variables
+#include <filesystem> //std::filesystem
+#include <random> //std::random_device
+#include <string> //std::string
+
+namespace mygbc{
+
+    /// @brief Returns a path in the temp directory that no other test process uses.
+    /// @details The stem of the name is suffixed with a per process token and a counter, so test binaries may run in parallel.
+    /// @param name Name of the file.
+    /// @return Path to the file, the file does not exist.
+    inline std::filesystem::path get_unique_temp_path(const std::string& name){
+        static const uint64_t process_token = (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()();
+        static std::atomic<uint64_t> file_counter(0);
+        const std::filesystem::path file_name(name);
+        const std::string unique_name = file_name.stem().string() + "_" + std::to_string(process_token) + "_" + std::to_string(file_counter.fetch_add(1)) + file_name.extension().string();
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / unique_name;
+        std::filesystem::remove(path);
+        return path;
+    }
+
+}//namespace_mygbc
+
+#endif
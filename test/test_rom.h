@@ -0,0 +1,46 @@
+#ifndef TEST_ROM_H
+#define TEST_ROM_H
+
+#include <vector> //std::vector
+#include <cstdint> //Fixed lenght variables
+#include "../src/gbc.h" //GBC
+#include "../src/memory/gbc_binary.h" //GBCBinary
+#include "../src/util/status/status.h" //Status
+
+namespace mygbc{
+
+    /// @brief Returns a ROM image with a JP 0x0000 loop at the boot address.
+    /// @details Shared by the tests and the benchmarks, patch the image for other programs.
+    /// @return Image of the ROM banks 0 and 1.
+    inline std::vector<uint8_t> get_jump_loop_rom_image(){
+        std::vector<uint8_t> rom(0x8000, 0x00);
+        rom[0x0000] = 0xC3; //JP a16
+        return rom;
+    }
+
+    /// @brief Wraps a ROM image in a binary with an empty header.
+    /// @param rom_image Image of the ROM banks 0 and 1.
+    /// @return ROM binary.
+    inline GBCBinary get_test_binary(const std::vector<uint8_t>& rom_image){
+        return GBCBinary(GBCBinary::GBCBinaryHeaderData(), true, true, rom_image);
+    }
+
+    /// @brief Loads the ROM image to the GBC.
+    /// @param gbc GBC to load the ROM to.
+    /// @param rom_image Image of the ROM banks 0 and 1.
+    /// @return Status of the load.
+    inline Status load_test_rom(GBC& gbc, const std::vector<uint8_t>& rom_image){
+        GBCBinary binary = get_test_binary(rom_image);
+        return gbc.get_memory().load_rom(binary);
+    }
+
+    /// @brief Loads a ROM with a JP 0x0000 loop at the boot address.
+    /// @param gbc GBC to load the ROM to.
+    /// @return Status of the load.
+    inline Status load_jump_loop_rom(GBC& gbc){
+        return load_test_rom(gbc, get_jump_loop_rom_image());
+    }
+
+}//namespace_mygbc
+
+#endif
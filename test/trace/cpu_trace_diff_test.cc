@@ -0,0 +1,72 @@
+#include "../../src/trace/cpu_trace_diff.h" //CpuTraceDiff
+#include "../../src/trace/cpu_trace_recorder.h" //CpuTraceRecorder
+#include "../test_path.h" //get_unique_temp_path
+#include <gtest/gtest.h> //GTest
+#include <filesystem> //std::filesystem
+#include <string> //std::string
+
+/// @brief Writes a trace of JP instructions, the AF register changes at the given entry.
+/// @param name Name of the trace in the temp directory.
+/// @param entry_count Number of entries.
+/// @param changed_entry Entry from which AF differs, entry_count for none.
+/// @return Path to the trace.
+static std::string write_jump_trace(const std::string& name, const std::size_t entry_count, const std::size_t changed_entry){
+    const std::filesystem::path path = mygbc::get_unique_temp_path(name);
+    mygbc::CpuTraceRecorder recorder;
+    EXPECT_TRUE(recorder.open(path.string(), 0).ok());
+    for(std::size_t index = 0; index < entry_count; ++index){
+        const uint16_t a_f = index >= changed_entry ? 0x0100 : 0x0000;
+        const uint16_t pc = static_cast<uint16_t>(0x0150 + ((index % 4) * 3));
+        recorder.record({0, a_f, 0, 0, 0, pc, 0xFFFE}, {0xC3, 0x01, 0x50, 0x00}, 16);
+    }
+    EXPECT_TRUE(recorder.close().ok());
+    return path.string();
+}
+
+/// @brief Checks that equal traces match and the first divergence is reported with context.
+TEST(CpuTraceDiffTest, finds_first_divergence){
+    const std::size_t entry_count = 10000;
+    const std::size_t changed_entry = 6000;
+    const std::size_t context_size = 4;
+    const std::string reference_path = write_jump_trace("mygbc_trace_diff_reference.mgtr", entry_count, entry_count);
+    const std::string same_path = write_jump_trace("mygbc_trace_diff_same.mgtr", entry_count, entry_count);
+    const std::string changed_path = write_jump_trace("mygbc_trace_diff_changed.mgtr", entry_count, changed_entry);
+
+    mygbc::CpuTraceReader reference;
+    mygbc::CpuTraceReader same;
+    mygbc::CpuTraceReader changed;
+    ASSERT_TRUE(reference.open(reference_path).ok());
+    ASSERT_TRUE(same.open(same_path).ok());
+    ASSERT_TRUE(changed.open(changed_path).ok());
+    ASSERT_FALSE(mygbc::CpuTraceDiff::find_first_divergence(reference, same, context_size).value().diverged);
+
+    mygbc::CpuTraceDivergence divergence = mygbc::CpuTraceDiff::find_first_divergence(reference, changed, context_size).value();
+    ASSERT_TRUE(divergence.diverged);
+    ASSERT_EQ(divergence.index, changed_entry);
+    ASSERT_EQ(divergence.context.size(), context_size);
+    ASSERT_EQ(divergence.context.back().index, changed_entry - 1);
+    mygbc::InstructionSetLR35902 instruction_set;
+    const std::string report = mygbc::CpuTraceDiff::format_report(divergence, instruction_set);
+    ASSERT_NE(report.find("JP $0150"), std::string::npos);
+    ASSERT_NE(report.find("Differs in: AF"), std::string::npos);
+
+    std::filesystem::remove(reference_path);
+    std::filesystem::remove(same_path);
+    std::filesystem::remove(changed_path);
+}
+
+/// @brief Checks that a trace ending early is reported as a divergence.
+TEST(CpuTraceDiffTest, shorter_trace_diverges_at_its_end){
+    const std::string long_path = write_jump_trace("mygbc_trace_diff_long.mgtr", 5000, 5000);
+    const std::string short_path = write_jump_trace("mygbc_trace_diff_short.mgtr", 4500, 4500);
+    mygbc::CpuTraceReader long_trace;
+    mygbc::CpuTraceReader short_trace;
+    ASSERT_TRUE(long_trace.open(long_path).ok());
+    ASSERT_TRUE(short_trace.open(short_path).ok());
+    mygbc::CpuTraceDivergence divergence = mygbc::CpuTraceDiff::find_first_divergence(long_trace, short_trace, 2).value();
+    ASSERT_TRUE(divergence.diverged);
+    ASSERT_TRUE(divergence.second_ended);
+    ASSERT_EQ(divergence.index, 4500);
+    std::filesystem::remove(long_path);
+    std::filesystem::remove(short_path);
+}
@@ -0,0 +1,131 @@
+#include "../../src/trace/cpu_trace_recorder.h" //CpuTraceRecorder
+#include "../../src/trace/cpu_trace_reader.h" //CpuTraceReader
+#include "../../src/gbc.h" //GBC
+#include "../test_rom.h" //load_jump_loop_rom
+#include "../test_path.h" //get_unique_temp_path
+#include <gtest/gtest.h> //GTest
+#include <array> //std::array
+#include <filesystem> //std::filesystem
+#include <string> //std::string
+#include <vector> //std::vector
+
+/// @brief Returns a fresh trace path in the temp directory.
+/// @param name Name of the trace.
+/// @return Path to the trace.
+static std::string fresh_trace_path(const std::string& name){
+    return mygbc::get_unique_temp_path(name).string();
+}
+
+/// @brief Checks that recorded entries decode back across chunks.
+TEST(CpuTraceTest, recorded_entries_roundtrip){
+    const std::string path = fresh_trace_path("mygbc_cpu_trace_roundtrip.mgtr");
+    const uint64_t start_cycle = 100;
+    const std::size_t entry_count = (mygbc::CpuTraceFormat::records_per_chunk * 2) + 10;
+    std::vector<mygbc::CpuTraceEntry> expected(entry_count);
+    uint64_t cycle = start_cycle;
+    for(std::size_t index = 0; index < entry_count; ++index){
+        mygbc::CpuTraceEntry& entry = expected[index];
+        entry.index = index;
+        entry.cycle = cycle;
+        entry.register_words = {0, static_cast<uint16_t>(index * 7), 0x1234, static_cast<uint16_t>(index / 3), 0x0000, static_cast<uint16_t>((index * 3) % 0x9000), 0xFFFE};
+        entry.pc_memory = {static_cast<uint8_t>(index % 5), 0x01, 0x02, static_cast<uint8_t>(index % 2)};
+        entry.cycles = static_cast<uint8_t>(4 + ((index % 3) * 4));
+        cycle += entry.cycles;
+    }
+    {
+        mygbc::CpuTraceRecorder recorder;
+        ASSERT_TRUE(recorder.open(path, start_cycle).ok());
+        for(const mygbc::CpuTraceEntry& entry : expected){
+            recorder.record(entry.register_words, entry.pc_memory, entry.cycles);
+        }
+        ASSERT_TRUE(recorder.close().ok());
+    }
+    mygbc::CpuTraceReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    mygbc::CpuTraceEntry entry;
+    for(const mygbc::CpuTraceEntry& expected_entry : expected){
+        mygbc::StatusOr<bool> has_entry = reader.next(entry);
+        ASSERT_TRUE(has_entry.ok());
+        ASSERT_TRUE(has_entry.value());
+        ASSERT_EQ(entry.index, expected_entry.index);
+        ASSERT_EQ(entry.cycle, expected_entry.cycle);
+        ASSERT_EQ(entry.register_words, expected_entry.register_words);
+        ASSERT_EQ(entry.pc_memory, expected_entry.pc_memory);
+        ASSERT_EQ(entry.cycles, expected_entry.cycles);
+    }
+    ASSERT_FALSE(reader.next(entry).value());
+    std::filesystem::remove(path);
+}
+
+/// @brief Checks that the CPU records its instructions and that they expand to gameboy-doctor lines.
+TEST(CpuTraceTest, cpu_records_doctor_lines){
+    const std::string path = fresh_trace_path("mygbc_cpu_trace_cpu.mgtr");
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+
+    mygbc::CpuTraceRecorder recorder;
+    ASSERT_TRUE(recorder.open(path, gbc.get_cycle_count()).ok());
+    gbc.get_processing_unit().set_trace_recorder(&recorder);
+    ASSERT_TRUE(gbc.run_frame().ok());
+    gbc.get_processing_unit().set_trace_recorder(nullptr);
+    ASSERT_TRUE(recorder.close().ok());
+    //Each JP takes 16 T-cycles
+    const uint64_t expected_records = (mygbc::GBC::cycles_per_frame + 15) / 16;
+    ASSERT_EQ(recorder.get_record_count(), expected_records);
+    ASSERT_LT(std::filesystem::file_size(path), expected_records * 3);
+
+    mygbc::CpuTraceReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    mygbc::CpuTraceEntry entry;
+    ASSERT_TRUE(reader.next(entry).value());
+    ASSERT_EQ(entry.to_doctor_line(), "A:00 F:00 B:00 C:00 D:00 E:00 H:00 L:00 SP:0000 PC:0000 PCMEM:C3,00,00,00");
+    ASSERT_EQ(entry.cycles, 16);
+    std::filesystem::remove(path);
+}
+
+/// @brief Checks that a recorder with a single pending chunk waits for the writer and still writes every chunk.
+TEST(CpuTraceTest, bounded_queue_keeps_every_chunk){
+    const std::string path = fresh_trace_path("mygbc_cpu_trace_bounded.mgtr");
+    const std::size_t chunk_count = 16;
+    const std::array<uint16_t, mygbc::CpuTraceEntry::register_count> register_words{};
+    const std::array<uint8_t, 4> pc_memory{0x00, 0x00, 0x00, 0x00};
+    mygbc::CpuTraceRecorder recorder(1);
+    ASSERT_TRUE(recorder.open(path, 0).ok());
+    for(std::size_t record = 0; record < chunk_count * mygbc::CpuTraceFormat::records_per_chunk; ++record){
+        recorder.record(register_words, pc_memory, 4);
+    }
+    ASSERT_TRUE(recorder.close().ok());
+    //The queue never holds more than one full chunk and the buffer being encoded
+    ASSERT_LE(recorder.get_memory_usage(), 3 * (mygbc::CpuTraceFormat::chunk_header_size + (mygbc::CpuTraceFormat::records_per_chunk * mygbc::CpuTraceFormat::max_record_size)) + 256);
+
+    mygbc::CpuTraceReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    ASSERT_EQ(reader.get_chunk_count(), chunk_count);
+    std::filesystem::remove(path);
+}
+
+/// @brief Checks that reopening a reader in the middle of a chunk decodes the new trace from its start.
+TEST(CpuTraceTest, reopened_reader_starts_at_first_entry){
+    const std::string path = fresh_trace_path("mygbc_cpu_trace_reopen.mgtr");
+    {
+        mygbc::CpuTraceRecorder recorder;
+        ASSERT_TRUE(recorder.open(path, 0).ok());
+        for(uint16_t pc = 0; pc < 8; ++pc){
+            recorder.record({0, 0, 0, 0, 0, pc, 0xFFFE}, {0x00, 0x00, 0x00, 0x00}, 4);
+        }
+        ASSERT_TRUE(recorder.close().ok());
+    }
+    mygbc::CpuTraceReader reader;
+    ASSERT_TRUE(reader.open(path).ok());
+    mygbc::CpuTraceEntry entry;
+    ASSERT_TRUE(reader.next(entry).value());
+    ASSERT_TRUE(reader.next(entry).value());
+    ASSERT_TRUE(reader.open(path).ok());
+    mygbc::StatusOr<bool> has_entry = reader.next(entry);
+    ASSERT_TRUE(has_entry.ok());
+    ASSERT_TRUE(has_entry.value());
+    ASSERT_EQ(entry.index, 0);
+    ASSERT_EQ(entry.cycle, 0);
+    ASSERT_EQ(entry.register_words[mygbc::CpuTraceFormat::pc_index], 0);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,74 @@
+#include "../../../src/util/compression/snapshot_codec.h" //SnapshotCodec
+#include <gtest/gtest.h> //GTest
+#include <random> //std::mt19937
+#include <vector> //std::vector
+
+/// @brief Compresses and decompresses the bytes, checks that the result matches.
+/// @param source Bytes to roundtrip.
+static void expect_roundtrip(const std::vector<uint8_t>& source){
+    const std::vector<uint8_t> compressed = mygbc::SnapshotCodec::compress(source);
+    std::vector<uint8_t> decompressed;
+    ASSERT_TRUE(mygbc::SnapshotCodec::decompress(compressed, decompressed).ok());
+    ASSERT_EQ(decompressed, source);
+}
+
+/// @brief Checks that zero runs roundtrip and compress well.
+TEST(SnapshotCodecTest, zero_run_roundtrip){
+    const std::vector<uint8_t> source(0x10000, 0x00);
+    expect_roundtrip(source);
+    const std::size_t max_compressed_size = 16;
+    ASSERT_LE(mygbc::SnapshotCodec::compress(source).size(), max_compressed_size);
+}
+
+/// @brief Checks that fills, literals and matches roundtrip.
+TEST(SnapshotCodecTest, mixed_roundtrip){
+    std::vector<uint8_t> source(0x4000, 0x00);
+    for(std::size_t index = 0x100; index < 0x200; ++index){
+        source[index] = 0xFF;
+    }
+    for(std::size_t index = 0x1000; index < 0x2000; ++index){
+        source[index] = static_cast<uint8_t>(index % 48);
+    }
+    source[0x3FFF] = 0x01;
+    expect_roundtrip(source);
+    ASSERT_LT(mygbc::SnapshotCodec::compress(source).size(), source.size() / 8);
+}
+
+/// @brief Checks that random bytes and short inputs roundtrip.
+TEST(SnapshotCodecTest, random_and_short_roundtrip){
+    std::mt19937 generator(1234);
+    std::vector<uint8_t> source(0x1000);
+    for(uint8_t& byte : source){
+        byte = static_cast<uint8_t>(generator());
+    }
+    expect_roundtrip(source);
+    expect_roundtrip({});
+    expect_roundtrip({0x01});
+    expect_roundtrip({0x00, 0x00, 0x01});
+}
+
+/// @brief Checks that corrupted streams are rejected.
+TEST(SnapshotCodecTest, corrupted_stream_rejected){
+    std::vector<uint8_t> source(0x1000, 0xAB);
+    source[0x10] = 0x00;
+    std::vector<uint8_t> compressed = mygbc::SnapshotCodec::compress(source);
+    std::vector<uint8_t> decompressed;
+    const mygbc::Status::StatusType expected_status = mygbc::Status::StatusType::INVALID_INPUT_ERROR;
+    compressed.pop_back();
+    ASSERT_EQ(mygbc::SnapshotCodec::decompress(compressed, decompressed).code(), expected_status);
+    //Match reaching before the start of the output
+    const std::vector<uint8_t> bad_match = {0x08, 0xC4, 0x10};
+    ASSERT_EQ(mygbc::SnapshotCodec::decompress(bad_match, decompressed).code(), expected_status);
+}
+
+/// @brief Checks that zero runs are counted across the SIMD and tail paths.
+TEST(SnapshotCodecTest, count_zero_run){
+    std::vector<uint8_t> source(100, 0x00);
+    ASSERT_EQ(mygbc::SnapshotCodec::count_zero_run(source.data(), source.size()), source.size());
+    const std::size_t nonzero_positions[] = {0, 7, 15, 16, 33, 99};
+    for(const std::size_t position : nonzero_positions){
+        source[position] = 0x01;
+        ASSERT_EQ(mygbc::SnapshotCodec::count_zero_run(source.data(), source.size()), position);
+        source[position] = 0x00;
+    }
+}
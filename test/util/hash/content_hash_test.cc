@@ -0,0 +1,47 @@
+#include "../../../src/util/hash/content_hash.h" //ContentHash
+#include <gtest/gtest.h> //GTest
+#include <vector> //std::vector
+
+/// @brief Checks that the hash depends on the content, order, size and seed.
+TEST(ContentHashTest, hash_depends_on_content){
+    std::vector<uint8_t> data(256);
+    for(std::size_t index = 0; index < data.size(); ++index){
+        data[index] = static_cast<uint8_t>(index);
+    }
+    const uint64_t hash = mygbc::ContentHash::hash(data.data(), data.size());
+    ASSERT_EQ(mygbc::ContentHash::hash(data.data(), data.size()), hash);
+    ASSERT_NE(mygbc::ContentHash::hash(data.data(), data.size(), 1), hash);
+    ASSERT_NE(mygbc::ContentHash::hash(data.data(), data.size() - 1), hash);
+
+    //Swapping two 32 byte blocks
+    std::vector<uint8_t> swapped = data;
+    std::swap_ranges(swapped.begin(), swapped.begin() + 32, swapped.begin() + 32);
+    ASSERT_NE(mygbc::ContentHash::hash(swapped.data(), swapped.size()), hash);
+
+    //Flipping single bits in the blocks and the tail
+    const std::size_t flipped_positions[] = {0, 31, 100, 254};
+    for(const std::size_t position : flipped_positions){
+        std::vector<uint8_t> flipped = data;
+        flipped[position] ^= 0x01;
+        ASSERT_NE(mygbc::ContentHash::hash(flipped.data(), flipped.size()), hash);
+        ASSERT_NE(mygbc::ContentHash::hash(flipped.data(), 255), mygbc::ContentHash::hash(data.data(), 255));
+    }
+}
+
+/// @brief Checks the hash of fixed inputs on the build kernel and the portable kernel.
+/// @details The hashes are stored in snapshot archives, a changed value needs a new SnapshotArchiveFormat::version.
+TEST(ContentHashTest, hash_matches_golden_values){
+    std::vector<uint8_t> data(300);
+    for(std::size_t index = 0; index < data.size(); ++index){
+        data[index] = static_cast<uint8_t>((index * 7) + 3);
+    }
+    //Empty, tail only, single block, blocks with words and bytes left, a page and a page with a tail
+    const std::size_t sizes[] = {0, 7, 32, 100, 256, 300};
+    const uint64_t expected[] = {0x9C45B7D61FBDEFF7ull, 0x713E17DB08B887F4ull, 0x61C69D8F33294F1Bull, 0x315B59D7588CEDCBull, 0x51D1E5ADE498EA02ull, 0x01AA12EEDD5EE1B3ull};
+    for(std::size_t test = 0; test < 6; ++test){
+        ASSERT_EQ(mygbc::ContentHash::hash(data.data(), sizes[test]), expected[test]);
+        ASSERT_EQ(mygbc::ContentHash::hash_portable(data.data(), sizes[test]), expected[test]);
+    }
+    ASSERT_EQ(mygbc::ContentHash::hash(data.data(), 256, 0x1234), 0xF226347A8C934419ull);
+    ASSERT_EQ(mygbc::ContentHash::hash_portable(data.data(), 256, 0x1234), 0xF226347A8C934419ull);
+}
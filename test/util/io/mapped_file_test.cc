@@ -0,0 +1,36 @@
+#include "../../../src/util/io/mapped_file.h" //MappedFile
+#include "../../test_path.h" //get_unique_temp_path
+#include <gtest/gtest.h> //GTest
+#include <filesystem> //std::filesystem
+#include <fstream> //std::ofstream
+#include <string> //std::string
+#include <vector> //std::vector
+
+/// @brief Checks that the contents are the same for every access pattern.
+TEST(MappedFileTest, access_patterns_read_contents){
+    const std::filesystem::path path = mygbc::get_unique_temp_path("mygbc_mapped_file.bin");
+    std::vector<uint8_t> expected(10000);
+    for(std::size_t index = 0; index < expected.size(); ++index){
+        expected[index] = static_cast<uint8_t>(index * 7);
+    }
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(expected.data()), static_cast<std::streamsize>(expected.size()));
+    }
+    for(const mygbc::MappedFile::AccessPattern access_pattern : {mygbc::MappedFile::AccessPattern::sequential, mygbc::MappedFile::AccessPattern::random}){
+        mygbc::MappedFile mapped_file;
+        ASSERT_TRUE(mapped_file.open(path.string(), access_pattern).ok());
+        ASSERT_EQ(mapped_file.size(), expected.size());
+        ASSERT_EQ(std::vector<uint8_t>(mapped_file.data(), mapped_file.data() + mapped_file.size()), expected);
+    }
+    std::filesystem::remove(path);
+}
+
+/// @brief Checks that a missing file fails to open and leaves the file closed.
+TEST(MappedFileTest, missing_file_fails){
+    const std::filesystem::path path = mygbc::get_unique_temp_path("mygbc_mapped_file_missing.bin");
+    mygbc::MappedFile mapped_file;
+    ASSERT_EQ(mapped_file.open(path.string()).code(), mygbc::Status::StatusType::IO_ERROR);
+    ASSERT_EQ(mapped_file.data(), nullptr);
+    ASSERT_EQ(mapped_file.size(), 0u);
+}
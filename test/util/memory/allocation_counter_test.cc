@@ -0,0 +1,46 @@
+#include "../../../src/util/memory/allocation_counter.h" //AllocationCounter
+#include "../../../src/gbc.h" //GBC
+#include "../../../src/profile/cpu_profiler.h" //CpuProfiler
+#include "../../test_rom.h" //load_jump_loop_rom
+#include <gtest/gtest.h> //GTest
+#include <memory> //std::unique_ptr
+#include <thread> //std::thread
+#include <vector> //std::vector
+
+/// @brief Checks that the hooks count the allocations of the calling thread.
+TEST(AllocationCounterTest, counts_allocations){
+    ASSERT_TRUE(mygbc::AllocationCounter::is_hooked());
+    mygbc::AllocationScope scope;
+    std::unique_ptr<uint64_t> value = std::make_unique<uint64_t>(1);
+    std::vector<uint8_t> bytes(100);
+    ASSERT_EQ(scope.get_allocation_count(), 2);
+    ASSERT_GE(scope.get_allocated_bytes(), sizeof(uint64_t) + 100);
+}
+
+/// @brief Checks that the process count includes the allocations of other threads.
+TEST(AllocationCounterTest, counts_process_allocations){
+    std::unique_ptr<uint64_t> value;
+    const uint64_t start_allocations = mygbc::AllocationCounter::get_process_allocation_count();
+    std::thread allocating_thread([&value](){
+        value = std::make_unique<uint64_t>(1);
+    });
+    allocating_thread.join();
+    //Starting the thread may allocate too
+    ASSERT_GE(mygbc::AllocationCounter::get_process_allocation_count() - start_allocations, 1);
+}
+
+/// @brief Checks that steady state emulation does not allocate.
+TEST(AllocationCounterTest, steady_state_frames_do_not_allocate){
+    mygbc::GBC gbc;
+    ASSERT_TRUE(mygbc::load_jump_loop_rom(gbc).ok());
+    mygbc::CpuProfiler profiler(2);
+    gbc.get_processing_unit().set_profiler(&profiler);
+    //Warm up
+    ASSERT_TRUE(gbc.run_frame().ok());
+    mygbc::AllocationScope scope;
+    for(int frame = 0; frame < 3; ++frame){
+        ASSERT_TRUE(gbc.run_frame().ok());
+    }
+    ASSERT_EQ(scope.get_allocation_count(), 0);
+    gbc.get_processing_unit().set_profiler(nullptr);
+}
@@ -0,0 +1,92 @@
+#include "../../../src/util/thread/worker_pool.h" //WorkerPool
+#include <gtest/gtest.h> //GTest
+#include <atomic> //std::atomic
+#include <utility> //std::pair
+#include <vector> //std::vector
+#if defined(__linux__)
+#include <pthread.h> //pthread_getaffinity_np
+#include <sched.h> //sched_getaffinity
+#endif
+
+/// @brief Counts the runs of each task index.
+/// @param context Vector of counters.
+/// @param index Task index.
+static void count_task(void* context, const std::size_t index){
+    (*static_cast<std::vector<std::atomic<int>>*>(context))[index].fetch_add(1);
+}
+
+/// @brief Checks that every task runs once per batch.
+TEST(WorkerPoolTest, runs_every_task_once){
+    mygbc::WorkerPool pool(4);
+    ASSERT_EQ(pool.get_thread_count(), 4);
+    std::vector<std::atomic<int>> counters(1000);
+    for(int batch = 0; batch < 50; ++batch){
+        pool.run(counters.size(), &count_task, &counters);
+    }
+    for(const std::atomic<int>& counter : counters){
+        ASSERT_EQ(counter.load(), 50);
+    }
+}
+
+/// @brief Checks that a single threaded pool runs the tasks on the calling thread.
+TEST(WorkerPoolTest, single_thread_runs_inline){
+    mygbc::WorkerPool pool(1);
+    ASSERT_EQ(pool.get_thread_count(), 1);
+    std::vector<std::atomic<int>> counters(3);
+    pool.run(counters.size(), &count_task, &counters);
+    pool.run(0, &count_task, &counters);
+    for(const std::atomic<int>& counter : counters){
+        ASSERT_EQ(counter.load(), 1);
+    }
+}
+
+/// @brief Checks that pinned workers run the tasks.
+TEST(WorkerPoolTest, pinned_workers_run_tasks){
+    mygbc::WorkerPool pool(3, true);
+    ASSERT_EQ(pool.get_thread_count(), 3);
+    std::vector<std::atomic<int>> counters(100);
+    pool.run(counters.size(), &count_task, &counters);
+    for(const std::atomic<int>& counter : counters){
+        ASSERT_EQ(counter.load(), 1);
+    }
+}
+
+#if defined(__linux__)
+/// @brief Counts the tasks that ran on a thread allowed outside of the CPU of the context.
+/// @param context Pair of the allowed CPU and the counter.
+/// @param index Task index.
+static void count_outside_cpu_task(void* context, const std::size_t){
+    std::pair<int, std::atomic<int>>& allowed = *static_cast<std::pair<int, std::atomic<int>>*>(context);
+    cpu_set_t thread_set;
+    CPU_ZERO(&thread_set);
+    pthread_getaffinity_np(pthread_self(), sizeof(thread_set), &thread_set);
+    if(CPU_COUNT(&thread_set) != 1 || !CPU_ISSET(allowed.first, &thread_set)){
+        allowed.second.fetch_add(1);
+    }
+}
+
+/// @brief Checks that pinned workers stay inside the affinity mask of the process.
+TEST(WorkerPoolTest, pinned_workers_respect_affinity_mask){
+    cpu_set_t original_set;
+    CPU_ZERO(&original_set);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(original_set), &original_set), 0);
+    int last_cpu = 0;
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu){
+        if(CPU_ISSET(cpu, &original_set)){
+            last_cpu = cpu;
+        }
+    }
+    //As under taskset with a single CPU
+    cpu_set_t restricted_set;
+    CPU_ZERO(&restricted_set);
+    CPU_SET(last_cpu, &restricted_set);
+    ASSERT_EQ(sched_setaffinity(0, sizeof(restricted_set), &restricted_set), 0);
+    std::pair<int, std::atomic<int>> allowed(last_cpu, 0);
+    {
+        mygbc::WorkerPool pool(4, true);
+        pool.run(100, &count_outside_cpu_task, &allowed);
+    }
+    sched_setaffinity(0, sizeof(original_set), &original_set);
+    ASSERT_EQ(allowed.second.load(), 0);
+}
+#endif
@@ -0,0 +1,62 @@
+#include <cstdlib> //std::strtoull
+#include <fstream> //std::ofstream
+#include <iostream> //std::cout, std::cerr
+#include "../src/gbc.h" //GBC
+#include "../src/memory/gbc_binary.h" //GBCBinary
+#include "../src/profile/cpu_profiler.h" //CpuProfiler
+#include "../src/profile/symbol_table.h" //SymbolTable
+#include "../src/util/io/binary_reader.h" //BinaryReader
+
+//Runs the ROM for the given frames and reports where the emulated code spent its cycles
+//Usage: mygbc_profile <rom> <frames> [symbols.sym] [collapsed stacks output]
+//Exit code: 0 profiled, 2 error
+int main(int argc, char* argv[]){
+    if(argc < 3){
+        std::cerr << "Usage: " << argv[0] << " <rom> <frames> [symbols.sym] [collapsed stacks output]\n";
+        return 2;
+    }
+    mygbc::StatusOr<std::vector<uint8_t>> rom = mygbc::BinaryReader::read_as_bytes(argv[1]);
+    if(!rom.ok()){
+        std::cerr << argv[1] << ": " << rom.status().message() << "\n";
+        return 2;
+    }
+    mygbc::StatusOr<mygbc::GBCBinary> binary = mygbc::GBCBinary::parse_bytes(rom.value());
+    if(!binary.ok()){
+        std::cerr << argv[1] << ": " << binary.status().message() << "\n";
+        return 2;
+    }
+    mygbc::SymbolTable symbols;
+    if(argc > 3){
+        mygbc::StatusOr<mygbc::SymbolTable> symbols_load = mygbc::SymbolTable::load(argv[3]);
+        if(!symbols_load.ok()){
+            std::cerr << argv[3] << ": " << symbols_load.status().message() << "\n";
+            return 2;
+        }
+        symbols = std::move(symbols_load).value();
+    }
+
+    mygbc::GBC gbc;
+    gbc.get_memory().load_rom(binary.value());
+    mygbc::CpuProfiler profiler(binary.value());
+    gbc.get_processing_unit().set_profiler(&profiler);
+    const uint64_t frames = std::strtoull(argv[2], nullptr, 10);
+    for(uint64_t frame = 0; frame < frames; ++frame){
+        mygbc::Status frame_status = gbc.run_frame();
+        if(!frame_status.ok()){
+            std::cerr << "Stopped at frame " << frame << ": " << frame_status.message() << "\n";
+            break;
+        }
+    }
+    gbc.get_processing_unit().set_profiler(nullptr);
+
+    std::cout << profiler.format_hot_functions(symbols, 32);
+    if(argc > 4){
+        std::ofstream collapsed(argv[4]);
+        collapsed << profiler.format_collapsed_stacks(symbols);
+        if(!collapsed){
+            std::cerr << argv[4] << ": could not write the collapsed stacks\n";
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include <cstdlib> //std::strtoul
+#include <iostream> //std::cout, std::cerr
+#include "../src/instruction_set_lr35902/instruction_set_lr35902.h" //InstructionSetLR35902
+#include "../src/trace/cpu_trace_diff.h" //CpuTraceDiff
+#include "../src/trace/cpu_trace_reader.h" //CpuTraceReader
+
+//Reports the first divergence of two binary CPU traces
+//Usage: mygbc_trace_diff <first trace> <second trace> [context entries]
+//Exit code: 0 traces match, 1 traces diverge, 2 error
+int main(int argc, char* argv[]){
+    if(argc < 3){
+        std::cerr << "Usage: " << argv[0] << " <first trace> <second trace> [context entries]\n";
+        return 2;
+    }
+    const std::size_t context_size = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 8;
+    mygbc::CpuTraceReader first;
+    mygbc::CpuTraceReader second;
+    mygbc::Status first_open = first.open(argv[1]);
+    if(!first_open.ok()){
+        std::cerr << argv[1] << ": " << first_open.message() << "\n";
+        return 2;
+    }
+    mygbc::Status second_open = second.open(argv[2]);
+    if(!second_open.ok()){
+        std::cerr << argv[2] << ": " << second_open.message() << "\n";
+        return 2;
+    }
+    mygbc::StatusOr<mygbc::CpuTraceDivergence> divergence = mygbc::CpuTraceDiff::find_first_divergence(first, second, context_size);
+    if(!divergence.ok()){
+        std::cerr << divergence.status().message() << "\n";
+        return 2;
+    }
+    mygbc::InstructionSetLR35902 instruction_set;
+    std::cout << mygbc::CpuTraceDiff::format_report(divergence.value(), instruction_set);
+    return divergence.value().diverged ? 1 : 0;
+}
@@ -0,0 +1,41 @@
+#include <fstream> //std::ofstream
+#include <iostream> //std::cout, std::cerr
+#include <string> //std::string
+#include "../src/trace/cpu_trace_reader.h" //CpuTraceReader
+
+//Expands a binary CPU trace to gameboy-doctor text
+//Usage: mygbc_trace_expand <trace file> [output file]
+int main(int argc, char* argv[]){
+    if(argc < 2){
+        std::cerr << "Usage: " << argv[0] << " <trace file> [output file]\n";
+        return 1;
+    }
+    mygbc::CpuTraceReader reader;
+    mygbc::Status open_status = reader.open(argv[1]);
+    if(!open_status.ok()){
+        std::cerr << open_status.message() << "\n";
+        return 1;
+    }
+    std::ofstream output_file;
+    if(argc > 2){
+        output_file.open(argv[2]);
+        if(!output_file){
+            std::cerr << "Could not open " << argv[2] << " for writing!\n";
+            return 1;
+        }
+    }
+    std::ostream& output = argc > 2 ? static_cast<std::ostream&>(output_file) : std::cout;
+    mygbc::CpuTraceEntry entry;
+    while(true){
+        mygbc::StatusOr<bool> has_entry = reader.next(entry);
+        if(!has_entry.ok()){
+            std::cerr << has_entry.status().message() << "\n";
+            return 1;
+        }
+        if(!has_entry.value()){
+            break;
+        }
+        output << entry.to_doctor_line() << "\n";
+    }
+    return 0;
+}